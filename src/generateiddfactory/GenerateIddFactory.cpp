@@ -270,6 +270,7 @@ void initializeOutFiles(GenerateIddFactoryOutFiles& outFiles,
     cxxFile->tempFile
       << "#include <utilities/idd/IddFactory.hxx>" << std::endl
       << "#include <utilities/idd/IddEnums.hxx>" << std::endl
+      << "#include <utilities/idd/IddObjectTable.hpp>" << std::endl
       << std::endl
       << "#include <utilities/core/Assert.hpp>" << std::endl
       << "#include <utilities/core/Compare.hpp>" << std::endl
@@ -784,7 +785,8 @@ void completeOutFiles(const IddFileFactoryDataVector& iddFiles,
     << "    if (::openstudio::embedded_files::hasFile(iddPath) && (version < currentVersion)) {" << std::endl
     << "      std::stringstream ss;" << std::endl
     << "      ss << ::openstudio::embedded_files::getFileAsString(iddPath);" << std::endl
-    << "      result = IddFile::load(ss);" << std::endl
+    << "      // version translation only needs the objects that appear in the model being translated" << std::endl
+    << "      result = IddFile::load(ss, true);" << std::endl
     << "    }" << std::endl
     << "    if (result) {" << std::endl
     << "      m_osIddFiles[version] = *result;" << std::endl
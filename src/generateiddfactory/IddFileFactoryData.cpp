@@ -31,11 +31,13 @@
 #include "WriteEnums.hpp"
 
 #include "../utilities/idd/IddRegex.hpp"
+#include "../utilities/idd/CommentRegex.hpp"
 
 #include <boost/regex.hpp>
 #include <boost/algorithm/string.hpp>
 
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <exception>
@@ -191,17 +193,8 @@ void IddFileFactoryData::parseFile(const path& outPath,
     objectName.first = m_convertName(objectName.second);
     m_objectNames.push_back(objectName);
 
-    // start writing create function
-    cxxFile->tempFile
-      << std::endl
-      << "IddObject create" << objectName.first << "IddObject() {" << std::endl
-      << std::endl
-      << "  static const IddObject object = []{" << std::endl
-      << std::endl
-      << "    // Rely on C++11 static initialization and Initialize on First Use Idiom" << std::endl
-      << "    // to make sure all statics are initialized properly, thread safely" << std::endl
-      << "    std::stringstream ss;" << std::endl
-      << "    ss << \"" << m_readyLineForOutput(line) << "\\n\";";
+    // start collecting object text, split into tables once the object is complete
+    std::string objectText = trimLine + "\n";
 
     // start collecting field names
     // (requires \field tag, which is expected to occur one per line)
@@ -212,22 +205,8 @@ void IddFileFactoryData::parseFile(const path& outPath,
     while (std::getline(iddFile,line)) {
       ++lineNum; trimLine = line; boost::trim(trimLine);
       if (trimLine.empty()) {
-        // finish writing create function
-        cxxFile->tempFile
-          << std::endl
-          << std::endl
-          << "    IddObjectType objType(IddObjectType::" << objectName.first << ");" << std::endl
-          << "    OptionalIddObject oObj = IddObject::load(\"" << objectName.second << "\"," << std::endl
-          << "                                             \"" << group << "\"," << std::endl
-          << "                                             ss.str()," << std::endl
-          << "                                             objType);" << std::endl
-          << "    OS_ASSERT(oObj);" << std::endl
-          << "    return *oObj;" << std::endl
-          << "  }(); // immediately invoked lambda" << std::endl
-          << std::endl
-          << "  OS_ASSERT(object.type() == IddObjectType::" << objectName.first << ");" << std::endl
-          << "  return object;" << std::endl
-          << "}" << std::endl;
+        // write create function
+        m_writeObjectTable(cxxFile->tempFile, objectName, group, objectText);
 
         // write field enums
         if (!fieldNames.empty() || !extensibleFieldNames.empty()) {
@@ -318,10 +297,8 @@ void IddFileFactoryData::parseFile(const path& outPath,
         break;
       }
 
-      // continue writing create function
-      cxxFile->tempFile
-        << std::endl
-        << "    ss << \"" << m_readyLineForOutput(line) << "\\n\";";
+      // continue collecting object text
+      objectText += trimLine + "\n";
 
       // look for field name
       std::string fieldName;
@@ -429,4 +406,189 @@ std::string IddFileFactoryData::m_readyLineForOutput(const std::string& line) co
   return result;
 }
 
+std::string IddFileFactoryData::m_escapeForOutput(const std::string& text) const {
+  std::string result;
+  result.reserve(text.size());
+  for (char c : text) {
+    switch (c) {
+      case '\\': result += "\\\\"; break;
+      case '"': result += "\\\""; break;
+      case '\n': result += "\\n"; break;
+      case '\r': result += "\\r"; break;
+      case '\t': result += "\\t"; break;
+      default: result += c; break;
+    }
+  }
+  return result;
+}
+
+void IddFileFactoryData::m_writeObjectTable(std::ostream& os,
+                                            const StringPair& objectName,
+                                            const std::string& group,
+                                            const std::string& text) const
+{
+  struct FieldData {
+    std::string fieldId;
+    std::string name;
+    std::vector<std::string> properties;
+  };
+
+  std::stringstream ss;
+  boost::smatch matches;
+
+  // splits slash code text into individual properties, mirrors IddObject_Impl::parseObject
+  // and IddField_Impl::parse
+  auto splitProperties = [&](std::string propertiesText, std::vector<std::string>& properties) {
+    boost::smatch propertyMatches;
+    while (boost::regex_search(propertiesText, propertyMatches, iddRegex::metaDataComment())) {
+      std::string thisProperty(propertyMatches[1].first, propertyMatches[1].second);
+      boost::trim(thisProperty);
+      properties.push_back(thisProperty);
+      propertiesText = std::string(propertyMatches[2].first, propertyMatches[2].second);
+      boost::trim(propertiesText);
+    }
+    if ( !( (boost::regex_match(propertiesText, commentRegex::whitespaceOnlyBlock())) ||
+            (boost::regex_match(propertiesText, iddRegex::commentOnlyLine())) ) ) {
+      ss << "Could not process properties text '" << propertiesText << "' in object '"
+         << objectName.second << "' of Idd file '" << m_fileName << "'.";
+      throw std::runtime_error(ss.str().c_str());
+    }
+  };
+
+  // split object text from fields text, mirrors IddObject_Impl::parse
+  std::string objectText;
+  std::string fieldsText;
+  if (boost::regex_search(text, matches, iddRegex::objectAndFields())) {
+    objectText = std::string(matches[1].first, matches[1].second);
+    fieldsText = std::string(matches[2].first, matches[2].second);
+  }
+  else if (boost::regex_match(text, iddRegex::objectNoFields())) {
+    objectText = text;
+  }
+  else {
+    ss << "Unexpected pattern '" << text << "' found in object '" << objectName.second
+       << "' of Idd file '" << m_fileName << "'.";
+    throw std::runtime_error(ss.str().c_str());
+  }
+
+  std::vector<std::string> objectProperties;
+  if (boost::regex_search(objectText, matches, iddRegex::line())) {
+    std::string propertiesText(matches[2].first, matches[2].second);
+    boost::trim(propertiesText);
+    splitProperties(propertiesText, objectProperties);
+  }
+  else {
+    ss << "Could not determine object name from text '" << objectText << "' in Idd file '"
+       << m_fileName << "'.";
+    throw std::runtime_error(ss.str().c_str());
+  }
+
+  // split fields, mirrors IddObject_Impl::parseFields
+  std::vector<FieldData> fields;
+  while (boost::regex_search(fieldsText, matches, iddRegex::lastField())) {
+    std::string fieldText(matches[2].first, matches[2].second);
+    FieldData field;
+
+    boost::smatch fieldMatches;
+    if (!boost::regex_search(fieldText, fieldMatches, iddRegex::field())) {
+      ss << "Field text '" << fieldText << "' in object '" << objectName.second
+         << "' of Idd file '" << m_fileName << "' does not match expected pattern.";
+      throw std::runtime_error(ss.str().c_str());
+    }
+    std::string fieldTypeChar(fieldMatches[1].first, fieldMatches[1].second);
+    std::string fieldTypeNumber(fieldMatches[2].first, fieldMatches[2].second);
+    std::string propertiesText(fieldMatches[3].first, fieldMatches[3].second);
+    field.fieldId = fieldTypeChar + fieldTypeNumber;
+
+    if (boost::regex_search(fieldText, fieldMatches, iddRegex::name())) {
+      field.name = std::string(fieldMatches[1].first, fieldMatches[1].second);
+      boost::trim(field.name);
+    }
+    else {
+      field.name = field.fieldId;
+    }
+
+    splitProperties(propertiesText, field.properties);
+    fields.push_back(field);
+
+    fieldsText = std::string(matches[1].first, matches[1].second);
+  }
+
+  if (!fieldsText.empty()) {
+    ss << "Could not process remaining field text '" << fieldsText << "' in object '"
+       << objectName.second << "' of Idd file '" << m_fileName << "'.";
+    throw std::runtime_error(ss.str().c_str());
+  }
+
+  // fields were found last to first
+  std::reverse(fields.begin(), fields.end());
+
+  // write create function
+  os << std::endl
+     << "IddObject create" << objectName.first << "IddObject() {" << std::endl
+     << std::endl
+     << "  static const IddObject object = []{" << std::endl
+     << std::endl
+     << "    // Rely on C++11 static initialization and Initialize on First Use Idiom" << std::endl
+     << "    // to make sure all statics are initialized properly, thread safely" << std::endl;
+
+  auto writeProperties = [&](const std::string& arrayName, const std::vector<std::string>& properties) {
+    if (properties.empty()) {
+      return;
+    }
+    os << "    static const char* const " << arrayName << "[] = {" << std::endl;
+    for (const std::string& property : properties) {
+      os << "      \"" << m_escapeForOutput(property) << "\"," << std::endl;
+    }
+    os << "    };" << std::endl;
+  };
+
+  writeProperties("objectProperties", objectProperties);
+  for (unsigned i = 0, n = fields.size(); i < n; ++i) {
+    writeProperties("field" + std::to_string(i) + "Properties", fields[i].properties);
+  }
+
+  if (!fields.empty()) {
+    os << "    static const IddFieldTable fields[] = {" << std::endl;
+    for (unsigned i = 0, n = fields.size(); i < n; ++i) {
+      os << "      {\"" << fields[i].fieldId << "\", \"" << m_escapeForOutput(fields[i].name) << "\", ";
+      if (fields[i].properties.empty()) {
+        os << "nullptr, 0";
+      }
+      else {
+        os << "field" << i << "Properties, " << fields[i].properties.size();
+      }
+      os << "}," << std::endl;
+    }
+    os << "    };" << std::endl;
+  }
+
+  os << "    static const IddObjectTable table = {" << std::endl
+     << "      \"" << m_escapeForOutput(objectName.second) << "\"," << std::endl
+     << "      \"" << m_escapeForOutput(group) << "\"," << std::endl;
+  if (objectProperties.empty()) {
+    os << "      nullptr, 0," << std::endl;
+  }
+  else {
+    os << "      objectProperties, " << objectProperties.size() << "," << std::endl;
+  }
+  if (fields.empty()) {
+    os << "      nullptr, 0" << std::endl;
+  }
+  else {
+    os << "      fields, " << fields.size() << std::endl;
+  }
+  os << "    };" << std::endl
+     << std::endl
+     << "    IddObjectType objType(IddObjectType::" << objectName.first << ");" << std::endl
+     << "    OptionalIddObject oObj = IddObject::load(table, objType);" << std::endl
+     << "    OS_ASSERT(oObj);" << std::endl
+     << "    return *oObj;" << std::endl
+     << "  }(); // immediately invoked lambda" << std::endl
+     << std::endl
+     << "  OS_ASSERT(object.type() == IddObjectType::" << objectName.first << ");" << std::endl
+     << "  return object;" << std::endl
+     << "}" << std::endl;
+}
+
 } // openstudio
@@ -78,6 +78,15 @@ class IddFileFactoryData {
 
   std::string m_convertName(const std::string& originalName) const;
   std::string m_readyLineForOutput(const std::string& line) const;
+  std::string m_escapeForOutput(const std::string& text) const;
+
+  /** Splits the text of one IddObject into object properties, fields, and field properties
+   *  using the same expressions as IddObject::load, and writes the result out as a static
+   *  IddObjectTable inside the object's create function. */
+  void m_writeObjectTable(std::ostream& os,
+                          const StringPair& objectName,
+                          const std::string& group,
+                          const std::string& text) const;
 };
 
 typedef std::vector<IddFileFactoryData> IddFileFactoryDataVector;
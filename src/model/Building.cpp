@@ -707,12 +707,12 @@ namespace detail {
   double Building_Impl::floorArea() const
   {
     double result = 0;
-    for (const Space& space : spaces()){
+    this->model().forEachConcreteModelObject<Space>([&result](const Space_Impl& space) {
       bool partofTotalFloorArea = space.partofTotalFloorArea();
       if (partofTotalFloorArea) {
         result += space.multiplier() * space.floorArea();
       }
-    }
+    });
     return result;
   }
 
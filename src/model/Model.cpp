@@ -53,6 +53,8 @@
 #include "../utilities/idd/IddField_Impl.hpp"
 #include "../utilities/idd/IddFile_Impl.hpp"
 #include "../utilities/idf/Workspace_Impl.hpp" // needed for serialization
+#include "../utilities/idf/WorkspaceBatchEdit.hpp"
+#include "../utilities/idf/WorkspaceSnapshot.hpp"
 
 #include "../utilities/idf/IdfFile.hpp"
 
@@ -62,6 +64,7 @@
 
 #include "../utilities/sql/SqlFile.hpp"
 
+#include <boost/algorithm/string/case_conv.hpp>
 #include <boost/regex.hpp>
 
 using openstudio::IddObjectType;
@@ -165,6 +168,7 @@ namespace detail {
     std::shared_ptr<SqlFile> tsf = m_sqlFile;
     m_sqlFile = otherImpl->m_sqlFile;
     otherImpl->m_sqlFile = tsf;
+    m_sizingResults.swap(otherImpl->m_sizingResults);
 
     ComponentWatcherVector tcw = m_componentWatchers;
     m_componentWatchers = otherImpl->m_componentWatchers;
@@ -759,6 +763,68 @@ namespace detail {
     }
   }
 
+  boost::optional<double> Model_Impl::sizingResult(const std::string& objectType, const std::string& sqlName, const std::string& description) const
+  {
+    boost::optional<double> result;
+    if (!m_sqlFile) {
+      return result;
+    }
+
+    const SizingResults& sizingResults = this->sizingResults();
+    auto typeIt = sizingResults.byType.find(std::make_tuple(objectType, sqlName, description));
+    if (typeIt != sizingResults.byType.end()) {
+      result = typeIt->second;
+    } else {
+      auto nameIt = sizingResults.byName.find(std::make_pair(sqlName, description));
+      if (nameIt != sizingResults.byName.end()) {
+        result = nameIt->second;
+      }
+    }
+    return result;
+  }
+
+  const Model_Impl::SizingResults& Model_Impl::sizingResults() const
+  {
+    if (m_sizingResults) {
+      return *m_sizingResults;
+    }
+
+    m_sizingResults = SizingResults();
+
+    // pivot the table to one row per component, each query returns one column in table order,
+    // EnergyPlus names the columns Component Type, Component Name, Input Field Description and Value
+    std::string pivotQuery = "SELECT COALESCE(MAX(CASE WHEN ColumnName=? THEN Value END), '') "
+                             "FROM tabulardatawithstrings "
+                             "WHERE ReportName='Initialization Summary' "
+                             "AND ReportForString='Entire Facility' "
+                             "AND TableName='Component Sizing Information' "
+                             "GROUP BY RowName "
+                             "HAVING COUNT(CASE WHEN ColumnName='Value' THEN 1 END) > 0 "
+                             "ORDER BY MIN(TabularDataIndex)";
+
+    boost::optional<std::vector<std::string>> types = m_sqlFile->execAndReturnVectorOfString(pivotQuery, std::vector<std::string>{"Component Type"});
+    boost::optional<std::vector<std::string>> names = m_sqlFile->execAndReturnVectorOfString(pivotQuery, std::vector<std::string>{"Component Name"});
+    boost::optional<std::vector<std::string>> descriptions = m_sqlFile->execAndReturnVectorOfString(pivotQuery, std::vector<std::string>{"Input Field Description"});
+    boost::optional<std::vector<double>> values = m_sqlFile->execAndReturnVectorOfDouble(pivotQuery, std::vector<std::string>{"Value"});
+
+    if (!types || !names || !descriptions || !values ||
+        (names->size() != types->size()) || (descriptions->size() != types->size()) || (values->size() != types->size())) {
+      LOG(Warn, "Could not read the Initialization Summary Component Sizing table, autosized values will not be available.");
+      return *m_sizingResults;
+    }
+
+    for (std::vector<std::string>::size_type i = 0; i < types->size(); ++i) {
+      std::string sqlName = boost::to_upper_copy((*names)[i]);
+      // emplace keeps the first row for a key, as the row by row queries did
+      m_sizingResults->byType.emplace(std::make_tuple((*types)[i], sqlName, (*descriptions)[i]), (*values)[i]);
+      m_sizingResults->byName.emplace(std::make_pair(sqlName, (*descriptions)[i]), (*values)[i]);
+    }
+
+    LOG(Debug, "Loaded " << m_sizingResults->byType.size() << " component sizing values");
+
+    return *m_sizingResults;
+  }
+
   bool Model_Impl::setWorkflowJSON(const openstudio::WorkflowJSON& workflowJSON)
   {
     m_workflowJSON = workflowJSON;
@@ -775,6 +841,7 @@ namespace detail {
   {
     bool result = true;
     m_sqlFile = std::shared_ptr<openstudio::SqlFile>(new openstudio::SqlFile(sqlFile));
+    m_sizingResults.reset();
     return result;
   }
 
@@ -783,6 +850,7 @@ namespace detail {
   {
     bool result = true;
     m_sqlFile.reset();
+    m_sizingResults.reset();
     return result;
   }
 
@@ -819,6 +887,7 @@ namespace detail {
   std::vector<openstudio::IdfObject> Model_Impl::purgeUnusedResourceObjects() {
     ResourceObjectVector resources = model().getModelObjects<ResourceObject>();
     IdfObjectVector removedObjects;
+    WorkspaceBatchEdit batchEdit(model());
     for (ResourceObject& resource : resources) {
       // test for initialized first in case earlier .remove() got this one already
       if ((resource.initialized()) && (resource.nonResourceObjectUseCount(true) == 0)) {
@@ -831,6 +900,7 @@ namespace detail {
 
   std::vector<openstudio::IdfObject> Model_Impl::purgeUnusedResourceObjects(IddObjectType iddObjectType) {
     IdfObjectVector removedObjects;
+    WorkspaceBatchEdit batchEdit(model());
     for (const WorkspaceObject& workspaceObject : getObjectsByType(iddObjectType)) {
       boost::optional<ResourceObject> resource = workspaceObject.optionalCast<ResourceObject>();
       if (resource){
@@ -1129,7 +1199,7 @@ Model::Model(const openstudio::IdfFile& idfFile)
     LOG(Trace,"objectImplPtr: " << toString(objectImplPtrs.back()->handle()));
   }
   // add Object_ImplPtrs to Workspace_Impl
-  getImpl<detail::Model_Impl>()->addObjects(objectImplPtrs);
+  getImpl<detail::Model_Impl>()->bulkAddObjects(objectImplPtrs,false);
   // watch loaded components
   getImpl<detail::Model_Impl>()->createComponentWatchers();
 }
@@ -1157,9 +1227,9 @@ Model::Model(const openstudio::Workspace& workspace)
   getImpl<detail::Model_Impl>()->createComponentWatchers();
 }
 
-boost::optional<Model> Model::load(const path& osmPath) {
+boost::optional<Model> Model::load(const path& osmPath, unsigned numThreads) {
   OptionalModel result;
-  OptionalIdfFile oIdfFile = IdfFile::load(osmPath,IddFileType::OpenStudio);
+  OptionalIdfFile oIdfFile = IdfFile::load(osmPath,IddFileType::OpenStudio,nullptr,numThreads);
   if (oIdfFile) {
     try {
       result = Model(*oIdfFile);
@@ -1181,9 +1251,9 @@ boost::optional<Model> Model::load(const path& osmPath) {
   return result;
 }
 
-boost::optional<Model> Model::load(const path& osmPath, const path& workflowJSONPath)
+boost::optional<Model> Model::load(const path& osmPath, const path& workflowJSONPath, unsigned numThreads)
 {
-  OptionalModel result = load(osmPath);
+  OptionalModel result = load(osmPath, numThreads);
   if (result){
     boost::optional<WorkflowJSON> workflowJSON = WorkflowJSON::load(workflowJSONPath);
     if (workflowJSON){
@@ -1196,6 +1266,36 @@ boost::optional<Model> Model::load(const path& osmPath, const path& workflowJSON
 }
 
 
+boost::optional<Model> Model::loadBinary(const path& snapshotPath)
+{
+  OptionalModel result;
+  WorkspaceSnapshotReader snapshot(snapshotPath);
+  if (snapshot.isValid() && (snapshot.iddFileType() == IddFileType::OpenStudio)) {
+    try {
+      Model model(std::shared_ptr<detail::Model_Impl>(new detail::Model_Impl()));
+      if (model.getImpl<detail::Model_Impl>()->addSnapshotObjects(snapshot)) {
+        // watch loaded components
+        model.getImpl<detail::Model_Impl>()->createComponentWatchers();
+        result = model;
+      }
+    }
+    catch (...) {}
+  }
+
+  if (result){
+    // Load the workflow.osw in the model's companion folder
+    path workflowJSONPath = getCompanionFolder(snapshotPath) / toPath("workflow.osw");
+    if (exists(workflowJSONPath)){
+      boost::optional<WorkflowJSON> workflowJSON = WorkflowJSON::load(workflowJSONPath);
+      if (workflowJSON){
+        result->setWorkflowJSON(*workflowJSON);
+      }
+    }
+  }
+
+  return result;
+}
+
 Model::Model(std::shared_ptr<detail::Model_Impl> p)
   : Workspace(std::move(p))
 {}
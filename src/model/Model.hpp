@@ -314,6 +314,20 @@ class MODEL_API Model : public openstudio::Workspace {
     return result;
   }
 
+  /** Calls visitor on the implementation of each \link ModelObject ModelObject \endlink of
+   *  concrete type T, without materializing a std::vector<T>. Like getConcreteModelObjects, this
+   *  requires T_Impl.hpp to be included. visitor must not add or remove objects. */
+  template <typename T, typename Visitor>
+  void forEachConcreteModelObject(Visitor visitor) const
+  {
+    this->forEachObjectOfType(T::iddObjectType(),
+      [&visitor](const std::shared_ptr<openstudio::detail::WorkspaceObject_Impl>& p) {
+        if (const typename T::ImplType* impl = dynamic_cast<const typename T::ImplType*>(p.get())) {
+          visitor(*impl);
+        }
+      });
+  }
+
   /** Returns the subset of \link ModelObject ModelObjects \endlink referenced by handles
    *  which are of type T. This method can be used with T as a concrete type (e.g. Zone) or
    *  as an abstract class (e.g. ParentObject).
@@ -409,11 +423,18 @@ class MODEL_API Model : public openstudio::Workspace {
 
   //@}
 
-  /** Load Model from file, attempts to load WorkflowJSON from standard path. */
-  static boost::optional<Model> load(const path& osmPath);
+  /** Load Model from file, attempts to load WorkflowJSON from standard path. Objects are read on
+   *  numThreads threads, or one per hardware core if numThreads is 0, see IdfFile::load. */
+  static boost::optional<Model> load(const path& osmPath, unsigned numThreads=1);
 
   /** Load Model and WorkflowJSON from files, fails if either osm or workflowJSON cannot be loaded. */
-  static boost::optional<Model> load(const path& osmPath, const path& workflowJSONPath);
+  static boost::optional<Model> load(const path& osmPath, const path& workflowJSONPath, unsigned numThreads=1);
+
+  /** Load Model from a binary snapshot written by saveBinary, attempts to load WorkflowJSON from
+   *  the snapshot's companion folder as load does. Returns an uninitialized object if the file is
+   *  not an OpenStudio snapshot or was written against a different IDD version, in which case the
+   *  osm should be loaded instead. */
+  static boost::optional<Model> loadBinary(const path& snapshotPath);
 
   /// Equality test, tests if this Model shares the same implementation object with other.
   bool operator==(const Model& other) const;
@@ -260,42 +260,12 @@ namespace detail {
     }
 
     if (sqlObjectType == "CoilPerformance:DX:Cooling") {
-      // Get the parent object
+      // Get the parent object from the objects pointing to this one, rather than searching every two stage coil
       boost::optional<CoilCoolingDXTwoStageWithHumidityControlMode> parentCoil;
-      auto coilTwoSpdHumCtrls = this->model().getConcreteModelObjects<CoilCoolingDXTwoStageWithHumidityControlMode>();
-      for (const auto & coilInModel : coilTwoSpdHumCtrls) {
-        // Check the coil performance objects in this coil to see if one of them is this object
-        auto coilPerf = coilInModel.normalModeStage1CoilPerformance();
-        if (coilPerf) {
-          if (coilPerf->handle() == this->handle()) {
-            parentCoil = coilInModel;
-            break;
-          }
-        }
-
-        coilPerf = coilInModel.normalModeStage1Plus2CoilPerformance();
-        if (coilPerf) {
-          if (coilPerf->handle() == this->handle()) {
-            parentCoil = coilInModel;
-            break;
-          }
-        }
-
-        coilPerf = coilInModel.dehumidificationMode1Stage1CoilPerformance();
-        if (coilPerf) {
-          if (coilPerf->handle() == this->handle()) {
-            parentCoil = coilInModel;
-            break;
-          }
-        }
-
-        coilPerf = coilInModel.dehumidificationMode1Stage1Plus2CoilPerformance();
-        if (coilPerf) {
-          if (coilPerf->handle() == this->handle()) {
-            parentCoil = coilInModel;
-            break;
-          }
-        }
+      std::vector<CoilCoolingDXTwoStageWithHumidityControlMode> parentCoils = getObject<ModelObject>().getModelObjectSources<CoilCoolingDXTwoStageWithHumidityControlMode>(
+        CoilCoolingDXTwoStageWithHumidityControlMode::iddObjectType());
+      if (!parentCoils.empty()) {
+        parentCoil = parentCoils.front();
       }
 
       if (!parentCoil) {
@@ -316,26 +286,8 @@ namespace detail {
       return result;
     }
 
-    // Query the Intialization Summary -> Component Sizing table to get
-    // the row names that contains information for this component.
-    std::stringstream rowsQuery;
-    rowsQuery << "SELECT RowName ";
-    rowsQuery << "FROM tabulardatawithstrings ";
-    rowsQuery << "WHERE ReportName='Initialization Summary' ";
-    rowsQuery << "AND ReportForString='Entire Facility' ";
-    rowsQuery << "AND TableName = 'Component Sizing Information' ";
-    rowsQuery << "AND Value='" + sqlName + "'";
-
-    boost::optional<std::vector<std::string>> rowNames = model().sqlFile().get().execAndReturnVectorOfString(rowsQuery.str());
-
-    // Warn if the query failed
-    if (!rowNames) {
-      LOG(Warn, "Could not find a component called '" + sqlName + "' in any rows of the Initialization Summary Component Sizing table.");
-      return result;
-    }
-
-    // Query each row of the Intialization Summary -> Component Sizing table
-    // that contains this component to get the desired value.
+    // Look up the value in the Intialization Summary -> Component Sizing table,
+    // which the model reads once for all of its objects.
     std::string valueNameAndUnits = valueName + std::string(" [") + units + std::string("]");
     if (units == "") {
       valueNameAndUnits = valueName;
@@ -343,37 +295,7 @@ namespace detail {
       valueNameAndUnits = valueName + std::string(" []");
     }
 
-    for (std::string rowName : rowNames.get()) {
-      std::stringstream rowCheckQuery;
-      rowCheckQuery << "SELECT Value ";
-      rowCheckQuery << "FROM tabulardatawithstrings ";
-      rowCheckQuery << "WHERE ReportName='Initialization Summary' ";
-      rowCheckQuery << "AND ReportForString='Entire Facility' ";
-      rowCheckQuery << "AND TableName = 'Component Sizing Information' ";
-      rowCheckQuery << "AND RowName='" << rowName << "' ";
-      rowCheckQuery << "AND Value='" << valueNameAndUnits << "'";
-      boost::optional<std::string> rowValueName = model().sqlFile().get().execAndReturnFirstString(rowCheckQuery.str());
-      // Check if the query succeeded
-      if (!rowValueName) {
-        continue;
-      }
-      // This is the right row
-      std::stringstream valQuery;
-      valQuery << "SELECT Value ";
-      valQuery << "FROM tabulardatawithstrings ";
-      valQuery << "WHERE ReportName='Initialization Summary' ";
-      valQuery << "AND ReportForString='Entire Facility' ";
-      valQuery << "AND TableName = 'Component Sizing Information' ";
-      valQuery << "AND ColumnName='Value' ";
-      valQuery << "AND RowName='" << rowName << "' ";
-      boost::optional<double> val = model().sqlFile().get().execAndReturnFirstDouble(valQuery.str());
-      // Check if the query succeeded
-      if (val) {
-        result = val.get();
-        break;
-      }
-    }
-
+    result = model().getImpl<detail::Model_Impl>()->sizingResult(sqlObjectType, sqlName, valueNameAndUnits);
 
     if (!result) {
       LOG(Debug, "The autosized value query for " + valueNameAndUnits + " of " + sqlName + " returned no value.");
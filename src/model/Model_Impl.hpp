@@ -50,6 +50,8 @@
 
 #include <boost/optional.hpp>
 
+#include <map>
+#include <tuple>
 #include <vector>
 
 namespace openstudio {
@@ -139,6 +141,11 @@ namespace detail {
     /// Get the sql file
     boost::optional<openstudio::SqlFile> sqlFile() const;
 
+    /** Get a value of the Initialization Summary Component Sizing Information table of the sql file, by EnergyPlus object
+     *  type, uppercased object name and description (e.g. 'Design Size Nominal Capacity [W]'). The table is read once per
+     *  sql file. If no row matches objectType, the first row for sqlName and description is returned. */
+    boost::optional<double> sizingResult(const std::string& objectType, const std::string& sqlName, const std::string& description) const;
+
     /** Get the Building object if there is one, this implementation uses a cached reference to the Building
      *  object which can be significantly faster than calling getOptionalUniqueModelObject<Building>(). */
     boost::optional<Building> building() const;
@@ -298,6 +305,16 @@ namespace detail {
     // Make this a shared_ptr to avoid having to #include SqlFile.hpp in all Model objects
     std::shared_ptr<openstudio::SqlFile> m_sqlFile;
 
+    // Component Sizing Information values of m_sqlFile, loaded on first use of sizingResult
+    struct SizingResults
+    {
+      std::map<std::tuple<std::string, std::string, std::string>, double> byType; // object type, name, description
+      std::map<std::pair<std::string, std::string>, double> byName;               // name, description
+    };
+    mutable boost::optional<SizingResults> m_sizingResults;
+
+    const SizingResults& sizingResults() const;
+
     std::vector<ComponentWatcher> m_componentWatchers;
 
     void mf_createComponentWatcher(ComponentData& componentData);
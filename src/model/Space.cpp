@@ -914,23 +914,26 @@ namespace detail {
 
   double Space_Impl::floorArea() const
   {
+    // visit the surfaces in place rather than building a SurfaceVector, this is called for
+    // every space by Building_Impl::floorArea
     double result = 0;
-    for (const Surface& surface : this->surfaces()) {
-      if (istringEqual(surface.surfaceType(), "Floor"))
+    forEachSource(Surface::iddObjectType(), [&result](const std::shared_ptr<WorkspaceObject_Impl>& p) {
+      const Surface_Impl* surface = dynamic_cast<const Surface_Impl*>(p.get());
+      if (surface && istringEqual(surface->surfaceTypeView(), "Floor"))
       {
-        if (surface.isAirWall()){
-          continue;
+        if (surface->isAirWall()){
+          return;
         }
-        result += surface.grossArea();
+        result += surface->grossArea();
       }
-    }
+    });
     return result;
   }
 
   double Space_Impl::exteriorArea() const {
     double result = 0;
     for (const Surface& surface : this->surfaces()) {
-      if (istringEqual(surface.outsideBoundaryCondition(), "Outdoors"))
+      if (istringEqual(surface.getImpl<detail::Surface_Impl>()->outsideBoundaryConditionView(), "Outdoors"))
       {
         result += surface.grossArea();
       }
@@ -941,9 +944,10 @@ namespace detail {
   double Space_Impl::exteriorWallArea() const {
     double result = 0;
     for (const Surface& surface : this->surfaces()) {
-      if (istringEqual(surface.outsideBoundaryCondition(), "Outdoors"))
+      std::shared_ptr<detail::Surface_Impl> surfaceImpl = surface.getImpl<detail::Surface_Impl>();
+      if (istringEqual(surfaceImpl->outsideBoundaryConditionView(), "Outdoors"))
       {
-        if (istringEqual(surface.surfaceType(), "Wall"))
+        if (istringEqual(surfaceImpl->surfaceTypeView(), "Wall"))
         {
           result += surface.grossArea();
         }
@@ -961,12 +965,13 @@ namespace detail {
     double floorHeight = 0;
     int numFloor = 0;
     for (const Surface& surface : this->surfaces()) {
-      if (istringEqual(surface.surfaceType(), "Floor")){
+      std::string_view surfaceType = surface.getImpl<detail::Surface_Impl>()->surfaceTypeView();
+      if (istringEqual(surfaceType, "Floor")){
         for (const Point3d& point : surface.vertices()) {
           floorHeight += point.z();
           ++numFloor;
         }
-      }else if (istringEqual(surface.surfaceType(), "RoofCeiling")){
+      }else if (istringEqual(surfaceType, "RoofCeiling")){
         for (const Point3d& point : surface.vertices()) {
           roofHeight += point.z();
           ++numRoof;
@@ -327,6 +327,12 @@ namespace detail {
     return value.get();
   }
 
+  std::string_view Surface_Impl::surfaceTypeView() const {
+    boost::optional<std::string_view> value = getStringView(OS_SurfaceFields::SurfaceType,true,true);
+    OS_ASSERT(value);
+    return value.get();
+  }
+
   std::vector<std::string> Surface_Impl::surfaceTypeValues() const
   {
     return Surface::validSurfaceTypeValues();
@@ -338,6 +344,12 @@ namespace detail {
     return value.get();
   }
 
+  std::string_view Surface_Impl::outsideBoundaryConditionView() const {
+    boost::optional<std::string_view> value = getStringView(OS_SurfaceFields::OutsideBoundaryCondition,true);
+    OS_ASSERT(value);
+    return value.get();
+  }
+
   std::vector<std::string> Surface_Impl::outsideBoundaryConditionValues() const
   {
     return Surface::validOutsideBoundaryConditionValues();
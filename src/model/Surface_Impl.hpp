@@ -127,6 +127,12 @@ namespace detail {
 
     std::vector<std::string> outsideBoundaryConditionValues() const;
 
+    /** Views of surfaceType() and outsideBoundaryCondition() for comparisons that should not
+     *  copy, valid until this surface is next changed (see IdfObject::getStringView). */
+    std::string_view surfaceTypeView() const;
+
+    std::string_view outsideBoundaryConditionView() const;
+
     bool isGroundSurface() const;
 
     std::string sunExposure() const;
@@ -74,6 +74,14 @@
 #include "../FanConstantVolume_Impl.hpp"
 #include "../AirLoopHVAC.hpp"
 #include "../AirLoopHVAC_Impl.hpp"
+#include "../PlantLoop.hpp"
+#include "../PlantLoop_Impl.hpp"
+#include "../BoilerHotWater.hpp"
+#include "../BoilerHotWater_Impl.hpp"
+#include "../CoilCoolingDXTwoStageWithHumidityControlMode.hpp"
+#include "../CoilCoolingDXTwoStageWithHumidityControlMode_Impl.hpp"
+#include "../CoilPerformanceDXCooling.hpp"
+#include "../CoilPerformanceDXCooling_Impl.hpp"
 
 #include "../../utilities/sql/SqlFile.hpp"
 #include "../../utilities/data/TimeSeries.hpp"
@@ -81,11 +89,22 @@
 #include "../../utilities/idf/Workspace.hpp"
 #include "../../utilities/idf/WorkspaceObject.hpp"
 #include "../../utilities/idf/ValidityReport.hpp"
+#include "../../utilities/core/Filesystem.hpp"
+#include "../../utilities/filetypes/EpwFile.hpp"
+#include "../../utilities/time/Calendar.hpp"
+#include "../../utilities/time/DateTime.hpp"
 
 #include <utilities/idd/IddEnums.hxx>
 
+#include <resources.hxx>
+
 #include <boost/algorithm/string/case_conv.hpp>
 
+#include <chrono>
+#include <map>
+#include <iterator>
+#include <sstream>
+
 using namespace openstudio::model;
 using namespace openstudio;
 /*
@@ -528,6 +547,246 @@ TEST_F(ExampleModelFixture, ExampleModel_ReloadTwoTimes)
 }
 
 
+TEST_F(ExampleModelFixture, ExampleModel_BinarySnapshot)
+{
+  Model model = exampleModel();
+
+  openstudio::path osmPath = toPath("./ExampleModel_BinarySnapshot.osm");
+  openstudio::path snapshotPath = toPath("./ExampleModel_BinarySnapshot.osmb");
+  addPathToCleanUp(osmPath);
+  addPathToCleanUp(snapshotPath);
+
+  EXPECT_TRUE(model.save(osmPath, true));
+  EXPECT_TRUE(model.saveBinary(snapshotPath, true));
+  EXPECT_FALSE(model.saveBinary(snapshotPath, false));
+
+  // text is not a snapshot
+  EXPECT_FALSE(Model::loadBinary(osmPath));
+
+  boost::optional<Model> loaded = Model::loadBinary(snapshotPath);
+  ASSERT_TRUE(loaded);
+  ASSERT_EQ(model.numObjects(), loaded->numObjects());
+
+  // same text as the original model, and as the reloaded osm
+  std::stringstream expected, actual, reloaded;
+  model.toIdfFile().print(expected);
+  loaded->toIdfFile().print(actual);
+  EXPECT_EQ(expected.str(), actual.str());
+  boost::optional<Model> osm = Model::load(osmPath);
+  ASSERT_TRUE(osm);
+  osm->toIdfFile().print(reloaded);
+  EXPECT_EQ(reloaded.str(), actual.str());
+
+  // pointers are restored
+  std::vector<WorkspaceObject> objects = model.objects();
+  for (const WorkspaceObject& object : objects) {
+    boost::optional<WorkspaceObject> other = loaded->getObject(object.handle());
+    ASSERT_TRUE(other);
+    for (unsigned index : object.objectListFields()) {
+      boost::optional<WorkspaceObject> target = object.getTarget(index);
+      boost::optional<WorkspaceObject> otherTarget = other->getTarget(index);
+      ASSERT_EQ(static_cast<bool>(target), static_cast<bool>(otherTarget));
+      if (target) {
+        EXPECT_EQ(target->handle(), otherTarget->handle());
+      }
+    }
+  }
+  ThermalZoneVector zones = loaded->getConcreteModelObjects<ThermalZone>();
+  ASSERT_FALSE(zones.empty());
+  EXPECT_FALSE(zones[0].spaces().empty());
+  ASSERT_TRUE(loaded->building());
+  EXPECT_DOUBLE_EQ(model.building()->floorArea(), loaded->building()->floorArea());
+
+  // the loaded model is a regular model
+  Space space(*loaded);
+  EXPECT_TRUE(space.setThermalZone(zones[0]));
+
+  // damaged snapshots are rejected
+  std::string bytes;
+  {
+    openstudio::filesystem::ifstream inFile(snapshotPath, std::ios_base::binary);
+    bytes.assign(std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>());
+  }
+  {
+    openstudio::filesystem::ofstream outFile(snapshotPath, std::ios_base::binary);
+    outFile.write(bytes.data(), bytes.size() / 2);
+  }
+  EXPECT_FALSE(Model::loadBinary(snapshotPath));
+}
+
+// timing only, run with --gtest_also_run_disabled_tests
+TEST_F(ExampleModelFixture, DISABLED_ExampleModel_BinarySnapshot_Benchmark)
+{
+  Model model = exampleModel();
+
+  openstudio::path osmPath = toPath("./ExampleModel_BinarySnapshot_Benchmark.osm");
+  openstudio::path snapshotPath = toPath("./ExampleModel_BinarySnapshot_Benchmark.osmb");
+  addPathToCleanUp(osmPath);
+  addPathToCleanUp(snapshotPath);
+
+  EXPECT_TRUE(model.save(osmPath, true));
+  EXPECT_TRUE(model.saveBinary(snapshotPath, true));
+
+  unsigned reps = 5;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < reps; ++i) {
+    EXPECT_TRUE(Model::load(osmPath));
+  }
+  auto middle = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < reps; ++i) {
+    EXPECT_TRUE(Model::loadBinary(snapshotPath));
+  }
+  auto end = std::chrono::steady_clock::now();
+  LOG_FREE(Info, "ExampleModel_BinarySnapshot_Benchmark", reps << " loads of " << model.numObjects() << " objects took "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(middle - start).count() << " ms with load and "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(end - middle).count() << " ms with loadBinary.");
+}
+
+namespace {
+
+  // model with numBoilers boilers on a plant loop and a two stage coil, named as in writeComponentSizingSql
+  Model applySizingValuesModel(unsigned numBoilers)
+  {
+    Model model;
+    PlantLoop plantLoop(model);
+    for (unsigned i = 0; i < numBoilers; ++i) {
+      BoilerHotWater boiler(model);
+      EXPECT_TRUE(boiler.setName("Boiler " + std::to_string(i)));
+      EXPECT_TRUE(plantLoop.addSupplyBranchForComponent(boiler));
+    }
+    CoilCoolingDXTwoStageWithHumidityControlMode coil(model);
+    EXPECT_TRUE(coil.setName("Two Stage Coil"));
+    boost::optional<CoilPerformanceDXCooling> coilPerformance = coil.normalModeStage1CoilPerformance();
+    EXPECT_TRUE(coilPerformance);
+    if (coilPerformance) {
+      EXPECT_TRUE(coilPerformance->setName("Stage 1 Performance"));
+    }
+    return model;
+  }
+
+  // write the Component Sizing Information table of a simulation sizing the objects of applySizingValuesModel,
+  // laid out as EnergyPlus writes it: rows are named by number, units are part of the description and cells
+  // are written column by column
+  void writeComponentSizingSql(const openstudio::path& sqlPath, unsigned numBoilers)
+  {
+    if (openstudio::filesystem::exists(sqlPath)) {
+      openstudio::filesystem::remove(sqlPath);
+    }
+    SqlFile sqlFile(sqlPath, EpwFile(resourcesPath() / toPath("utilities/Filetypes/USA_CO_Golden-NREL.724666_TMY3.epw")), DateTime::now(), Calendar(2012));
+    ASSERT_TRUE(sqlFile.connectionOpen());
+    EXPECT_EQ(101, sqlFile.execute("BEGIN TRANSACTION"));
+
+    enum StringType { ReportName = 1, ReportForString, TableName, RowName, ColumnName, Units };
+    std::vector<std::string> stringTypes{"ReportName", "ReportForString", "TableName", "RowName", "ColumnName", "Units"};
+    for (unsigned i = 0; i < stringTypes.size(); ++i) {
+      EXPECT_EQ(101, sqlFile.execute("INSERT INTO StringTypes (StringTypeIndex, Value) VALUES (" + std::to_string(i + 1) + ", '" + stringTypes[i] + "')"));
+    }
+
+    // strings are unique by type and value
+    std::map<std::pair<int, std::string>, int> stringIndices;
+    auto stringIndex = [&](int stringType, const std::string& value) {
+      auto it = stringIndices.find(std::make_pair(stringType, value));
+      if (it == stringIndices.end()) {
+        int index = stringIndices.size() + 1;
+        EXPECT_EQ(101, sqlFile.execute("INSERT INTO Strings (StringIndex, StringTypeIndex, Value) VALUES (" + std::to_string(index) + ", "
+                                       + std::to_string(stringType) + ", '" + value + "')"));
+        it = stringIndices.emplace(std::make_pair(stringType, value), index).first;
+      }
+      return it->second;
+    };
+
+    std::vector<std::string> columns{"Component Type", "Component Name", "Input Field Description", "Value"};
+    std::vector<std::vector<std::string>> rows;
+    for (unsigned i = 0; i < numBoilers; ++i) {
+      std::string name = "BOILER " + std::to_string(i);
+      rows.push_back({"Boiler:HotWater", name, "Design Size Nominal Capacity [W]", std::to_string(1000 + i)});
+      rows.push_back({"Boiler:HotWater", name, "Design Size Design Water Flow Rate [m3/s]", std::to_string(0.001 * (i + 1))});
+    }
+    rows.push_back({"CoilPerformance:DX:Cooling", "TWO STAGE COIL:STAGE 1 PERFORMANCE", "Design Size Gross Rated Total Cooling Capacity [W]", "5000"});
+
+    std::string tableIndices = std::to_string(stringIndex(ReportName, "Initialization Summary")) + ", "
+                               + std::to_string(stringIndex(ReportForString, "Entire Facility")) + ", "
+                               + std::to_string(stringIndex(TableName, "Component Sizing Information"));
+    int unitsIndex = stringIndex(Units, "");
+    int tabularDataIndex = 0;
+    for (unsigned column = 0; column < columns.size(); ++column) {
+      int columnNameIndex = stringIndex(ColumnName, columns[column]);
+      for (unsigned row = 0; row < rows.size(); ++row) {
+        int rowNameIndex = stringIndex(RowName, std::to_string(row + 1));
+        EXPECT_EQ(101, sqlFile.execute("INSERT INTO TabularData (TabularDataIndex, ReportNameIndex, ReportForStringIndex, TableNameIndex, RowNameIndex, "
+                                       "ColumnNameIndex, UnitsIndex, SimulationIndex, RowId, ColumnId, Value) VALUES ("
+                                       + std::to_string(++tabularDataIndex) + ", " + tableIndices + ", " + std::to_string(rowNameIndex) + ", "
+                                       + std::to_string(columnNameIndex) + ", " + std::to_string(unitsIndex) + ", 1, " + std::to_string(row) + ", "
+                                       + std::to_string(column) + ", '" + rows[row][column] + "')"));
+      }
+    }
+    EXPECT_EQ(101, sqlFile.execute("COMMIT"));
+  }
+
+}
+
+TEST_F(ModelFixture, ApplySizingValues)
+{
+  const unsigned numBoilers = 10;
+  Model model = applySizingValuesModel(numBoilers);
+  boost::optional<CoilPerformanceDXCooling> coilPerformance = model.getConcreteModelObjectByName<CoilPerformanceDXCooling>("Stage 1 Performance");
+  ASSERT_TRUE(coilPerformance);
+
+  openstudio::path sqlPath = openstudio::tempDir() / toPath("ApplySizingValues.sql");
+  writeComponentSizingSql(sqlPath, numBoilers);
+
+  SqlFile sqlFile(sqlPath);
+  ASSERT_TRUE(sqlFile.connectionOpen());
+  EXPECT_TRUE(model.setSqlFile(sqlFile));
+
+  boost::optional<BoilerHotWater> boiler = model.getConcreteModelObjectByName<BoilerHotWater>("Boiler 7");
+  ASSERT_TRUE(boiler);
+  ASSERT_TRUE(boiler->autosizedNominalCapacity());
+  EXPECT_DOUBLE_EQ(1007.0, boiler->autosizedNominalCapacity().get());
+  ASSERT_TRUE(coilPerformance->autosizedGrossRatedTotalCoolingCapacity());
+  EXPECT_DOUBLE_EQ(5000.0, coilPerformance->autosizedGrossRatedTotalCoolingCapacity().get());
+  EXPECT_FALSE(coilPerformance->autosizedRatedAirFlowRate());
+
+  model.applySizingValues();
+
+  for (const BoilerHotWater& b : model.getConcreteModelObjects<BoilerHotWater>()) {
+    ASSERT_TRUE(b.nominalCapacity());
+    EXPECT_FALSE(b.isNominalCapacityAutosized());
+    EXPECT_FALSE(b.isDesignWaterFlowRateAutosized());
+  }
+  ASSERT_TRUE(boiler->nominalCapacity());
+  EXPECT_DOUBLE_EQ(1007.0, boiler->nominalCapacity().get());
+
+  sqlFile.close();
+  EXPECT_TRUE(model.resetSqlFile());
+  openstudio::filesystem::remove(sqlPath);
+}
+
+// timing only, run with --gtest_also_run_disabled_tests
+TEST_F(ModelFixture, DISABLED_ApplySizingValues_Benchmark)
+{
+  const unsigned numBoilers = 400;
+  Model model = applySizingValuesModel(numBoilers);
+
+  openstudio::path sqlPath = openstudio::tempDir() / toPath("ApplySizingValues_Benchmark.sql");
+  writeComponentSizingSql(sqlPath, numBoilers);
+
+  SqlFile sqlFile(sqlPath);
+  ASSERT_TRUE(sqlFile.connectionOpen());
+  EXPECT_TRUE(model.setSqlFile(sqlFile));
+
+  auto start = std::chrono::steady_clock::now();
+  model.applySizingValues();
+  auto end = std::chrono::steady_clock::now();
+
+  LOG_FREE(Info, "ApplySizingValues_Benchmark", "applySizingValues on " << model.numObjects() << " objects took "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms.");
+
+  sqlFile.close();
+  EXPECT_TRUE(model.resetSqlFile());
+  openstudio::filesystem::remove(sqlPath);
+}
+
 TEST_F(ModelFixture, Model_building) {
   Model model;
 
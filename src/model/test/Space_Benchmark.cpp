@@ -0,0 +1,150 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2020, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+// These benchmarks replace global operator new and delete to count allocations, so they are built into their own
+// executable rather than the model test binary.
+
+#include <gtest/gtest.h>
+
+#include "ModelFixture.hpp"
+
+#include "../Space.hpp"
+#include "../Space_Impl.hpp"
+#include "../Surface.hpp"
+#include "../Surface_Impl.hpp"
+
+#include "../../utilities/core/Compare.hpp"
+#include "../../utilities/geometry/Point3d.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+using namespace openstudio;
+using namespace openstudio::model;
+
+namespace {
+
+  // counts global operator new calls while enabled
+  std::atomic<bool> countAllocations(false);
+  std::atomic<std::size_t> allocationCount(0);
+
+  template<typename F>
+  std::size_t allocationsIn(F f) {
+    allocationCount = 0;
+    countAllocations = true;
+    f();
+    countAllocations = false;
+    return allocationCount;
+  }
+
+  // n spaces made from the same 10 m by 10 m floor print
+  std::vector<Space> floorPrintSpaces(Model& model, unsigned n) {
+    std::vector<Point3d> floorPrint;
+    floorPrint.push_back(Point3d(0, 10, 0));
+    floorPrint.push_back(Point3d(10, 10, 0));
+    floorPrint.push_back(Point3d(10, 0, 0));
+    floorPrint.push_back(Point3d(0, 0, 0));
+
+    std::vector<Space> result;
+    for (unsigned i = 0; i < n; ++i) {
+      boost::optional<Space> space = Space::fromFloorPrint(floorPrint, 3, model);
+      EXPECT_TRUE(space);
+      if (space) {
+        result.push_back(*space);
+      }
+    }
+    return result;
+  }
+
+}
+
+void* operator new(std::size_t size) {
+  if (countAllocations) {
+    ++allocationCount;
+  }
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+// timing only, run with --gtest_also_run_disabled_tests
+TEST_F(ModelFixture, DISABLED_Space_FloorArea_Benchmark) {
+  Model model;
+  unsigned n = 1000;
+  std::vector<Space> spaces = floorPrintSpaces(model, n);
+  ASSERT_EQ(n, spaces.size());
+
+  // floorArea visits the surfaces in place and compares surface types through views, the copying loop is what
+  // it replaced: build the SurfaceVector and copy each surface type out. The first pass fills caches the surface
+  // getters keep, so it is not counted
+  for (const Space& space : spaces) {
+    space.floorArea();
+  }
+  double viewArea = 0.0;
+  std::size_t viewAllocations = allocationsIn([&]() {
+    for (const Space& space : spaces) {
+      viewArea += space.floorArea();
+    }
+  });
+  double copyArea = 0.0;
+  std::size_t copyAllocations = allocationsIn([&]() {
+    for (const Space& space : spaces) {
+      for (const Surface& surface : space.surfaces()) {
+        if (istringEqual(surface.surfaceType(), "Floor") && !surface.isAirWall()) {
+          copyArea += surface.grossArea();
+        }
+      }
+    }
+  });
+  EXPECT_NEAR(copyArea, viewArea, 0.01);
+  EXPECT_LT(viewAllocations, copyAllocations);
+
+  unsigned reps = 20;
+  double area = 0.0;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned rep = 0; rep < reps; ++rep) {
+    area = 0.0;
+    for (const Space& space : spaces) {
+      area += space.floorArea();
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  LOG_FREE(Info, "Space_FloorArea_Benchmark", "floorArea over " << n << " spaces made " << viewAllocations
+           << " allocations, the copying loop made " << copyAllocations << ". " << reps << " passes of floorArea took "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms, total area "
+           << area << " m2.");
+}
@@ -72,6 +72,8 @@
 #include "../../utilities/idf/WorkspaceObjectWatcher.hpp"
 #include "../../utilities/core/Compare.hpp"
 
+#include <utilities/idd/OS_Surface_FieldEnums.hxx>
+
 #include <iostream>
 
 using namespace openstudio;
@@ -2042,3 +2044,53 @@ TEST_F(ModelFixture, Space_intersectSurfaces_degenerate3) {
 
   //m.save("intersect3.osm", true);
 }
+
+namespace {
+
+  // n spaces made from the same 10 m by 10 m floor print
+  std::vector<Space> floorPrintSpaces(Model& model, unsigned n) {
+    std::vector<Point3d> floorPrint;
+    floorPrint.push_back(Point3d(0, 10, 0));
+    floorPrint.push_back(Point3d(10, 10, 0));
+    floorPrint.push_back(Point3d(10, 0, 0));
+    floorPrint.push_back(Point3d(0, 0, 0));
+
+    std::vector<Space> result;
+    for (unsigned i = 0; i < n; ++i) {
+      boost::optional<Space> space = Space::fromFloorPrint(floorPrint, 3, model);
+      EXPECT_TRUE(space);
+      if (space) {
+        result.push_back(*space);
+      }
+    }
+    return result;
+  }
+
+}
+
+TEST_F(ModelFixture, Space_StringViews) {
+  Model model;
+  unsigned n = 10;
+  std::vector<Space> spaces = floorPrintSpaces(model, n);
+  ASSERT_EQ(n, spaces.size());
+  std::vector<Surface> surfaces = model.getConcreteModelObjects<Surface>();
+  ASSERT_EQ(6 * n, surfaces.size());
+
+  // views agree with the copying getters, pointer fields view the target's name
+  for (const Surface& surface : surfaces) {
+    std::shared_ptr<openstudio::model::detail::Surface_Impl> impl = surface.getImpl<openstudio::model::detail::Surface_Impl>();
+    EXPECT_EQ(surface.surfaceType(), std::string(impl->surfaceTypeView()));
+    EXPECT_EQ(surface.outsideBoundaryCondition(), std::string(impl->outsideBoundaryConditionView()));
+    EXPECT_EQ(surface.nameString(), std::string(surface.nameStringView()));
+    ASSERT_TRUE(surface.getStringView(OS_SurfaceFields::SpaceName));
+    EXPECT_EQ(surface.space()->nameString(), std::string(*surface.getStringView(OS_SurfaceFields::SpaceName)));
+  }
+
+  // the area getters compare surface types through views
+  for (const Space& space : spaces) {
+    EXPECT_NEAR(100.0, space.floorArea(), 0.01);
+    EXPECT_NEAR(120.0, space.exteriorWallArea(), 0.01);
+    EXPECT_NEAR(220.0, space.exteriorArea(), 0.01);
+    EXPECT_NEAR(300.0, space.volume(), 0.01);
+  }
+}
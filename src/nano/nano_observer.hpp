@@ -97,6 +97,13 @@ class Observer
         removeAll();
     }
 
+    // Disconnect from every Signal in one pass, an Observer connected to many Signals
+    // can call this before they are destroyed rather than have each of them search this list
+    void disconnectAll()
+    {
+        removeAll();
+    }
+
     //--------------------------------------------------------------------PUBLIC
 
     public:
@@ -666,20 +666,20 @@ std::string VersionTranslator::defaultUpdate(const IdfFile& idf,
                                              const IddFileAndFactoryWrapper& targetIdd)
 {
   // use for version increments with no IDD changes
-  std::stringstream ss;
-
-  ss << idf.header() << std::endl << std::endl;
+  std::string result;
+  result += idf.header();
+  result += "\n\n";
 
   // new version object
   IdfFile targetIdf(targetIdd.iddFile());
-  ss << targetIdf.versionObject().get();
+  targetIdf.versionObject().get().print(result);
 
   // all other objects
   for (const IdfObject& object : idf.objects()) {
-    ss << object;
+    object.print(result);
   }
 
-  return ss.str();
+  return result;
 }
 
 std::string VersionTranslator::update_0_7_1_to_0_7_2(const IdfFile& idf_0_7_1, const IddFileAndFactoryWrapper& idd_0_7_2) {
@@ -36,6 +36,7 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
 
 #include <boost/optional.hpp>
 #include <boost/algorithm/string.hpp>
@@ -67,8 +68,13 @@ struct UTILITIES_API IcharCompare{
   };
 };
 
-/** Test equality between two strings without regard to case. */
+/** Test equality between two strings without regard to case. Takes views in C++ so that
+ *  IdfObject::getStringView results can be compared without copying. */
+#if defined(SWIG)
 inline UTILITIES_API bool istringEqual(const std::string& x, const std::string& y){
+#else
+inline UTILITIES_API bool istringEqual(std::string_view x, std::string_view y){
+#endif
   return x.size() == y.size() &&
          std::equal(x.begin(), x.end(), y.begin(), IcharCompare());
 };
@@ -32,6 +32,8 @@
 #include "Path.hpp"
 #include "Assert.hpp"
 
+#include <boost/iostreams/device/mapped_file.hpp>
+
 namespace openstudio {
   namespace filesystem {
     std::vector<char> read(openstudio::filesystem::ifstream &t_file)
@@ -255,5 +257,55 @@ namespace openstudio {
       LOG_FREE(Warn, "FilesystemHelpers", "home_path No Home Found");
       return toPath("/");
     }
+
+    mapped_file_prefix::mapped_file_prefix(const openstudio::path &t_path, std::size_t t_max_length)
+      : m_open(false), m_complete(false)
+    {
+      boost::system::error_code ec;
+      const auto file_len = openstudio::filesystem::file_size(t_path, ec);
+      if (ec) {
+        return;
+      }
+
+      std::size_t length = static_cast<std::size_t>(file_len);
+      if ((t_max_length > 0) && (t_max_length < length)) {
+        length = t_max_length;
+      }
+      m_complete = (length == file_len);
+
+      if (length == 0) {
+        // nothing to map
+        m_open = true;
+        return;
+      }
+
+      try {
+        m_file.reset(new boost::iostreams::mapped_file_source(t_path, length));
+        m_open = m_file->is_open();
+      } catch (const std::exception &e) {
+        LOG_FREE(Debug, "FilesystemHelpers", "Unable to map '" << openstudio::toString(t_path) << "': " << e.what());
+        m_file.reset();
+      }
+    }
+
+    mapped_file_prefix::~mapped_file_prefix() = default;
+
+    bool mapped_file_prefix::is_open() const
+    {
+      return m_open;
+    }
+
+    std::string_view mapped_file_prefix::data() const
+    {
+      if (m_file && m_file->is_open()) {
+        return std::string_view(m_file->data(), m_file->size());
+      }
+      return std::string_view();
+    }
+
+    bool mapped_file_prefix::complete() const
+    {
+      return m_complete;
+    }
   }
 }
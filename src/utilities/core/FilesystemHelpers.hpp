@@ -32,6 +32,15 @@
 
 #include "Filesystem.hpp"
 
+#include <memory>
+#include <string_view>
+
+namespace boost {
+  namespace iostreams {
+    class mapped_file_source;
+  }
+}
+
 namespace openstudio {
   namespace filesystem {
     /// reads entire file from the current read position until the end of file
@@ -77,6 +86,34 @@ namespace openstudio {
     /// Returns the current user's home path
     UTILITIES_API openstudio::path home_path();
 
+    /// Read-only memory mapping of the start of a file, for quickly sniffing headers without
+    /// going through a stream
+    class UTILITIES_API mapped_file_prefix
+    {
+      public:
+        /// maps at most t_max_length bytes from the start of t_path, or the whole file if
+        /// t_max_length is 0
+        explicit mapped_file_prefix(const openstudio::path &t_path, std::size_t t_max_length = 0);
+        ~mapped_file_prefix();
+
+        mapped_file_prefix(const mapped_file_prefix &) = delete;
+        mapped_file_prefix &operator=(const mapped_file_prefix &) = delete;
+
+        /// true if the file could be opened and mapped (empty files map to empty data)
+        bool is_open() const;
+
+        /// the mapped bytes, valid for the lifetime of this object
+        std::string_view data() const;
+
+        /// true if data() holds the whole file
+        bool complete() const;
+
+      private:
+        std::unique_ptr<boost::iostreams::mapped_file_source> m_file;
+        bool m_open;
+        bool m_complete;
+    };
+
   }
 }
 
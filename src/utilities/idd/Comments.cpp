@@ -121,6 +121,14 @@ std::string makeComment(const std::string& str) {
 }
 
 std::string makeIdfEditorComment(const std::string& str) {
+  // a single line that is not indented and has no comment marks, e.g. an IddField name,
+  // just gets the prefix
+  if (!str.empty() && (str[0] != ' ') && (str[0] != '\t') &&
+      (str.find_first_of("!\n\r\v\f") == std::string::npos))
+  {
+    return "!- " + str;
+  }
+
   // make sure each line starts with !-
   boost::smatch m;
   if (boost::regex_match(str,m,commentRegex::editorCommentWhitespaceOnlyBlock())) {
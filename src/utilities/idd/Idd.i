@@ -58,6 +58,13 @@
 // ignore ostream related functions
 %ignore print(std::ostream&, bool) const;
 
+// ignore loading from tables written by GenerateIddFactory
+%ignore openstudio::IddField::load(const IddFieldTable&, const std::string&);
+%ignore openstudio::IddObject::load(const IddObjectTable&, IddObjectType);
+
+// ignore the compiled validation programs used by IdfObject
+%ignore openstudio::IddObject::validation;
+
 // include the headers into the swig interface directly
 %include <utilities/idd/IddEnums.hpp>
 
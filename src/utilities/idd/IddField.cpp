@@ -30,6 +30,8 @@
 #include "IddField.hpp"
 #include "IddField_Impl.hpp"
 
+#include "IddKeyProperties.hpp"
+#include "IddObjectTable.hpp"
 #include "IddRegex.hpp"
 #include "CommentRegex.hpp"
 #include <utilities/idd/IddFactory.hxx>
@@ -46,6 +48,10 @@
 
 
 #include <boost/lexical_cast.hpp>
+#include <boost/functional/hash.hpp>
+
+#include <mutex>
+#include <unordered_map>
 
 
 using boost::algorithm::trim;
@@ -54,14 +60,147 @@ namespace openstudio {
 
 namespace detail {
 
+  namespace {
+
+    /** Pool of immutable values shared by all IddFields with identical data. Most fields of the
+     *  EnergyPlus and OpenStudio IDDs differ from some other field only by name, so sharing the
+     *  data cuts the memory held by the IddFactory substantially. Only weak references are kept,
+     *  so values are released along with the last field that uses them. */
+    template <typename T>
+    class InternPool {
+     public:
+      typedef std::size_t (*HashFunction)(const T&);
+      typedef bool (*EqualFunction)(const T&, const T&);
+
+      InternPool(HashFunction hash, EqualFunction equal)
+        : m_hash(hash), m_equal(equal)
+      {}
+
+      std::shared_ptr<const T> intern(T&& value) {
+        std::size_t hash = m_hash(value);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto range = m_values.equal_range(hash);
+        for (auto it = range.first; it != range.second; ) {
+          if (std::shared_ptr<const T> existing = it->second.lock()) {
+            if (m_equal(*existing, value)) {
+              return existing;
+            }
+            ++it;
+          }
+          else {
+            it = m_values.erase(it);
+          }
+        }
+        // not constructed with make_shared, so that the value is freed as soon as it expires
+        std::shared_ptr<const T> result(new T(std::move(value)));
+        m_values.emplace(hash, result);
+        return result;
+      }
+
+     private:
+      HashFunction m_hash;
+      EqualFunction m_equal;
+      std::mutex m_mutex;
+      std::unordered_multimap<std::size_t, std::weak_ptr<const T> > m_values;
+    };
+
+    void hashCombine(std::size_t& seed, const boost::optional<std::string>& value) {
+      boost::hash_combine(seed, value.is_initialized());
+      if (value) {
+        boost::hash_combine(seed, *value);
+      }
+    }
+
+    void hashCombine(std::size_t& seed, const boost::optional<double>& value) {
+      boost::hash_combine(seed, value.is_initialized());
+      if (value) {
+        boost::hash_combine(seed, *value);
+      }
+    }
+
+    std::size_t hashObjectName(const std::string& name) {
+      return boost::hash_value(name);
+    }
+
+    bool equalObjectNames(const std::string& name, const std::string& other) {
+      return (name == other);
+    }
+
+    std::size_t hashProperties(const IddFieldProperties& properties) {
+      std::size_t seed = 0;
+      boost::hash_combine(seed, properties.type.value());
+      boost::hash_combine(seed, properties.note);
+      boost::hash_combine(seed, properties.required);
+      boost::hash_combine(seed, properties.autosizable);
+      boost::hash_combine(seed, properties.autocalculatable);
+      boost::hash_combine(seed, properties.retaincase);
+      boost::hash_combine(seed, properties.deprecated);
+      boost::hash_combine(seed, properties.beginExtensible);
+      hashCombine(seed, properties.units);
+      hashCombine(seed, properties.ipUnits);
+      boost::hash_combine(seed, static_cast<int>(properties.minBoundType));
+      hashCombine(seed, properties.minBoundText);
+      boost::hash_combine(seed, static_cast<int>(properties.maxBoundType));
+      hashCombine(seed, properties.maxBoundText);
+      hashCombine(seed, properties.stringDefault);
+      hashCombine(seed, properties.numericDefault);
+      boost::hash_combine(seed, properties.objectLists);
+      boost::hash_combine(seed, properties.references);
+      boost::hash_combine(seed, properties.referenceClassNames);
+      boost::hash_combine(seed, properties.externalLists);
+      return seed;
+    }
+
+    // IddFieldProperties::operator== does not look at every member that is printed
+    bool equalProperties(const IddFieldProperties& properties, const IddFieldProperties& other) {
+      return ((properties == other) &&
+              (properties.beginExtensible == other.beginExtensible) &&
+              (properties.minBoundText == other.minBoundText) &&
+              (properties.maxBoundText == other.maxBoundText) &&
+              (properties.numericDefault == other.numericDefault));
+    }
+
+    std::size_t hashKeys(const IddKeyVector& keys) {
+      std::size_t seed = 0;
+      for (const IddKey& key : keys) {
+        boost::hash_combine(seed, key.name());
+        boost::hash_combine(seed, key.properties().note);
+      }
+      return seed;
+    }
+
+    bool equalKeys(const IddKeyVector& keys, const IddKeyVector& other) {
+      return (keys == other);
+    }
+
+    std::shared_ptr<const std::string> internObjectName(std::string objectName) {
+      static InternPool<std::string> pool(hashObjectName, equalObjectNames);
+      return pool.intern(std::move(objectName));
+    }
+
+    std::shared_ptr<const IddFieldProperties> internProperties(IddFieldProperties&& properties) {
+      static InternPool<IddFieldProperties> pool(hashProperties, equalProperties);
+      return pool.intern(std::move(properties));
+    }
+
+    std::shared_ptr<const IddKeyVector> internKeys(IddKeyVector&& keys) {
+      static InternPool<IddKeyVector> pool(hashKeys, equalKeys);
+      return pool.intern(std::move(keys));
+    }
+
+  } // anonymous namespace
+
   // CONSTRUCTORS
 
   /// default constructor for serialization
   IddField_Impl::IddField_Impl()
+    : m_objectName(internObjectName(std::string())),
+      m_properties(internProperties(IddFieldProperties())),
+      m_keys(internKeys(IddKeyVector()))
   {}
 
   IddField_Impl::IddField_Impl(const std::string& name, const std::string& objectName)
-    : m_name(name), m_objectName(objectName)
+    : m_name(name), m_objectName(internObjectName(objectName))
   {}
 
   // GETTERS
@@ -77,7 +216,7 @@ namespace detail {
 
   const IddFieldProperties& IddField_Impl::properties() const
   {
-    return m_properties;
+    return *m_properties;
   }
 
   boost::optional<Unit> IddField_Impl::getUnits(bool returnIP) const {
@@ -162,7 +301,7 @@ namespace detail {
   OptionalIddKey IddField_Impl::getKey(const std::string& keyName) const
   {
     OptionalIddKey result;
-    for (const IddKey& key : m_keys){
+    for (const IddKey& key : *m_keys){
       if (boost::iequals(key.name(),keyName)){
         result = key;
         break;
@@ -173,7 +312,7 @@ namespace detail {
 
   IddKeyVector IddField_Impl::keys() const
   {
-    return m_keys;
+    return *m_keys;
   }
 
   // SETTERS
@@ -224,13 +363,13 @@ namespace detail {
     if (m_fieldId != other.m_fieldId) {
       return false;
     }
-    if (m_objectName != other.m_objectName) {
+    if ((m_objectName != other.m_objectName) && (*m_objectName != *other.m_objectName)) {
       return false;
     }
-    if (m_properties != other.m_properties) {
+    if ((m_properties != other.m_properties) && (*m_properties != *other.m_properties)) {
       return false;
     }
-    if (m_keys != other.m_keys) {
+    if ((m_keys != other.m_keys) && (*m_keys != *other.m_keys)) {
       return false;
     }
 
@@ -250,13 +389,50 @@ namespace detail {
     std::shared_ptr<IddField_Impl> result;
     IddField_Impl iddFieldImpl(name,objectName);
 
-    try { iddFieldImpl.parse(text); }
+    try {
+      IddFieldProperties properties;
+      IddKeyVector keys;
+      iddFieldImpl.parse(text,properties,keys);
+      iddFieldImpl.setProperties(std::move(properties),std::move(keys));
+    }
     catch (...) { return result; }
 
     result = std::shared_ptr<IddField_Impl>(new IddField_Impl(iddFieldImpl));
     return result;
   }
 
+  std::shared_ptr<IddField_Impl> IddField_Impl::load(const IddFieldTable& table,
+                                                       const std::string& objectName) {
+
+    std::shared_ptr<IddField_Impl> result(new IddField_Impl(table.name,objectName));
+    result->m_fieldId = table.fieldId;
+
+    try {
+      IddFieldProperties properties;
+      IddKeyVector keys;
+
+      // check for base content type
+      if ((result->m_fieldId[0] == 'A') || (result->m_fieldId[0] == 'a')){
+        properties.type = IddFieldType(IddFieldType::AlphaType);
+      }else if ((result->m_fieldId[0] == 'N') || (result->m_fieldId[0] == 'n')){
+        // default numerics to real, can be overwritten later
+        properties.type = IddFieldType(IddFieldType::RealType);
+      }else{
+        LOG_AND_THROW("Unknown field type identifier found: '" << result->m_fieldId << "'");
+      }
+
+      for (unsigned i = 0; i < table.numProperties; ++i){
+        result->parseProperty(table.properties[i],properties,keys);
+      }
+
+      result->checkProperties(properties,keys);
+      result->setProperties(std::move(properties),std::move(keys));
+    }
+    catch (...) { return std::shared_ptr<IddField_Impl>(); }
+
+    return result;
+  }
+
   std::ostream& IddField_Impl::print(std::ostream& os, bool lastField) const
   {
     std::string separator = (lastField ? std::string(";") : std::string(","));
@@ -269,16 +445,16 @@ namespace detail {
 
     os << std::endl;
 
-    m_properties.print(os);
+    m_properties->print(os);
 
-    for (const auto & key : m_keys){
+    for (const auto & key : *m_keys){
       key.print(os);
     }
 
     return os;
   }
 
-  void IddField_Impl::parse(const std::string& text)
+  void IddField_Impl::parse(const std::string& text, IddFieldProperties& properties, IddKeyVector& keys)
   {
     boost::smatch matches;
     if (boost::regex_search(text, matches, iddRegex::field())){
@@ -292,10 +468,10 @@ namespace detail {
 
       // check for base content type
       if (boost::iequals(fieldTypeChar, "A")){
-        m_properties.type = IddFieldType(IddFieldType::AlphaType);
+        properties.type = IddFieldType(IddFieldType::AlphaType);
       }else if (boost::iequals(fieldTypeChar, "N")){
         // default numerics to real, can be overwritten later
-        m_properties.type = IddFieldType(IddFieldType::RealType);
+        properties.type = IddFieldType(IddFieldType::RealType);
       }else{
         LOG_AND_THROW("Unknown field type identifier found: '" << fieldTypeChar << "'");
       }
@@ -303,7 +479,7 @@ namespace detail {
       // parse all the properties
       while (boost::regex_search(fieldProperties, matches, iddRegex::metaDataComment())){
         std::string thisProperty(matches[1].first, matches[1].second); boost::trim(thisProperty);
-        parseProperty(thisProperty);
+        parseProperty(thisProperty,properties,keys);
 
         fieldProperties = std::string(matches[2].first, matches[2].second); boost::trim(fieldProperties);
       }
@@ -316,34 +492,45 @@ namespace detail {
       LOG_AND_THROW("Field text does not match expected pattern: '" << text << "'");
     }
 
-    if (m_properties.type == IddFieldType::ChoiceType){
+    checkProperties(properties,keys);
+  }
+
+  void IddField_Impl::checkProperties(IddFieldProperties& properties, const IddKeyVector& keys)
+  {
+    if (properties.type == IddFieldType::ChoiceType){
       // if this is a choice, assert we have some keys
-      if (m_keys.empty()){
+      if (keys.empty()){
         LOG(Error,  "Field is of type choice but keys are empty: '" << m_name << "'");
       }
     }else{
       // else assert we have no keys
-      if (!m_keys.empty()){
+      if (!keys.empty()){
         LOG(Error,  "Field is not of type choice but has non-empty keys: '" << m_name << "'");
       }
     }
 
-    if (m_properties.type == IddFieldType::UnknownType){
+    if (properties.type == IddFieldType::UnknownType){
 
       LOG_AND_THROW("Field is of unknown type after parsing: '" << m_name << "'");
     }
 
     // If the field has a default then it is not required. This overrides the idd text.
-    if (m_properties.stringDefault){
-      if (m_properties.required){
-        LOG(Info,  "Field '" << m_name << "' of object '" << m_objectName <<
+    if (properties.stringDefault){
+      if (properties.required){
+        LOG(Info,  "Field '" << m_name << "' of object '" << *m_objectName <<
             "' is both required and has default value, setting required = false.");
-        m_properties.required = false;
+        properties.required = false;
       }
     }
   }
 
-  void IddField_Impl::parseProperty(const std::string& text)
+  void IddField_Impl::setProperties(IddFieldProperties&& properties, IddKeyVector&& keys)
+  {
+    m_properties = internProperties(std::move(properties));
+    m_keys = internKeys(std::move(keys));
+  }
+
+  void IddField_Impl::parseProperty(const std::string& text, IddFieldProperties& properties, IddKeyVector& keys)
   {
     // this function is called very often and has been identified as a bottleneck
     // that is why some of the optimizations below have been applied
@@ -369,12 +556,12 @@ namespace detail {
       {
         if (boost::algorithm::starts_with(lowerText, "autosizable"))
         {
-          m_properties.autosizable = true;
+          properties.autosizable = true;
           notHandled=false;
         }
         else if (boost::algorithm::starts_with(lowerText, "autocalculatable"))
         {
-          m_properties.autocalculatable = true;
+          properties.autocalculatable = true;
           notHandled=false;
         }
         break;
@@ -383,7 +570,7 @@ namespace detail {
       {
         if (boost::algorithm::starts_with(lowerText, "begin-extensible"))
         {
-          m_properties.beginExtensible = true;
+          properties.beginExtensible = true;
           notHandled=false;
         }
         break;
@@ -396,26 +583,26 @@ namespace detail {
           OS_ASSERT(boost::regex_search(text, matches, iddRegex::defaultProperty()));
           std::string stringDefault(matches[1].first, matches[1].second);
           boost::trim(stringDefault);
-          m_properties.stringDefault = stringDefault;
+          properties.stringDefault = stringDefault;
           notHandled=false;
           // if we are numeric type and not set to autosize, set the numeric property
-          if ((m_properties.type == IddFieldType::RealType) ||
-              (m_properties.type == IddFieldType::IntegerType))
+          if ((properties.type == IddFieldType::RealType) ||
+              (properties.type == IddFieldType::IntegerType))
           {
             if (!boost::regex_match(text, iddRegex::automaticDefault()))
             {
-              m_properties.numericDefault = boost::lexical_cast<double>(stringDefault);
+              properties.numericDefault = boost::lexical_cast<double>(stringDefault);
             }
             else
             {
               // otherwise this is -9999
-              m_properties.numericDefault = -9999;
+              properties.numericDefault = -9999;
             }
           }
         }
         else if (boost::algorithm::starts_with(lowerText, "deprecated"))
         {
-          m_properties.deprecated = true;
+          properties.deprecated = true;
           notHandled=false;
         }
         break;
@@ -427,7 +614,7 @@ namespace detail {
           OS_ASSERT(boost::regex_search(text, matches, iddRegex::externalListProperty()));
           std::string externalList(matches[1].first, matches[1].second);
           boost::trim(externalList);
-          m_properties.externalLists.push_back(externalList);
+          properties.externalLists.push_back(externalList);
           notHandled=false;
         }
 
@@ -444,7 +631,7 @@ namespace detail {
           if (!boost::equals(m_name, fieldName))
           {
             LOG_AND_THROW("Field name '" << fieldName << "' does not match expected '" << m_name
-                          << "' in object '" << m_objectName << "'");
+                          << "' in object '" << *m_objectName << "'");
           }
         }
         break;
@@ -456,7 +643,7 @@ namespace detail {
           OS_ASSERT(boost::regex_search(text, matches, iddRegex::ipUnitsProperty()));
           std::string ipUnits(matches[1].first, matches[1].second);
           boost::trim(ipUnits);
-          m_properties.ipUnits = ipUnits;
+          properties.ipUnits = ipUnits;
           notHandled=false;
         }
         break;
@@ -479,7 +666,7 @@ namespace detail {
             OptionalIddKey key = IddKey::load(keyName, keyText);
 
             // add the key to the keys
-            if (key) { m_keys.push_back(*key); }
+            if (key) { keys.push_back(*key); }
             else
             {
               LOG_AND_THROW("Key could not be loaded from text '" << keyText << "'.");
@@ -499,20 +686,20 @@ namespace detail {
         {
           if (boost::regex_search(text, matches, iddRegex::minExclusiveProperty()))
           {
-            m_properties.minBoundType = IddFieldProperties::ExclusiveBound;
+            properties.minBoundType = IddFieldProperties::ExclusiveBound;
             std::string minExclusive(matches[1].first, matches[1].second);
             boost::trim(minExclusive);
-            m_properties.minBoundValue = boost::lexical_cast<double>(minExclusive);
-            m_properties.minBoundText = minExclusive;
+            properties.minBoundValue = boost::lexical_cast<double>(minExclusive);
+            properties.minBoundText = minExclusive;
             notHandled=false;
           }
           else if (boost::regex_search(text, matches, iddRegex::minInclusiveProperty()))
           {
-            m_properties.minBoundType = IddFieldProperties::InclusiveBound;
+            properties.minBoundType = IddFieldProperties::InclusiveBound;
             std::string minInclusive(matches[1].first, matches[1].second);
             boost::trim(minInclusive);
-            m_properties.minBoundValue = boost::lexical_cast<double>(minInclusive);
-            m_properties.minBoundText = minInclusive;
+            properties.minBoundValue = boost::lexical_cast<double>(minInclusive);
+            properties.minBoundText = minInclusive;
             notHandled=false;
           }
         }
@@ -520,20 +707,20 @@ namespace detail {
         {
           if (boost::regex_search(text, matches, iddRegex::maxExclusiveProperty()))
           {
-            m_properties.maxBoundType = IddFieldProperties::ExclusiveBound;
+            properties.maxBoundType = IddFieldProperties::ExclusiveBound;
             std::string maxExclusive(matches[1].first, matches[1].second);
             boost::trim(maxExclusive);
-            m_properties.maxBoundValue = boost::lexical_cast<double>(maxExclusive);
-            m_properties.maxBoundText = maxExclusive;
+            properties.maxBoundValue = boost::lexical_cast<double>(maxExclusive);
+            properties.maxBoundText = maxExclusive;
             notHandled=false;
           }
           else if (boost::regex_search(text, matches, iddRegex::maxInclusiveProperty()))
           {
-            m_properties.maxBoundType = IddFieldProperties::InclusiveBound;
+            properties.maxBoundType = IddFieldProperties::InclusiveBound;
             std::string maxInclusive(matches[1].first, matches[1].second);
             boost::trim(maxInclusive);
-            m_properties.maxBoundValue = boost::lexical_cast<double>(maxInclusive);
-            m_properties.maxBoundText = maxInclusive;
+            properties.maxBoundValue = boost::lexical_cast<double>(maxInclusive);
+            properties.maxBoundText = maxInclusive;
             notHandled=false;
           }
         }
@@ -543,8 +730,8 @@ namespace detail {
           OS_ASSERT(boost::regex_search(text, matches, iddRegex::memoProperty()));
           std::string memo(matches[1].first, matches[1].second);
           trim(memo);
-          if (m_properties.note.empty()) { m_properties.note = memo; }
-          else {m_properties.note += "\n" + memo; }
+          if (properties.note.empty()) { properties.note = memo; }
+          else {properties.note += "\n" + memo; }
         }
         break;
       }
@@ -556,8 +743,8 @@ namespace detail {
           OS_ASSERT(boost::regex_search(text, matches, iddRegex::noteProperty()));
           std::string note(matches[1].first, matches[1].second);
           trim(note);
-          if (m_properties.note.empty()) { m_properties.note = note; }
-          else { m_properties.note += "\n" + note; }
+          if (properties.note.empty()) { properties.note = note; }
+          else { properties.note += "\n" + note; }
         }
         break;
       }
@@ -568,7 +755,7 @@ namespace detail {
           OS_ASSERT(boost::regex_search(text, matches, iddRegex::objectListProperty()));
           std::string objectList(matches[1].first, matches[1].second);
           boost::trim(objectList);
-          m_properties.objectLists.push_back(objectList);
+          properties.objectLists.push_back(objectList);
           notHandled=false;
         }
         break;
@@ -577,7 +764,7 @@ namespace detail {
       {
         if (boost::algorithm::starts_with(lowerText, "required-field"))
         {
-          m_properties.required = true;
+          properties.required = true;
           notHandled=false;
         }
         else if (boost::algorithm::starts_with(lowerText, "reference-class-name"))
@@ -585,7 +772,7 @@ namespace detail {
           OS_ASSERT(boost::regex_search(text, matches, iddRegex::referenceClassNameProperty()));
           std::string reference(matches[1].first, matches[1].second);
           boost::trim(reference);
-          m_properties.referenceClassNames.push_back(reference);
+          properties.referenceClassNames.push_back(reference);
           notHandled=false;
         }
         else if (boost::algorithm::starts_with(lowerText, "reference"))
@@ -593,12 +780,12 @@ namespace detail {
           OS_ASSERT(boost::regex_search(text, matches, iddRegex::referenceProperty()));
           std::string reference(matches[1].first, matches[1].second);
           boost::trim(reference);
-          m_properties.references.push_back(reference);
+          properties.references.push_back(reference);
           notHandled=false;
         }
         else if (boost::algorithm::starts_with(lowerText, "retaincase"))
         {
-          m_properties.retaincase = true;
+          properties.retaincase = true;
           notHandled=false;
         }
         break;
@@ -611,7 +798,7 @@ namespace detail {
           OS_ASSERT(boost::regex_search(text, matches, iddRegex::typeProperty()));
           std::string fieldType(matches[1].first, matches[1].second);
           boost::trim(fieldType);
-          m_properties.type = IddFieldType(fieldType);
+          properties.type = IddFieldType(fieldType);
           notHandled=false;
         }
         break;
@@ -629,7 +816,7 @@ namespace detail {
           OS_ASSERT(boost::regex_search(text, matches, iddRegex::unitsProperty()));
           std::string units(matches[1].first, matches[1].second);
           boost::trim(units);
-          m_properties.units = units;
+          properties.units = units;
           notHandled=false;
         }
         break;
@@ -729,6 +916,13 @@ OptionalIddField IddField::load(const std::string& name,
   else { return boost::none; }
 }
 
+OptionalIddField IddField::load(const IddFieldTable& table,
+                                const std::string& objectName) {
+  std::shared_ptr<detail::IddField_Impl> p = detail::IddField_Impl::load(table,objectName);
+  if (p) { return IddField(p); }
+  else { return boost::none; }
+}
+
 std::ostream& IddField::print(std::ostream& os, bool lastField) const
 {
   return m_impl->print(os, lastField);
@@ -45,6 +45,7 @@ namespace openstudio {
 
 class Unit;
 class IddKey;
+struct IddFieldTable;
 
 // forward declarations
 namespace detail {
@@ -138,6 +139,10 @@ class UTILITIES_API IddField {
                                         const std::string& text,
                                         const std::string& objectName);
 
+  /** Load the IddField from a table written by GenerateIddFactory. */
+  static boost::optional<IddField> load(const IddFieldTable& table,
+                                        const std::string& objectName);
+
   /** Print the IddField to an output stream. Field slash codes are indented to produce pretty
    *  output. If lastField, then the field id will be followed by a semi-colon; otherwise, a
    *  comma will be used (consistent with IDD formatting). */
@@ -44,6 +44,7 @@
 namespace openstudio {
 
 class Unit;
+struct IddFieldTable;
 
 namespace detail {
 
@@ -131,6 +132,11 @@ namespace detail {
                                                  const std::string& text,
                                                  const std::string& objectName);
 
+    /** Load the IddField from a table written by GenerateIddFactory. Only the individual
+     *  property strings are parsed. */
+    static std::shared_ptr<IddField_Impl> load(const IddFieldTable& table,
+                                                 const std::string& objectName);
+
     /** Print the IddField to an output stream. Field slash codes are indented to produce pretty
      *  output. If lastField, then the field id will be followed by a semi-colon; otherwise, a
      *  comma will be used (consistent with IDD formatting). */
@@ -138,23 +144,31 @@ namespace detail {
 
     //@}
    private:
+    // The object name, properties and keys are interned, that is, shared by all fields (in all
+    // loaded IddFiles) that have identical data. They must not be modified once interned.
     std::string m_name;
-    std::string m_fieldId;           // e.g. A1, N1
-    std::string m_objectName;        // name of IddObject to which this field belongs
-    IddFieldProperties m_properties; // IDD markup information
-    std::vector<IddKey> m_keys;      // vector of all keys
+    std::string m_fieldId;                                   // e.g. A1, N1
+    std::shared_ptr<const std::string> m_objectName;         // name of IddObject to which this field belongs
+    std::shared_ptr<const IddFieldProperties> m_properties;  // IDD markup information
+    std::shared_ptr<const std::vector<IddKey> > m_keys;      // vector of all keys
 
     // partial constructor used by load
     IddField_Impl(const std::string& name, const std::string& objectName);
 
-    // parses the text
-    void parse(const std::string& text);
+    // parses the text into properties and keys
+    void parse(const std::string& text, IddFieldProperties& properties, std::vector<IddKey>& keys);
 
     // parse single field
     void parseField(const std::string& text);
 
     // parse property of field
-    void parseProperty(const std::string& text);
+    void parseProperty(const std::string& text, IddFieldProperties& properties, std::vector<IddKey>& keys);
+
+    // consistency checks run once all properties have been parsed
+    void checkProperties(IddFieldProperties& properties, const std::vector<IddKey>& keys);
+
+    // interns properties and keys as this field's data
+    void setProperties(IddFieldProperties&& properties, std::vector<IddKey>&& keys);
 
     // configure logging
     REGISTER_LOGGER("utilities.idd.IddField");
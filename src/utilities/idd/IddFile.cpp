@@ -35,10 +35,14 @@
 #include <utilities/idd/IddEnums.hxx>
 
 #include "../core/PathHelpers.hpp"
+#include "../core/FilesystemHelpers.hpp"
 #include "../core/Assert.hpp"
 
 #include "../core/Containers.hpp"
 
+#include <iterator>
+#include <sstream>
+
 
 
 
@@ -46,6 +50,31 @@ namespace openstudio {
 
 namespace detail {
 
+  namespace {
+
+    // reads the line starting at pos and ending before end, like std::getline
+    bool getLine(const std::string& text,
+                 std::string::size_type& pos,
+                 std::string::size_type end,
+                 std::string& line)
+    {
+      if (pos >= end) {
+        return false;
+      }
+      std::string::size_type eol = text.find('\n', pos);
+      if ((eol == std::string::npos) || (eol >= end)) {
+        line.assign(text, pos, end - pos);
+        pos = end;
+      }
+      else {
+        line.assign(text, pos, eol - pos);
+        pos = eol + 1;
+      }
+      return true;
+    }
+
+  }
+
   // CONSTRUCTORS
 
   IddFile_Impl::IddFile_Impl()
@@ -66,22 +95,31 @@ namespace detail {
   }
 
   std::vector<IddObject> IddFile_Impl::objects() const {
-    return m_objects;
+    IddObjectVector result;
+    result.reserve(m_objects.size());
+    for (const ObjectEntry& entry : m_objects) {
+      if (OptionalIddObject object = this->object(entry)) {
+        result.push_back(*object);
+      }
+    }
+    return result;
   }
 
   std::vector<std::string> IddFile_Impl::groups() const {
     StringSet result;
-    for (const IddObject& object : objects()) {
-      result.insert(object.group());
+    for (const ObjectEntry& entry : m_objects) {
+      result.insert(entry.group);
     }
     return StringVector(result.begin(),result.end());
   }
 
   std::vector<IddObject> IddFile_Impl::getObjectsInGroup(const std::string& group) const {
     IddObjectVector result;
-    for (const IddObject& object : m_objects){
-      if(istringEqual(object.group(), group)){
-        result.push_back(object);
+    for (const ObjectEntry& entry : m_objects){
+      if(istringEqual(entry.group, group)){
+        if (OptionalIddObject object = this->object(entry)) {
+          result.push_back(*object);
+        }
       }
     }
     return result;
@@ -90,9 +128,11 @@ namespace detail {
   std::vector<IddObject> IddFile_Impl::getObjects(const boost::regex &objectRegex) const {
     IddObjectVector result;
 
-    for (const IddObject& object : m_objects) {
-      if (boost::regex_match(object.name(),objectRegex)) {
-        result.push_back(object);
+    for (const ObjectEntry& entry : m_objects) {
+      if (boost::regex_match(entry.name,objectRegex)) {
+        if (OptionalIddObject object = this->object(entry)) {
+          result.push_back(*object);
+        }
       }
     }
 
@@ -116,9 +156,9 @@ namespace detail {
   boost::optional<IddObject> IddFile_Impl::getObject(const std::string& objectName) const
   {
     OptionalIddObject result;
-    for (const IddObject& object : m_objects){
-      if(istringEqual(object.name(), objectName)){
-        result = object;
+    for (const ObjectEntry& entry : m_objects){
+      if(istringEqual(entry.name, objectName)){
+        result = object(entry);
         break;
       }
     }
@@ -137,9 +177,10 @@ namespace detail {
       return result;
     }
 
-    for (const IddObject& object : m_objects){
-      if (object.type() == objectType) {
-        result = object;
+    for (const ObjectEntry& entry : m_objects){
+      // objects parsed from text are always UserCustom, so only look at the others
+      if ((entry.begin == entry.end) && entry.object && (entry.object->type() == objectType)) {
+        result = entry.object;
         break;
       }
     }
@@ -150,7 +191,7 @@ namespace detail {
   std::vector<IddObject> IddFile_Impl::requiredObjects() const
   {
     IddObjectVector result;
-    for (const IddObject& object : m_objects){
+    for (const IddObject& object : objects()){
       if(object.properties().required){
         result.push_back(object);
       }
@@ -161,7 +202,7 @@ namespace detail {
   std::vector<IddObject> IddFile_Impl::uniqueObjects() const
   {
     IddObjectVector result;
-    for (const IddObject& object : m_objects){
+    for (const IddObject& object : objects()){
       if(object.properties().unique){
         result.push_back(object);
       }
@@ -183,23 +224,20 @@ namespace detail {
 
   void IddFile_Impl::addObject(const IddObject& object)
   {
-    m_objects.push_back(object);
+    m_objects.push_back(ObjectEntry{object.name(), object.group(), 0, 0, object, true});
   }
 
   // SERIALIZATION
 
-  std::shared_ptr<IddFile_Impl> IddFile_Impl::load(std::istream& is) {
-    std::shared_ptr<IddFile_Impl> result;
-    IddFile_Impl iddFileImpl;
+  std::shared_ptr<IddFile_Impl> IddFile_Impl::load(std::istream& is, bool lazy) {
+    std::shared_ptr<IddFile_Impl> result(new IddFile_Impl());
 
     try {
-      iddFileImpl.parse(is);
+      result->parse(is, lazy);
     }
-    catch (...) { return result; }
+    catch (...) { result.reset(); }
 
-    result = std::shared_ptr<IddFile_Impl>(new IddFile_Impl(iddFileImpl));
     return result;
-
   }
 
 
@@ -207,7 +245,7 @@ namespace detail {
   {
     os << m_header << std::endl;
     std::string groupName;
-    for (const IddObject& object : m_objects){
+    for (const IddObject& object : objects()){
       if (object.group() != groupName) {
         groupName = object.group();
         os << "\\group " << groupName << std::endl << std::endl;
@@ -220,7 +258,7 @@ namespace detail {
 
   // PRIVATE
 
-  void IddFile_Impl::parse(std::istream& is)
+  void IddFile_Impl::parse(std::istream& is, bool lazy)
   {
 
     // keep track of line number in the idd
@@ -243,7 +281,11 @@ namespace detail {
                                                           iddRegex::commentOnlyObjectText(),
                                                           IddObjectType::CommentOnly);
     OS_ASSERT(commentOnlyObject);
-    m_objects.push_back(*commentOnlyObject);
+    addObject(*commentOnlyObject);
+
+    // keep the text, objects are located in it by position
+    m_text.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    std::string::size_type pos = 0;
 
     // temp string to read file
     std::string line;
@@ -252,7 +294,7 @@ namespace detail {
     boost::smatch matches;
 
     // read in the version from the first line
-    getline(is, line);
+    getLine(m_text, pos, m_text.size(), line);
     if (boost::regex_search(line, matches, iddRegex::version())){
 
       m_version = std::string(matches[1].first,matches[1].second);
@@ -267,7 +309,8 @@ namespace detail {
 
     // read the rest of the file line by line
     // todo, do this by regex
-    while(getline(is, line)){
+    std::string::size_type lineBegin = pos;
+    while(getLine(m_text, pos, m_text.size(), line)){
       ++lineNum;
 
       // remove whitespace
@@ -278,7 +321,6 @@ namespace detail {
         headerClosed = true;
 
         // empty line
-        continue;
       }else if (boost::regex_search(line, matches, iddRegex::build())) {
         m_build = std::string(matches[1].first,matches[1].second);
         // this line belongs to the header
@@ -291,7 +333,6 @@ namespace detail {
         }
 
         // comment only line
-        continue;
       }else if (boost::regex_search(line, matches, iddRegex::group())){
 
         headerClosed = true;
@@ -302,7 +343,6 @@ namespace detail {
         // set the current group
         currentGroup = groupName;
 
-        continue;
       }else{
 
         headerClosed = true;
@@ -323,8 +363,14 @@ namespace detail {
                          ": '" << line << "'");
         }
 
-        // put the text for this object in a new string
-        std::string text(line);
+        // the text for this object starts on this line
+        ObjectEntry entry{objectName, currentGroup, lineBegin, m_text.size(), boost::none, false};
+
+        // without lazy, put the text for this object in a new string
+        std::string text;
+        if (!lazy) {
+          text = line;
+        }
 
           // check if the object has no fields
         if (boost::regex_match(line, iddRegex::objectNoFields())){
@@ -338,7 +384,8 @@ namespace detail {
 
         // continue reading until we have seen the entire object
         // last line will be thrown away, requires empty line between objects in idd
-        while(getline(is, line)){
+        lineBegin = pos;
+        while(getLine(m_text, pos, m_text.size(), line)){
           ++lineNum;
 
           // remove whitespace
@@ -346,35 +393,81 @@ namespace detail {
 
           // found last field and this is not a field comment
           if (foundClosingLine && (!boost::regex_match(line, iddRegex::metaDataComment()))){
+            entry.end = lineBegin;
             break;
           }
 
           if (!line.empty()){
-            // if the line is not empty add it to the text
             // note, text does not include newlines
-            text += line;
+            if (!lazy) {
+              text += line;
+            }
 
             // check if we have found the last field
             if (boost::regex_match(line, iddRegex::closingField())){
               foundClosingLine = true;
             }
           }
+          lineBegin = pos;
         }
 
-        // construct the IddObject using default UserCustom type
-        OptionalIddObject object = IddObject::load(objectName, currentGroup, text);
-
-        // construct a new object and put it in the object vector
-        if (object) { m_objects.push_back(*object); }
+        if (lazy) {
+          ++m_numUnloadedObjects;
+        }
         else {
-          LOG_AND_THROW("Unable to construct IddObject from text: " << std::endl << text);
+          // construct the IddObject using default UserCustom type
+          entry.object = IddObject::load(objectName, currentGroup, text);
+          if (!entry.object) {
+            LOG_AND_THROW("Unable to construct IddObject from text: " << std::endl << text);
+          }
+          entry.begin = entry.end = 0;
+          entry.loaded = true;
         }
 
+        m_objects.push_back(entry);
       }
+
+      lineBegin = pos;
     }
 
     // set header
     m_header = header.str();
+
+    if (m_numUnloadedObjects == 0) {
+      std::string().swap(m_text);
+    }
+  }
+
+  boost::optional<IddObject> IddFile_Impl::object(const ObjectEntry& entry) const
+  {
+    if (entry.begin == entry.end) {
+      return entry.object;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!entry.loaded) {
+      // join the trimmed, non-empty lines of the object, note, text does not include newlines
+      std::string text;
+      std::string line;
+      std::string::size_type pos = entry.begin;
+      while (getLine(m_text, pos, entry.end, line)) {
+        boost::trim(line);
+        text += line;
+      }
+
+      // construct the IddObject using default UserCustom type
+      entry.object = IddObject::load(entry.name, entry.group, text);
+      if (!entry.object) {
+        LOG(Error,"Unable to construct IddObject from text: " << std::endl << text);
+      }
+      entry.loaded = true;
+
+      // every object is loaded, the text is no longer needed
+      if (--m_numUnloadedObjects == 0) {
+        std::string().swap(m_text);
+      }
+    }
+    return entry.object;
   }
 
 } // detail
@@ -456,19 +549,19 @@ std::vector<IddObject> IddFile::uniqueObjects() const
 
 // SERIALIZATION
 
-OptionalIddFile IddFile::load(std::istream& is)
+OptionalIddFile IddFile::load(std::istream& is, bool lazy)
 {
-  std::shared_ptr<detail::IddFile_Impl> p = detail::IddFile_Impl::load(is);
+  std::shared_ptr<detail::IddFile_Impl> p = detail::IddFile_Impl::load(is, lazy);
   if (p) { return IddFile(p); }
   return boost::none;
 }
 
-OptionalIddFile IddFile::load(const openstudio::path& p) {
+OptionalIddFile IddFile::load(const openstudio::path& p, bool lazy) {
   openstudio::path wp = completePathToFile(p,path(),"idd",true);
   if (wp.empty()) { return boost::none; }
   openstudio::filesystem::ifstream inFile(wp);
   if (!inFile) { return boost::none; }
-  return load(inFile);
+  return load(inFile, lazy);
 }
 
 std::ostream& IddFile::print(std::ostream& os) const
@@ -476,32 +569,64 @@ std::ostream& IddFile::print(std::ostream& os) const
   return m_impl->print(os);
 }
 
-std::pair<VersionString, std::string> IddFile::parseVersionBuild(const openstudio::path &p)
-{
-  std::ifstream ifs(openstudio::toSystemFilename(p));
+namespace {
 
-  if (!ifs.good()) {
-    throw std::runtime_error("Unable to open file for reading: " + openstudio::toString(p));
+  // number of bytes at the start of an IDD that parseVersionBuild scans for the header lines
+  // before scanning the whole file
+  const std::size_t versionBuildSniffLength = 10000;
+
+  bool isLineBreak(char c) {
+    return (c == '\n') || (c == '\r') || (c == '\f');
   }
 
-  ifs.seekg(0, std::ios_base::end);
-  const auto end = ifs.tellg();
-  ifs.seekg(0, std::ios_base::beg);
+  bool isSpace(char c) {
+    return (c == ' ') || (c == '\t') || (c == '\v') || isLineBreak(c);
+  }
 
-  const auto length_to_read = std::min(std::streampos(10000), end);
+  // Finds the first line of text that starts with key, and returns the non-space characters
+  // directly following it, as the iddRegex::version() and iddRegex::build() expressions do.
+  boost::optional<std::string> findHeaderValue(std::string_view text, std::string_view key) {
+    std::string_view::size_type pos = 0;
+    while ((pos = text.find(key, pos)) != std::string_view::npos) {
+      if ((pos == 0) || isLineBreak(text[pos - 1])) {
+        std::string_view::size_type begin = pos + key.size(), end = begin;
+        while ((end < text.size()) && !isSpace(text[end])) {
+          ++end;
+        }
+        if (end > begin) {
+          return std::string(text.substr(begin, end - begin));
+        }
+      }
+      ++pos;
+    }
+    return boost::none;
+  }
+
+}
 
-  std::vector<char> data(length_to_read);
-  ifs.read(data.data(), length_to_read);
-  const std::string strdata(data.cbegin(), data.cend());
+std::pair<VersionString, std::string> IddFile::parseVersionBuild(const openstudio::path &p)
+{
+  // the header lines are at the top, so only map the start of the file unless they are missing
+  openstudio::filesystem::mapped_file_prefix prefix(p, versionBuildSniffLength);
+  if (!prefix.is_open()) {
+    throw std::runtime_error("Unable to open file for reading: " + openstudio::toString(p));
+  }
 
-  std::string build;
-  boost::smatch matches;
-  if (boost::regex_search(strdata, matches, iddRegex::build())) {
-    build = std::string(matches[1].first,matches[1].second);
+  boost::optional<std::string> version = findHeaderValue(prefix.data(), "!IDD_Version ");
+  boost::optional<std::string> build = findHeaderValue(prefix.data(), "!IDD_BUILD ");
+
+  if (!version && !prefix.complete()) {
+    openstudio::filesystem::mapped_file_prefix file(p);
+    if (file.is_open()) {
+      version = findHeaderValue(file.data(), "!IDD_Version ");
+      if (!build) {
+        build = findHeaderValue(file.data(), "!IDD_BUILD ");
+      }
+    }
   }
 
-  if (boost::regex_search(strdata, matches, iddRegex::version())) {
-    return std::make_pair(VersionString(std::string(matches[1].first, matches[1].second)), build);
+  if (version) {
+    return std::make_pair(VersionString(*version), build ? *build : std::string());
   }
 
   throw std::runtime_error("Unable to parse version from IDD: " + openstudio::toString(p));
@@ -118,11 +118,14 @@ class UTILITIES_API IddFile {
   /** @name Serialization */
   //@{
 
-  /** Load an IddFile from std::istream, if possible. */
-  static boost::optional<IddFile> load(std::istream& is);
-
-  /** Load an IddFile from path p, if possible. */
-  static boost::optional<IddFile> load(const openstudio::path& p);
+  /** Load an IddFile from std::istream, if possible. If lazy, only the names, groups and
+   *  positions of the objects are read, and each IddObject is parsed the first time it is
+   *  requested. This is much faster when only a few objects are needed, but errors in object
+   *  text are then only logged when the object is requested, rather than failing the load. */
+  static boost::optional<IddFile> load(std::istream& is, bool lazy=false);
+
+  /** Load an IddFile from path p, if possible. See above for lazy. */
+  static boost::optional<IddFile> load(const openstudio::path& p, bool lazy=false);
 
   /** Prints this file to std::ostream os. */
   std::ostream& print(std::ostream& os) const;
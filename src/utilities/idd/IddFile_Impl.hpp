@@ -36,6 +36,7 @@
 
 #include <string>
 #include <ostream>
+#include <mutex>
 #include <vector>
 
 #include <boost/algorithm/string.hpp>
@@ -110,8 +111,10 @@ namespace detail{
     /** @name Serialization */
     //@{
 
-    /// parse text from input stream to construct an IddFile_Impl
-    static std::shared_ptr<IddFile_Impl> load(std::istream& is);
+    /** Parse text from input stream to construct an IddFile_Impl. If lazy, only object names,
+     *  groups and positions are read up front, and each IddObject is parsed the first time it is
+     *  requested. */
+    static std::shared_ptr<IddFile_Impl> load(std::istream& is, bool lazy=false);
 
     /// print
     std::ostream& print(std::ostream& os) const;
@@ -120,8 +123,22 @@ namespace detail{
 
    private:
 
-    /// Parse file text to populate this IddFile.
-    void parse(std::istream& is);
+    /** An object of this IddFile. Objects of a lazy load are located by [begin,end) in m_text
+     *  and constructed once, when loaded is set; for all others begin == end. */
+    struct ObjectEntry {
+      std::string name;
+      std::string group;
+      std::string::size_type begin;
+      std::string::size_type end;
+      mutable boost::optional<IddObject> object; // none if the text could not be parsed
+      mutable bool loaded;
+    };
+
+    /// Parse file text to populate this IddFile. If lazy, objects are only indexed.
+    void parse(std::istream& is, bool lazy);
+
+    /// Returns the object of entry, constructing it from m_text if necessary.
+    boost::optional<IddObject> object(const ObjectEntry& entry) const;
 
     /// Version string required to be at top of any IddFile.
     std::string m_version;
@@ -132,8 +149,17 @@ namespace detail{
     /// The first comment block in an IddFile is its header.
     std::string m_header;
 
-    /// The vector of IddObjects that constitute this IddFile.
-    std::vector<IddObject> m_objects;
+    /// The objects that constitute this IddFile, in order.
+    std::vector<ObjectEntry> m_objects;
+
+    /// Text of the objects in m_objects that have not been loaded yet, freed once all are.
+    mutable std::string m_text;
+
+    /// Number of objects in m_objects that have not been loaded yet.
+    mutable std::size_t m_numUnloadedObjects = 0;
+
+    /// Guards loading objects from m_text.
+    mutable std::mutex m_mutex;
 
     /// Cache the Version IddObject
     mutable boost::optional<IddObject> m_versionObject;
@@ -31,6 +31,8 @@
 #include "IddObject_Impl.hpp"
 
 #include "ExtensibleIndex.hpp"
+#include "IddObjectTable.hpp"
+#include "IddObjectValidation.hpp"
 #include "IddRegex.hpp"
 #include <utilities/idd/IddFactory.hxx>
 #include <utilities/idd/IddEnums.hxx>
@@ -197,6 +199,7 @@ namespace detail {
         unsigned newMaxFields = m_properties.maxFields.get() + 1;
         m_properties.maxFields = newMaxFields;
       }
+      std::atomic_store(&m_validation, std::shared_ptr<const IddObjectValidation>());
     }
   }
 
@@ -383,6 +386,19 @@ namespace detail {
     return result;
   }
 
+  std::shared_ptr<const IddObjectValidation> IddObject_Impl::validation() const {
+    std::shared_ptr<const IddObjectValidation> result = std::atomic_load(&m_validation);
+    if (!result) {
+      std::lock_guard<std::mutex> lock(m_validationMutex);
+      result = m_validation;
+      if (!result) {
+        result = std::make_shared<const IddObjectValidation>(m_fields, m_extensibleFields, references());
+        std::atomic_store(&m_validation, result);
+      }
+    }
+    return result;
+  }
+
   bool IddObject_Impl::operator==(const IddObject_Impl& other) const {
     if (this == &other) {
       return true;
@@ -428,6 +444,37 @@ namespace detail {
     return result;
   }
 
+  std::shared_ptr<IddObject_Impl> IddObject_Impl::load(const IddObjectTable& table,
+                                                         IddObjectType type)
+  {
+    std::shared_ptr<IddObject_Impl> result;
+    result = std::shared_ptr<IddObject_Impl>(new IddObject_Impl(table.name,table.group,type));
+
+    try {
+      for (unsigned i = 0; i < table.numProperties; ++i){
+        result->parseProperty(table.properties[i]);
+      }
+
+      result->m_fields.reserve(table.numFields);
+      for (unsigned i = 0; i < table.numFields; ++i){
+        OptionalIddField oField = IddField::load(table.fields[i], result->m_name);
+        if (!oField) {
+          LOG_AND_THROW("Cannot load IddField '" << table.fields[i].fieldId << "' in object '"
+                        << result->m_name << "'.");
+        }
+        result->m_fields.push_back(*oField);
+      }
+
+      // remove existing extensible fields and add them the the extensible list
+      if (result->m_properties.extensible) {
+        result->makeExtensible();
+      }
+    }
+    catch (...) { return std::shared_ptr<IddObject_Impl>(); }
+
+    return result;
+  }
+
   /// print
   std::ostream& IddObject_Impl::print(std::ostream& os) const
   {
@@ -805,6 +852,10 @@ std::vector<unsigned> IddObject::urlFields() const {
   return m_impl->urlFields();
 }
 
+std::shared_ptr<const IddObjectValidation> IddObject::validation() const {
+  return m_impl->validation();
+}
+
 bool IddObject::operator==(const IddObject& other) const {
   return (*m_impl == *(other.m_impl));
 }
@@ -831,6 +882,13 @@ boost::optional<IddObject> IddObject::load(const std::string& name,
   return load(name,group,text,IddObjectType(IddObjectType::UserCustom));
 }
 
+boost::optional<IddObject> IddObject::load(const IddObjectTable& table,
+                                           IddObjectType type) {
+  std::shared_ptr<detail::IddObject_Impl> p = detail::IddObject_Impl::load(table,type);
+  if (p) { return IddObject(p); }
+  else { return boost::none; }
+}
+
 std::ostream& IddObject::print(std::ostream& os) const
 {
   return m_impl->print(os);
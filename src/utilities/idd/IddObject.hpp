@@ -45,7 +45,9 @@ namespace openstudio {
 
 // forward declarations
 class ExtensibleIndex;
+class IddObjectValidation;
 struct IddObjectType;
+struct IddObjectTable;
 
 namespace detail {
   class IddObject_Impl;
@@ -179,6 +181,11 @@ class UTILITIES_API IddObject {
    *  type. Includes indices in the first extensible group. */
   std::vector<unsigned> objectListFields() const;
 
+  /** Returns the validation program for the fields of this object, which is compiled from the
+   *  IddFieldProperties on first use and shared by all copies of this IddObject. Used by
+   *  IdfObject and WorkspaceObject to check field data. */
+  std::shared_ptr<const IddObjectValidation> validation() const;
+
   /** Returns true if all underlying data is equal (either trivially or by exhaustive
    *  comparison). */
   bool operator==(const IddObject& other) const;
@@ -205,6 +212,11 @@ class UTILITIES_API IddObject {
                                          const std::string& group,
                                          const std::string& text);
 
+  /** Load from a table written by GenerateIddFactory. The table holds the object text already
+   *  split into properties and fields, so only the individual slash codes are parsed. */
+  static boost::optional<IddObject> load(const IddObjectTable& table,
+                                         IddObjectType type);
+
   /** Print this object to os, in standard IDD format. */
   std::ostream& print(std::ostream& os) const;
 
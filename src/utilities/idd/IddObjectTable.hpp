@@ -0,0 +1,63 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2020, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef UTILITIES_IDD_IDDOBJECTTABLE_HPP
+#define UTILITIES_IDD_IDDOBJECTTABLE_HPP
+
+/** \file IddObjectTable.hpp
+ *
+ *  Defines the static tables written by GenerateIddFactory. Each table holds an IddObject that
+ *  has already been split into object properties, fields, and field properties, so that
+ *  IddObject::load does not have to run the text-splitting regexes on the full object text at
+ *  runtime. Every property string is the text following a single slash code, e.g.
+ *  "type choice" or "minimum> 0.0". */
+
+namespace openstudio {
+
+/** Pre-split data for a single IddField. */
+struct IddFieldTable {
+  const char* fieldId;             // e.g. A1, N1
+  const char* name;                // \\field name, or fieldId if absent
+  const char* const* properties;   // slash code text, in file order
+  unsigned numProperties;
+};
+
+/** Pre-split data for a single IddObject. */
+struct IddObjectTable {
+  const char* name;
+  const char* group;
+  const char* const* properties;   // object-level slash code text, in file order
+  unsigned numProperties;
+  const IddFieldTable* fields;     // all fields, extensible fields included
+  unsigned numFields;
+};
+
+} // openstudio
+
+#endif // UTILITIES_IDD_IDDOBJECTTABLE_HPP
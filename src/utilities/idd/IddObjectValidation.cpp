@@ -0,0 +1,232 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2020, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include "IddObjectValidation.hpp"
+#include "IddField.hpp"
+#include "IddKey.hpp"
+
+#include "../core/Assert.hpp"
+#include "../core/Compare.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <set>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace openstudio {
+
+namespace {
+
+  // bits assigned to reference list names, shared by all ReferenceListSets
+  struct ReferenceListBits {
+    std::shared_mutex mutex;
+    std::unordered_map<std::string, unsigned> bits;
+  };
+
+  ReferenceListBits& referenceListBits() {
+    static ReferenceListBits result;
+    return result;
+  }
+
+  boost::optional<unsigned> findReferenceListBit(const std::string& referenceListName) {
+    ReferenceListBits& registry = referenceListBits();
+    std::shared_lock<std::shared_mutex> lock(registry.mutex);
+    auto it = registry.bits.find(referenceListName);
+    if (it == registry.bits.end()) {
+      return boost::none;
+    }
+    return it->second;
+  }
+
+  // bit assigned to referenceListName, assigning the next one if it has none
+  unsigned referenceListBit(const std::string& referenceListName) {
+    if (boost::optional<unsigned> bit = findReferenceListBit(referenceListName)) {
+      return *bit;
+    }
+    ReferenceListBits& registry = referenceListBits();
+    std::unique_lock<std::shared_mutex> lock(registry.mutex);
+    auto insertResult = registry.bits.insert(std::make_pair(referenceListName, static_cast<unsigned>(registry.bits.size())));
+    return insertResult.first->second;
+  }
+
+  std::string upperCase(const std::string& value) {
+    std::string result(value);
+    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    return result;
+  }
+
+  IddFieldValidation compileField(const IddField& iddField) {
+    IddFieldValidation result;
+    const IddFieldProperties& properties = iddField.properties();
+
+    result.type = properties.type.value();
+    result.required = properties.required;
+    result.autosizable = properties.autosizable;
+    result.autocalculatable = properties.autocalculatable;
+    result.objectListField = iddField.isObjectListField();
+
+    result.minBoundType = properties.minBoundType;
+    if (result.minBoundType != IddFieldProperties::Unbounded) {
+      OS_ASSERT(properties.minBoundValue);
+      result.minBound = *properties.minBoundValue;
+    }
+    result.maxBoundType = properties.maxBoundType;
+    if (result.maxBoundType != IddFieldProperties::Unbounded) {
+      OS_ASSERT(properties.maxBoundValue);
+      result.maxBound = *properties.maxBoundValue;
+    }
+
+    if (result.type == IddFieldType::ChoiceType) {
+      for (const IddKey& key : iddField.keys()) {
+        result.keys.insert(upperCase(key.name()));
+      }
+    }
+
+    // ids in the order of IddObject::objectLists, which callers search in
+    std::set<std::string> objectLists(properties.objectLists.begin(), properties.objectLists.end());
+    for (const std::string& objectList : objectLists) {
+      if (istringEqual(objectList, "AllObjects")) {
+        result.allObjects = true;
+      }
+      result.objectLists.insert(objectList);
+      result.objectListIds.push_back(ReferenceListSet::id(objectList));
+    }
+    for (const std::string& reference : properties.references) {
+      result.referenceIds.push_back(ReferenceListSet::id(reference));
+    }
+
+    return result;
+  }
+
+} // anonymous namespace
+
+unsigned ReferenceListSet::id(const std::string& referenceListName) {
+  return referenceListBit(referenceListName);
+}
+
+boost::optional<unsigned> ReferenceListSet::findId(const std::string& referenceListName) {
+  return findReferenceListBit(referenceListName);
+}
+
+void ReferenceListSet::insert(const std::string& referenceListName) {
+  unsigned bit = referenceListBit(referenceListName);
+  unsigned word = bit / 64;
+  if (word >= m_words.size()) {
+    m_words.resize(word + 1, 0);
+  }
+  m_words[word] |= (std::uint64_t(1) << (bit % 64));
+}
+
+bool ReferenceListSet::empty() const {
+  return std::all_of(m_words.begin(), m_words.end(), [](std::uint64_t word) { return word == 0; });
+}
+
+bool ReferenceListSet::intersects(const ReferenceListSet& other) const {
+  std::size_t n = std::min(m_words.size(), other.m_words.size());
+  for (std::size_t i = 0; i < n; ++i) {
+    if ((m_words[i] & other.m_words[i]) != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+IddFieldValidation::IddFieldValidation()
+  : type(IddFieldType::UnknownType),
+    required(false),
+    autosizable(false),
+    autocalculatable(false),
+    objectListField(false),
+    minBoundType(IddFieldProperties::Unbounded),
+    minBound(0.0),
+    maxBoundType(IddFieldProperties::Unbounded),
+    maxBound(0.0),
+    allObjects(false)
+{}
+
+bool IddFieldValidation::withinBounds(double value) const {
+  if (minBoundType == IddFieldProperties::InclusiveBound) {
+    if (value < minBound) { return false; }
+  }
+  else if (minBoundType == IddFieldProperties::ExclusiveBound) {
+    if (value <= minBound) { return false; }
+  }
+
+  if (maxBoundType == IddFieldProperties::InclusiveBound) {
+    if (value > maxBound) { return false; }
+  }
+  else if (maxBoundType == IddFieldProperties::ExclusiveBound) {
+    if (value >= maxBound) { return false; }
+  }
+
+  return true;
+}
+
+bool IddFieldValidation::isKey(const std::string& value) const {
+  return (keys.count(upperCase(value)) > 0);
+}
+
+IddObjectValidation::IddObjectValidation(const std::vector<IddField>& nonextensibleFields,
+                                         const std::vector<IddField>& extensibleGroup,
+                                         const std::vector<std::string>& references)
+{
+  m_fields.reserve(nonextensibleFields.size());
+  for (const IddField& iddField : nonextensibleFields) {
+    m_fields.push_back(compileField(iddField));
+  }
+  m_extensibleFields.reserve(extensibleGroup.size());
+  for (const IddField& iddField : extensibleGroup) {
+    m_extensibleFields.push_back(compileField(iddField));
+  }
+  for (const std::string& reference : references) {
+    m_references.insert(reference);
+    m_referenceIds.push_back(ReferenceListSet::id(reference));
+  }
+}
+
+const IddFieldValidation* IddObjectValidation::field(unsigned index) const {
+  if (index < m_fields.size()) {
+    return &m_fields[index];
+  }
+  if (!m_extensibleFields.empty()) {
+    return &m_extensibleFields[(index - m_fields.size()) % m_extensibleFields.size()];
+  }
+  return nullptr;
+}
+
+const ReferenceListSet& IddObjectValidation::references() const {
+  return m_references;
+}
+
+const std::vector<unsigned>& IddObjectValidation::referenceIds() const {
+  return m_referenceIds;
+}
+
+} // openstudio
@@ -0,0 +1,140 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2020, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef UTILITIES_IDD_IDDOBJECTVALIDATION_HPP
+#define UTILITIES_IDD_IDDOBJECTVALIDATION_HPP
+
+/** \file IddObjectValidation.hpp
+ *
+ *  Defines the validation programs that IddObject compiles on first use. Checking IdfObject
+ *  field data against an IddField otherwise re-reads the IddFieldProperties (type, bounds, keys
+ *  and object lists) for every field of every object checked. */
+
+#include "../UtilitiesAPI.hpp"
+#include "IddFieldProperties.hpp"
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace openstudio {
+
+class IddField;
+
+/** Set of reference list names, stored as a bitmap. Names are assigned bits in a registry that
+ *  is shared by all IddObjects, so that sets built from different objects can be intersected. */
+class UTILITIES_API ReferenceListSet {
+ public:
+  /** Returns the id of referenceListName, which is the bit it is assigned in every set. Ids are
+   *  dense and shared by all IddObjects, so Workspace uses them to index its reference maps. */
+  static unsigned id(const std::string& referenceListName);
+
+  /** Returns the id of referenceListName if it has been assigned one, without assigning it. Use
+   *  this for lookups, so that names that are never inserted do not grow the registry. */
+  static boost::optional<unsigned> findId(const std::string& referenceListName);
+
+  /** Adds referenceListName to the set. Names are case-sensitive, as in Workspace. */
+  void insert(const std::string& referenceListName);
+
+  bool empty() const;
+
+  /** Returns true if this set and other have at least one name in common. */
+  bool intersects(const ReferenceListSet& other) const;
+
+ private:
+  std::vector<std::uint64_t> m_words;
+};
+
+/** Compiled form of the IddFieldProperties used to check IdfObject field data. */
+struct UTILITIES_API IddFieldValidation {
+  IddFieldValidation();
+
+  IddFieldType::domain type;
+  bool required;
+  bool autosizable;
+  bool autocalculatable;
+  bool objectListField; // IddField::isObjectListField
+
+  IddFieldProperties::BoundTypes minBoundType;
+  double minBound;
+  IddFieldProperties::BoundTypes maxBoundType;
+  double maxBound;
+
+  /** Upper-cased key names, for fields of type choice. */
+  std::unordered_set<std::string> keys;
+
+  /** The object lists of this field. */
+  ReferenceListSet objectLists;
+  /** The ids of the object lists of this field, see ReferenceListSet::id, sorted by name as in
+   *  IddObject::objectLists. */
+  std::vector<unsigned> objectListIds;
+  /** The ids of the reference lists this field forwards to its target. */
+  std::vector<unsigned> referenceIds;
+  /** True if objectLists includes the universal 'AllObjects' list. */
+  bool allObjects;
+
+  /** Returns true if value is within the numeric bounds of this field. */
+  bool withinBounds(double value) const;
+
+  /** Returns true if value iequals one of the keys of this field. */
+  bool isKey(const std::string& value) const;
+};
+
+/** Validation program for all the fields of an IddObject. Obtain from IddObject::validation. */
+class UTILITIES_API IddObjectValidation {
+ public:
+  /** Compiles the validation program for an IddObject with the given fields and references. */
+  IddObjectValidation(const std::vector<IddField>& nonextensibleFields,
+                      const std::vector<IddField>& extensibleGroup,
+                      const std::vector<std::string>& references);
+
+  /** Returns the compiled IddField at index, using the same mapping as IddObject::getField, or
+   *  nullptr if there is no such IddField. */
+  const IddFieldValidation* field(unsigned index) const;
+
+  /** The reference lists to which objects following this IddObject belong, as returned by
+   *  IddObject::references. */
+  const ReferenceListSet& references() const;
+
+  /** The ids of references(), see ReferenceListSet::id. */
+  const std::vector<unsigned>& referenceIds() const;
+
+ private:
+  std::vector<IddFieldValidation> m_fields;
+  std::vector<IddFieldValidation> m_extensibleFields;
+  ReferenceListSet m_references;
+  std::vector<unsigned> m_referenceIds;
+};
+
+} // openstudio
+
+#endif // UTILITIES_IDD_IDDOBJECTVALIDATION_HPP
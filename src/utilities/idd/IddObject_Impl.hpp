@@ -40,6 +40,8 @@
 
 #include "IddEnums.hpp"
 
+#include <memory>
+#include <mutex>
 #include <string>
 #include <ostream>
 #include <vector>
@@ -48,6 +50,8 @@ namespace openstudio {
 
 // forward declarations
 class ExtensibleIndex;
+class IddObjectValidation;
+struct IddObjectTable;
 
 namespace detail {
 
@@ -166,6 +170,9 @@ namespace detail {
     /// get the indices of the fields of \type url
     std::vector<unsigned> urlFields() const;
 
+    /// get the validation program for this object's fields, compiling it on first use
+    std::shared_ptr<const IddObjectValidation> validation() const;
+
     /// equality operator
     bool operator==(const IddObject_Impl& other) const;
 
@@ -179,6 +186,10 @@ namespace detail {
                                                   const std::string& text,
                                                   IddObjectType type);
 
+    /** Load from a table written by GenerateIddFactory. */
+    static std::shared_ptr<IddObject_Impl> load(const IddObjectTable& table,
+                                                  IddObjectType type);
+
     // print
     std::ostream& print(std::ostream& os) const;
 
@@ -197,6 +208,10 @@ namespace detail {
     // .first = hasNameField(); .second = nameFieldIndex
     mutable boost::optional< std::pair<bool,unsigned> > m_nameFieldCache;
 
+    // compiled by validation(), reset if the fields change
+    mutable std::shared_ptr<const IddObjectValidation> m_validation;
+    mutable std::mutex m_validationMutex;
+
     // partial constructor used by load
     IddObject_Impl(const std::string& name, const std::string& group, IddObjectType type);
 
@@ -34,15 +34,27 @@
 #include <utilities/idd/IddEnums.hxx>
 #include "../IddFieldProperties.hpp"
 #include "../IddKey.hpp"
+#include "../IddRegex.hpp"
 
 #include "../../units/QuantityConverter.hpp"
 #include "../../units/Quantity.hpp"
 
 #include "../../core/Containers.hpp"
 #include "../../core/Compare.hpp"
+#include "../../core/Filesystem.hpp"
 
 #include <OpenStudio.hxx>
 
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/regex.hpp>
+
+#include <set>
+#include <sstream>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
 using namespace openstudio;
 
 TEST_F(IddFixture,IddFactory_Version_Header) {
@@ -430,3 +442,132 @@ TEST_F(IddFixture,IddFactory_OpenStudio_EnforceNoExternalList) {
     }
   }
 }
+
+namespace {
+
+  struct IddObjectText {
+    std::string name;
+    std::string group;
+    std::string text;
+  };
+
+  // splits an IDD file into object text the way GenerateIddFactory does before it writes the
+  // object tables: the header is skipped, and each object runs from its name line to the next
+  // blank line, with every line trimmed
+  std::vector<IddObjectText> generatorObjectTexts(const path& iddPath) {
+    std::vector<IddObjectText> result;
+    openstudio::filesystem::ifstream iddFile(iddPath);
+    std::string line;
+    while (std::getline(iddFile,line) && !boost::trim_copy(line).empty()) {}
+    std::string group;
+    boost::smatch matches;
+    while (std::getline(iddFile,line)) {
+      boost::trim(line);
+      if (line.empty() || boost::regex_match(line,iddRegex::commentOnlyLine())) {
+        continue;
+      }
+      if (boost::regex_search(line,matches,iddRegex::group())) {
+        group = boost::trim_copy(std::string(matches[1].first,matches[1].second));
+        continue;
+      }
+      if (boost::regex_search(line,iddRegex::includeFile()) || boost::regex_search(line,iddRegex::removeObject())) {
+        continue;
+      }
+      if (!boost::regex_search(line,matches,iddRegex::line())) {
+        continue;
+      }
+      IddObjectText object;
+      object.name = boost::trim_copy(std::string(matches[1].first,matches[1].second));
+      object.group = group;
+      object.text = line + "\n";
+      while (std::getline(iddFile,line)) {
+        boost::trim(line);
+        if (line.empty()) {
+          break;
+        }
+        object.text += line + "\n";
+      }
+      result.push_back(object);
+    }
+    return result;
+  }
+
+}
+
+TEST_F(IddFixture,IddFactory_TablesMatchText) {
+  // the factory loads each object from the pre-split table GenerateIddFactory writes for it, which
+  // must give the same object as loading that object's text
+  std::vector<std::pair<IddFile, path> > files;
+  files.push_back(std::make_pair(epIddFile, resourcesPath()/toPath("energyplus/ProposedEnergy+.idd")));
+  files.push_back(std::make_pair(osIddFile, resourcesPath()/toPath("model/OpenStudio.idd")));
+  for (const auto& file : files) {
+    std::vector<IddObjectText> objectTexts = generatorObjectTexts(file.second);
+    EXPECT_FALSE(objectTexts.empty());
+    for (const IddObjectText& objectText : objectTexts) {
+      OptionalIddObject tableObject = file.first.getObject(objectText.name);
+      ASSERT_TRUE(tableObject) << objectText.name;
+      OptionalIddObject textObject = IddObject::load(objectText.name, objectText.group, objectText.text, tableObject->type());
+      ASSERT_TRUE(textObject) << objectText.name;
+      EXPECT_TRUE(*textObject == *tableObject) << objectText.name;
+      std::stringstream textPrint, tablePrint;
+      textObject->print(textPrint);
+      tableObject->print(tablePrint);
+      EXPECT_EQ(textPrint.str(), tablePrint.str());
+    }
+    // all but CommentOnly come from the file
+    EXPECT_EQ(file.first.objects().size(), objectTexts.size() + 1u);
+  }
+}
+
+namespace {
+
+  // resident set size of this process in kB, 0 if unknown
+  long residentMemory() {
+    long result = 0;
+#if defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    long size(0), resident(0);
+    if (statm >> size >> resident) {
+      result = resident * (sysconf(_SC_PAGESIZE) / 1024);
+    }
+#endif
+    return result;
+  }
+
+}
+
+TEST_F(IddFixture,IddFactory_SharedFieldProperties) {
+  long before = residentMemory();
+  IddObjectVector factoryObjects = IddFactory::instance().getObjects(IddFileType::WholeFactory);
+  long afterFactory = residentMemory();
+  OptionalIddFile epIddFileCopy = IddFile::load(resourcesPath()/toPath("energyplus/ProposedEnergy+.idd"));
+  ASSERT_TRUE(epIddFileCopy);
+  long afterCopy = residentMemory();
+  LOG(Info,"Resident memory: " << before << " kB before accessing the IddFactory, " << afterFactory
+      << " kB after, " << afterCopy << " kB after loading another copy of the EnergyPlus IDD.");
+
+  // identical field properties and keys are stored once, whichever file the field came from
+  std::set<const IddFieldProperties*> properties;
+  unsigned numFields(0);
+  for (const IddObject& object : epIddFileCopy->objects()) {
+    OptionalIddObject factoryObject = IddFactory::instance().getObject(object.name());
+    if (!factoryObject) {
+      continue;
+    }
+    ASSERT_EQ(object.numFields(), factoryObject->numFields());
+    for (unsigned i = 0; i < object.numFields(); ++i) {
+      const IddFieldProperties& fieldProperties = object.getField(i)->properties();
+      const IddFieldProperties& factoryProperties = factoryObject->getField(i)->properties();
+      if ((fieldProperties == factoryProperties) &&
+          (fieldProperties.beginExtensible == factoryProperties.beginExtensible) &&
+          (fieldProperties.minBoundText == factoryProperties.minBoundText) &&
+          (fieldProperties.maxBoundText == factoryProperties.maxBoundText))
+      {
+        EXPECT_EQ(&fieldProperties, &factoryProperties);
+      }
+      properties.insert(&fieldProperties);
+      ++numFields;
+    }
+  }
+  EXPECT_LT(properties.size(), numFields);
+}
@@ -34,9 +34,12 @@
 
 #include "../../core/StringStreamLogSink.hpp"
 #include "../../core/Containers.hpp"
+#include "../../core/Compare.hpp"
 
 #include <OpenStudio.hxx>
 
+#include <boost/algorithm/string/replace.hpp>
+
 using namespace std;
 using namespace boost;
 using namespace openstudio;
@@ -383,3 +386,127 @@ TEST_F(IddFixture, IddFile_EpGroups) {
       << " object groups, including the first, unnamed group: " << std::endl << ss.str());
 }
 
+
+TEST_F(IddFixture, IddFile_LazyLoad) {
+  path iddPath = resourcesPath()/toPath("energyplus/ProposedEnergy+.idd");
+  OptionalIddFile eagerIddFile = IddFile::load(iddPath);
+  ASSERT_TRUE(eagerIddFile);
+  OptionalIddFile lazyIddFile = IddFile::load(iddPath, true);
+  ASSERT_TRUE(lazyIddFile);
+
+  EXPECT_EQ(eagerIddFile->version(), lazyIddFile->version());
+  EXPECT_EQ(eagerIddFile->build(), lazyIddFile->build());
+  EXPECT_EQ(eagerIddFile->header(), lazyIddFile->header());
+  EXPECT_EQ(eagerIddFile->groups(), lazyIddFile->groups());
+
+  // objects requested one at a time are parsed on demand
+  OptionalIddObject zone = lazyIddFile->getObject("zone");
+  ASSERT_TRUE(zone);
+  EXPECT_TRUE(*zone == eagerIddFile->getObject("Zone").get());
+  EXPECT_EQ(IddObjectType::UserCustom, zone->type().value());
+  EXPECT_FALSE(lazyIddFile->getObject("NotAnObject"));
+  EXPECT_FALSE(lazyIddFile->getObject(IddObjectType::Zone));
+  ASSERT_TRUE(lazyIddFile->getObject(IddObjectType::CommentOnly));
+  ASSERT_TRUE(lazyIddFile->versionObject());
+  EXPECT_TRUE(*eagerIddFile->versionObject() == *lazyIddFile->versionObject());
+
+  // the same objects, in the same order
+  IddObjectVector eagerObjects = eagerIddFile->objects();
+  IddObjectVector lazyObjects = lazyIddFile->objects();
+  ASSERT_EQ(eagerObjects.size(), lazyObjects.size());
+  for (unsigned i = 0, n = eagerObjects.size(); i < n; ++i) {
+    EXPECT_TRUE(eagerObjects[i] == lazyObjects[i]) << eagerObjects[i].name();
+  }
+  EXPECT_EQ(eagerIddFile->requiredObjects().size(), lazyIddFile->requiredObjects().size());
+  EXPECT_EQ(eagerIddFile->uniqueObjects().size(), lazyIddFile->uniqueObjects().size());
+
+  std::stringstream eagerText, lazyText;
+  eagerIddFile->print(eagerText);
+  lazyIddFile->print(lazyText);
+  EXPECT_EQ(eagerText.str(), lazyText.str());
+}
+
+TEST_F(IddFixture, IddFile_LazyLoadMalformedObject) {
+  std::string text("!IDD_Version 1.0.0\n"
+                   "\n"
+                   "\\group Test\n"
+                   "\n"
+                   "Good:Object,\n"
+                   "  A1 ; \\field Name\n"
+                   "\n"
+                   "Bad:Object,\n"
+                   "  X1 ; \\field Name\n");
+
+  // an eager load fails on the malformed object
+  std::stringstream eagerText(text);
+  EXPECT_FALSE(IddFile::load(eagerText));
+
+  std::stringstream lazyText(text);
+  OptionalIddFile lazyIddFile = IddFile::load(lazyText, true);
+  ASSERT_TRUE(lazyIddFile);
+
+  // the failure is remembered, it is only parsed and logged once
+  StringStreamLogSink ss;
+  ss.setLogLevel(Error);
+  EXPECT_FALSE(lazyIddFile->getObject("Bad:Object"));
+  std::size_t numMessages = ss.logMessages().size();
+  EXPECT_LT(0u, numMessages);
+  EXPECT_FALSE(lazyIddFile->getObject("Bad:Object"));
+  EXPECT_EQ(numMessages, ss.logMessages().size());
+
+  EXPECT_TRUE(lazyIddFile->getObject("Good:Object"));
+  for (const IddObject& object : lazyIddFile->objects()) {
+    EXPECT_NE("Bad:Object", object.name());
+  }
+  EXPECT_EQ(numMessages, ss.logMessages().size());
+}
+
+TEST_F(IddFixture, IddFile_ParseVersionBuild) {
+  openstudio::path dir = resourcesPath()/toPath("utilities/Idd/ParseVersionBuild");
+  openstudio::filesystem::create_directories(dir);
+
+  std::string padding;
+  for (unsigned i = 0; i < 500; ++i) {
+    padding += "! Comment-only line padding out the header of this file\n";
+  }
+  std::string objects = "\\group Simulation Parameters\n\nVersion,\n  A1 ; \\field Version Identifier\n";
+
+  for (bool windows : {false, true}) {
+    auto write = [&dir, windows](const std::string& name, std::string text) {
+      if (windows) {
+        text = boost::replace_all_copy(text, "\n", "\r\n");
+      }
+      openstudio::path p = dir/toPath(name + (windows ? "_Windows.idd" : ".idd"));
+      openstudio::filesystem::ofstream outFile(p, std::ios_base::binary);
+      outFile << text;
+      return p;
+    };
+
+    openstudio::path p = write("VersionBuild", "!IDD_Version 9.3.0\n!IDD_BUILD baff08990c\n" + objects);
+    std::pair<VersionString, std::string> versionBuild = IddFile::parseVersionBuild(p);
+    EXPECT_EQ(VersionString("9.3.0"), versionBuild.first);
+    EXPECT_EQ("baff08990c", versionBuild.second);
+
+    p = write("VersionOnly", "! Comment-only header\n!IDD_Version 3.0.0\n" + objects);
+    versionBuild = IddFile::parseVersionBuild(p);
+    EXPECT_EQ(VersionString("3.0.0"), versionBuild.first);
+    EXPECT_TRUE(versionBuild.second.empty());
+
+    // not at the start of a line
+    p = write("NotAtLineStart", "! !IDD_Version 9.3.0\n" + objects);
+    EXPECT_ANY_THROW(IddFile::parseVersionBuild(p));
+
+    // header lines past the prefix that is scanned first
+    p = write("VersionPastPrefix", padding + "!IDD_Version 9.2.0\n!IDD_BUILD 7c3bbe4830\n" + objects);
+    versionBuild = IddFile::parseVersionBuild(p);
+    EXPECT_EQ(VersionString("9.2.0"), versionBuild.first);
+    EXPECT_EQ("7c3bbe4830", versionBuild.second);
+  }
+
+  // the real thing
+  std::pair<VersionString, std::string> versionBuild = IddFile::parseVersionBuild(resourcesPath()/toPath("energyplus/ProposedEnergy+.idd"));
+  EXPECT_EQ(VersionString(IddFactory::instance().getVersion(IddFileType::EnergyPlus)), versionBuild.first);
+  EXPECT_FALSE(versionBuild.second.empty());
+
+  EXPECT_ANY_THROW(IddFile::parseVersionBuild(dir/toPath("DoesNotExist.idd")));
+}
@@ -30,6 +30,7 @@
 #include <gtest/gtest.h>
 #include "IddFixture.hpp"
 #include "../IddObject.hpp"
+#include "../IddObjectTable.hpp"
 #include <utilities/idd/IddFactory.hxx>
 #include "../IddEnums.hpp"
 #include <utilities/idd/IddEnums.hxx>
@@ -80,6 +81,54 @@ TEST_F(IddFixture,IddObject_EqualityOperators) {
   EXPECT_TRUE(*object1 != *object2);
 }
 
+TEST_F(IddFixture,IddObject_LoadFromTable) {
+  std::stringstream text;
+  text << "Test:Object," << std::endl
+       << "  \\memo A test object." << std::endl
+       << "  \\extensible:2" << std::endl
+       << "  A1, \\field Name" << std::endl
+       << "  \\required-field" << std::endl
+       << "  \\type alpha" << std::endl
+       << "  N1, \\field Multiplier" << std::endl
+       << "  \\default 1.0" << std::endl
+       << "  \\minimum> 0" << std::endl
+       << "  A2, \\field Key 1" << std::endl
+       << "  \\begin-extensible" << std::endl
+       << "  \\type choice" << std::endl
+       << "  \\key Yes" << std::endl
+       << "  \\key No" << std::endl
+       << "  N2; \\field Value 1" << std::endl;
+
+  static const char* const objectProperties[] = {"memo A test object.", "extensible:2"};
+  static const char* const field0Properties[] = {"field Name", "required-field", "type alpha"};
+  static const char* const field1Properties[] = {"field Multiplier", "default 1.0", "minimum> 0"};
+  static const char* const field2Properties[] = {"field Key 1", "begin-extensible", "type choice", "key Yes", "key No"};
+  static const char* const field3Properties[] = {"field Value 1"};
+  static const IddFieldTable fields[] = {
+    {"A1", "Name", field0Properties, 3},
+    {"N1", "Multiplier", field1Properties, 3},
+    {"A2", "Key 1", field2Properties, 5},
+    {"N2", "Value 1", field3Properties, 1},
+  };
+  static const IddObjectTable table = {"Test:Object", "Tests", objectProperties, 2, fields, 4};
+
+  OptionalIddObject fromText = IddObject::load("Test:Object", "Tests", text.str());
+  ASSERT_TRUE(fromText);
+  OptionalIddObject fromTable = IddObject::load(table, IddObjectType(IddObjectType::UserCustom));
+  ASSERT_TRUE(fromTable);
+  EXPECT_TRUE(*fromText == *fromTable);
+  EXPECT_EQ("Tests", fromTable->group());
+  EXPECT_EQ(2u, fromTable->nonextensibleFields().size());
+  ASSERT_EQ(2u, fromTable->extensibleGroup().size());
+  EXPECT_EQ("Key", fromTable->extensibleGroup()[0].name());
+  EXPECT_FALSE(fromTable->nonextensibleFields()[1].properties().required);
+
+  // field ids must start with A or N
+  static const IddFieldTable badFields[] = {{"X1", "Name", nullptr, 0}};
+  static const IddObjectTable badTable = {"Test:Object", "Tests", nullptr, 0, badFields, 1};
+  EXPECT_FALSE(IddObject::load(badTable, IddObjectType(IddObjectType::UserCustom)));
+}
+
 TEST_F(IddFixture,IddObject_ExtensibleIndex) {
   OptionalIddObject oio = IddFactory::instance().getObject(IddObjectType::BuildingSurface_Detailed);
   ASSERT_TRUE(oio);
@@ -0,0 +1,321 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2020, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef UTILITIES_IDF_FLATHANDLEMAP_HPP
+#define UTILITIES_IDF_FLATHANDLEMAP_HPP
+
+#include "Handle.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace openstudio {
+namespace detail {
+
+  /** Open-addressing (linear probing) hash map keyed on Handle. Entries live in one contiguous
+   *  array, so lookups and iteration touch far less memory than a node-based std::unordered_map.
+   *  The interface is the subset of std::unordered_map used by Workspace_Impl, with these
+   *  differences: value_type is std::pair<Handle,T> (do not modify the key through an iterator),
+   *  and any insertion may invalidate iterators, pointers and references. Erasing leaves a
+   *  tombstone, so erase does not invalidate other iterators. */
+  template <class T>
+  class FlatHandleMap {
+   public:
+    typedef Handle key_type;
+    typedef T mapped_type;
+    typedef std::pair<Handle,T> value_type;
+    typedef std::size_t size_type;
+
+   private:
+    enum SlotState : unsigned char { Empty = 0, Full = 1, Erased = 2 };
+
+    template <bool Const>
+    class Iterator {
+     public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef typename FlatHandleMap::value_type value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef typename std::conditional<Const, const value_type*, value_type*>::type pointer;
+      typedef typename std::conditional<Const, const value_type&, value_type&>::type reference;
+
+      Iterator() : m_slot(nullptr), m_state(nullptr), m_stateEnd(nullptr) {}
+
+      /** Conversion from iterator to const_iterator. */
+      template <bool OtherConst, class = typename std::enable_if<Const && !OtherConst>::type>
+      Iterator(const Iterator<OtherConst>& other)
+        : m_slot(other.m_slot), m_state(other.m_state), m_stateEnd(other.m_stateEnd) {}
+
+      reference operator*() const { return *m_slot; }
+      pointer operator->() const { return m_slot; }
+
+      Iterator& operator++() {
+        ++m_slot; ++m_state;
+        skipToFull();
+        return *this;
+      }
+
+      Iterator operator++(int) {
+        Iterator result(*this);
+        ++(*this);
+        return result;
+      }
+
+      friend bool operator==(const Iterator& lhs, const Iterator& rhs) { return lhs.m_state == rhs.m_state; }
+      friend bool operator!=(const Iterator& lhs, const Iterator& rhs) { return lhs.m_state != rhs.m_state; }
+
+     private:
+      friend class FlatHandleMap;
+      template <bool> friend class Iterator;
+
+      Iterator(pointer slot, const unsigned char* state, const unsigned char* stateEnd)
+        : m_slot(slot), m_state(state), m_stateEnd(stateEnd) {}
+
+      void skipToFull() {
+        while ((m_state != m_stateEnd) && (*m_state != Full)) { ++m_slot; ++m_state; }
+      }
+
+      pointer m_slot;
+      const unsigned char* m_state;
+      const unsigned char* m_stateEnd;
+    };
+
+   public:
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+
+    FlatHandleMap() : m_size(0), m_erased(0) {}
+
+    /** @name Iteration */
+    //@{
+
+    iterator begin() {
+      iterator result(m_slots.data(), m_states.data(), m_states.data() + m_states.size());
+      result.skipToFull();
+      return result;
+    }
+
+    iterator end() {
+      return iterator(m_slots.data() + m_slots.size(), m_states.data() + m_states.size(), m_states.data() + m_states.size());
+    }
+
+    const_iterator begin() const {
+      const_iterator result(m_slots.data(), m_states.data(), m_states.data() + m_states.size());
+      result.skipToFull();
+      return result;
+    }
+
+    const_iterator end() const {
+      return const_iterator(m_slots.data() + m_slots.size(), m_states.data() + m_states.size(), m_states.data() + m_states.size());
+    }
+
+    //@}
+    /** @name Lookup */
+    //@{
+
+    bool empty() const { return (m_size == 0); }
+
+    size_type size() const { return m_size; }
+
+    /** Number of slots allocated. */
+    size_type capacity() const { return m_slots.size(); }
+
+    /** Bytes allocated for slots and slot states. Does not include memory owned by T. */
+    size_type memoryUsage() const {
+      return m_slots.capacity() * sizeof(value_type) + m_states.capacity();
+    }
+
+    iterator find(const Handle& key) {
+      size_type index = findIndex(key);
+      if (index == npos()) { return end(); }
+      return iterator(m_slots.data() + index, m_states.data() + index, m_states.data() + m_states.size());
+    }
+
+    const_iterator find(const Handle& key) const {
+      size_type index = findIndex(key);
+      if (index == npos()) { return end(); }
+      return const_iterator(m_slots.data() + index, m_states.data() + index, m_states.data() + m_states.size());
+    }
+
+    size_type count(const Handle& key) const {
+      return (findIndex(key) == npos()) ? 0 : 1;
+    }
+
+    //@}
+    /** @name Modification */
+    //@{
+
+    std::pair<iterator,bool> insert(const value_type& value) {
+      std::pair<size_type,bool> result = insertIndex(value.first);
+      if (result.second) {
+        m_slots[result.first].second = value.second;
+      }
+      return std::make_pair(iterator(m_slots.data() + result.first, m_states.data() + result.first, m_states.data() + m_states.size()),
+                            result.second);
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+      for (; first != last; ++first) {
+        insert(*first);
+      }
+    }
+
+    T& operator[](const Handle& key) {
+      return m_slots[insertIndex(key).first].second;
+    }
+
+    /** Erases the entry at position, returning an iterator to the next entry. */
+    iterator erase(const_iterator position) {
+      size_type index = position.m_state - m_states.data();
+      eraseIndex(index);
+      iterator result(m_slots.data() + index, m_states.data() + index, m_states.data() + m_states.size());
+      result.skipToFull();
+      return result;
+    }
+
+    size_type erase(const Handle& key) {
+      size_type index = findIndex(key);
+      if (index == npos()) { return 0; }
+      eraseIndex(index);
+      return 1;
+    }
+
+    void clear() {
+      m_slots.clear();
+      m_states.clear();
+      m_size = 0;
+      m_erased = 0;
+    }
+
+    /** Allocates enough slots to hold n entries without rehashing. */
+    void reserve(size_type n) {
+      size_type capacity = minCapacity();
+      while (!fits(n, capacity)) { capacity *= 2; }
+      if (capacity > m_slots.size()) {
+        rehash(capacity);
+      }
+    }
+
+    void swap(FlatHandleMap& other) {
+      m_slots.swap(other.m_slots);
+      m_states.swap(other.m_states);
+      std::swap(m_size, other.m_size);
+      std::swap(m_erased, other.m_erased);
+    }
+
+    //@}
+   private:
+    static size_type npos() { return static_cast<size_type>(-1); }
+
+    static size_type minCapacity() { return 2; }
+
+    // keep the load factor, counting tombstones, at or below 3/4
+    static bool fits(size_type n, size_type capacity) { return 4 * n <= 3 * capacity; }
+
+    // handles are (almost always) random version 4 UUIDs, so a cheap mix of their bytes is enough
+    static size_type hash(const Handle& key) {
+      std::uint64_t lo, hi;
+      std::memcpy(&lo, key.data, sizeof(lo));
+      std::memcpy(&hi, key.data + sizeof(lo), sizeof(hi));
+      std::uint64_t h = lo ^ (hi * 0x9E3779B97F4A7C15ull);
+      return static_cast<size_type>(h ^ (h >> 32));
+    }
+
+    size_type findIndex(const Handle& key) const {
+      if (m_slots.empty()) { return npos(); }
+      size_type mask = m_slots.size() - 1;
+      for (size_type index = hash(key) & mask; ; index = (index + 1) & mask) {
+        if (m_states[index] == Empty) { return npos(); }
+        if ((m_states[index] == Full) && (m_slots[index].first == key)) { return index; }
+      }
+    }
+
+    // returns the slot holding key, and true if key was newly inserted (with a default T)
+    std::pair<size_type,bool> insertIndex(const Handle& key) {
+      size_type index = findIndex(key);
+      if (index != npos()) { return std::make_pair(index, false); }
+      if (!fits(m_size + m_erased + 1, m_slots.size())) {
+        size_type capacity = std::max(m_slots.size(), minCapacity());
+        // grow, unless the slots are mostly tombstones, in which case clean up in place
+        if (!m_slots.empty() && !fits(2 * (m_size + 1), capacity)) { capacity *= 2; }
+        while (!fits(m_size + 1, capacity)) { capacity *= 2; }
+        rehash(capacity);
+      }
+      size_type mask = m_slots.size() - 1;
+      index = hash(key) & mask;
+      while (m_states[index] == Full) { index = (index + 1) & mask; }
+      if (m_states[index] == Erased) { --m_erased; }
+      m_states[index] = Full;
+      m_slots[index].first = key;
+      ++m_size;
+      return std::make_pair(index, true);
+    }
+
+    void eraseIndex(size_type index) {
+      m_states[index] = Erased;
+      m_slots[index] = value_type();
+      --m_size;
+      ++m_erased;
+      if (m_size == 0) {
+        std::fill(m_states.begin(), m_states.end(), static_cast<unsigned char>(Empty));
+        m_erased = 0;
+      }
+    }
+
+    void rehash(size_type capacity) {
+      std::vector<value_type> slots(capacity);
+      std::vector<unsigned char> states(capacity, static_cast<unsigned char>(Empty));
+      size_type mask = capacity - 1;
+      for (size_type i = 0, n = m_slots.size(); i < n; ++i) {
+        if (m_states[i] != Full) { continue; }
+        size_type index = hash(m_slots[i].first) & mask;
+        while (states[index] == Full) { index = (index + 1) & mask; }
+        states[index] = Full;
+        slots[index] = std::move(m_slots[i]);
+      }
+      m_slots.swap(slots);
+      m_states.swap(states);
+      m_erased = 0;
+    }
+
+    std::vector<value_type> m_slots;
+    std::vector<unsigned char> m_states;
+    size_type m_size;
+    size_type m_erased;
+  };
+
+} // detail
+} // openstudio
+
+#endif // UTILITIES_IDF_FLATHANDLEMAP_HPP
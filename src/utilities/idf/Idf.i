@@ -18,6 +18,7 @@
   #include <utilities/idf/WorkspaceObjectOrder.hpp>
   #include <utilities/idf/WorkspaceObjectWatcher.hpp>
   #include <utilities/idf/ValidityEnums.hpp>
+  #include <utilities/idf/IdfObjectDiff.hpp>
   #include <utilities/idf/ValidityReport.hpp>
   #include <utilities/idf/DataError.hpp>
 
@@ -91,6 +92,13 @@
 %ignore openstudio::IdfFile::load(std::istream&, IddFileType);
 %ignore openstudio::IdfFile::load(std::istream&, const IddFile&);
 
+// appending to a std::string buffer is for C++ serialization only
+%ignore openstudio::IdfObject::print(std::string&) const;
+
+// views into field storage are for C++ comparisons only
+%ignore openstudio::IdfObject::getStringView;
+%ignore openstudio::IdfObject::nameStringView;
+
 #if defined(SWIGRUBY)
   // add mixins
   %mixin openstudio::IdfObject "Comparable, Marshal";
@@ -109,12 +117,17 @@
   %typemap(csclassmodifiers) openstudio::IdfExtensibleGroup "public partial class"
 #endif
 
+// visitor interface is for C++ aggregation only
+%ignore openstudio::Workspace::forEachObjectOfType;
+
 #if defined(SWIGJAVA)
   %ignore openstudio::Workspace::load;
 #endif
 
 %include <utilities/idf/Handle.hpp>
 %include <utilities/idf/ValidityEnums.hpp>
+%ignore openstudio::IdfObjectDiff;
+%include <utilities/idf/IdfObjectDiff.hpp>
 %include <utilities/idf/DataError.hpp>
 %include <utilities/idf/ValidityReport.hpp>
 %include <utilities/idf/IdfObject.hpp>
@@ -30,6 +30,7 @@
 #include "IdfFile.hpp"
 #include <utilities/idf/IdfObject_Impl.hpp> // needed for serialization
 #include "IdfRegex.hpp"
+#include "IdfTokenizer.hpp"
 #include "ValidityReport.hpp"
 
 #include "../idd/IddRegex.hpp"
@@ -40,12 +41,15 @@
 
 #include "../plot/ProgressBar.hpp"
 #include "../core/PathHelpers.hpp"
+#include "../core/FilesystemHelpers.hpp"
 #include "../core/Assert.hpp"
 
 
 
-#include <boost/iostreams/filter/newline.hpp>
-#include <boost/iostreams/filtering_stream.hpp>
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <thread>
 
 
 namespace openstudio {
@@ -324,14 +328,15 @@ ValidityReport IdfFile::validityReport(StrictnessLevel level) const {
 
 boost::optional<IdfFile> IdfFile::load(std::istream& is,
                                        const IddFileType& iddFileType,
-                                       ProgressBar* progressBar)
+                                       ProgressBar* progressBar,
+                                       unsigned numThreads)
 {
   IdfFile result(iddFileType);
   // remove initial version object
   if (OptionalIdfObject vo = result.versionObject()) {
     result.removeObject(*vo);
   }
-  if (result.m_load(is, progressBar)) {
+  if (result.m_load(is, progressBar, false, numThreads)) {
     // check for it again here
     result.addVersionObject();
     return result;
@@ -341,14 +346,15 @@ boost::optional<IdfFile> IdfFile::load(std::istream& is,
 
 OptionalIdfFile IdfFile::load(std::istream& is,
                               const IddFile& iddFile,
-                              ProgressBar* progressBar)
+                              ProgressBar* progressBar,
+                              unsigned numThreads)
 {
   IdfFile result(iddFile);
   // remove initial version object
   if (OptionalIdfObject vo = result.versionObject()) {
     result.removeObject(*vo);
   }
-  if (result.m_load(is, progressBar)) {
+  if (result.m_load(is, progressBar, false, numThreads)) {
     // check for it again here
     result.addVersionObject();
     return result;
@@ -356,7 +362,7 @@ OptionalIdfFile IdfFile::load(std::istream& is,
   return boost::none;
 }
 
-OptionalIdfFile IdfFile::load(const path& p, ProgressBar* progressBar) {
+OptionalIdfFile IdfFile::load(const path& p, ProgressBar* progressBar, unsigned numThreads) {
   // determine IddFileType
   IddFileType iddType(IddFileType::EnergyPlus); // default
 
@@ -370,12 +376,13 @@ OptionalIdfFile IdfFile::load(const path& p, ProgressBar* progressBar) {
     iddType = IddFileType(IddFileType::OpenStudio);
   }
 
-  return load(p, iddType, progressBar);
+  return load(p, iddType, progressBar, numThreads);
 }
 
 OptionalIdfFile IdfFile::load(const path& p,
                               const IddFileType& iddFileType,
-                              ProgressBar* progressBar)
+                              ProgressBar* progressBar,
+                              unsigned numThreads)
 {
   // complete path
   path wp(p);
@@ -405,7 +412,7 @@ OptionalIdfFile IdfFile::load(const path& p,
   openstudio::filesystem::ifstream inFile(wp);
   if (inFile) {
     try {
-      return load(inFile, iddFileType, progressBar);
+      return load(inFile, iddFileType, progressBar, numThreads);
     }
     catch (...) { return boost::none; }
   }
@@ -413,7 +420,7 @@ OptionalIdfFile IdfFile::load(const path& p,
   return boost::none;
 }
 
-OptionalIdfFile IdfFile::load(const path& p, const IddFile& iddFile, ProgressBar* progressBar) {
+OptionalIdfFile IdfFile::load(const path& p, const IddFile& iddFile, ProgressBar* progressBar, unsigned numThreads) {
   // complete path
   path wp = completePathToFile(p,path(),"idf",false);
 
@@ -421,7 +428,7 @@ OptionalIdfFile IdfFile::load(const path& p, const IddFile& iddFile, ProgressBar
   openstudio::filesystem::ifstream inFile(wp);
   if (inFile) {
     try {
-      return load(inFile, iddFile, progressBar);
+      return load(inFile, iddFile, progressBar, numThreads);
     }
     catch (...) { return boost::none; }
   }
@@ -454,9 +461,79 @@ boost::optional<VersionString> IdfFile::loadVersionOnly(std::istream& is) {
   return result;
 }
 
+namespace {
+
+  // number of bytes at the start of a file that loadVersionOnly scans before falling back to a
+  // full parse. Version objects are written at or near the top of the file.
+  const std::size_t versionSniffLength = 64 * 1024;
+
+  // Looks for the version object in text the same way IdfFile::loadVersionOnly(std::istream&)
+  // does, without constructing any IdfObjects. If complete is false, text is only the start of
+  // the file. Returns false if the version cannot be decided from text alone.
+  bool sniffVersion(std::string_view text, bool complete, boost::optional<VersionString>& result) {
+    std::string normalized;
+    if (text.find('\r') != std::string_view::npos) {
+      normalized.assign(text.data(), text.size());
+      IdfTokenizer::normalizeNewlines(normalized);
+      text = normalized;
+    }
+    if (!complete) {
+      // drop the last, possibly partial, line
+      std::string_view::size_type lastNewline = text.rfind('\n');
+      if (lastNewline == std::string_view::npos) {
+        return false;
+      }
+      text = text.substr(0, lastNewline + 1);
+    }
+
+    IdfTokenizer tokenizer(text);
+    IdfTokenizer::Block block;
+    IdfObjectTokens tokens;
+    while (tokenizer.next(block)) {
+      if ((block.type != IdfTokenizer::ObjectBlock) || !IdfTokenizer::isVersionObjectType(block.objectType)) {
+        continue;
+      }
+      if (!block.terminated) {
+        // the object runs past the end of text
+        return complete;
+      }
+      if (!IdfTokenizer::tokenizeObject(block.text, tokens) || tokens.fields.empty()) {
+        // leave anything unusual to the full parse
+        return false;
+      }
+      // the version identifier is the last field, or the penultimate one when OS:Version has
+      // a prerelease tag
+      std::string::size_type index = tokens.fields.size() - 1;
+      if (tokens.fields.size() == 3u) {
+        --index;
+      }
+      if (!tokens.fields[index].empty()) {
+        result = VersionString(std::string(tokens.fields[index]));
+      }
+      return true;
+    }
+
+    // a later block, past the end of text, may still hold the version object
+    return complete;
+  }
+
+}
+
 boost::optional<VersionString> IdfFile::loadVersionOnly(const path& p) {
   boost::optional<VersionString> result;
   path wp = completePathToFile(p,path(),"idf",false);
+
+  // sniff the start of the file first, fall back on a full parse if that is inconclusive
+  try {
+    openstudio::filesystem::mapped_file_prefix mapped(wp, versionSniffLength);
+    if (mapped.is_open() && sniffVersion(mapped.data(), mapped.complete(), result)) {
+      return result;
+    }
+  }
+  catch (...) {
+    return boost::none;
+  }
+
   openstudio::filesystem::ifstream inFile(wp);
   if (inFile) {
     try {
@@ -470,13 +547,25 @@ boost::optional<VersionString> IdfFile::loadVersionOnly(const path& p) {
 }
 
 std::ostream& IdfFile::print(std::ostream& os) const {
+  // serialize into one contiguous buffer, sized for typical field and comment widths, and
+  // hand that to os in a single write
+  std::string::size_type size = m_header.size() + 2;
+  for (const IdfObject& object : m_objects){
+    size += 64 + 80 * object.numFields();
+  }
+  std::string buffer;
+  buffer.reserve(size);
+
   if (!m_header.empty()) {
-    os << m_header << std::endl;
+    buffer += m_header;
+    buffer += '\n';
   }
-  os << std::endl;
+  buffer += '\n';
   for (const IdfObject& object : m_objects){
-    object.print(os);
+    object.print(buffer);
   }
+
+  os.write(buffer.data(), buffer.size());
   return os;
 }
 
@@ -544,175 +633,192 @@ bool IdfFile::save(const openstudio::path& p, bool overwrite) {
 
 // SERIALIZATION
 
-bool IdfFile::m_load(std::istream& is, ProgressBar* progressBar, bool versionOnly) {
+bool IdfFile::m_load(std::istream& is, ProgressBar* progressBar, bool versionOnly, unsigned numThreads) {
 
-  int lineNum = 0;        // Idf line number
   int objectNum = 0;      // number of objects, first is #1
-  std::string line;       // temp string to help with reading
-  boost::smatch matches;  // matches to regular expressions
-  std::string comment;    // keep running comment
   bool firstBlock = true; // to capture first comment block as the header
 
-  if (progressBar){
-    is.seekg(0, std::ios_base::end);
-    int streamsize = static_cast<int>(is.tellg());
-    progressBar->setMinimum(0);
-    progressBar->setMaximum(streamsize);
-    is.seekg(0, std::ios_base::beg);
+  // read the whole stream into one buffer so it can be scanned in a single pass
+  std::string buffer;
+  std::istream::pos_type begin = is.tellg();
+  if ((begin != std::istream::pos_type(-1)) && is.seekg(0, std::ios_base::end)) {
+    std::istream::pos_type end = is.tellg();
+    is.seekg(begin);
+    if (end > begin) {
+      buffer.resize(static_cast<std::string::size_type>(end - begin));
+      is.read(&buffer[0], static_cast<std::streamsize>(buffer.size()));
+      buffer.resize(static_cast<std::string::size_type>(is.gcount()));
+    }
+  }
+  else {
+    is.clear();
+    std::stringstream ss;
+    ss << is.rdbuf();
+    buffer = ss.str();
   }
 
+  // make sure that no matter what line endings come in, they are converted to '\n'
+  IdfTokenizer::normalizeNewlines(buffer);
 
-  // Use a boost filter to make sure that no matter what line endings come in,
-  // they are converted to what is expected by the current os
-  boost::iostreams::filtering_istream filt;
-
-//#ifdef _POSIX_VERSION
-  filt.push(boost::iostreams::newline_filter(boost::iostreams::newline::posix));
-//#else
-//  filt.push(boost::iostreams::newline_filter(boost::iostreams::newline::dos));
-//#endif
-  filt.push(is);
-
-  // read the file line by line using regexes
-  while(std::getline(filt, line)){
+  if (progressBar){
+    progressBar->setMinimum(0);
+    progressBar->setMaximum(static_cast<int>(buffer.size()));
+  }
 
-    if (line == "\r")
-    {
-      // This is not a real line at all, just the vestiges from the
-      // previous windows formatted line being parsed on unix, skip it,
-      // don't even count it
-      continue;
-    }
+  // objects in file order, found in a first serial pass and then constructed, possibly in
+  // parallel, before being added to this file in that same order
+  struct PendingObject {
+    std::string_view text;
+    IddObject iddObject;
+    std::shared_ptr<detail::IdfObject_Impl> impl;
+  };
+  std::vector<PendingObject> pending;
 
-    ++lineNum;
+  IdfTokenizer tokenizer(buffer);
+  IdfTokenizer::Block block;
+  IdfObjectTokens tokens;
+  while (tokenizer.next(block)) {
 
     if (progressBar){
-      int current = static_cast<int>(is.tellg());
-      progressBar->setValue(current);
+      progressBar->setValue(static_cast<int>(block.position));
     }
 
-    if (boost::regex_match(line, idfRegex::commentOnlyLine())){
-      // continue comment
-      comment += (line + idfRegex::newLinestring());
-    }
-    else if (boost::regex_match(line, commentRegex::whitespaceOnlyLine())){
-      // end comment
+    if (block.type == IdfTokenizer::CommentBlock) {
+      std::string comment(block.text);
       boost::trim(comment);
 
-      if (!comment.empty()) {
-        if (firstBlock) {
-          // set this comment as the header
-          setHeader(comment);
-          firstBlock = false;
-        }
-        else {
-          if (!versionOnly) {
-
-            // make a comment only object to hold the comment
-            OptionalIddObject commentOnlyIddObject = m_iddFileAndFactoryWrapper.getObject(IddObjectType::CommentOnly);
-            if (!commentOnlyIddObject) {
-              LOG(Error,"IddFile does not contain a CommentOnly object. Will not be able to save comment objects.");
-              continue;
-            }
-
-            OptionalIdfObject commentOnlyObject;
-            commentOnlyObject = IdfObject::load(commentOnlyIddObject->name() + ";" + comment,
-                                                *commentOnlyIddObject);
-            OS_ASSERT(commentOnlyObject);
-
-            // put it in the object list
-            addObject(*commentOnlyObject);
-          }
-        }
+      if (firstBlock) {
+        // set this comment as the header
+        setHeader(comment);
+        firstBlock = false;
       }
+      else if (!versionOnly) {
 
-      //clear out comment
-      comment = "";
+        // make a comment only object to hold the comment
+        OptionalIddObject commentOnlyIddObject = m_iddFileAndFactoryWrapper.getObject(IddObjectType::CommentOnly);
+        if (!commentOnlyIddObject) {
+          LOG(Error,"IddFile does not contain a CommentOnly object. Will not be able to save comment objects.");
+          continue;
+        }
 
-    }
-    else{
+        std::string text(commentOnlyIddObject->name() + ";" + comment);
+        bool ok = IdfTokenizer::tokenizeObject(text, tokens);
+        OS_ASSERT(ok);
+        std::shared_ptr<detail::IdfObject_Impl> commentOnlyImpl = detail::IdfObject_Impl::load(tokens, *commentOnlyIddObject);
+        OS_ASSERT(commentOnlyImpl);
 
-      bool foundEndLine(false);
-      firstBlock = false;
-      bool isVersion = false;
+        // the comment text is not in buffer, so construct it now
+        pending.push_back(PendingObject{block.text, *commentOnlyIddObject, commentOnlyImpl});
+      }
+      continue;
+    }
 
-      // peek at the object type and name for indexing in map
-      std::string objectType;
+    firstBlock = false;
+    bool isVersion = false;
 
-      if (boost::regex_search(line, matches, idfRegex::line())){
-        objectType = std::string(matches[1].first, matches[1].second); boost::trim(objectType);
-      }else{
-        // can't figure out the object's type
-        if (!versionOnly) {
-          LOG(Warn, "Unrecognizable object type '" + line + "'. Defaulting to 'Catchall'.");
-        }
-        objectType = "Catchall";
+    // peek at the object type for indexing in map
+    std::string objectType(block.objectType);
+    if (objectType.empty()) {
+      // can't figure out the object's type
+      if (!versionOnly) {
+        LOG(Warn, "Unrecognizable object type '" << block.text << "'. Defaulting to 'Catchall'.");
       }
-      if (boost::regex_match(objectType,iddRegex::versionObjectName())) {
-        isVersion = true;
-      }
-
-      // get the corresponding idd object entry
+      objectType = "Catchall";
+    }
+    if (IdfTokenizer::isVersionObjectType(objectType)) {
+      isVersion = true;
+    }
 
-      OptionalIddObject iddObject = m_iddFileAndFactoryWrapper.getObject(objectType);
-      if (!iddObject){
-        if (!versionOnly) {
-          LOG(Warn, "Cannot find object type '" + objectType + "' in Idd. Placing data in Catchall object.");
-        }
-        iddObject = IddObject();
-        objectType = "Catchall";
+    // get the corresponding idd object entry
+    OptionalIddObject iddObject = m_iddFileAndFactoryWrapper.getObject(objectType);
+    if (!iddObject){
+      if (!versionOnly) {
+        LOG(Warn, "Cannot find object type '" + objectType + "' in Idd. Placing data in Catchall object.");
       }
-      else { OS_ASSERT(iddObject->type() != IddObjectType::Catchall); }
+      iddObject = IddObject();
+      objectType = "Catchall";
+    }
+    else { OS_ASSERT(iddObject->type() != IddObjectType::Catchall); }
 
-      // put the text for this object in a new string with a newline
-      std::string text(comment + idfRegex::newLinestring() + line + idfRegex::newLinestring());
-      comment = "";
+    // unterminated text at the end of the stream is thrown away
+    if (!block.terminated) {
+      continue;
+    }
 
-        // check if this line also matches closing line object
-      if (boost::regex_match(line, idfRegex::objectEnd())){
-        foundEndLine = true;
+    if (!versionOnly) {
+      pending.push_back(PendingObject{block.text, *iddObject, nullptr});
+    }
+    else if (isVersion) {
+      std::shared_ptr<detail::IdfObject_Impl> impl;
+      if (IdfTokenizer::tokenizeObject(block.text, tokens)) {
+        impl = detail::IdfObject_Impl::load(tokens, *iddObject);
+      }
+      if (!impl) {
+        LOG(Error,"Unable to construct IdfObject from text: " << std::endl << block.text
+            << std::endl << "Throwing this object out and parsing the remainder of the file.");
+        continue;
       }
+      if (impl->iddObject().type() != IddObjectType::Catchall) {
+        ++objectNum;
+      }
+      addObject(IdfObject(impl));
 
-      // continue reading until we have seen the entire object
-      // last line will be thrown away, requires empty line between objects in Idf
-      while((!foundEndLine) && (std::getline(filt, line))){
-        ++lineNum;
+      // Increment objectNum to avoid triggering the warning below and return false
+      ++objectNum;
+      break;
+    }
 
-        // add line to text, include newline separator
-        text += (line + idfRegex::newLinestring());
+  }
 
-        // check if we have found the last field
-        if (boost::regex_match(line, idfRegex::objectEnd())){
-            foundEndLine = true;
+  // construct the objects, each one independently of the others
+  auto construct = [&pending](std::atomic<std::size_t>& next, std::size_t batchSize) {
+    IdfObjectTokens threadTokens;
+    for (std::size_t begin = next.fetch_add(batchSize); begin < pending.size(); begin = next.fetch_add(batchSize)) {
+      for (std::size_t i = begin, n = std::min(begin + batchSize, pending.size()); i < n; ++i) {
+        PendingObject& object = pending[i];
+        if (!object.impl && IdfTokenizer::tokenizeObject(object.text, threadTokens)) {
+          object.impl = detail::IdfObject_Impl::load(threadTokens, object.iddObject);
         }
       }
+    }
+  };
 
-      // construct the object
-      if (foundEndLine && (!versionOnly || isVersion)) {
-        OptionalIdfObject object = IdfObject::load(text,*iddObject);
-        if (!object) {
-          LOG(Error,"Unable to construct IdfObject from text: " << std::endl << text
-              << std::endl << "Throwing this object out and parsing the remainder of the file.");
-          continue;
-        } else {
-          // a valid Idf object to parse
-          if (object->iddObject().type() != IddObjectType::Catchall) {
-            ++objectNum;
-          }
-
-          // put it in the object list
-          addObject(*object);
-        }
+  // objects are handed out in batches, and small files are not worth starting threads for
+  const std::size_t batchSize = 256;
+  if (numThreads == 0) {
+    numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  numThreads = static_cast<unsigned>(std::min<std::size_t>(numThreads, (pending.size() + batchSize - 1) / batchSize));
 
-      }
+  std::atomic<std::size_t> next(0);
+  if (numThreads > 1) {
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < numThreads; ++i) {
+      threads.emplace_back(construct, std::ref(next), batchSize);
+    }
+    construct(next, batchSize);
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+  else {
+    construct(next, batchSize);
+  }
 
-      if (versionOnly && isVersion) {
-        // Increment objectNum to avoid triggering the warning below and return false
-        ++objectNum;
-        break;
-      }
+  // put the objects in the object list in file order
+  for (const PendingObject& object : pending) {
+    if (!object.impl) {
+      LOG(Error,"Unable to construct IdfObject from text: " << std::endl << object.text
+          << std::endl << "Throwing this object out and parsing the remainder of the file.");
+      continue;
+    }
 
+    // a valid Idf object to parse
+    if (object.impl->iddObject().type() != IddObjectType::Catchall) {
+      ++objectNum;
     }
+
+    addObject(IdfObject(object.impl));
   }
 
   // If we sucessfully parsed at least one object, we return true, otherwise false
@@ -174,40 +174,48 @@ class UTILITIES_API IdfFile {
   //@{
 
   /** Load an IdfFile from std::istream using the IDD defined by IddFactory and iddFileType, if
-   *  possible. */
+   *  possible. Objects are constructed on numThreads threads, or on one thread per hardware core
+   *  if numThreads is 0. The result does not depend on numThreads. */
   static boost::optional<IdfFile> load(std::istream& is,
                                        const IddFileType& iddFileType,
-                                       ProgressBar* progressBar=nullptr);
+                                       ProgressBar* progressBar=nullptr,
+                                       unsigned numThreads=1);
 
-  /** Load an IdfFile from std::istream using iddFile, if possible. */
+  /** Load an IdfFile from std::istream using iddFile, if possible. See above for numThreads. */
   static boost::optional<IdfFile> load(std::istream& is,
                                        const IddFile& iddFile,
-                                       ProgressBar* progressBar=nullptr);
+                                       ProgressBar* progressBar=nullptr,
+                                       unsigned numThreads=1);
 
   /** Load an IdfFile from path using the IddFactory, and choosing iddFileType based on file
    *  extension, if possible. (IddFileType::OpenStudio if extension is modelFileExtension() or
-   *  componentFileExtension(), IddFileType::EnergyPlus otherwise.) */
+   *  componentFileExtension(), IddFileType::EnergyPlus otherwise.) See above for numThreads. */
   static boost::optional<IdfFile> load(const path& p,
-                                       ProgressBar* progressBar=nullptr);
+                                       ProgressBar* progressBar=nullptr,
+                                       unsigned numThreads=1);
 
   /** Load an IdfFile from path using the IddFactory and iddFileType, if possible. Will attempt to
-   *  complete the path by tacking on .osm or .idf as appropriate. */
+   *  complete the path by tacking on .osm or .idf as appropriate. See above for numThreads. */
   static boost::optional<IdfFile> load(const path& p,
                                        const IddFileType& iddFileType,
-                                       ProgressBar* progressBar=nullptr);
+                                       ProgressBar* progressBar=nullptr,
+                                       unsigned numThreads=1);
 
   /** Load an IdfFile from path using iddFile, if possible. If no file extension is provided, will
-   *  try "idf". */
+   *  try "idf". See above for numThreads. */
   static boost::optional<IdfFile> load(const path& p,
                                        const IddFile& iddFile,
-                                       ProgressBar* progressBar=nullptr);
+                                       ProgressBar* progressBar=nullptr,
+                                       unsigned numThreads=1);
 
   /** Quick load method that uses the IddFile::catchallIddFile and stops parsing once a version
    *  identifier is found. Used to determine the appropriate IddFile to use for a full load. */
   static boost::optional<VersionString> loadVersionOnly(std::istream& is);
 
-  /** Quick load method that uses the IddFile::catchallIddFile and stops parsing once a version
-   *  identifier is found. Used to determine the appropriate IddFile to use for a full load. */
+  /** Quick load method that finds the version identifier without loading the file. The start of
+   *  the file is memory-mapped and scanned for the version object, and only if that is
+   *  inconclusive is the file parsed as by loadVersionOnly(std::istream&). Used to determine the
+   *  appropriate IddFile to use for a full load. */
   static boost::optional<VersionString> loadVersionOnly(const path& p);
 
   /** Print this file to std::ostream os. */
@@ -245,7 +253,7 @@ class UTILITIES_API IdfFile {
   // SERIALIZATION
 
   /// private load function that uses m_iddFile and m_iddFileType initialized elsewhere
-  bool m_load(std::istream& is, ProgressBar* progressBar=nullptr, bool versionOnly=false);
+  bool m_load(std::istream& is, ProgressBar* progressBar=nullptr, bool versionOnly=false, unsigned numThreads=1);
 
   // configure logging
   REGISTER_LOGGER("utilities.idf.IdfFile");
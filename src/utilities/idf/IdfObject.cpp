@@ -32,9 +32,11 @@
 
 #include "IdfExtensibleGroup.hpp"
 #include "IdfRegex.hpp"
+#include "IdfTokenizer.hpp"
 #include "ValidityReport.hpp"
 
 #include "../idd/IddKey.hpp"
+#include "../idd/IddObjectValidation.hpp"
 #include <utilities/idd/IddFactory.hxx>
 #include <utilities/idd/IddEnums.hxx>
 #include "../idd/IddRegex.hpp"
@@ -51,6 +53,7 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
 #include <iomanip>
 
 using std::cout;
@@ -65,7 +68,7 @@ namespace detail {
   IdfObject_Impl::IdfObject_Impl(const IdfObject_Impl& other, bool keepHandle)
     : m_comment(other.comment()),
       m_iddObject(other.iddObject()),
-      m_fields(other.fields()),
+      m_fields(other.m_fields),
       m_fieldComments(other.fieldComments())
   {
     if (keepHandle){
@@ -132,13 +135,13 @@ namespace detail {
   IdfObject_Impl::IdfObject_Impl(const Handle& handle,
                                  const std::string& comment,
                                  const IddObject& iddObject,
-                                 const StringVector& fields,
-                                 const StringVector& fieldComments)
+                                 StringVector fields,
+                                 StringVector fieldComments)
     : m_handle(handle),
       m_comment(comment),
       m_iddObject(iddObject),
-      m_fields(fields),
-      m_fieldComments(fieldComments)
+      m_fields(std::move(fields)),
+      m_fieldComments(std::move(fieldComments))
   {
     resizeToMinFields();
   }
@@ -219,6 +222,16 @@ namespace detail {
     return "";
   }
 
+  std::string_view IdfObject_Impl::nameStringView(bool returnDefault) const
+  {
+    if (OptionalUnsigned oi = m_iddObject.nameFieldIndex()) {
+      if (boost::optional<std::string_view> temp = IdfObject_Impl::getStringView(*oi, returnDefault)) {
+        return *temp;
+      }
+    }
+    return std::string_view();
+  }
+
   std::string IdfObject_Impl::briefDescription() const {
     std::stringstream ss;
     ss << "Object of type '" << m_iddObject.type().valueDescription() << "'";
@@ -262,8 +275,35 @@ namespace detail {
     return boost::none;
   }
 
+  boost::optional<std::string_view> IdfObject_Impl::getStringView(unsigned index, bool returnDefault, bool returnUninitializedEmpty) const
+  {
+    boost::optional<std::string_view> result;
+    if (index < m_fields.size()) {
+      result = std::string_view(m_fields[index]);
+    }
+    if (returnDefault && ((result && result->empty()) || (!result))) {
+      // the IddField shares its properties with m_iddObject, so the default outlives this call
+      OptionalIddField iddField = m_iddObject.getField(index);
+      if (iddField && iddField->properties().stringDefault) {
+        result = std::string_view(*(iddField->properties().stringDefault));
+      }
+    }
+    if (returnUninitializedEmpty && (result && result->empty())){
+      result.reset();
+    }
+    return result;
+  }
+
   boost::optional<double> IdfObject_Impl::getDouble(unsigned index, bool returnDefault) const
   {
+    if ((index < m_fields.size()) && !m_fields[index].empty()) {
+      const ParsedField& parsed = parsedField(index);
+      if (!parsed.converted) {
+        LOG(Error, "Could not convert '" << decodeString(m_fields[index]) << "' to double");
+      }
+      return parsed.value;
+    }
+
     OptionalDouble result;
     OptionalString value = getString(index, returnDefault, false);
     if (value){
@@ -291,6 +331,20 @@ namespace detail {
   boost::optional<unsigned> IdfObject_Impl::getUnsigned(unsigned index, bool returnDefault) const
   {
     OptionalUnsigned result;
+    if ((index < m_fields.size()) && !m_fields[index].empty()) {
+      const ParsedField& parsed = parsedField(index);
+      try {
+        if (parsed.value) {
+          result = boost::numeric_cast<unsigned>(*parsed.value);
+        }
+      }
+      catch (const std::exception&) {}
+      if (!parsed.converted || (parsed.value && !result)) {
+        LOG(Error, "Could not convert '" << decodeString(m_fields[index]) << "' to unsigned");
+      }
+      return result;
+    }
+
     OptionalString value = getString(index, returnDefault, false);
     if (value){
       if (!( istringEqual(*value,"") ||
@@ -312,6 +366,20 @@ namespace detail {
   boost::optional<int> IdfObject_Impl::getInt(unsigned index, bool returnDefault) const
   {
     OptionalInt result;
+    if ((index < m_fields.size()) && !m_fields[index].empty()) {
+      const ParsedField& parsed = parsedField(index);
+      try {
+        if (parsed.value) {
+          result = boost::numeric_cast<int>(*parsed.value);
+        }
+      }
+      catch (const std::exception&) {}
+      if (!parsed.converted || (parsed.value && !result)) {
+        LOG(Error, "Could not convert '" << decodeString(m_fields[index]) << "' to int");
+      }
+      return result;
+    }
+
     OptionalString value = getString(index, returnDefault, false);
     if (value){
       if (!( istringEqual(*value,"") ||
@@ -364,7 +432,7 @@ namespace detail {
   void IdfObject_Impl::setComment(const std::string& comment, bool checkValidity)
   {
     m_comment = makeComment(comment);
-    m_diffs.push_back(IdfObjectDiff(boost::none, boost::none, boost::none));
+    recordDiff(IdfObjectDiff(boost::none, boost::none, boost::none));
   }
 
   bool IdfObject_Impl::setFieldComment(unsigned index, const std::string& cmnt) {
@@ -383,7 +451,7 @@ namespace detail {
 
       m_fieldComments[index] = makeComment(cmnt);
 
-      m_diffs.push_back(IdfObjectDiff(index, m_fields[index], m_fields[index]));
+      recordDiff(IdfObjectDiff(index, m_fields[index], m_fields[index]));
 
       return true;
     }
@@ -442,18 +510,24 @@ namespace detail {
       if (n == 0 && i == 1) {
         OS_ASSERT(!m_handle.isNull());
         m_fields.push_back(toString(m_handle));
-        m_diffs.push_back(IdfObjectDiff(0u,boost::none,m_fields.back()));
+        recordDiff(IdfObjectDiff(0u,boost::none,m_fields.back()));
       }
       n = numFields();
+      OptionalString oldName;
       if (i < n) {
-        std::string oldName = m_fields[i];
-        m_fields[i] = newName;
-        m_diffs.push_back(IdfObjectDiff(i, oldName, newName));
+        oldName = m_fields[i];
+        m_fields.set(i, newName);
+        invalidateParsedField(i);
+        recordDiff(IdfObjectDiff(i, oldName, newName));
       }
       else {
         m_fields.push_back(newName);
-        m_diffs.push_back(IdfObjectDiff(i, boost::none, newName));
+        recordDiff(IdfObjectDiff(i, boost::none, newName));
+      }
+      if (oldName) {
+        oldName = decodeString(*oldName);
       }
+      nameFieldChanged(oldName);
       //return decoded string since we might have made changes to it if its an EMS object.
       newName = decodeString(newName);
       return newName; // success!
@@ -498,7 +572,7 @@ namespace detail {
       boost::optional<std::string> oldValue;
       unsigned n = m_fields.size();
       unsigned nn = n;
-      unsigned diffSize = m_diffs.size();
+      DiffTransaction diffTransaction(*this);
       unsigned iddn = m_iddObject.numFields();
 
       if (index >= m_fields.size()){
@@ -519,10 +593,11 @@ namespace detail {
 
       if (!result) {
         // remove diffs
-        m_diffs.resize(diffSize);
+        diffTransaction.rollback();
 
         // resize fields
         m_fields.resize(n);
+        trimParsedFields();
         if (m_fieldComments.size() > n) {
           m_fieldComments.resize(n);
         }
@@ -532,8 +607,9 @@ namespace detail {
 
       OS_ASSERT(index < m_fields.size());
 
-      m_fields[index] = value;
-      m_diffs.push_back(IdfObjectDiff(index, oldValue, value));
+      m_fields.set(index, value);
+      invalidateParsedField(index);
+      recordDiff(IdfObjectDiff(index, oldValue, value));
       return result;
     }
     return false;
@@ -646,7 +722,7 @@ namespace detail {
         (m_iddObject.isExtensibleField(index) && (m_iddObject.properties().numExtensible == 1)))
     {
       m_fields.push_back(value);
-      m_diffs.push_back(IdfObjectDiff(index, boost::none, value));
+      recordDiff(IdfObjectDiff(index, boost::none, value));
       return true;
     }
     return false;
@@ -672,7 +748,7 @@ namespace detail {
 
     StringVector wValues = values; // copy so can resize empty vector
     OptionalUnsigned mf = maxFields();
-    unsigned diffSize = m_diffs.size();
+    DiffTransaction diffTransaction(*this);
 
     // push fields as needed
     unsigned iddn = m_iddObject.numFields();
@@ -680,10 +756,11 @@ namespace detail {
       bool ok = this->setString(iddn - 1,"",checkValidity);
       if (!ok) {
         // remove the diffs
-        m_diffs.resize(diffSize);
+        diffTransaction.rollback();
 
         // resize the fields
         m_fields.resize(n);
+        trimParsedFields();
         if (m_fieldComments.size() > n) {
           m_fieldComments.resize(n);
         }
@@ -710,10 +787,11 @@ namespace detail {
         bool ok = setString(n+i,wValues[i],checkValidity);
         if (!ok) {
           // remove the diffs
-          m_diffs.resize(diffSize);
+          diffTransaction.rollback();
 
           // resize the fields
           m_fields.resize(n);
+          trimParsedFields();
           if (m_fieldComments.size() > n){
             m_fieldComments.resize(n);
           }
@@ -762,7 +840,7 @@ namespace detail {
     }
 
     // record diffs at start
-    unsigned diffSize = m_diffs.size();
+    DiffTransaction diffTransaction(*this);
 
     // from now on, groupIndex < numExtensibleGroups(), and numExtensibleGroups() > 0
     OptionalUnsigned mf = maxFields();
@@ -782,7 +860,6 @@ namespace detail {
       IdfExtensibleGroup temp = pushExtensibleGroup(eg.fields(),checkValidity);
       if (temp.empty()) {
         OS_ASSERT(numFields() == n);
-        OS_ASSERT(m_diffs.size() == diffSize);
 
         return result;
       }
@@ -808,7 +885,7 @@ namespace detail {
           popExtensibleGroup(false);
 
           // remove the diffs
-          m_diffs.resize(diffSize);
+          diffTransaction.rollback();
 
           return result;
         }
@@ -832,7 +909,7 @@ namespace detail {
         popExtensibleGroup(false);
 
         // remove the diffs
-        m_diffs.resize(diffSize);
+        diffTransaction.rollback();
 
         return result;
       }
@@ -871,10 +948,11 @@ namespace detail {
 
       // record diffs for each field going backwards
       for (unsigned i = 0; i < groupSize; ++i){
-        m_diffs.push_back(IdfObjectDiff(numBeforePop-1-i, result[i], boost::none));
+        recordDiff(IdfObjectDiff(numBeforePop-1-i, result[i], boost::none));
       }
 
       m_fields.resize(numAfterPop);
+      trimParsedFields();
       if (m_fieldComments.size() > m_fields.size()) {
         m_fieldComments.resize(numAfterPop);
       }
@@ -909,7 +987,7 @@ namespace detail {
     }
 
     // record diffs at start
-    unsigned diffSize = m_diffs.size();
+    DiffTransaction diffTransaction(*this);
 
     bool ok = true;
     // pop was successful. roll up until overwrite groupIndex
@@ -933,7 +1011,7 @@ namespace detail {
         OS_ASSERT(!eg.empty());
 
         // remove the diffs
-        m_diffs.resize(diffSize);
+        diffTransaction.rollback();
 
         return StringVector();
       }
@@ -963,7 +1041,7 @@ namespace detail {
     if (gn == 0) { return rollbackValues; }
 
     // record diffs at start
-    unsigned diffSize = m_diffs.size();
+    DiffTransaction diffTransaction(*this);
 
     // loop through groups
     UnsignedVector indices;
@@ -994,7 +1072,7 @@ namespace detail {
         }
 
         // remove the diffs
-        m_diffs.resize(diffSize);
+        diffTransaction.rollback();
 
         return rollbackValues;
       }
@@ -1270,112 +1348,167 @@ namespace detail {
     return result;
   }
 
+  std::shared_ptr<IdfObject_Impl> IdfObject_Impl::load(const IdfObjectTokens& tokens,
+                                                         const IddObject& iddObject)
+  {
+    std::shared_ptr<IdfObject_Impl> result;
+    IdfObject_Impl idfObjectImpl(iddObject,false,true);
+
+    try {
+      idfObjectImpl.parse(tokens);
+      idfObjectImpl.resizeToMinFields();
+    }
+    catch (...) { return result; }
+
+    bool keepHandle = idfObjectImpl.iddObject().hasHandleField();
+    result = std::shared_ptr<IdfObject_Impl>(new IdfObject_Impl(idfObjectImpl,keepHandle));
+    return result;
+  }
+
   std::ostream& IdfObject_Impl::print(std::ostream& os) const {
+    std::string buffer;
+    print(buffer);
+    os.write(buffer.data(), buffer.size());
+    return os;
+  }
+
+  std::ostream& IdfObject_Impl::printName(std::ostream& os, bool hasFields) const {
+    std::string buffer;
+    printName(buffer, hasFields);
+    os.write(buffer.data(), buffer.size());
+    return os;
+  }
+
+  std::ostream& IdfObject_Impl::printField(std::ostream& os,
+                                           unsigned index,
+                                           bool isLastField) const
+  {
+    std::string buffer;
+    printField(buffer, index, isLastField);
+    os.write(buffer.data(), buffer.size());
+    return os;
+  }
+
+  std::string& IdfObject_Impl::print(std::string& buffer) const {
     unsigned n = numFields();
     if (n == 0) {
-      printName(os,false);
+      printName(buffer,false);
     }
     else {
-      printName(os,true);
+      printName(buffer,true);
     }
 
     for (unsigned i = 0; i < n; ++i) {
       if (i < n-1) {
-        printField(os,i);
+        printField(buffer,i);
       }
       else {
-        printField(os,i,true);
+        printField(buffer,i,true);
       }
     }
 
-    os << std::endl;
+    buffer += '\n';
 
-    return os;
+    return buffer;
   }
 
-  std::ostream& IdfObject_Impl::printName(std::ostream& os, bool hasFields) const {
+  std::string& IdfObject_Impl::printName(std::string& buffer, bool hasFields) const {
     // print comment, if any
     if (!m_comment.empty()){
-      os << m_comment << std::endl;
+      buffer += m_comment;
+      buffer += '\n';
     }
 
     // if this is a comment only object, return
     // todo, tighten up handling of comments with comment only object type
     if (boost::iequals(m_iddObject.name(), iddRegex::commentOnlyObjectName()) ){
-      return os;
+      return buffer;
     }
 
-    os << m_iddObject.name();
+    buffer += m_iddObject.name();
 
     if (hasFields) {
-      os << "," << std::endl;
+      buffer += ",\n";
     }
     else {
-      os << ";" << std::endl;
+      buffer += ";\n";
     }
 
-    return os;
+    return buffer;
   }
 
-  std::ostream& IdfObject_Impl::printField(std::ostream& os,
-                                           unsigned index,
-                                           bool isLastField) const
+  std::string& IdfObject_Impl::printField(std::string& buffer,
+                                          unsigned index,
+                                          bool isLastField) const
   {
     if (index < numFields()) {
+      const IddObjectProperties& properties = m_iddObject.properties();
+      const std::string& field = m_fields[index];
       // different formatting for vertices
-      if ((m_iddObject.properties().format == "vertices") && (m_iddObject.isExtensibleField(index))) {
+      if ((properties.format == "vertices") && (m_iddObject.isExtensibleField(index))) {
         ExtensibleIndex eIndex = m_iddObject.extensibleIndex(index);
         static int textWidth(0);
         if (eIndex.field == 0) {
-          os << "  ";
+          buffer += "  ";
           textWidth = 0;
         }
         else {
-          os << " ";
+          buffer += ' ';
         }
         // field value
-        os << m_fields[index];
+        buffer += field;
         // delimiter
-        if (isLastField) {
-          os << ";";
-        }
-        else {
-          os << ",";
-        }
-        textWidth += m_fields[index].size();
+        buffer += isLastField ? ';' : ',';
+        textWidth += field.size();
         // comment
-        if (eIndex.field == m_iddObject.properties().numExtensible - 1) {
+        if (eIndex.field == properties.numExtensible - 1) {
           int numSpaces = IdfObject::printedFieldSpace() - textWidth - 4;
           if (numSpaces > 0) {
-            os << std::setw(numSpaces) << " ";
+            buffer.append(numSpaces, ' ');
           }
-          os << " !- X,Y,Z Vertex " << eIndex.group + 1;
+          buffer += " !- X,Y,Z Vertex ";
+          buffer += std::to_string(eIndex.group + 1);
           IddField iddField = m_iddObject.getField(index).get();
-          if (OptionalString units = iddField.properties().units) {
-            os << " {" << *units << "}";
+          if (const OptionalString& units = iddField.properties().units) {
+            buffer += " {";
+            buffer += *units;
+            buffer += '}';
           }
-          os << std::endl;
+          buffer += '\n';
         }
       }
       else {
         // field value
-        os << "  " << m_fields[index];
+        buffer += "  ";
+        buffer += field;
         // delimiter
-        if (isLastField) {
-          os << ";";
-        }
-        else {
-          os << ",";
-        }
+        buffer += isLastField ? ';' : ',';
         // field comment
-        int numSpaces = IdfObject::printedFieldSpace() - int(m_fields[index].size());
+        int numSpaces = IdfObject::printedFieldSpace() - int(field.size());
         if (numSpaces > 0) {
-          os << std::setw(numSpaces) << " ";
+          buffer.append(numSpaces, ' ');
         }
-        os << " " << fieldComment(index,true) << std::endl;
+        buffer += ' ';
+        if ((index < m_fieldComments.size()) && !m_fieldComments[index].empty()) {
+          buffer += m_fieldComments[index];
+        }
+        else if (OptionalIddField iddField = m_iddObject.getField(index)) {
+          // same text as fieldComment(index,true), without the stringstream
+          buffer += makeIdfEditorComment(iddField->name());
+          if (m_iddObject.isExtensibleField(index)) {
+            buffer += ' ';
+            buffer += std::to_string(m_iddObject.extensibleIndex(index).group + 1);
+          }
+          if (const OptionalString& units = iddField->properties().units) {
+            buffer += " {";
+            buffer += *units;
+            buffer += '}';
+          }
+        }
+        buffer += '\n';
       }
     } // if index < numFields()
-    return os;
+    return buffer;
   }
 
   void IdfObject_Impl::emitChangeSignals()
@@ -1419,6 +1552,83 @@ namespace detail {
     m_diffs.clear();
   }
 
+  unsigned IdfObject_Impl::numDiffs() const {
+    return m_diffs.size();
+  }
+
+  std::size_t IdfObject_Impl::diffMemoryUsage() const {
+    std::size_t result = m_diffs.capacity() * sizeof(IdfObjectDiff);
+    for (const IdfObjectDiff& diff : m_diffs) {
+      result += diff.memoryUsage() - sizeof(IdfObjectDiff);
+    }
+    return result;
+  }
+
+  // PROTECTED
+
+  IdfObjectDiffMode IdfObject_Impl::diffMode() const {
+    return IdfObjectDiffMode::Full;
+  }
+
+  void IdfObject_Impl::recordDiff(const IdfObjectDiff& diff) {
+    IdfObjectDiffMode mode = diffMode();
+    if (mode == IdfObjectDiffMode::Full) {
+      m_diffs.push_back(diff);
+      return;
+    }
+
+    // Coalesced or Off, one diff per index
+    for (auto it = m_diffs.rbegin(); it != m_diffs.rend(); ++it) {
+      if (it->index() == diff.index()) {
+        if (boost::optional<IdfObjectDiff> merged = it->merge(diff)) {
+          if (m_numDiffTransactions > 0) {
+            m_mergedDiffs.push_back(std::make_pair(static_cast<std::size_t>(m_diffs.rend() - it - 1), *it));
+          }
+          if (mode == IdfObjectDiffMode::Coalesced) {
+            *it = *merged;
+          }
+          else {
+            // without values, a merged change cannot be recognized as a net null change
+            IdfObjectDiff marker = merged->withoutValues();
+            if (!marker.isNull()) {
+              *it = marker;
+            }
+          }
+          return;
+        }
+        break;
+      }
+    }
+    m_diffs.push_back((mode == IdfObjectDiffMode::Off) ? diff.withoutValues() : diff);
+  }
+
+  IdfObject_Impl::DiffTransaction::DiffTransaction(IdfObject_Impl& object)
+    : m_object(object), m_numDiffs(object.m_diffs.size()), m_numMergedDiffs(object.m_mergedDiffs.size())
+  {
+    ++m_object.m_numDiffTransactions;
+  }
+
+  IdfObject_Impl::DiffTransaction::~DiffTransaction() {
+    --m_object.m_numDiffTransactions;
+    if (m_object.m_numDiffTransactions == 0) {
+      m_object.m_mergedDiffs.clear();
+    }
+  }
+
+  void IdfObject_Impl::DiffTransaction::rollback() {
+    // undo merges newest first, so a diff merged into more than once gets its original value back
+    std::vector<std::pair<std::size_t, IdfObjectDiff> >& mergedDiffs = m_object.m_mergedDiffs;
+    while (mergedDiffs.size() > m_numMergedDiffs) {
+      if (mergedDiffs.back().first < std::min(m_numDiffs, m_object.m_diffs.size())) {
+        m_object.m_diffs[mergedDiffs.back().first] = mergedDiffs.back().second;
+      }
+      mergedDiffs.pop_back();
+    }
+    if (m_object.m_diffs.size() > m_numDiffs) {
+      m_object.m_diffs.resize(m_numDiffs);
+    }
+  }
+
   // PRIVATE
 
   void IdfObject_Impl::resizeToMinFields() {
@@ -1615,6 +1825,65 @@ namespace detail {
 
   }
 
+  void IdfObject_Impl::parse(const IdfObjectTokens& tokens)
+  {
+    std::string objectType(tokens.type);
+    if (!boost::iequals(objectType, m_iddObject.name())){
+      if (m_iddObject.type() != IddObjectType::Catchall) {
+        LOG(Error, "IdfObject type '" << objectType << "', does not equal its IddObject name '"
+            << m_iddObject.name() << "'. Reverting to default Catchall IddObject.");
+      }
+      m_iddObject = IddObject();
+      m_fields.push_back(objectType);
+    }
+
+    m_comment = tokens.comment;
+
+    for (unsigned iddFieldIndex = 0, n = tokens.fields.size(); iddFieldIndex < n; ++iddFieldIndex) {
+      const std::string_view& fieldText = tokens.fields[iddFieldIndex];
+      const std::string_view& fieldComment = tokens.fieldComments[iddFieldIndex];
+
+      // get the idd field
+      OptionalIddField iddField = m_iddObject.getField(iddFieldIndex);
+      if (!iddField) {
+        LOG(Error, "IdfObject of type '" << m_iddObject.name() << "' " <<
+          "cannot have field index of " << iddFieldIndex << ". " <<
+          "Cutting off IdfObject field parsing here, with " << n - iddFieldIndex <<
+          " fields remaining, starting with: " << std::endl << fieldText);
+        return;
+      }
+
+      // add this to our fields
+      m_fields.push_back(std::string(fieldText));
+
+      if (!fieldComment.empty()) {
+        // drop default comments, see commentRegex::editorCommentWhitespaceOnlyLine
+        bool editorComment = (fieldComment.size() > 1) && (fieldComment[0] == '!') && (fieldComment[1] == '-');
+        if (editorComment && (fieldComment.find_first_of("\v\f\r\n") != std::string_view::npos)) {
+          editorComment = boost::regex_match(std::string(fieldComment),
+                                             commentRegex::editorCommentWhitespaceOnlyLine());
+        }
+        if (!editorComment) {
+          m_fieldComments.resize(m_fields.size());
+          m_fieldComments.back() = std::string(fieldComment);
+        }
+      }
+
+      // keep handle if this is a handle field
+      if (iddField->properties().type == IddFieldType::HandleType) {
+        Handle candidate = toUUID(std::string(fieldText));
+        if (!candidate.isNull()) {
+          m_handle = candidate;
+        }
+      }
+    }
+
+    if (!tokens.unparsed.empty()) {
+      LOG(Warn, "After parsing IdfObject fields, the following text remains unprocessed: "
+        << std::endl << tokens.unparsed);
+    }
+  }
+
   // GETTER AND SETTER HELPERS
 
   bool IdfObject_Impl::setIddObject(const IddObject& iddObject)
@@ -1628,6 +1897,7 @@ namespace detail {
       for (unsigned i = 0, n = numFields(); i < n; ++i) {
         if (!(m_iddObject.isNonextensibleField(i) || m_iddObject.isExtensibleField(i))) {
           m_fields.resize(i);
+          trimParsedFields();
           if (m_fieldComments.size() > m_fields.size()) {
             m_fieldComments.resize(i);
           }
@@ -1690,6 +1960,42 @@ namespace detail {
     return result;
   }
 
+  const IdfObject_Impl::ParsedField& IdfObject_Impl::parsedField(unsigned index) const {
+    OS_ASSERT(index < m_fields.size());
+    if (index >= m_parsedFields.size()) {
+      m_parsedFields.resize(index + 1);
+    }
+    ParsedField& result = m_parsedFields[index];
+    if (!result.parsed) {
+      std::string value = decodeString(m_fields[index]);
+      result.parsed = true;
+      result.converted = true;
+      result.value.reset();
+      if (!( istringEqual(value,"") ||
+             istringEqual(value,"autosize") ||
+             istringEqual(value,"autocalculate") ))
+      {
+        try { result.value = boost::lexical_cast<double>(value); }
+        catch (const std::exception& ) {
+          result.converted = false;
+        }
+      }
+    }
+    return result;
+  }
+
+  void IdfObject_Impl::invalidateParsedField(unsigned index) {
+    if (index < m_parsedFields.size()) {
+      m_parsedFields[index].parsed = false;
+    }
+  }
+
+  void IdfObject_Impl::trimParsedFields() {
+    if (m_parsedFields.size() > m_fields.size()) {
+      m_parsedFields.resize(m_fields.size());
+    }
+  }
+
   // QUERY HELPERS
 
 void IdfObject_Impl::populateValidityReport(ValidityReport& report, bool checkNames) const
@@ -1724,7 +2030,7 @@ void IdfObject_Impl::populateValidityReport(ValidityReport& report, bool checkNa
 
     // DataErrorType::NoIdd
     // field-level
-    if (!m_iddObject.getField(index)) {
+    if (!m_iddObject.validation()->field(index)) {
       result.push_back(DataError(index,
                                  getObject<IdfObject>(),
                                  DataErrorType(DataErrorType::NoIdd)));
@@ -1767,33 +2073,33 @@ void IdfObject_Impl::populateValidityReport(ValidityReport& report, bool checkNa
   }
 
   bool IdfObject_Impl::fieldDataIsCorrectType(unsigned index) const {
-    OptionalIddField oIddField = m_iddObject.getField(index);
-    if (!oIddField) { return true; }
+    std::shared_ptr<const IddObjectValidation> validation = m_iddObject.validation();
+    const IddFieldValidation* field = validation->field(index);
+    if (!field) { return true; }
 
-    IddField iddField = *oIddField;
-    IddFieldType fieldType = iddField.properties().type;
+    IddFieldType::domain fieldType = field->type;
     OS_ASSERT(m_fields.size() > index);
 
     if ((fieldType == IddFieldType::IntegerType) && (!m_fields[index].empty())) {
       OptionalInt value = getInt(index);
       if (!value) {
         // ok if autosize or autocalculate
-        if (iddField.properties().autosizable && istringEqual(m_fields[index],"autosize")) {
+        if (field->autosizable && istringEqual(m_fields[index],"autosize")) {
         }
-        else if (iddField.properties().autocalculatable &&
+        else if (field->autocalculatable &&
                  istringEqual(m_fields[index],"autocalculate"))
         {
         }
-        else if (iddField.properties().autosizable &&
+        else if (field->autosizable &&
                  istringEqual(m_fields[index],"autocalculate"))
         {
-          LOG(Info, "Field " << index << ", '" << iddField.name() << "', of an object of type "
+          LOG(Info, "Field " << index << ", '" << m_iddObject.getField(index)->name() << "', of an object of type "
               << m_iddObject.name() << " has 'autocalculate' as its value even though it is autosizable.");
         }
-        else if (iddField.properties().autocalculatable &&
+        else if (field->autocalculatable &&
                  istringEqual(m_fields[index],"autosize"))
         {
-          LOG(Info, "Field " << index << ", '" << iddField.name() << "', of an object of type "
+          LOG(Info, "Field " << index << ", '" << m_iddObject.getField(index)->name() << "', of an object of type "
               << m_iddObject.name() << " has 'autosize' as its value even though it is autocalculable.");
         }
         else{
@@ -1808,22 +2114,22 @@ void IdfObject_Impl::populateValidityReport(ValidityReport& report, bool checkNa
       OptionalDouble value = getDouble(index);
       if (!value) {
         // ok if autosize or autocalculate
-        if (iddField.properties().autosizable && istringEqual(m_fields[index],"autosize")) {
+        if (field->autosizable && istringEqual(m_fields[index],"autosize")) {
         }
-        else if (iddField.properties().autocalculatable &&
+        else if (field->autocalculatable &&
                  istringEqual(m_fields[index],"autocalculate"))
         {
         }
-        else if (iddField.properties().autosizable &&
+        else if (field->autosizable &&
                  istringEqual(m_fields[index],"autocalculate"))
         {
-          LOG(Info, "Field " << index << ", '" << iddField.name() << "', of an object of type "
+          LOG(Info, "Field " << index << ", '" << m_iddObject.getField(index)->name() << "', of an object of type "
               << m_iddObject.name() << " has 'autocalculate' as its value even though it is autosizable.");
         }
-        else if (iddField.properties().autocalculatable &&
+        else if (field->autocalculatable &&
                  istringEqual(m_fields[index],"autosize"))
         {
-          LOG(Info, "Field " << index << ", '" << iddField.name() << "', of an object of type "
+          LOG(Info, "Field " << index << ", '" << m_iddObject.getField(index)->name() << "', of an object of type "
               << m_iddObject.name() << " has 'autosize' as its value even though it is autocalculable.");
         }
         else {
@@ -1831,11 +2137,11 @@ void IdfObject_Impl::populateValidityReport(ValidityReport& report, bool checkNa
         }
       } else{
         if (std::isnan(*value)) {
-          LOG(Warn, "Cannot set field " << index << ", '" << iddField.name() << "', an object of type "
+          LOG(Warn, "Cannot set field " << index << ", '" << m_iddObject.getField(index)->name() << "', an object of type "
               << m_iddObject.name() << " to NaN.");
           return false;
         }else if (std::isinf(*value)) {
-          LOG(Warn, "Cannot set field " << index << ", '" << iddField.name() << "', an object of type "
+          LOG(Warn, "Cannot set field " << index << ", '" << m_iddObject.getField(index)->name() << "', an object of type "
               << m_iddObject.name() << " to Infinity.");
           return false;
         }
@@ -1844,10 +2150,7 @@ void IdfObject_Impl::populateValidityReport(ValidityReport& report, bool checkNa
 
     if ((fieldType == IddFieldType::ChoiceType) && (!m_fields[index].empty())) {
       // value should iequal one of the keys
-      IddKeyVector keys = iddField.keys();
-      NameFinder<IddKey> finder(m_fields[index]);
-      IddKeyVector::const_iterator loc = std::find_if(keys.begin(),keys.end(),finder);
-      if (loc == keys.end()) {
+      if (!field->isKey(m_fields[index])) {
         return false;
       }
     }
@@ -1856,24 +2159,22 @@ void IdfObject_Impl::populateValidityReport(ValidityReport& report, bool checkNa
   }
 
   bool IdfObject_Impl::fieldDataIsWithinBounds(unsigned index) const {
-    OptionalIddField oIddField = m_iddObject.getField(index);
-    if (!oIddField) { return true; } // default to true
+    std::shared_ptr<const IddObjectValidation> validation = m_iddObject.validation();
+    const IddFieldValidation* field = validation->field(index);
+    if (!field) { return true; } // default to true
 
-    IddField iddField = *oIddField;
-    IddFieldType fieldType = iddField.properties().type;
     OS_ASSERT(m_fields.size() > index);
 
-    if (fieldType == IddFieldType::IntegerType) {
+    if (field->type == IddFieldType::IntegerType) {
       OptionalInt value = getInt(index);
       if (value) {
-        double fieldValue = static_cast<double>(*value);
-        return withinBounds(fieldValue,iddField);
+        return field->withinBounds(static_cast<double>(*value));
       }
     }
-    if (fieldType == IddFieldType::RealType) {
+    if (field->type == IddFieldType::RealType) {
       OptionalDouble value = getDouble(index);
       if (value) {
-        return withinBounds(*value,iddField);
+        return field->withinBounds(*value);
       }
     }
 
@@ -1881,47 +2182,18 @@ void IdfObject_Impl::populateValidityReport(ValidityReport& report, bool checkNa
   }
 
   bool IdfObject_Impl::fieldIsNonnullIfRequired(unsigned index) const {
-    OptionalIddField oIddField = m_iddObject.getField(index);
-    if (!oIddField) { return true; } // default to true
+    std::shared_ptr<const IddObjectValidation> validation = m_iddObject.validation();
+    const IddFieldValidation* field = validation->field(index);
+    if (!field) { return true; } // default to true
 
-    IddField iddField = *oIddField;
     OS_ASSERT(m_fields.size() > index);
 
-    if (iddField.properties().required && (!iddField.isObjectListField()) &&
-        m_fields[index].empty()) {
+    if (field->required && (!field->objectListField) && m_fields[index].empty()) {
       return false;
     }
     return true;
   }
 
-  bool IdfObject_Impl::withinBounds(double fieldValue,const IddField& iddField) const {
-
-    // minimum bounds
-    OptionalDouble boundValue = iddField.properties().minBoundValue;
-    IddFieldProperties::BoundTypes boundType = iddField.properties().minBoundType;
-    if (boundType != IddFieldProperties::Unbounded) {
-      OS_ASSERT(boundValue);
-      // check min bound
-      if (boundType == IddFieldProperties::InclusiveBound) {
-        if (fieldValue < *boundValue) { return false; }
-      }
-      else if (fieldValue <= *boundValue) { return false; }
-    }
-
-    // maximum bounds
-    boundValue = iddField.properties().maxBoundValue;
-    boundType = iddField.properties().maxBoundType;
-    if (boundType != IddFieldProperties::Unbounded) {
-      OS_ASSERT(boundValue);
-      if (boundType == IddFieldProperties::InclusiveBound) {
-        if (fieldValue > *boundValue) { return false; }
-      }
-      else if (fieldValue >= *boundValue) { return false; }
-    }
-
-    return true;
-  }
-
   OSOptionalQuantity IdfObject_Impl::getQuantityFromDouble(unsigned index, boost::optional<double> value, bool returnIP) const {
     OptionalIddField iddField = m_iddObject.getField(index);
     if (!iddField) {
@@ -2141,6 +2413,10 @@ std::string IdfObject::nameString(bool returnDefault) const {
   return m_impl->nameString(returnDefault);
 }
 
+std::string_view IdfObject::nameStringView(bool returnDefault) const {
+  return m_impl->nameStringView(returnDefault);
+}
+
 std::string IdfObject::briefDescription() const {
   return m_impl->briefDescription();
 }
@@ -2156,6 +2432,13 @@ boost::optional<std::string> IdfObject::getString(unsigned index,
   return m_impl->getString(index,returnDefault,returnUninitializedEmpty);
 }
 
+boost::optional<std::string_view> IdfObject::getStringView(unsigned index,
+                                                           bool returnDefault,
+                                                           bool returnUninitializedEmpty) const
+{
+  return m_impl->getStringView(index,returnDefault,returnUninitializedEmpty);
+}
+
 boost::optional<double> IdfObject::getDouble(unsigned index, bool returnDefault) const {
   return m_impl->getDouble(index,returnDefault);
 }
@@ -2360,6 +2643,11 @@ std::ostream& IdfObject::print(std::ostream& os) const
   return m_impl->print(os);
 }
 
+std::string& IdfObject::print(std::string& buffer) const
+{
+  return m_impl->print(buffer);
+}
+
 std::ostream& IdfObject::printName(std::ostream& os, bool hasFields) const {
   return m_impl->printName(os,hasFields);
 }
@@ -39,6 +39,7 @@
 #include <boost/optional.hpp>
 
 #include <string>
+#include <string_view>
 #include <ostream>
 #include <vector>
 #include <algorithm>
@@ -138,6 +139,9 @@ class UTILITIES_API IdfObject {
    *  name will return the default name, if it exists. */
   std::string nameString(bool returnDefault=false) const;
 
+  /** Like nameString, but returns a view subject to the lifetime rules of getStringView. */
+  std::string_view nameStringView(bool returnDefault=false) const;
+
   /** Get a brief description of this object. Always includes iddObject().type(), and includes
    *  name() if available and not empty. */
   std::string briefDescription() const;
@@ -153,6 +157,14 @@ class UTILITIES_API IdfObject {
    */
   boost::optional<std::string> getString(unsigned index, bool returnDefault=false, bool returnUninitializedEmpty=false ) const;
 
+  /** Like getString, but returns a view of the stored text rather than a copy, for comparisons
+   *  in tight loops. The view is only valid until any field of this object is changed, inserted
+   *  or removed, or the object is removed from its Workspace and destroyed; copy it into a
+   *  std::string to keep it longer. Encoded special characters ('&#10' and the like) are not
+   *  decoded. For pointer fields of WorkspaceObjects the view is of the target's name, and is
+   *  subject to the same rules on the target. */
+  boost::optional<std::string_view> getStringView(unsigned index, bool returnDefault=false, bool returnUninitializedEmpty=false) const;
+
   /** Get the value of the field at index, converted to double, if possible. Returns an
    *  uninitialized object if the conversion is unsuccessful for any reason. Logs a warning
    *  if the conversion fails, the field is RealType, and the field is not equal to
@@ -358,6 +370,10 @@ class UTILITIES_API IdfObject {
   /** Serialize this object to os as Idf text. */
   std::ostream& print(std::ostream& os) const;
 
+  /** Serialize this object as Idf text, appending it to buffer. Produces exactly the text of
+   *  print(std::ostream&), but without going through formatted stream output. */
+  std::string& print(std::string& buffer) const;
+
   /** Serialize just the preceding comments and name of this IdfObject in the format used by
    *  full object print. If hasFields, the name is followed by a ','. Otherwise, the name is
    *  followed by a ';'. */
@@ -413,6 +429,7 @@ class UTILITIES_API IdfObject {
   friend class detail::Workspace_Impl;       // for finding IdfObjects in a workspace
   friend class WorkspaceObject;              // for WorkspaceObject::idfObject()
   friend class Workspace;                    // for toIdfFile completion (constructs IdfObject from impl)
+  friend class IdfFile;                      // for IdfFile::m_load (constructs IdfObject from tokenized text)
 
   /** Protected constructor from impl. */
   IdfObject(std::shared_ptr<detail::IdfObject_Impl> impl);
@@ -32,6 +32,8 @@
 
 #include "../core/Assert.hpp"
 
+#include <typeinfo>
+
 namespace openstudio {
   namespace detail {
 
@@ -71,6 +73,34 @@ namespace openstudio {
       return m_newValue;
     }
 
+    std::shared_ptr<IdfObjectDiff_Impl> IdfObjectDiff_Impl::merge(const IdfObjectDiff_Impl& later) const
+    {
+      if (typeid(later) != typeid(IdfObjectDiff_Impl)) {
+        return nullptr;
+      }
+      return std::make_shared<IdfObjectDiff_Impl>(m_index, m_oldValue, later.newValue());
+    }
+
+    std::shared_ptr<IdfObjectDiff_Impl> IdfObjectDiff_Impl::withoutValues() const
+    {
+      if (isNull()) {
+        return std::make_shared<IdfObjectDiff_Impl>(m_index, boost::none, boost::none);
+      }
+      return std::make_shared<IdfObjectDiff_Impl>(m_index, boost::none, std::string());
+    }
+
+    std::size_t IdfObjectDiff_Impl::memoryUsage() const
+    {
+      std::size_t result = sizeof(IdfObjectDiff_Impl);
+      if (m_oldValue) {
+        result += m_oldValue->capacity();
+      }
+      if (m_newValue) {
+        result += m_newValue->capacity();
+      }
+      return result;
+    }
+
   } // detail
 
   IdfObjectDiff::IdfObjectDiff()
@@ -111,4 +141,25 @@ namespace openstudio {
     return m_impl->newValue();
   }
 
+  boost::optional<IdfObjectDiff> IdfObjectDiff::merge(const IdfObjectDiff& later) const
+  {
+    boost::optional<IdfObjectDiff> result;
+    if (index() == later.index()) {
+      if (std::shared_ptr<detail::IdfObjectDiff_Impl> impl = m_impl->merge(*later.m_impl)) {
+        result = IdfObjectDiff(impl);
+      }
+    }
+    return result;
+  }
+
+  IdfObjectDiff IdfObjectDiff::withoutValues() const
+  {
+    return IdfObjectDiff(m_impl->withoutValues());
+  }
+
+  std::size_t IdfObjectDiff::memoryUsage() const
+  {
+    return sizeof(IdfObjectDiff) + m_impl->memoryUsage();
+  }
+
 } // openstudio
@@ -31,6 +31,7 @@
 #define UTILITIES_IDF_IDFOBJECTDIFF_HPP
 
 #include "../UtilitiesAPI.hpp"
+#include "../core/Enum.hpp"
 
 #include <boost/optional.hpp>
 
@@ -41,6 +42,26 @@ namespace detail {
   class IdfObjectDiff_Impl;
 }
 
+/** \class IdfObjectDiffMode
+ *  \brief Controls how the objects in a Workspace keep IdfObjectDiffs until their change signals
+ *  are emitted.
+ *
+ *  Full keeps every diff. Coalesced keeps one diff per field, from the first old value to the latest
+ *  new value. Off keeps one diff per field without any values, which
+ *  is just enough to emit the right signals.
+ *
+ *  See the OPENSTUDIO_ENUM documentation in utilities/core/Enum.hpp. The actual macro call is:
+ *  \code
+OPENSTUDIO_ENUM(IdfObjectDiffMode,
+                ((Full))
+                ((Coalesced))
+                ((Off)) );
+ *  \endcode */
+OPENSTUDIO_ENUM(IdfObjectDiffMode,
+                ((Full))
+                ((Coalesced))
+                ((Off)) );
+
 /** IdfObjectDiff represents a change to an IdfObject.
 **/
 class UTILITIES_API IdfObjectDiff {
@@ -62,6 +83,15 @@ public:
   /// get the new value, uninitialized optional means that the field no longer exists
   boost::optional<std::string> newValue() const;
 
+  /// returns a diff equivalent to this one followed by later, if both are for the same index and of the same type
+  boost::optional<IdfObjectDiff> merge(const IdfObjectDiff& later) const;
+
+  /// returns a copy of this diff that records which index changed, but not the values
+  IdfObjectDiff withoutValues() const;
+
+  /// returns the approximate number of bytes used by this diff
+  std::size_t memoryUsage() const;
+
   /// cast to type T, can throw std::bad_cast
   template<typename T>
   T cast() const{
@@ -34,6 +34,7 @@
 
 #include <boost/optional.hpp>
 
+#include <memory>
 #include <string>
 
 namespace openstudio {
@@ -60,6 +61,15 @@ namespace detail {
     /// get the new value, uninitialized optional means that the field no longer exists
     boost::optional<std::string> newValue() const;
 
+    /// returns a diff equivalent to this one followed by later, or nullptr if later is of another type
+    virtual std::shared_ptr<IdfObjectDiff_Impl> merge(const IdfObjectDiff_Impl& later) const;
+
+    /// returns a copy of this diff with no old value and an empty new value
+    virtual std::shared_ptr<IdfObjectDiff_Impl> withoutValues() const;
+
+    /// returns the approximate number of bytes used by this diff
+    virtual std::size_t memoryUsage() const;
+
   private:
 
     boost::optional<unsigned> m_index;
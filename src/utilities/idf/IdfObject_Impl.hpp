@@ -41,7 +41,9 @@
 
 #include <boost/optional.hpp>
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <ostream>
 #include <vector>
 
@@ -56,10 +58,85 @@ class ValidityReport;
 class DataError;
 class Quantity;
 class OSOptionalQuantity;
+struct IdfObjectTokens;
 
 // private namespace
 namespace detail {
 
+  /** Field text of an IdfObject_Impl. Copies share storage until one of them is changed with
+   *  set, push_back, pop_back or resize, so cloned objects (and cloned Workspaces) do not
+   *  duplicate field data up front. Reads never copy. While shared, the first field is kept
+   *  apart from the shared storage, so that giving a clone its own handle does not copy it.
+   *
+   *  Only the copy that is changed moves to new storage; the storage seen by the other copies is
+   *  left as is, so references into it stay valid. */
+  class IdfObjectFields {
+   public:
+    typedef std::vector<std::string> vector_type;
+    typedef vector_type::size_type size_type;
+
+    IdfObjectFields() : m_data(std::make_shared<vector_type>()) {}
+
+    IdfObjectFields(const vector_type& fields) : m_data(std::make_shared<vector_type>(fields)) {}
+
+    IdfObjectFields(vector_type&& fields) : m_data(std::make_shared<vector_type>(std::move(fields))) {}
+
+    size_type size() const { return m_data->size(); }
+
+    const std::string& operator[](size_type index) const {
+      if ((index == 0) && m_first) {
+        return *m_first;
+      }
+      return (*m_data)[index];
+    }
+
+    const std::string& back() const { return (*this)[size() - 1]; }
+
+    void set(size_type index, const std::string& value) {
+      if ((index == 0) && (m_first || isShared())) {
+        m_first = value;
+      }
+      else {
+        mutableData()[index] = value;
+      }
+    }
+
+    void push_back(const std::string& value) { mutableData().push_back(value); }
+
+    void pop_back() { mutableData().pop_back(); }
+
+    void resize(size_type n) {
+      if (n != size()) { mutableData().resize(n); }
+    }
+
+    /** Returns a copy of the field text. */
+    operator vector_type() const {
+      vector_type result(*m_data);
+      if (m_first) {
+        result[0] = *m_first;
+      }
+      return result;
+    }
+
+    /** Returns true if this storage is currently shared with another IdfObjectFields. */
+    bool isShared() const { return m_data.use_count() > 1; }
+
+   private:
+    vector_type& mutableData() {
+      if (isShared()) {
+        m_data = std::make_shared<vector_type>(*m_data);
+      }
+      if (m_first) {
+        (*m_data)[0] = std::move(*m_first);
+        m_first.reset();
+      }
+      return *m_data;
+    }
+
+    std::shared_ptr<vector_type> m_data;
+    boost::optional<std::string> m_first;
+  };
+
   /** Implementation of IdfObject. */
   class UTILITIES_API IdfObject_Impl : public std::enable_shared_from_this<IdfObject_Impl>,
                                        public Nano::Observer {
@@ -77,12 +154,13 @@ namespace detail {
     /** Constructor from iddObject. */
     explicit IdfObject_Impl(const IddObject& iddObject, bool fastName=false);
 
-    /** Constructor from underlying data. Used by WorkspaceObject_Impl. */
+    /** Constructor from underlying data. Used by WorkspaceObject_Impl. fields and fieldComments
+     *  are taken by value, pass temporaries to move them in. */
     IdfObject_Impl(const Handle& handle,
                    const std::string& comment,
                    const IddObject& iddObject,
-                   const StringVector& fields,
-                   const StringVector& fieldComments);
+                   StringVector fields,
+                   StringVector fieldComments);
 
     virtual ~IdfObject_Impl() {}
 
@@ -112,6 +190,9 @@ namespace detail {
     *  name will return the default name, if it exists. */
     std::string nameString(bool returnDefault = false) const;
 
+    /** Like nameString, but returns a view subject to the lifetime rules of getStringView. */
+    std::string_view nameStringView(bool returnDefault = false) const;
+
     /** Get a brief description of this object. Always includes iddObject().type(), and includes
      *  name() if available and not empty. */
     std::string briefDescription() const;
@@ -129,6 +210,14 @@ namespace detail {
                                                    bool returnDefault=false,
                                                    bool returnUninitializedEmpty=false) const;
 
+    /** Like getString, but returns a view of the stored text rather than a copy. The view points
+     *  into this object's field storage (or into the IddField properties for defaults) and is
+     *  only valid until any field of this object is changed, inserted or removed, or the object
+     *  is destroyed. Encoded special characters ('&#10' and the like) are not decoded. */
+    virtual boost::optional<std::string_view> getStringView(unsigned index,
+                                                            bool returnDefault=false,
+                                                            bool returnUninitializedEmpty=false) const;
+
     /** Get the value of the field at index, converted to double, if possible. Returns an
      *  uninitialized object if the conversion is unsuccessful for any reason. Logs a warning
      *  if the conversion fails, the field is RealType, and the field is not equal to
@@ -265,6 +354,10 @@ namespace detail {
     /** Returns the current number of fields in the object. */
     unsigned numFields() const;
 
+    /** Returns true if this object's field text is still shared with a clone (or the object it was
+     *  cloned from). */
+    bool fieldsShared() const { return m_fields.isShared(); }
+
     /** Returns the current number of non-extensible fields in the object. */
     unsigned numNonextensibleFields() const;
 
@@ -336,6 +429,10 @@ namespace detail {
      *  be invalid at enums::Strictness level None.) */
     static std::shared_ptr<IdfObject_Impl> load(const std::string& text,const IddObject& iddObject);
 
+    /** Constructor from text already split by IdfTokenizer and an explicit iddObject. Produces
+     *  the same object as load(text,iddObject) would for the tokenized text. */
+    static std::shared_ptr<IdfObject_Impl> load(const IdfObjectTokens& tokens,const IddObject& iddObject);
+
     /** Serialize this object to os as Idf text. */
     std::ostream& print(std::ostream& os) const;
 
@@ -348,6 +445,15 @@ namespace detail {
      *  field value is followed by a ','. Otherwise, the object is ended by using a ';'. */
     std::ostream& printField(std::ostream& os, unsigned index, bool isLastField=false) const;
 
+    /** Serialize this object as Idf text, appending it to buffer. */
+    std::string& print(std::string& buffer) const;
+
+    /** Append the text of printName(os,hasFields) to buffer. */
+    std::string& printName(std::string& buffer, bool hasFields=true) const;
+
+    /** Append the text of printField(os,index,isLastField) to buffer. */
+    std::string& printField(std::string& buffer, unsigned index, bool isLastField=false) const;
+
     //@}
     /** @name Type Casting */
     //@{
@@ -367,6 +473,12 @@ namespace detail {
     /** Emits signals after batch update and error checking is complete, clears the diffs */
     virtual void emitChangeSignals();
 
+    /** Returns the number of diffs waiting for emitChangeSignals. */
+    unsigned numDiffs() const;
+
+    /** Returns the approximate number of bytes used by the diffs waiting for emitChangeSignals. */
+    std::size_t diffMemoryUsage() const;
+
     //@}
 
     //@}
@@ -396,13 +508,28 @@ namespace detail {
     // idd object definition
     IddObject m_iddObject;
 
-    // idf fields
-    std::vector<std::string> m_fields;
+    // idf fields, shared with clones until either side changes them
+    IdfObjectFields m_fields;
     std::vector<std::string> m_fieldComments; // only populated if encounter non-empty, non-default comment
 
     // idf differences
     std::vector<IdfObjectDiff> m_diffs;
 
+    // diffs that recordDiff merged a change into while a DiffTransaction was open, with their
+    // positions in m_diffs, so that DiffTransaction::rollback can restore them
+    std::vector<std::pair<std::size_t, IdfObjectDiff> > m_mergedDiffs;
+    unsigned m_numDiffTransactions = 0;
+
+    // numeric value of a field, parsed on first request and kept until the field changes
+    struct ParsedField {
+      bool parsed = false;
+      bool converted = false; // false if the field text is not a number, "autosize" or "autocalculate"
+      boost::optional<double> value;
+    };
+    // parsed numeric values of m_fields, never longer than m_fields. const getters fill it in; like
+    // the rest of this class it is not synchronized, an object must not be read from two threads at once.
+    mutable std::vector<ParsedField> m_parsedFields;
+
     // GETTER HELPERS
 
     std::vector<std::string> fields() const;
@@ -424,6 +551,46 @@ namespace detail {
 
     virtual bool fieldIsNonnullIfRequired(unsigned index) const;
 
+    // SETTER HELPERS
+
+    /** Called by setName once the name field has been changed. oldName is the previous (decoded)
+     *  name, if there was one. */
+    virtual void nameFieldChanged(const boost::optional<std::string>& oldName) {}
+
+    /** Returns how diffs are kept until emitChangeSignals. Objects outside of a Workspace keep
+     *  every diff. */
+    virtual IdfObjectDiffMode diffMode() const;
+
+    /** Adds diff to m_diffs as directed by diffMode(). */
+    void recordDiff(const IdfObjectDiff& diff);
+
+    /** Marks the diffs of an operation that may have to be undone part way through. In Coalesced
+     *  and Off modes recordDiff merges changes into earlier diffs, so truncating m_diffs does not
+     *  undo them; rollback also restores the diffs that were merged into. Transactions nest. */
+    class DiffTransaction {
+     public:
+      explicit DiffTransaction(IdfObject_Impl& object);
+      ~DiffTransaction();
+
+      DiffTransaction(const DiffTransaction&) = delete;
+      DiffTransaction& operator=(const DiffTransaction&) = delete;
+
+      /** Restores m_diffs to what it was when this transaction was opened. */
+      void rollback();
+
+     private:
+      IdfObject_Impl& m_object;
+      std::size_t m_numDiffs;
+      std::size_t m_numMergedDiffs;
+    };
+
+    /** Forgets the parsed numeric value of field index. Call whenever m_fields[index] is changed. */
+    void invalidateParsedField(unsigned index);
+
+    /** Forgets the parsed numeric values of fields past the end of m_fields. Call whenever
+     *  m_fields shrinks. */
+    void trimParsedFields();
+
    private:
 
     IdfObject_Impl(){}
@@ -445,6 +612,9 @@ namespace detail {
     // parse fields
     void parseFields(const std::string& text);
 
+    // same as parse(text,false), for text already split by IdfTokenizer
+    void parse(const IdfObjectTokens& tokens);
+
     // GETTER AND SETTER HELPERS
 
     /** Set this object's IddObject to iddObject. */
@@ -456,13 +626,13 @@ namespace detail {
     // repeat indices as many times as necessary to fill out extensible groups in m_fields
     UnsignedVector repeatExtensibleIndices(const UnsignedVector& indices) const;
 
+    // Returns the parsed numeric value of m_fields[index], parsing it if necessary.
+    const ParsedField& parsedField(unsigned index) const;
+
     // QUERY HELPERS
 
     bool fieldDataIsWithinBounds(unsigned index) const;
 
-    /** Check fieldValue against bounds in iddField. */
-    bool withinBounds(double fieldValue,const IddField& iddField) const;
-
     // convert a user string to one that can be written to file
     std::string encodeString(const std::string& value) const;
 
@@ -0,0 +1,309 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2020, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include "IdfTokenizer.hpp"
+
+namespace openstudio {
+
+namespace {
+
+  // the space class of the classic locale, as used by boost::trim and by \s in idfRegex
+  inline bool isSpace(char c) {
+    return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\v') || (c == '\f') || (c == '\r');
+  }
+
+  // true if a regex '^' can match right after text[i]
+  inline bool isLineSeparator(std::string_view text, std::string::size_type i) {
+    char c = text[i];
+    if (c == '\r') {
+      return (i + 1 == text.size()) || (text[i + 1] != '\n');
+    }
+    return (c == '\n') || (c == '\f');
+  }
+
+  inline std::string::size_type skipSpace(std::string_view text,
+                                          std::string::size_type pos,
+                                          std::string::size_type end) {
+    while ((pos < end) && isSpace(text[pos])) {
+      ++pos;
+    }
+    return pos;
+  }
+
+  inline std::string_view trim(std::string_view text) {
+    std::string::size_type begin = skipSpace(text, 0, text.size());
+    std::string::size_type end = text.size();
+    while ((end > begin) && isSpace(text[end - 1])) {
+      --end;
+    }
+    return text.substr(begin, end - begin);
+  }
+
+  inline void trimRight(std::string& text) {
+    std::string::size_type end = text.size();
+    while ((end > 0) && isSpace(text[end - 1])) {
+      --end;
+    }
+    text.resize(end);
+  }
+
+  // matches idfRegex::commentOnlyLine() on a single line
+  inline bool isCommentOnlyLine(std::string_view line) {
+    std::string::size_type pos = skipSpace(line, 0, line.size());
+    return (pos < line.size()) && (line[pos] == '!');
+  }
+
+  // matches commentRegex::whitespaceOnlyLine()
+  inline bool isWhitespaceOnlyLine(std::string_view line) {
+    for (char c : line) {
+      if ((c != ' ') && (c != '\t')) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // matches idfRegex::objectEnd()
+  inline bool isObjectEndLine(std::string_view line) {
+    std::string::size_type pos = line.find_first_of(";!");
+    return (pos != std::string_view::npos) && (line[pos] == ';');
+  }
+
+  struct LineMatch {
+    std::string::size_type begin;     // matches[1].first
+    std::string::size_type separator; // position of the ',' or ';'
+    std::string::size_type lineEnd;   // matches[3].first, just past the next '\n'
+  };
+
+  // Equivalent of boost::regex_search on text.substr(start) with idfRegex::line(). The regex is
+  // searched from every position where '^' can match, and succeeds at the first of those from
+  // which a ',' or ';' can be reached without passing a '!'.
+  bool findLine(std::string_view text, std::string::size_type start, LineMatch& match) {
+    std::string::size_type n = text.size();
+    std::string::size_type pos = start;
+    while (pos < n) {
+      std::string::size_type i = text.find_first_of(",;!", pos);
+      if (i == std::string_view::npos) {
+        return false;
+      }
+      if (text[i] != '!') {
+        match.begin = pos;
+        match.separator = i;
+        std::string::size_type newLine = text.find('\n', i + 1);
+        match.lineEnd = (newLine == std::string_view::npos) ? n : newLine + 1;
+        return true;
+      }
+      // every line start up to the '!' fails the same way, try the next line
+      while ((i < n) && !isLineSeparator(text, i)) {
+        ++i;
+      }
+      if (i == n) {
+        return false;
+      }
+      pos = i + 1;
+    }
+    return false;
+  }
+
+  // Equivalent of repeatedly matching idfRegex::commentOnlyLine() and keeping the trim_left
+  // of the remaining text. Appends the comments in IdfObject::comment() format.
+  void readCommentLines(std::string_view text, std::string::size_type& pos, std::string& comment) {
+    std::string::size_type n = text.size();
+    while (true) {
+      std::string::size_type bang = skipSpace(text, pos, n);
+      if ((bang == n) || (text[bang] != '!')) {
+        return;
+      }
+      std::string::size_type newLine = text.find('\n', bang + 1);
+      std::string::size_type end = (newLine == std::string_view::npos) ? n : newLine;
+      if (end > bang + 1) {
+        comment += '!';
+        comment.append(text.data() + bang + 1, end - bang - 1);
+        comment += '\n';
+      }
+      pos = skipSpace(text, (newLine == std::string_view::npos) ? n : newLine + 1, n);
+    }
+  }
+
+} // anonymous namespace
+
+void IdfObjectTokens::clear() {
+  type = std::string_view();
+  comment.clear();
+  fields.clear();
+  fieldComments.clear();
+  unparsed = std::string_view();
+}
+
+IdfTokenizer::IdfTokenizer(std::string_view buffer)
+  : m_buffer(buffer), m_pos(0)
+{}
+
+bool IdfTokenizer::next(Block& block) {
+  std::string::size_type n = m_buffer.size();
+  std::string::size_type commentBegin = std::string_view::npos;
+
+  // same line classification as the regex based loader: comment-only, whitespace-only, or the
+  // start of an object
+  while (m_pos < n) {
+    std::string::size_type lineBegin = m_pos;
+    std::string::size_type newLine = m_buffer.find('\n', lineBegin);
+    std::string::size_type lineEnd = (newLine == std::string_view::npos) ? n : newLine;
+    m_pos = (newLine == std::string_view::npos) ? n : newLine + 1;
+    std::string_view line = m_buffer.substr(lineBegin, lineEnd - lineBegin);
+
+    if (isCommentOnlyLine(line)) {
+      if (commentBegin == std::string_view::npos) {
+        commentBegin = lineBegin;
+      }
+      continue;
+    }
+
+    if (isWhitespaceOnlyLine(line)) {
+      if (commentBegin != std::string_view::npos) {
+        block.type = CommentBlock;
+        block.text = m_buffer.substr(commentBegin, lineBegin - commentBegin);
+        block.objectType = std::string_view();
+        block.terminated = true;
+        block.position = m_pos;
+        return true;
+      }
+      continue;
+    }
+
+    // object, which takes ownership of any comment lines directly above it
+    std::string::size_type objectBegin = (commentBegin == std::string_view::npos) ? lineBegin : commentBegin;
+
+    LineMatch match;
+    if (findLine(line, 0, match)) {
+      block.objectType = trim(line.substr(match.begin, match.separator - match.begin));
+    }
+    else {
+      block.objectType = std::string_view();
+    }
+
+    bool terminated = isObjectEndLine(line);
+    while (!terminated && (m_pos < n)) {
+      lineBegin = m_pos;
+      newLine = m_buffer.find('\n', lineBegin);
+      lineEnd = (newLine == std::string_view::npos) ? n : newLine;
+      m_pos = (newLine == std::string_view::npos) ? n : newLine + 1;
+      terminated = isObjectEndLine(m_buffer.substr(lineBegin, lineEnd - lineBegin));
+    }
+
+    block.type = ObjectBlock;
+    block.text = m_buffer.substr(objectBegin, m_pos - objectBegin);
+    block.terminated = terminated;
+    block.position = m_pos;
+    return true;
+  }
+
+  return false;
+}
+
+bool IdfTokenizer::tokenizeObject(std::string_view text, IdfObjectTokens& tokens) {
+  tokens.clear();
+
+  // preceding comments
+  std::string::size_type pos = 0;
+  readCommentLines(text, pos, tokens.comment);
+
+  // object type
+  LineMatch match;
+  if (!findLine(text, pos, match)) {
+    return false;
+  }
+  tokens.type = trim(text.substr(match.begin, match.separator - match.begin));
+
+  // comment on the object type line, unless more fields follow on it
+  std::string::size_type rest = skipSpace(text, match.separator + 1, match.lineEnd);
+  if ((rest == match.lineEnd) || (text[rest] == '!')) {
+    tokens.comment.append(text.data() + rest, match.lineEnd - rest);
+    pos = match.lineEnd;
+  }
+  else {
+    pos = rest;
+  }
+
+  // trailing comments
+  readCommentLines(text, pos, tokens.comment);
+  trimRight(tokens.comment);
+
+  // fields
+  while (findLine(text, pos, match)) {
+    tokens.fields.push_back(trim(text.substr(match.begin, match.separator - match.begin)));
+    std::string_view fieldComment = trim(text.substr(match.separator + 1, match.lineEnd - match.separator - 1));
+    if (fieldComment.empty() || (fieldComment[0] == '!')) {
+      tokens.fieldComments.push_back(fieldComment);
+      pos = match.lineEnd;
+    }
+    else {
+      // there may be multiple fields on this line
+      tokens.fieldComments.push_back(std::string_view());
+      pos = match.separator + 1;
+    }
+  }
+
+  tokens.unparsed = trim(text.substr(pos));
+  return true;
+}
+
+void IdfTokenizer::normalizeNewlines(std::string& buffer) {
+  std::string::size_type i = buffer.find('\r');
+  if (i == std::string::npos) {
+    return;
+  }
+  std::string::size_type out = i;
+  for (std::string::size_type n = buffer.size(); i < n; ++i) {
+    if (buffer[i] == '\r') {
+      buffer[out++] = '\n';
+      if ((i + 1 < n) && (buffer[i + 1] == '\n')) {
+        ++i;
+      }
+    }
+    else {
+      buffer[out++] = buffer[i];
+    }
+  }
+  buffer.resize(out);
+}
+
+bool IdfTokenizer::isVersionObjectType(std::string_view objectType) {
+  // matches iddRegex::versionObjectName()
+  std::string::size_type pos = objectType.find("ersion", 1);
+  while (pos != std::string_view::npos) {
+    if ((objectType[pos - 1] == 'v') || (objectType[pos - 1] == 'V')) {
+      return true;
+    }
+    pos = objectType.find("ersion", pos + 1);
+  }
+  return false;
+}
+
+} // openstudio
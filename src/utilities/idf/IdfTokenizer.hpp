@@ -0,0 +1,127 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2020, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef UTILITIES_IDF_IDFTOKENIZER_HPP
+#define UTILITIES_IDF_IDFTOKENIZER_HPP
+
+#include "../UtilitiesAPI.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace openstudio {
+
+/** The text of a single IdfObject, split into its parts without using regular expressions. All
+ *  views point into the text passed to IdfTokenizer::tokenizeObject. */
+struct UTILITIES_API IdfObjectTokens {
+  /** The object type, e.g. "Zone" or "OS:Zone". */
+  std::string_view type;
+  /** Preceding, same-line and trailing comments on the object type, as IdfObject::comment()
+   *  returns them. */
+  std::string comment;
+  /** Trimmed field text, in order. */
+  std::vector<std::string_view> fields;
+  /** Trimmed comment following each field, or empty if there is none. Always the same size as
+   *  fields. */
+  std::vector<std::string_view> fieldComments;
+  /** Trimmed text that remains after the last field separator. */
+  std::string_view unparsed;
+
+  /** Clears all data, keeping allocated capacity. */
+  void clear();
+};
+
+/** Single-pass scanner over Idf text held in one contiguous buffer. It replaces the per-line
+ *  regular expressions in idfRegex for the hot paths of IdfFile and IdfObject loading, and
+ *  produces exactly the same splits they do. The buffer is not copied and must outlive the
+ *  tokenizer and any views it returns. */
+class UTILITIES_API IdfTokenizer {
+ public:
+  /** @name Constructors */
+  //@{
+
+  /** Scan buffer, which should already have its line endings converted to '\\n' (see
+   *  normalizeNewlines). */
+  explicit IdfTokenizer(std::string_view buffer);
+
+  //@}
+  /** @name Types */
+  //@{
+
+  enum BlockType {
+    /** A block of comment-only lines ended by a blank line. */
+    CommentBlock,
+    /** An object, together with the comment-only lines directly above it. */
+    ObjectBlock,
+  };
+
+  struct Block {
+    BlockType type;
+    /** For CommentBlock, the comment lines. For ObjectBlock, the comment lines and object text.
+     *  Lines keep their '\\n'. */
+    std::string_view text;
+    /** For ObjectBlock, the trimmed text before the first separator of the first object line,
+     *  or empty if the line does not have one. */
+    std::string_view objectType;
+    /** For ObjectBlock, true if a line ending the object with ';' was found before the end of
+     *  the buffer. */
+    bool terminated;
+    /** Number of buffer characters consumed so far. */
+    std::string::size_type position;
+  };
+
+  //@}
+  /** @name Scanning */
+  //@{
+
+  /** Advance to the next comment or object block. Returns false once the buffer is exhausted.
+   *  Blank lines, and blank-only comment blocks, are skipped. A trailing comment block that
+   *  is not followed by a blank line is dropped. */
+  bool next(Block& block);
+
+  /** Split the text of a single object into tokens. Returns false if no object type can be
+   *  found. */
+  static bool tokenizeObject(std::string_view text, IdfObjectTokens& tokens);
+
+  /** Convert "\\r\\n" and lone '\\r' line endings in buffer to '\\n', in place. */
+  static void normalizeNewlines(std::string& buffer);
+
+  /** Returns true if objectType names a version object. */
+  static bool isVersionObjectType(std::string_view objectType);
+
+  //@}
+ private:
+  std::string_view m_buffer;
+  std::string::size_type m_pos;
+};
+
+} // openstudio
+
+#endif // UTILITIES_IDF_IDFTOKENIZER_HPP
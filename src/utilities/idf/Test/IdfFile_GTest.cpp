@@ -34,12 +34,15 @@
 #include "../ValidityReport.hpp"
 
 #include "../../time/Time.hpp"
+#include "../../core/Compare.hpp"
 
 #include <resources.hxx>
 #include <utilities/idd/IddEnums.hxx>
 
 
 
+#include <boost/algorithm/string/replace.hpp>
+
 #include <iostream>
 #include <sstream>
 
@@ -102,6 +105,32 @@ TEST_F(IdfFixture, IdfFile_Header) {
   file.setHeader(header);
   EXPECT_EQ("! Multi-line \n! Non-comment.",file.header());
 }
+
+TEST_F(IdfFixture, IdfFile_LoadWithThreads) {
+  openstudio::path p = resourcesPath()/toPath("energyplus/HospitalBaseline/in.idf");
+  OptionalIdfFile serialFile = IdfFile::load(p, IddFileType::EnergyPlus, nullptr, 1);
+  ASSERT_TRUE(serialFile);
+
+  for (unsigned numThreads : {0u, 2u, 32u}) {
+    OptionalIdfFile parallelFile = IdfFile::load(p, IddFileType::EnergyPlus, nullptr, numThreads);
+    ASSERT_TRUE(parallelFile);
+    EXPECT_EQ(serialFile->header(), parallelFile->header());
+
+    // objects keep their file order no matter how many threads construct them
+    IdfObjectVector serialObjects = serialFile->objects();
+    IdfObjectVector parallelObjects = parallelFile->objects();
+    ASSERT_EQ(serialObjects.size(), parallelObjects.size());
+    for (unsigned i = 0, n = serialObjects.size(); i < n; ++i) {
+      ASSERT_EQ(serialObjects[i].iddObject().type(), parallelObjects[i].iddObject().type());
+      EXPECT_EQ(serialObjects[i].comment(), parallelObjects[i].comment());
+      ASSERT_EQ(serialObjects[i].numFields(), parallelObjects[i].numFields());
+      for (unsigned j = 0, m = serialObjects[i].numFields(); j < m; ++j) {
+        EXPECT_EQ(serialObjects[i].getString(j).get(), parallelObjects[i].getString(j).get());
+        EXPECT_TRUE(serialObjects[i].fieldComment(j) == parallelObjects[i].fieldComment(j));
+      }
+    }
+  }
+}
 /*
 TEST_F(IdfFixture, IdfFile_UnixLineEndings) {
   OptionalIdfFile oFile = IdfFile::load(resourcesPath()/toPath("utilities/Idf/UnixLineEndingTest.idf"));
@@ -160,3 +189,63 @@ TEST_F(IdfFixture, IdfFile_ObjectComments) {
   oFile->print(outFile);
 }
 */
+
+TEST_F(IdfFixture, IdfFile_LoadVersionOnly) {
+  openstudio::path dir = resourcesPath()/toPath("utilities/Idf/LoadVersionOnly");
+  openstudio::filesystem::create_directories(dir);
+
+  // start of the file, version object, and the version identifier loadVersionOnly should find
+  struct VersionCase {
+    std::string name;
+    std::string text;
+    boost::optional<std::string> version;
+  };
+  std::string padding;
+  for (unsigned i = 0; i < 2000; ++i) {
+    padding += "Timestep,\n  4;                       !- Number of Timesteps per Hour\n\n";
+  }
+  std::vector<VersionCase> cases {
+    {"Simple", "Version,9.3;\n", std::string("9.3")},
+    {"CommentOnlyHeader", "! File Header\n! Written by hand\n\nVersion,\n  9.2;                     !- Version Identifier\n\nTimestep,4;\n", std::string("9.2")},
+    {"CommentOnlyFile", "! File Header\n! No objects at all\n\n! Another comment block\n", boost::none},
+    {"NoVersion", "! File Header\n\nTimestep,4;\n", boost::none},
+    {"OSVersion", "OS:Version,\n  {d12a6bd2-2ef8-4a0a-9a34-ebd4a9f07a2e}, !- Handle\n  3.0.0;                  !- Version Identifier\n", std::string("3.0.0")},
+    {"OSVersionPrerelease", "OS:Version,\n  {d12a6bd2-2ef8-4a0a-9a34-ebd4a9f07a2e}, !- Handle\n  3.0.1,                  !- Version Identifier\n  rc2;                    !- Prerelease Identifier\n", std::string("3.0.1")},
+    {"EmptyVersion", "Version,\n  ;                        !- Version Identifier\n", boost::none},
+    {"VersionPastPrefix", padding + "Version,\n  9.1;                     !- Version Identifier\n", std::string("9.1")},
+    {"NoVersionPastPrefix", padding, boost::none},
+  };
+  for (const VersionCase& versionCase : cases) {
+    for (bool windows : {false, true}) {
+      std::string text = versionCase.text;
+      if (windows) {
+        text = boost::replace_all_copy(text, "\n", "\r\n");
+      }
+      openstudio::path p = dir/toPath(versionCase.name + (windows ? "_Windows.idf" : ".idf"));
+      {
+        openstudio::filesystem::ofstream outFile(p, std::ios_base::binary);
+        ASSERT_TRUE(outFile ? true : false);
+        outFile << text;
+      }
+
+      boost::optional<VersionString> version = IdfFile::loadVersionOnly(p);
+      if (versionCase.version) {
+        ASSERT_TRUE(version) << toString(p);
+        EXPECT_EQ(VersionString(*versionCase.version), *version) << toString(p);
+      }
+      else {
+        EXPECT_FALSE(version) << toString(p);
+      }
+
+      // same answer as the stream-based parse
+      std::stringstream ss(text);
+      boost::optional<VersionString> streamVersion = IdfFile::loadVersionOnly(ss);
+      EXPECT_EQ(static_cast<bool>(streamVersion), static_cast<bool>(version)) << toString(p);
+      if (streamVersion && version) {
+        EXPECT_EQ(*streamVersion, *version) << toString(p);
+      }
+    }
+  }
+
+  EXPECT_FALSE(IdfFile::loadVersionOnly(dir/toPath("DoesNotExist.idf")));
+}
@@ -44,6 +44,8 @@
 #include "../../units/OSOptionalQuantity.hpp"
 
 #include <utilities/idd/OS_Building_FieldEnums.hxx>
+#include <utilities/idd/BuildingSurface_Detailed_FieldEnums.hxx>
+#include <utilities/idd/Zone_FieldEnums.hxx>
 
 #include <resources.hxx>
 
@@ -51,6 +53,7 @@
 
 #include <sstream>
 #include <limits>
+#include <chrono>
 
 using namespace std;
 using namespace boost;
@@ -784,3 +787,257 @@ TEST_F(IdfFixture, IdfObject_SetDouble_NaN_and_Inf) {
   EXPECT_EQ(4u, object2.numExtensibleGroups());
 }
 
+
+TEST_F(IdfFixture, IdfObject_ParsedFieldCache) {
+  IdfObject object(IddObjectType::BuildingSurface_Detailed);
+  StringVector values;
+  values.push_back("2.1");
+  values.push_back("1.0E2");
+  values.push_back("0.000");
+  ASSERT_FALSE(object.pushExtensibleGroup(values).empty());
+  std::stringstream before;
+  object.print(before);
+
+  // cached values are returned until the field changes
+  ASSERT_TRUE(object.getDouble(11));
+  EXPECT_DOUBLE_EQ(100.0, object.getDouble(11).get());
+  ASSERT_TRUE(object.getInt(11));
+  EXPECT_EQ(100, object.getInt(11).get());
+  ASSERT_TRUE(object.getUnsigned(11));
+  EXPECT_EQ(100u, object.getUnsigned(11).get());
+  EXPECT_TRUE(object.setString(11, "-3.5"));
+  ASSERT_TRUE(object.getDouble(11));
+  EXPECT_DOUBLE_EQ(-3.5, object.getDouble(11).get());
+  ASSERT_TRUE(object.getInt(11));
+  EXPECT_EQ(-3, object.getInt(11).get());
+  EXPECT_FALSE(object.getUnsigned(11));
+  EXPECT_TRUE(object.setDouble(11, 100.0));
+  ASSERT_TRUE(object.getDouble(11));
+  EXPECT_DOUBLE_EQ(100.0, object.getDouble(11).get());
+  EXPECT_TRUE(object.setString(11, "autosize"));
+  EXPECT_FALSE(object.getDouble(11));
+  EXPECT_TRUE(object.setString(11, "Hi"));
+  EXPECT_FALSE(object.getDouble(11));
+  EXPECT_FALSE(object.getInt(11));
+  EXPECT_TRUE(object.setString(11, "1.0E2"));
+
+  // the text of the fields is untouched
+  std::stringstream after;
+  object.print(after);
+  EXPECT_EQ(before.str(), after.str());
+
+  // popped and re-pushed fields are parsed again
+  EXPECT_FALSE(object.popExtensibleGroup().empty());
+  values[1] = "7";
+  ASSERT_FALSE(object.pushExtensibleGroup(values).empty());
+  ASSERT_TRUE(object.getDouble(11));
+  EXPECT_DOUBLE_EQ(7.0, object.getDouble(11).get());
+
+  // repeated reads agree with parsing the field text each time
+  for (unsigned i = 0; i < 3; ++i) {
+    ASSERT_TRUE(object.getDouble(10 + i));
+    EXPECT_DOUBLE_EQ(boost::lexical_cast<double>(object.getString(10 + i).get()), object.getDouble(10 + i).get());
+    EXPECT_DOUBLE_EQ(object.getDouble(10 + i).get(), object.getDouble(10 + i).get());
+  }
+}
+
+namespace {
+
+  // coalesces its diffs like objects in a Workspace in IdfObjectDiffMode::Coalesced, and shows them
+  class CoalescingIdfObject_Impl : public openstudio::detail::IdfObject_Impl {
+   public:
+    CoalescingIdfObject_Impl() : IdfObject_Impl(IddObjectType::Zone) {}
+
+    using IdfObject_Impl::DiffTransaction;
+
+    const std::vector<IdfObjectDiff>& diffs() const { return m_diffs; }
+
+   protected:
+    virtual IdfObjectDiffMode diffMode() const override { return IdfObjectDiffMode::Coalesced; }
+  };
+
+}
+
+TEST_F(IdfFixture, IdfObject_DiffTransactionRollback) {
+  CoalescingIdfObject_Impl object;
+  EXPECT_TRUE(object.setString(ZoneFields::YOrigin, "0", false));
+  object.emitChangeSignals();
+  EXPECT_TRUE(object.setString(ZoneFields::XOrigin, "1", false));
+  ASSERT_EQ(1u, object.diffs().size());
+
+  // changes merged into an earlier diff are undone along with the diffs added after it
+  {
+    CoalescingIdfObject_Impl::DiffTransaction transaction(object);
+    EXPECT_TRUE(object.setString(ZoneFields::XOrigin, "2", false));
+    EXPECT_TRUE(object.setString(ZoneFields::YOrigin, "3", false));
+    EXPECT_TRUE(object.setString(ZoneFields::XOrigin, "4", false));
+    ASSERT_EQ(2u, object.diffs().size());
+    EXPECT_EQ("4", object.diffs()[0].newValue().get());
+    transaction.rollback();
+  }
+  ASSERT_EQ(1u, object.diffs().size());
+  EXPECT_EQ(static_cast<unsigned>(ZoneFields::XOrigin), object.diffs()[0].index().get());
+  EXPECT_EQ("1", object.diffs()[0].newValue().get());
+
+  // nested transactions that succeed are rolled back with the one they are part of
+  {
+    CoalescingIdfObject_Impl::DiffTransaction outer(object);
+    {
+      CoalescingIdfObject_Impl::DiffTransaction inner(object);
+      EXPECT_TRUE(object.setString(ZoneFields::XOrigin, "5", false));
+    }
+    EXPECT_EQ("5", object.diffs()[0].newValue().get());
+    outer.rollback();
+  }
+  ASSERT_EQ(1u, object.diffs().size());
+  EXPECT_EQ("1", object.diffs()[0].newValue().get());
+
+  // without a rollback the merged diff is kept
+  {
+    CoalescingIdfObject_Impl::DiffTransaction transaction(object);
+    EXPECT_TRUE(object.setString(ZoneFields::XOrigin, "6", false));
+  }
+  ASSERT_EQ(1u, object.diffs().size());
+  EXPECT_EQ("6", object.diffs()[0].newValue().get());
+}
+
+// timing only, run with --gtest_also_run_disabled_tests
+TEST_F(IdfFixture, DISABLED_IdfObject_ParsedFieldCache_Benchmark) {
+  IdfObject object(IddObjectType::BuildingSurface_Detailed);
+  StringVector values;
+  values.push_back("2.1");
+  values.push_back("1.0E2");
+  values.push_back("0.000");
+  ASSERT_FALSE(object.pushExtensibleGroup(values).empty());
+
+  // compare repeated reads against parsing the field text each time
+  unsigned n = 200000;
+  double sum1(0.0), sum2(0.0);
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < n; ++i) {
+    sum1 += boost::lexical_cast<double>(object.getString(10 + i % 3).get());
+  }
+  auto middle = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < n; ++i) {
+    sum2 += object.getDouble(10 + i % 3).get();
+  }
+  auto end = std::chrono::steady_clock::now();
+  EXPECT_DOUBLE_EQ(sum1, sum2);
+  LOG_FREE(Info, "IdfObject_ParsedFieldCache_Benchmark", n << " reads took "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(middle - start).count() << " ms with lexical_cast and "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(end - middle).count() << " ms with the parsed field cache.");
+}
+
+TEST_F(IdfFixture, IdfObject_GetStringView) {
+  IdfObject object(IddObjectType::BuildingSurface_Detailed);
+  EXPECT_TRUE(object.setName("Wall 1"));
+  EXPECT_TRUE(object.setString(BuildingSurface_DetailedFields::SurfaceType, "Wall"));
+  EXPECT_TRUE(object.setString(BuildingSurface_DetailedFields::SunExposure, ""));
+
+  // views agree with getString, including defaults and uninitialized empty fields
+  for (unsigned i = 0; i < object.numFields() + 2; ++i) {
+    for (bool returnDefault : {false, true}) {
+      for (bool returnUninitializedEmpty : {false, true}) {
+        OptionalString value = object.getString(i, returnDefault, returnUninitializedEmpty);
+        boost::optional<std::string_view> view = object.getStringView(i, returnDefault, returnUninitializedEmpty);
+        ASSERT_EQ(static_cast<bool>(value), static_cast<bool>(view)) << "field " << i;
+        if (value) {
+          EXPECT_EQ(*value, std::string(*view)) << "field " << i;
+        }
+      }
+    }
+  }
+  EXPECT_EQ("SunExposed", *object.getStringView(BuildingSurface_DetailedFields::SunExposure, true));
+  EXPECT_EQ("Wall 1", object.nameStringView());
+
+  // views refer to the stored text rather than to copies
+  EXPECT_EQ(object.getStringView(BuildingSurface_DetailedFields::SurfaceType)->data(),
+            object.getStringView(BuildingSurface_DetailedFields::SurfaceType)->data());
+
+  // special characters are not decoded
+  EXPECT_TRUE(object.setName("Wall, 1"));
+  EXPECT_EQ("Wall, 1", object.nameString());
+  EXPECT_EQ("Wall&#44 1", object.nameStringView());
+}
+
+TEST_F(IdfFixture, IdfObject_CloneSharesFields) {
+  IdfObject building(IddObjectType::OS_Building);
+  EXPECT_TRUE(building.setName("Building 1"));
+  EXPECT_TRUE(building.setDouble(OS_BuildingFields::NorthAxis, 30.0));
+  std::shared_ptr<openstudio::detail::IdfObject_Impl> buildingImpl = building.getImpl<openstudio::detail::IdfObject_Impl>();
+
+  // a clone gets its own handle without copying the other fields
+  IdfObject clone = building.clone();
+  std::shared_ptr<openstudio::detail::IdfObject_Impl> cloneImpl = clone.getImpl<openstudio::detail::IdfObject_Impl>();
+  EXPECT_TRUE(buildingImpl->fieldsShared());
+  EXPECT_TRUE(cloneImpl->fieldsShared());
+  EXPECT_NE(building.handle(), clone.handle());
+  EXPECT_EQ(toString(building.handle()), building.getString(0).get());
+  EXPECT_EQ(toString(clone.handle()), clone.getString(0).get());
+  EXPECT_EQ(building.numFields(), clone.numFields());
+  EXPECT_EQ("Building 1", clone.nameString());
+
+  // reading through non-const members does not copy
+  EXPECT_TRUE(clone.setFieldComment(OS_BuildingFields::NorthAxis, "rotated"));
+  EXPECT_TRUE(cloneImpl->fieldsShared());
+
+  // changing the clone copies its fields, views into the original stay valid
+  std::string_view name = building.nameStringView();
+  EXPECT_TRUE(clone.setName("Building 2"));
+  EXPECT_FALSE(cloneImpl->fieldsShared());
+  EXPECT_FALSE(buildingImpl->fieldsShared());
+  EXPECT_EQ("Building 1", name);
+  EXPECT_EQ("Building 2", clone.nameString());
+  EXPECT_EQ(toString(clone.handle()), clone.getString(0).get());
+  EXPECT_DOUBLE_EQ(30.0, clone.getDouble(OS_BuildingFields::NorthAxis).get());
+  EXPECT_EQ(toString(building.handle()), building.getString(0).get());
+}
+
+TEST_F(IdfFixture, IdfObject_Print) {
+  std::string text = "! A wall\n"
+                     "BuildingSurface:Detailed,\n"
+                     "  Wall 1,   ! first wall\n"
+                     "  Wall,\n"
+                     "  A Construction Name That Is Longer Than The Field Space,\n"
+                     "  Zone 1,\n"
+                     "  Outdoors, , SunExposed, WindExposed, autocalculate, 4,\n"
+                     "  0, 0, 3, 0, 0, 0, 10, 0, 0, 10, 0, 3;\n";
+  OptionalIdfObject object = IdfObject::load(text, *IddFactory::instance().getObject(IddObjectType::BuildingSurface_Detailed));
+  ASSERT_TRUE(object);
+
+  std::string expected = "! A wall\n"
+                         "BuildingSurface:Detailed,\n"
+                         "  Wall 1,                                 ! first wall\n"
+                         "  Wall,                                   !- Surface Type\n"
+                         "  A Construction Name That Is Longer Than The Field Space, !- Construction Name\n"
+                         "  Zone 1,                                 !- Zone Name\n"
+                         "  Outdoors,                               !- Outside Boundary Condition\n"
+                         "  ,                                       !- Outside Boundary Condition Object\n"
+                         "  SunExposed,                             !- Sun Exposure\n"
+                         "  WindExposed,                            !- Wind Exposure\n"
+                         "  autocalculate,                          !- View Factor to Ground\n"
+                         "  4,                                      !- Number of Vertices\n"
+                         "  0, 0, 3,                                !- X,Y,Z Vertex 1 {m}\n"
+                         "  0, 0, 0,                                !- X,Y,Z Vertex 2 {m}\n"
+                         "  10, 0, 0,                               !- X,Y,Z Vertex 3 {m}\n"
+                         "  10, 0, 3;                               !- X,Y,Z Vertex 4 {m}\n"
+                         "\n";
+
+  // appending to a buffer and printing to a stream give the same text
+  std::string buffer("existing text\n");
+  object->print(buffer);
+  EXPECT_EQ("existing text\n" + expected, buffer);
+
+  std::stringstream ss;
+  object->print(ss);
+  EXPECT_EQ(expected, ss.str());
+
+  // object without fields
+  IdfObject lead(IddObjectType::LeadInput);
+  ss.str("");
+  ss << lead;
+  buffer.clear();
+  lead.print(buffer);
+  EXPECT_EQ("Lead Input;\n\n", buffer);
+  EXPECT_EQ(buffer, ss.str());
+}
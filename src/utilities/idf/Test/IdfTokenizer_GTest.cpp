@@ -0,0 +1,243 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2020, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include <gtest/gtest.h>
+#include "IdfFixture.hpp"
+
+#include "../IdfTokenizer.hpp"
+#include "../IdfRegex.hpp"
+#include "../IdfFile.hpp"
+#include "../IdfObject.hpp"
+#include "../../idd/CommentRegex.hpp"
+#include "../../idd/IddFileAndFactoryWrapper.hpp"
+#include "../../core/Filesystem.hpp"
+
+#include <utilities/idd/IddEnums.hxx>
+
+#include <boost/algorithm/string.hpp>
+
+using namespace openstudio;
+
+namespace {
+
+  // Reference splitter: the line-by-line regular expression loop IdfFile used before
+  // IdfTokenizer, handing each object's text to IdfObject::load.
+  void regexLoad(std::istream& is, IddFileType iddFileType, std::string& header, std::vector<IdfObject>& objects) {
+    IddFileAndFactoryWrapper idd(iddFileType);
+    std::string line;
+    std::string comment;
+    boost::smatch matches;
+    bool firstBlock = true;
+    while (std::getline(is, line)) {
+      if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+      }
+      if (boost::regex_match(line, idfRegex::commentOnlyLine())) {
+        comment += (line + idfRegex::newLinestring());
+      } else if (boost::regex_match(line, commentRegex::whitespaceOnlyLine())) {
+        boost::trim(comment);
+        if (!comment.empty()) {
+          if (firstBlock) {
+            header = comment;
+            firstBlock = false;
+          } else {
+            OptionalIddObject commentOnly = idd.getObject(IddObjectType::CommentOnly);
+            ASSERT_TRUE(commentOnly);
+            OptionalIdfObject object = IdfObject::load(commentOnly->name() + ";" + comment, *commentOnly);
+            ASSERT_TRUE(object);
+            objects.push_back(*object);
+          }
+        }
+        comment = "";
+      } else {
+        firstBlock = false;
+        std::string objectType = "Catchall";
+        if (boost::regex_search(line, matches, idfRegex::line())) {
+          objectType = std::string(matches[1].first, matches[1].second);
+          boost::trim(objectType);
+        }
+        OptionalIddObject iddObject = idd.getObject(objectType);
+        if (!iddObject) {
+          iddObject = IddObject();
+        }
+        std::string text(comment + idfRegex::newLinestring() + line + idfRegex::newLinestring());
+        comment = "";
+        bool foundEndLine = boost::regex_match(line, idfRegex::objectEnd());
+        while (!foundEndLine && std::getline(is, line)) {
+          if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+          }
+          text += (line + idfRegex::newLinestring());
+          foundEndLine = boost::regex_match(line, idfRegex::objectEnd());
+        }
+        if (foundEndLine) {
+          if (OptionalIdfObject object = IdfObject::load(text, *iddObject)) {
+            objects.push_back(*object);
+          }
+        }
+      }
+    }
+  }
+
+  void expectSameObject(const IdfObject& expected, const IdfObject& actual) {
+    ASSERT_EQ(expected.iddObject().name(), actual.iddObject().name());
+    EXPECT_EQ(expected.comment(), actual.comment());
+    if (expected.iddObject().hasHandleField()) {
+      EXPECT_EQ(expected.handle(), actual.handle());
+    }
+    ASSERT_EQ(expected.numFields(), actual.numFields()) << expected;
+    for (unsigned i = 0; i < expected.numFields(); ++i) {
+      EXPECT_EQ(expected.getString(i).get(), actual.getString(i).get());
+      EXPECT_TRUE(expected.fieldComment(i) == actual.fieldComment(i)) << expected;
+    }
+  }
+
+}
+
+TEST_F(IdfFixture, IdfTokenizer_TokenizeObject)
+{
+  std::string text = "! leading comment\n"
+                     "  Zone,  ! type comment\n"
+                     "    Zone 1,                 !- Name\n"
+                     "    0, 0.0,\n"
+                     "    ! comment between fields\n"
+                     "    , 1;   !- Last field\n";
+  IdfObjectTokens tokens;
+  ASSERT_TRUE(IdfTokenizer::tokenizeObject(text, tokens));
+  EXPECT_EQ("Zone", tokens.type);
+  EXPECT_EQ("! leading comment\n! type comment", tokens.comment);
+  ASSERT_EQ(5u, tokens.fields.size());
+  ASSERT_EQ(tokens.fields.size(), tokens.fieldComments.size());
+  EXPECT_EQ("Zone 1", tokens.fields[0]);
+  EXPECT_EQ("!- Name", tokens.fieldComments[0]);
+  EXPECT_EQ("0", tokens.fields[1]);
+  EXPECT_EQ("", tokens.fieldComments[1]);
+  EXPECT_EQ("0.0", tokens.fields[2]);
+  EXPECT_EQ("", tokens.fields[3]);
+  EXPECT_EQ("1", tokens.fields[4]);
+  EXPECT_EQ("!- Last field", tokens.fieldComments[4]);
+  EXPECT_TRUE(tokens.unparsed.empty());
+
+  // no object type
+  EXPECT_FALSE(IdfTokenizer::tokenizeObject("! only a comment\n", tokens));
+
+  std::string dos = "a\r\nb\rc\n\r\n";
+  IdfTokenizer::normalizeNewlines(dos);
+  EXPECT_EQ("a\nb\nc\n\n", dos);
+}
+
+TEST_F(IdfFixture, IdfTokenizer_Blocks)
+{
+  std::string text = "! header\n"
+                     "\n"
+                     "Version, 9.0;\n"
+                     "\n"
+                     "! comment object\n"
+                     "\n"
+                     "! zone comment\n"
+                     "Zone,\n"
+                     "  Zone 1;\n"
+                     "\n"
+                     "Zone, unterminated,\n";
+  IdfTokenizer tokenizer(text);
+  IdfTokenizer::Block block;
+
+  ASSERT_TRUE(tokenizer.next(block));
+  EXPECT_EQ(IdfTokenizer::CommentBlock, block.type);
+  EXPECT_EQ("! header\n", block.text);
+
+  ASSERT_TRUE(tokenizer.next(block));
+  EXPECT_EQ(IdfTokenizer::ObjectBlock, block.type);
+  EXPECT_EQ("Version", block.objectType);
+  EXPECT_TRUE(block.terminated);
+  EXPECT_TRUE(IdfTokenizer::isVersionObjectType(block.objectType));
+
+  ASSERT_TRUE(tokenizer.next(block));
+  EXPECT_EQ(IdfTokenizer::CommentBlock, block.type);
+  EXPECT_EQ("! comment object\n", block.text);
+
+  ASSERT_TRUE(tokenizer.next(block));
+  EXPECT_EQ(IdfTokenizer::ObjectBlock, block.type);
+  EXPECT_EQ("Zone", block.objectType);
+  EXPECT_EQ("! zone comment\nZone,\n  Zone 1;\n", block.text);
+  EXPECT_TRUE(block.terminated);
+  EXPECT_FALSE(IdfTokenizer::isVersionObjectType(block.objectType));
+
+  ASSERT_TRUE(tokenizer.next(block));
+  EXPECT_EQ(IdfTokenizer::ObjectBlock, block.type);
+  EXPECT_FALSE(block.terminated);
+  EXPECT_EQ(text.size(), block.position);
+
+  EXPECT_FALSE(tokenizer.next(block));
+}
+
+// Every Idf and Osm file in resources must load exactly as the regular expression parser did.
+TEST_F(IdfFixture, IdfTokenizer_MatchesRegexParser)
+{
+  unsigned numFiles = 0;
+  for (const auto& entry : openstudio::filesystem::recursive_directory_iterator(resourcesPath())) {
+    openstudio::path p = entry.path();
+    std::string ext = boost::to_lower_copy(toString(p.extension()));
+    IddFileType iddFileType;
+    if (ext == ".idf") {
+      iddFileType = IddFileType::EnergyPlus;
+    } else if (ext == ".osm") {
+      iddFileType = IddFileType::OpenStudio;
+    } else {
+      continue;
+    }
+    SCOPED_TRACE(toString(p));
+
+    std::string header;
+    std::vector<IdfObject> objects;
+    {
+      openstudio::filesystem::ifstream is(p);
+      regexLoad(is, iddFileType, header, objects);
+    }
+    IdfFile reference(iddFileType);
+    reference.setHeader(header);
+    for (const IdfObject& object : objects) {
+      reference.addObject(object);
+    }
+
+    OptionalIdfFile idfFile = IdfFile::load(p, iddFileType);
+    if (!idfFile) {
+      continue;
+    }
+    ++numFiles;
+    EXPECT_EQ(reference.header(), idfFile->header());
+    IdfObjectVector expected = reference.objects();
+    IdfObjectVector actual = idfFile->objects();
+    ASSERT_EQ(expected.size(), actual.size());
+    for (unsigned i = 0; i < expected.size(); ++i) {
+      expectSameObject(expected[i], actual[i]);
+    }
+  }
+  EXPECT_LT(0u, numFiles);
+}
@@ -36,6 +36,7 @@
 #include <utilities/idd/Schedule_Compact_FieldEnums.hxx>
 #include <utilities/idd/OS_DaylightingDevice_Shelf_FieldEnums.hxx>
 #include <utilities/idd/OS_SetpointManager_MixedAir_FieldEnums.hxx>
+#include <utilities/idd/BuildingSurface_Detailed_FieldEnums.hxx>
 
 #include "../WorkspaceExtensibleGroup.hpp"
 #include "../IdfFile.hpp"
@@ -515,6 +516,126 @@ TEST_F(IdfFixture, WorkspaceObject_Filter_Sources)
 }
 
 
+namespace {
+
+  // getSources(type) must agree with filtering all sources by type
+  void checkSourcesByType(const WorkspaceObject& target, IddObjectType type) {
+    HandleVector expected;
+    for (const WorkspaceObject& source : target.sources()) {
+      if (source.iddObject().type() == type) {
+        expected.push_back(source.handle());
+      }
+    }
+    HandleVector actual = getHandles(target.getSources(type));
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    EXPECT_EQ(expected, actual);
+  }
+
+}
+
+TEST_F(IdfFixture, WorkspaceObject_SourcesByType)
+{
+  Workspace ws(epIdfFile, StrictnessLevel::Final);
+  ASSERT_EQ(StrictnessLevel::Final, ws.strictnessLevel().value());
+
+  // find a zone with surfaces and lights
+  OptionalWorkspaceObject zone;
+  for (const WorkspaceObject& candidate : ws.getObjectsByType(IddObjectType::Zone)) {
+    if (!candidate.getSources(IddObjectType::BuildingSurface_Detailed).empty() &&
+        !candidate.getSources(IddObjectType::Lights).empty())
+    {
+      zone = candidate;
+      break;
+    }
+  }
+  ASSERT_TRUE(zone);
+  unsigned nSurfaces = zone->getSources(IddObjectType::BuildingSurface_Detailed).size();
+  unsigned nLights = zone->getSources(IddObjectType::Lights).size();
+  for (const WorkspaceObject& surface : zone->getSources(IddObjectType::BuildingSurface_Detailed)) {
+    EXPECT_EQ(IddObjectType(IddObjectType::BuildingSurface_Detailed), surface.iddObject().type());
+  }
+  EXPECT_TRUE(zone->getSources(IddObjectType::Window).empty());
+  checkSourcesByType(*zone, IddObjectType::BuildingSurface_Detailed);
+  checkSourcesByType(*zone, IddObjectType::Lights);
+
+  // removing lights shrinks only the lights slice, adding them back restores it
+  WorkspaceObject lights = zone->getSources(IddObjectType::Lights)[0];
+  IdfObject lightsData = lights.idfObject();
+  EXPECT_TRUE(ws.removeObject(lights.handle()));
+  EXPECT_EQ(nLights - 1, zone->getSources(IddObjectType::Lights).size());
+  EXPECT_EQ(nSurfaces, zone->getSources(IddObjectType::BuildingSurface_Detailed).size());
+  checkSourcesByType(*zone, IddObjectType::Lights);
+  OptionalWorkspaceObject restoredLights = ws.addObject(lightsData);
+  ASSERT_TRUE(restoredLights);
+  EXPECT_EQ(nLights, zone->getSources(IddObjectType::Lights).size());
+  checkSourcesByType(*zone, IddObjectType::Lights);
+}
+
+TEST_F(IdfFixture, WorkspaceObject_RelinkSources)
+{
+  Workspace ws(epIdfFile, StrictnessLevel::Final);
+  ASSERT_EQ(StrictnessLevel::Final, ws.strictnessLevel().value());
+
+  OptionalWorkspaceObject zone;
+  for (const WorkspaceObject& candidate : ws.getObjectsByType(IddObjectType::Zone)) {
+    if (!candidate.getSources(IddObjectType::BuildingSurface_Detailed).empty() &&
+        !candidate.getSources(IddObjectType::Lights).empty())
+    {
+      zone = candidate;
+      break;
+    }
+  }
+  ASSERT_TRUE(zone);
+  unsigned nSurfaces = zone->getSources(IddObjectType::BuildingSurface_Detailed).size();
+  unsigned nLights = zone->getSources(IddObjectType::Lights).size();
+
+  // removing the zone would invalidate its surfaces, so the removal is undone and every
+  // source points at the zone again
+  EXPECT_FALSE(ws.removeObject(zone->handle()));
+  ASSERT_TRUE(ws.isMember(zone->handle()));
+  EXPECT_EQ(nSurfaces, zone->getSources(IddObjectType::BuildingSurface_Detailed).size());
+  EXPECT_EQ(nLights, zone->getSources(IddObjectType::Lights).size());
+  checkSourcesByType(*zone, IddObjectType::BuildingSurface_Detailed);
+  checkSourcesByType(*zone, IddObjectType::Lights);
+  for (const WorkspaceObject& surface : zone->getSources(IddObjectType::BuildingSurface_Detailed)) {
+    ASSERT_TRUE(surface.getTarget(BuildingSurface_DetailedFields::ZoneName));
+    EXPECT_EQ(zone->handle(), surface.getTarget(BuildingSurface_DetailedFields::ZoneName)->handle());
+  }
+
+  // swapping in a new zone moves every source to the new object
+  IdfObject newZone(IddObjectType::Zone);
+  EXPECT_TRUE(newZone.setName("Swapped Zone"));
+  WorkspaceObject currentZone = *zone;
+  Handle oldHandle = currentZone.handle();
+  EXPECT_TRUE(ws.swap(currentZone, newZone, true));
+  EXPECT_NE(oldHandle, currentZone.handle());
+  EXPECT_EQ(nSurfaces, currentZone.getSources(IddObjectType::BuildingSurface_Detailed).size());
+  EXPECT_EQ(nLights, currentZone.getSources(IddObjectType::Lights).size());
+  checkSourcesByType(currentZone, IddObjectType::BuildingSurface_Detailed);
+  checkSourcesByType(currentZone, IddObjectType::Lights);
+  for (const WorkspaceObject& surface : currentZone.getSources(IddObjectType::BuildingSurface_Detailed)) {
+    ASSERT_TRUE(surface.getTarget(BuildingSurface_DetailedFields::ZoneName));
+    EXPECT_EQ(currentZone.handle(), surface.getTarget(BuildingSurface_DetailedFields::ZoneName)->handle());
+  }
+
+  // swapping workspaces keeps the sources with their objects, and the objects report the
+  // workspace that now owns them
+  Workspace other(StrictnessLevel::Draft, IddFileType::EnergyPlus);
+  ws.swap(other);
+  EXPECT_EQ(0u, ws.numObjects());
+  EXPECT_TRUE(other.isMember(currentZone.handle()));
+  EXPECT_TRUE(currentZone.workspace() == other);
+  EXPECT_EQ(nSurfaces, currentZone.getSources(IddObjectType::BuildingSurface_Detailed).size());
+  EXPECT_EQ(nLights, currentZone.getSources(IddObjectType::Lights).size());
+  checkSourcesByType(currentZone, IddObjectType::BuildingSurface_Detailed);
+
+  // changes to swapped objects are seen by their new workspace
+  EXPECT_TRUE(currentZone.setName("Renamed Swapped Zone"));
+  ASSERT_TRUE(other.getObjectByTypeAndName(IddObjectType::Zone, "Renamed Swapped Zone"));
+  EXPECT_EQ(currentZone.handle(), other.getObjectByTypeAndName(IddObjectType::Zone, "Renamed Swapped Zone")->handle());
+}
+
 TEST_F(IdfFixture, WorkspaceObject_SetDouble_NaN_and_Inf) {
 
   // try with an WorkspaceObject
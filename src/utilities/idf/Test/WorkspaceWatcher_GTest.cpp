@@ -30,10 +30,14 @@
 #include <gtest/gtest.h>
 #include "IdfFixture.hpp"
 #include "../WorkspaceWatcher.hpp"
+#include "../WorkspaceBatchEdit.hpp"
+#include "../IdfObjectWatcher.hpp"
 #include "../Workspace.hpp"
+#include "../Workspace_Impl.hpp"
 #include "../WorkspaceObject.hpp"
 #include "../IdfExtensibleGroup.hpp"
 #include <utilities/idd/IddEnums.hxx>
+#include <utilities/idd/Lights_FieldEnums.hxx>
 
 #include <resources.hxx>
 
@@ -101,3 +105,128 @@ TEST_F(IdfFixture,WorkspaceWatcher_RemoveObjects)
   EXPECT_TRUE(result[0].handle().isNull());
 }
 
+namespace {
+
+  class CountingWorkspaceWatcher : public WorkspaceWatcher {
+   public:
+    CountingWorkspaceWatcher(const Workspace& workspace) : WorkspaceWatcher(workspace), numChanges(0) {}
+    virtual void onChangeWorkspace() override { ++numChanges; }
+    unsigned numChanges;
+  };
+
+  struct BatchChangeReceiver : public Nano::Observer {
+    std::vector<std::vector<Handle> > batches;
+    void batchChange(const std::vector<Handle>& handles) { batches.push_back(handles); }
+  };
+
+  class ThrowingWorkspaceWatcher : public WorkspaceWatcher {
+   public:
+    ThrowingWorkspaceWatcher(const Workspace& workspace) : WorkspaceWatcher(workspace) {}
+    virtual void onObjectAdd(const WorkspaceObject& addedObject) override {
+      WorkspaceWatcher::onObjectAdd(addedObject);
+      throw std::runtime_error("Slot failed.");
+    }
+  };
+
+}
+
+TEST_F(IdfFixture,WorkspaceWatcher_BatchEdit)
+{
+  Workspace workspace(epIdfFile);
+  CountingWorkspaceWatcher watcher(workspace);
+  BatchChangeReceiver receiver;
+  workspace.getImpl<openstudio::detail::Workspace_Impl>().get()->openstudio::detail::Workspace_Impl::onBatchChange.connect<BatchChangeReceiver, &BatchChangeReceiver::batchChange>(&receiver);
+
+  WorkspaceObjectVector lights = workspace.getObjectsByType(IddObjectType::Lights);
+  ASSERT_TRUE(lights.size() > 1u);
+  IdfObjectWatcher objectWatcher(lights[0]);
+
+  OptionalWorkspaceObject newLights;
+  {
+    WorkspaceBatchEdit batchEdit(workspace);
+    EXPECT_TRUE(workspace.isBatchEditing());
+    for (WorkspaceObject& object : lights) {
+      EXPECT_TRUE(object.setDouble(LightsFields::FractionRadiant,0.317));
+    }
+    {
+      WorkspaceBatchEdit innerBatchEdit(workspace);
+      EXPECT_TRUE(lights[1].setName("Batch Edited Lights"));
+      newLights = workspace.addObject(IdfObject(IddObjectType::Lights));
+      ASSERT_TRUE(newLights);
+    }
+    EXPECT_TRUE(workspace.isBatchEditing());
+
+    // values are current, and objects still see onChange, but nothing else has gone out
+    EXPECT_DOUBLE_EQ(0.317,lights[0].getDouble(LightsFields::FractionRadiant).get());
+    EXPECT_EQ("Batch Edited Lights",lights[1].name().get());
+    EXPECT_TRUE(objectWatcher.dirty());
+    EXPECT_FALSE(objectWatcher.dataChanged());
+    EXPECT_EQ(0u,watcher.numChanges);
+    EXPECT_FALSE(watcher.objectAdded());
+    EXPECT_TRUE(receiver.batches.empty());
+  }
+  EXPECT_FALSE(workspace.isBatchEditing());
+
+  EXPECT_TRUE(objectWatcher.dataChanged());
+  EXPECT_EQ(1u,watcher.numChanges);
+  EXPECT_TRUE(watcher.objectAdded());
+  ASSERT_EQ(1u,receiver.batches.size());
+  HandleVector batch = receiver.batches[0];
+  EXPECT_EQ(lights.size() + 1,batch.size());
+  EXPECT_NE(batch.end(),std::find(batch.begin(),batch.end(),newLights->handle()));
+  for (const WorkspaceObject& object : lights) {
+    EXPECT_NE(batch.end(),std::find(batch.begin(),batch.end(),object.handle()));
+  }
+
+  // removal is signaled immediately, onChange still waits
+  watcher.clearState();
+  workspace.beginBatchEdit();
+  EXPECT_TRUE(workspace.removeObject(newLights->handle()));
+  EXPECT_TRUE(watcher.objectRemoved());
+  EXPECT_EQ(1u,watcher.numChanges);
+  workspace.endBatchEdit();
+  EXPECT_EQ(2u,watcher.numChanges);
+  ASSERT_EQ(2u,receiver.batches.size());
+  EXPECT_EQ(1u,receiver.batches[1].size());
+
+  // outside of a batch edit, signals go out per change
+  EXPECT_TRUE(lights[0].setDouble(LightsFields::FractionRadiant,0.4));
+  EXPECT_EQ(3u,watcher.numChanges);
+  EXPECT_EQ(2u,receiver.batches.size());
+}
+
+TEST_F(IdfFixture,WorkspaceWatcher_BatchEdit_ThrowingSlot)
+{
+  Workspace workspace(epIdfFile);
+  ThrowingWorkspaceWatcher watcher(workspace);
+
+  // the destructor logs the exception and ends the batch edit
+  EXPECT_NO_THROW({
+    WorkspaceBatchEdit batchEdit(workspace);
+    EXPECT_TRUE(workspace.addObject(IdfObject(IddObjectType::Lights)));
+  });
+  EXPECT_TRUE(watcher.objectAdded());
+  EXPECT_FALSE(workspace.isBatchEditing());
+
+  // commit passes the exception on, and also ends the batch edit
+  watcher.clearState();
+  {
+    WorkspaceBatchEdit batchEdit(workspace);
+    EXPECT_TRUE(workspace.addObject(IdfObject(IddObjectType::Lights)));
+    EXPECT_THROW(batchEdit.commit(),std::runtime_error);
+    EXPECT_FALSE(workspace.isBatchEditing());
+    EXPECT_NO_THROW(batchEdit.commit());
+  }
+  EXPECT_TRUE(watcher.objectAdded());
+  EXPECT_FALSE(workspace.isBatchEditing());
+
+  // and the workspace batches as usual afterwards
+  CountingWorkspaceWatcher counter(workspace);
+  {
+    WorkspaceBatchEdit batchEdit(workspace);
+    EXPECT_TRUE(workspace.getObjectsByType(IddObjectType::Lights)[0].setDouble(LightsFields::FractionRadiant,0.2));
+    EXPECT_TRUE(workspace.isBatchEditing());
+    EXPECT_EQ(0u,counter.numChanges);
+  }
+  EXPECT_EQ(1u,counter.numChanges);
+}
@@ -34,12 +34,15 @@
 #include "../Workspace.hpp"
 #include "../Workspace_Impl.hpp"
 #include "../WorkspaceObject.hpp"
+#include "../WorkspaceObject_Impl.hpp"
 #include "../WorkspaceObjectOrder.hpp"
 #include "../ValidityReport.hpp"
 #include "../IdfExtensibleGroup.hpp"
 #include "../WorkspaceExtensibleGroup.hpp"
+#include "../WorkspaceSnapshot.hpp"
 
 #include "../../idd/IddEnums.hpp"
+#include "../../idd/IddObjectValidation.hpp"
 #include <utilities/idd/IddEnums.hxx>
 #include <utilities/idd/IddFactory.hxx>
 #include <utilities/idd/Building_FieldEnums.hxx>
@@ -55,9 +58,11 @@
 #include <utilities/idd/Sizing_Zone_FieldEnums.hxx>
 #include <utilities/idd/OS_WeatherFile_FieldEnums.hxx>
 #include "../WorkspaceWatcher.hpp"
+#include "../WorkspaceObjectWatcher.hpp"
 #include "IdfTestQObjects.hpp"
 
 #include "../../core/Path.hpp"
+#include "../../core/Filesystem.hpp"
 #include "../../core/Optional.hpp"
 
 #include "../../time/Time.hpp"
@@ -67,12 +72,17 @@
 
 #include <resources.hxx>
 
+#include <boost/lexical_cast.hpp>
+
 
 
 
 using namespace openstudio;
 
 #include <iostream>
+#include <chrono>
+#include <set>
+#include <sstream>
 
 TEST_F(IdfFixture, IdfFile_Workspace_DefaultConstructor)
 {
@@ -140,6 +150,14 @@ TEST_F(IdfFixture, ObjectGettersAndSetters_StrictnessNone)
   result = workspace.getObjectsByReference("CustomMeterNames");
   LOG(Info,"There are " << result.size() << " objects that can be accessed with \\object-list CustomMeterNames.");
 
+  // looking up an unknown reference list does not register its name
+  EXPECT_TRUE(workspace.getObjectsByReference("Workspace_GettersNoSuchReference").empty());
+  EXPECT_TRUE(workspace.getObjectsByReference(StringVector(1, "Workspace_GettersNoSuchReference")).empty());
+  EXPECT_FALSE(workspace.canBeTarget(result.empty() ? createUUID() : result[0].handle(),
+                                     std::set<std::string>{"Workspace_GettersNoSuchReference"}));
+  EXPECT_FALSE(ReferenceListSet::findId("Workspace_GettersNoSuchReference"));
+  EXPECT_TRUE(ReferenceListSet::findId("ZoneNames"));
+
 }
 
 TEST_F(IdfFixture, Workspace_StateCheckingAndRepair_ValidityCheckingAndReports)
@@ -552,6 +570,51 @@ TEST_F(IdfFixture, Workspace_Clone) {
   EXPECT_FALSE(cloneHandles == wsHandles);
 }
 
+TEST_F(IdfFixture, Workspace_Clone_KeepHandles_CopyOnWrite) {
+  Workspace workspace(epIdfFile,StrictnessLevel::None);
+  Workspace clone = workspace.clone(true);
+  HandleVector wsHandles = workspace.handles();
+  HandleVector cloneHandles = clone.handles();
+  std::sort(wsHandles.begin(),wsHandles.end());
+  std::sort(cloneHandles.begin(),cloneHandles.end());
+  EXPECT_EQ(wsHandles,cloneHandles);
+  for (const WorkspaceObject& object : clone.objects()) {
+    EXPECT_TRUE(object.getImpl<detail::WorkspaceObject_Impl>()->fieldsShared());
+  }
+
+  WorkspaceObjectVector wsLights = workspace.getObjectsByType(IddObjectType::Lights);
+  ASSERT_FALSE(wsLights.empty());
+  OptionalWorkspaceObject cloneLights = clone.getObject(wsLights[0].handle());
+  ASSERT_TRUE(cloneLights);
+  EXPECT_EQ(wsLights[0].name().get(),cloneLights->name().get());
+  std::string originalName = wsLights[0].name().get();
+
+  // changing the clone leaves the original alone
+  EXPECT_TRUE(cloneLights->setName("Clone Lights"));
+  EXPECT_TRUE(cloneLights->setDouble(LightsFields::FractionRadiant,0.25));
+  EXPECT_EQ(originalName,wsLights[0].name().get());
+  EXPECT_EQ("Clone Lights",cloneLights->name().get());
+  ASSERT_TRUE(cloneLights->getDouble(LightsFields::FractionRadiant));
+  EXPECT_DOUBLE_EQ(0.25,cloneLights->getDouble(LightsFields::FractionRadiant).get());
+  OptionalDouble wsFraction = wsLights[0].getDouble(LightsFields::FractionRadiant);
+  EXPECT_FALSE(wsFraction && (*wsFraction == 0.25));
+
+  // and changing the original leaves the clone alone
+  EXPECT_TRUE(wsLights[0].setDouble(LightsFields::FractionRadiant,0.5));
+  EXPECT_DOUBLE_EQ(0.5,wsLights[0].getDouble(LightsFields::FractionRadiant).get());
+  EXPECT_DOUBLE_EQ(0.25,cloneLights->getDouble(LightsFields::FractionRadiant).get());
+
+  // untouched objects still match field for field
+  WorkspaceObjectVector wsZones = workspace.getObjectsByType(IddObjectType::Zone);
+  ASSERT_FALSE(wsZones.empty());
+  OptionalWorkspaceObject cloneZone = clone.getObject(wsZones[0].handle());
+  ASSERT_TRUE(cloneZone);
+  ASSERT_EQ(wsZones[0].numFields(),cloneZone->numFields());
+  for (unsigned i = 0, n = wsZones[0].numFields(); i < n; ++i) {
+    EXPECT_EQ(wsZones[0].getString(i),cloneZone->getString(i));
+  }
+}
+
 TEST_F(IdfFixture,Workspace_Insert) {
   Workspace workspace(epIdfFile,StrictnessLevel::None);
   unsigned n = workspace.handles().size();
@@ -2149,3 +2212,764 @@ TEST_F(IdfFixture, Workspace_getObjects_Type_StringOverload) {
   }
 
 }
+
+// name lookups go through the Workspace name maps, make sure they always agree with a full scan
+void checkNameLookupsAgainstFullScan(const Workspace& workspace) {
+  std::vector<WorkspaceObject> objects = workspace.objects();
+  for (const WorkspaceObject& object : objects) {
+    OptionalString name = object.name();
+    if (!name || name->empty()) {
+      continue;
+    }
+
+    std::set<Handle> expected;
+    std::set<Handle> expectedOfType;
+    for (const WorkspaceObject& candidate : objects) {
+      OptionalString candidateName = candidate.name();
+      if (candidateName && istringEqual(*candidateName, *name)) {
+        expected.insert(candidate.handle());
+        if (candidate.iddObject().type() == object.iddObject().type()) {
+          expectedOfType.insert(candidate.handle());
+        }
+      }
+    }
+
+    std::set<Handle> actual;
+    for (const WorkspaceObject& candidate : workspace.getObjectsByName(boost::to_upper_copy(*name))) {
+      actual.insert(candidate.handle());
+    }
+    EXPECT_TRUE(expected == actual) << "Name lookup of '" << *name << "' disagrees with full scan.";
+
+    OptionalWorkspaceObject byTypeAndName = workspace.getObjectByTypeAndName(object.iddObject().type(), *name);
+    ASSERT_TRUE(byTypeAndName);
+    EXPECT_TRUE(expectedOfType.find(byTypeAndName->handle()) != expectedOfType.end());
+  }
+}
+
+TEST_F(IdfFixture, Workspace_NameLookups) {
+  Workspace workspace(epIdfFile, StrictnessLevel::Draft);
+  checkNameLookupsAgainstFullScan(workspace);
+
+  OptionalWorkspaceObject zone = workspace.getObjectByTypeAndName(IddObjectType::Zone, "space1-1");
+  ASSERT_TRUE(zone);
+  EXPECT_EQ("SPACE1-1", zone->nameString());
+
+  // rename
+  EXPECT_TRUE(zone->setName("Renamed Zone"));
+  EXPECT_FALSE(workspace.getObjectByTypeAndName(IddObjectType::Zone, "SPACE1-1"));
+  EXPECT_TRUE(workspace.getObjectsByName("SPACE1-1").empty());
+  ASSERT_TRUE(workspace.getObjectByTypeAndName(IddObjectType::Zone, "RENAMED ZONE"));
+  EXPECT_EQ(zone->handle(), workspace.getObjectByTypeAndName(IddObjectType::Zone, "RENAMED ZONE")->handle());
+  checkNameLookupsAgainstFullScan(workspace);
+
+  // rename through setString
+  EXPECT_TRUE(zone->setString(ZoneFields::Name, "Renamed Zone Again"));
+  EXPECT_FALSE(workspace.getObjectByTypeAndName(IddObjectType::Zone, "Renamed Zone"));
+  EXPECT_TRUE(workspace.getObjectByTypeAndName(IddObjectType::Zone, "Renamed Zone Again"));
+  checkNameLookupsAgainstFullScan(workspace);
+
+  // add, including a name clash that gets resolved
+  OptionalWorkspaceObject newZone = workspace.addObject(IdfObject(IddObjectType::Zone));
+  ASSERT_TRUE(newZone);
+  EXPECT_TRUE(newZone->setName("Renamed Zone Again"));
+  EXPECT_NE("Renamed Zone Again", newZone->nameString());
+  EXPECT_EQ(1u, workspace.getObjectsByName("Renamed Zone Again").size());
+  EXPECT_EQ(newZone->handle(), workspace.getObjectByTypeAndName(IddObjectType::Zone, newZone->nameString())->handle());
+  checkNameLookupsAgainstFullScan(workspace);
+
+  // same name, objects of different types that do not share a reference list
+  IdfObject lights(IddObjectType::Lights);
+  lights.setName("Renamed Zone Again");
+  OptionalWorkspaceObject newLights = workspace.addObject(lights);
+  ASSERT_TRUE(newLights);
+  EXPECT_EQ("Renamed Zone Again", newLights->nameString());
+  EXPECT_EQ(2u, workspace.getObjectsByName("Renamed Zone Again").size());
+  EXPECT_EQ(zone->handle(), workspace.getObjectByTypeAndName(IddObjectType::Zone, "Renamed Zone Again")->handle());
+  EXPECT_EQ(newLights->handle(), workspace.getObjectByTypeAndName(IddObjectType::Lights, "Renamed Zone Again")->handle());
+  checkNameLookupsAgainstFullScan(workspace);
+
+  // remove
+  Handle h = newZone->handle();
+  std::string removedName = newZone->nameString();
+  EXPECT_TRUE(workspace.removeObject(h));
+  EXPECT_FALSE(workspace.getObjectByTypeAndName(IddObjectType::Zone, removedName));
+  EXPECT_TRUE(workspace.getObjectsByName(removedName).empty());
+  EXPECT_FALSE(workspace.getObject(h));
+  checkNameLookupsAgainstFullScan(workspace);
+
+  // swap objects
+  IdfObject otherZone(IddObjectType::Zone);
+  otherZone.setName("Swapped Zone");
+  WorkspaceObject currentZone = *zone;
+  EXPECT_TRUE(workspace.swap(currentZone, otherZone, true));
+  EXPECT_TRUE(workspace.getObjectByTypeAndName(IddObjectType::Zone, "Swapped Zone"));
+  EXPECT_FALSE(workspace.getObjectByTypeAndName(IddObjectType::Zone, "Renamed Zone Again"));
+  checkNameLookupsAgainstFullScan(workspace);
+
+  // swap workspaces
+  Workspace other(StrictnessLevel::Draft, IddFileType::EnergyPlus);
+  other.addObject(IdfObject(IddObjectType::Zone));
+  workspace.swap(other);
+  EXPECT_TRUE(workspace.getObjectByTypeAndName(IddObjectType::Zone, "Zone 1"));
+  EXPECT_FALSE(workspace.getObjectByTypeAndName(IddObjectType::Zone, "Swapped Zone"));
+  EXPECT_TRUE(other.getObjectByTypeAndName(IddObjectType::Zone, "Swapped Zone"));
+  EXPECT_FALSE(other.getObjectByTypeAndName(IddObjectType::Zone, "Zone 1"));
+  checkNameLookupsAgainstFullScan(workspace);
+  checkNameLookupsAgainstFullScan(other);
+
+  // clone
+  Workspace clone = other.clone();
+  checkNameLookupsAgainstFullScan(clone);
+  EXPECT_TRUE(clone.getObjectByTypeAndName(IddObjectType::Zone, "Swapped Zone"));
+}
+
+TEST_F(IdfFixture, Workspace_NextName_Series) {
+  Workspace ws(StrictnessLevel::Draft, IddFileType::EnergyPlus);
+
+  std::vector<WorkspaceObject> zones;
+  for (unsigned i = 0; i < 5; ++i) {
+    OptionalWorkspaceObject zone = ws.addObject(IdfObject(IddObjectType::Zone));
+    ASSERT_TRUE(zone);
+    zones.push_back(*zone);
+  }
+  EXPECT_EQ("Zone 5", zones.back().nameString());
+  EXPECT_EQ("zone 6", ws.nextName("zone", false));
+  EXPECT_EQ("Zone 6", ws.nextName(IddObjectType::Zone, true));
+  EXPECT_EQ(5u, ws.getObjectsByName("ZONE 3", false).size());
+  EXPECT_EQ(5u, ws.getObjectsByTypeAndName(IddObjectType::Zone, "Zone").size());
+
+  // gaps are filled in from the bottom
+  EXPECT_TRUE(ws.removeObject(zones[1].handle()));
+  EXPECT_TRUE(ws.removeObject(zones[3].handle()));
+  EXPECT_EQ("Zone 2", ws.nextName(IddObjectType::Zone, true));
+  EXPECT_EQ("Zone 6", ws.nextName(IddObjectType::Zone, false));
+  EXPECT_EQ(3u, ws.getObjectsByTypeAndName(IddObjectType::Zone, "Zone").size());
+  EXPECT_TRUE(zones[0].setName("Zone 2"));
+  EXPECT_EQ("Zone 1", ws.nextName(IddObjectType::Zone, true));
+  EXPECT_TRUE(zones[2].setName("Zone 1"));
+  EXPECT_EQ("Zone 3", ws.nextName(IddObjectType::Zone, true));
+
+  // suffixes in use by more than one object type
+  IdfObject lights(IddObjectType::Lights);
+  lights.setName("Zone 7");
+  OptionalWorkspaceObject newLights = ws.addObject(lights);
+  ASSERT_TRUE(newLights);
+  EXPECT_EQ("Zone 8", ws.nextName("Zone", false));
+  EXPECT_EQ("Zone 6", ws.nextName(IddObjectType::Zone, false));
+  EXPECT_TRUE(newLights->setName("Lights"));
+  EXPECT_EQ("Zone 6", ws.nextName("Zone", false));
+
+  // the spacer follows the object with the largest suffix
+  EXPECT_TRUE(zones[4].setName("Zone_9"));
+  EXPECT_EQ("Zone_10", ws.nextName("Zone", false));
+  EXPECT_EQ("Zone_3", ws.nextName("Zone", true));
+  EXPECT_TRUE(zones[4].setName("Zone 9"));
+  EXPECT_EQ("Zone 10", ws.nextName("Zone", false));
+
+  // removed objects leave the series
+  Handle h = zones[4].handle();
+  EXPECT_TRUE(ws.removeObject(h));
+  EXPECT_EQ("Zone 3", ws.nextName("Zone", false));
+  std::vector<WorkspaceObject> clones = ws.clone().getObjectsByName("Zone", false);
+  EXPECT_EQ(2u, clones.size());
+}
+
+TEST_F(IdfFixture, Workspace_NextName_LongSeries) {
+  Workspace ws(StrictnessLevel::Draft, IddFileType::EnergyPlus);
+  unsigned n = 5000;
+
+  IdfObject surface(IddObjectType::BuildingSurface_Detailed);
+  for (unsigned i = 0; i < n; ++i) {
+    EXPECT_TRUE(surface.setName(ws.nextName("Surface", false)));
+    ASSERT_TRUE(ws.addObject(surface));
+  }
+
+  EXPECT_EQ(n, ws.numObjectsOfType(IddObjectType::BuildingSurface_Detailed));
+  EXPECT_EQ("Surface 5001", ws.nextName("Surface", false));
+  EXPECT_EQ("Surface 5001", ws.nextName("Surface", true));
+
+  OptionalWorkspaceObject middle = ws.getObjectByTypeAndName(IddObjectType::BuildingSurface_Detailed, "Surface 2500");
+  ASSERT_TRUE(middle);
+  EXPECT_TRUE(ws.removeObject(middle->handle()));
+  EXPECT_EQ("Surface 2500", ws.nextName("Surface", true));
+  EXPECT_EQ("Surface 5001", ws.nextName("Surface", false));
+}
+
+// timing only, run with --gtest_also_run_disabled_tests
+TEST_F(IdfFixture, DISABLED_Workspace_NextName_Benchmark) {
+  // with a per-base-name suffix index, adding objects to a long name series is linear overall
+  Workspace ws(StrictnessLevel::Draft, IddFileType::EnergyPlus);
+  unsigned n = 50000;
+
+  IdfObject surface(IddObjectType::BuildingSurface_Detailed);
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < n; ++i) {
+    surface.setName(ws.nextName("Surface", false));
+    ws.addObject(surface);
+  }
+  auto end = std::chrono::steady_clock::now();
+  LOG_FREE(Info, "Workspace_NextName_Benchmark", "Added " << n << " surfaces in "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms.");
+}
+
+namespace {
+
+  // n zones with six surfaces each, the surfaces point to their zone by name
+  IdfFile zonesAndSurfaces(unsigned n) {
+    IdfFile idfFile(IddFileType::EnergyPlus);
+    for (unsigned i = 0; i < n; ++i) {
+      IdfObject zone(IddObjectType::Zone);
+      zone.setName("Zone " + boost::lexical_cast<std::string>(i));
+      idfFile.addObject(zone);
+      for (unsigned j = 0; j < 6; ++j) {
+        IdfObject surface(IddObjectType::BuildingSurface_Detailed);
+        surface.setName("Surface " + boost::lexical_cast<std::string>(6*i + j));
+        surface.setString(BuildingSurface_DetailedFields::ZoneName, *zone.name());
+        idfFile.addObject(surface);
+      }
+    }
+    return idfFile;
+  }
+
+  // the general path, addObjects followed by resolvePotentialNameConflicts
+  Workspace addObjectsOneByOne(const IdfFile& idfFile) {
+    Workspace result(StrictnessLevel::Draft, IddFileType::EnergyPlus);
+    std::shared_ptr<detail::Workspace_Impl> impl = result.getImpl<detail::Workspace_Impl>();
+    std::vector<std::shared_ptr<detail::WorkspaceObject_Impl> > objectImplPtrs;
+    for (const IdfObject& idfObject : idfFile.objects()) {
+      objectImplPtrs.push_back(impl->createObject(idfObject, true));
+    }
+    impl->addObjects(objectImplPtrs, false);
+    impl->resolvePotentialNameConflicts(result);
+    return result;
+  }
+
+}
+
+TEST_F(IdfFixture, Workspace_BulkLoad) {
+  // constructing from an IdfFile uses the bulk-ingest path, it must agree with the general one
+  unsigned n = 200;
+  IdfFile idfFile = zonesAndSurfaces(n);
+  Workspace general = addObjectsOneByOne(idfFile);
+  EXPECT_EQ(idfFile.numObjects(), general.numObjects());
+  Workspace bulk(idfFile, StrictnessLevel::Draft);
+
+  // name conflicts within the file are resolved after pointers are set (at Draft, they make the
+  // file invalid)
+  IdfObject duplicate(IddObjectType::Zone);
+  EXPECT_TRUE(duplicate.setName("Zone 0"));
+  idfFile.addObject(duplicate);
+  Workspace withDuplicate(idfFile, StrictnessLevel::None);
+
+  for (const Workspace& ws : {general, bulk, withDuplicate}) {
+    unsigned nZones = ws.numObjectsOfType(IddObjectType::Zone);
+    EXPECT_EQ(ws == withDuplicate ? n + 1 : n, nZones);
+    EXPECT_EQ(6 * n, ws.numObjectsOfType(IddObjectType::BuildingSurface_Detailed));
+    std::set<std::string> zoneNames;
+    for (const WorkspaceObject& zone : ws.getObjectsByType(IddObjectType::Zone)) {
+      zoneNames.insert(*zone.name());
+    }
+    EXPECT_EQ(nZones, zoneNames.size());
+    for (unsigned i = 6; i < 6 * n; i += 97) {
+      OptionalWorkspaceObject surface = ws.getObjectByTypeAndName(IddObjectType::BuildingSurface_Detailed,
+                                                                  "Surface " + boost::lexical_cast<std::string>(i));
+      ASSERT_TRUE(surface);
+      OptionalWorkspaceObject zone = surface->getTarget(BuildingSurface_DetailedFields::ZoneName);
+      ASSERT_TRUE(zone);
+      EXPECT_EQ("Zone " + boost::lexical_cast<std::string>(i / 6), *zone->name());
+    }
+    EXPECT_TRUE(ws.isValid());
+  }
+
+  // surfaces without vertices are not valid at Final, so this load is rolled back. the maps it
+  // reserved are released, and the workspace works as usual afterwards.
+  Workspace failed(idfFile, StrictnessLevel::Final);
+  EXPECT_EQ(0u, failed.numObjects());
+  EXPECT_LT(failed.getImpl<detail::Workspace_Impl>()->objectMapsMemoryUsage(),
+            bulk.getImpl<detail::Workspace_Impl>()->objectMapsMemoryUsage());
+  EXPECT_TRUE(failed.setStrictnessLevel(StrictnessLevel::Draft));
+  std::vector<IdfObject> someObjects = idfFile.objects();
+  someObjects.erase(someObjects.begin() + 7, someObjects.end());
+  EXPECT_EQ(7u, failed.addObjects(someObjects).size());
+  EXPECT_EQ(1u, failed.getObjectsByReference("ZoneNames").size());
+  OptionalWorkspaceObject surface = failed.getObjectByTypeAndName(IddObjectType::BuildingSurface_Detailed, "Surface 0");
+  ASSERT_TRUE(surface);
+  ASSERT_TRUE(surface->getTarget(BuildingSurface_DetailedFields::ZoneName));
+  EXPECT_EQ("Zone 0", *surface->getTarget(BuildingSurface_DetailedFields::ZoneName)->name());
+}
+
+// timing only, run with --gtest_also_run_disabled_tests
+TEST_F(IdfFixture, DISABLED_Workspace_BulkLoad_Benchmark) {
+  IdfFile idfFile = zonesAndSurfaces(10000);
+
+  auto start = std::chrono::steady_clock::now();
+  Workspace general = addObjectsOneByOne(idfFile);
+  auto end = std::chrono::steady_clock::now();
+  LOG_FREE(Info, "Workspace_BulkLoad_Benchmark", "Added " << idfFile.numObjects() << " objects in "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms.");
+
+  start = std::chrono::steady_clock::now();
+  Workspace bulk(idfFile, StrictnessLevel::Draft);
+  end = std::chrono::steady_clock::now();
+  LOG_FREE(Info, "Workspace_BulkLoad_Benchmark", "Bulk loaded " << idfFile.numObjects() << " objects in "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms.");
+}
+
+TEST_F(IdfFixture, Workspace_FlatHandleMap) {
+  detail::FlatHandleMap<int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.begin() == map.end());
+  EXPECT_EQ(0u, map.memoryUsage());
+
+  HandleVector handles;
+  for (int i = 0; i < 1000; ++i) {
+    handles.push_back(createUUID());
+    EXPECT_TRUE(map.insert(std::make_pair(handles.back(), i)).second);
+  }
+  EXPECT_FALSE(map.insert(std::make_pair(handles[10], -1)).second);
+  EXPECT_EQ(1000u, map.size());
+  EXPECT_EQ(10, map.find(handles[10])->second);
+  EXPECT_TRUE(map.find(createUUID()) == map.end());
+  EXPECT_TRUE(map.find(Handle()) == map.end());
+
+  // erase every other entry while iterating
+  unsigned visited = 0;
+  for (auto it = map.begin(); it != map.end(); ) {
+    ++visited;
+    if (it->second % 2 == 0) {
+      it = map.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+  EXPECT_EQ(1000u, visited);
+  EXPECT_EQ(500u, map.size());
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(i % 2, static_cast<int>(map.count(handles[i])));
+  }
+
+  // tombstones are reused without unbounded growth
+  std::size_t capacity = map.capacity();
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < 1000; i += 2) {
+      map[handles[i]] = i;
+    }
+    for (int i = 0; i < 1000; i += 2) {
+      EXPECT_EQ(1u, map.erase(handles[i]));
+    }
+  }
+  EXPECT_EQ(500u, map.size());
+  EXPECT_EQ(capacity, map.capacity());
+
+  const detail::FlatHandleMap<int>& constMap = map;
+  int sum = 0;
+  for (const auto& p : constMap) {
+    sum += p.second;
+  }
+  EXPECT_EQ(250000, sum);
+
+  detail::FlatHandleMap<int> other;
+  other.swap(map);
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(500u, other.size());
+  other.clear();
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(0, other[handles[0]]);
+  EXPECT_EQ(1u, other.size());
+}
+
+TEST_F(IdfFixture, Workspace_ObjectMaps) {
+  unsigned n = 300;
+  IdfFile idfFile = zonesAndSurfaces(n);
+  Workspace ws(idfFile, StrictnessLevel::Draft);
+  ASSERT_EQ(idfFile.numObjects(), ws.numObjects());
+  std::shared_ptr<detail::Workspace_Impl> impl = ws.getImpl<detail::Workspace_Impl>();
+  EXPECT_GT(impl->objectMapsMemoryUsage(), 0u);
+
+  unsigned found = 0;
+  for (const WorkspaceObject& surface : ws.getObjectsByType(IddObjectType::BuildingSurface_Detailed)) {
+    if (ws.isMember(surface.handle()) && ws.getObject(surface.handle())) {
+      ++found;
+    }
+  }
+  EXPECT_EQ(6 * n, found);
+
+  // lookups by interned reference list id agree with lookups by name
+  std::vector<unsigned> zoneNames(1, ReferenceListSet::id("ZoneNames"));
+  std::vector<unsigned> surfaceNames(1, ReferenceListSet::id("SurfaceNames"));
+  OptionalWorkspaceObject zone = impl->getObjectByNameAndReference("ZONE 7", zoneNames);
+  ASSERT_TRUE(zone);
+  EXPECT_EQ("Zone 7", *zone->name());
+  EXPECT_FALSE(impl->getObjectByNameAndReference("Zone 7", surfaceNames));
+  EXPECT_TRUE(impl->getObjectByNameAndReference("Surface 7", surfaceNames));
+  EXPECT_EQ(zone->handle(), ws.getObjectByNameAndReference("Zone 7", StringVector(1, "ZoneNames"))->handle());
+
+  // removing objects leaves the maps consistent
+  for (unsigned i = 0; i < n; i += 2) {
+    zone = ws.getObjectByTypeAndName(IddObjectType::Zone, "Zone " + boost::lexical_cast<std::string>(i));
+    ASSERT_TRUE(zone);
+    EXPECT_FALSE(zone->remove().empty());
+  }
+  EXPECT_EQ(n / 2, ws.numObjectsOfType(IddObjectType::Zone));
+  EXPECT_EQ(n / 2, ws.getObjectsByReference("ZoneNames").size());
+  EXPECT_FALSE(impl->getObjectByNameAndReference("Zone 6", zoneNames));
+  EXPECT_TRUE(impl->getObjectByNameAndReference("Zone 7", zoneNames));
+  EXPECT_EQ(6 * n, ws.numObjectsOfType(IddObjectType::BuildingSurface_Detailed));
+  EXPECT_TRUE(ws.isValid());
+}
+
+// timing only, run with --gtest_also_run_disabled_tests
+TEST_F(IdfFixture, DISABLED_Workspace_ObjectMaps_Benchmark) {
+  IdfFile idfFile = zonesAndSurfaces(3000);
+  Workspace ws(idfFile, StrictnessLevel::Draft);
+  std::size_t bytes = ws.getImpl<detail::Workspace_Impl>()->objectMapsMemoryUsage();
+  LOG_FREE(Info, "Workspace_ObjectMaps_Benchmark", "Handle, type and reference maps use " << bytes << " bytes for "
+           << ws.numObjects() << " objects, " << bytes / ws.numObjects() << " bytes per object.");
+
+  auto start = std::chrono::steady_clock::now();
+  unsigned found = 0;
+  for (unsigned k = 0; k < 10; ++k) {
+    for (const WorkspaceObject& surface : ws.getObjectsByType(IddObjectType::BuildingSurface_Detailed)) {
+      if (ws.isMember(surface.handle()) && ws.getObject(surface.handle())) {
+        ++found;
+      }
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  LOG_FREE(Info, "Workspace_ObjectMaps_Benchmark", "Looked up " << found << " handles in "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms.");
+}
+
+TEST_F(IdfFixture, Workspace_IdfObjectDiffMode) {
+  Workspace ws(StrictnessLevel::Draft, IddFileType::EnergyPlus);
+  EXPECT_EQ(IdfObjectDiffMode::Full, ws.idfObjectDiffMode().value());
+  OptionalWorkspaceObject zone = ws.addObject(IdfObject(IddObjectType::Zone));
+  ASSERT_TRUE(zone);
+  std::shared_ptr<detail::WorkspaceObject_Impl> impl = zone->getImpl<detail::WorkspaceObject_Impl>();
+
+  // setters that do not emit signals keep their diffs until emitChangeSignals
+  auto makeChanges = [&impl]() {
+    for (unsigned i = 0; i < 100; ++i) {
+      EXPECT_TRUE(impl->setString(ZoneFields::XOrigin, boost::lexical_cast<std::string>(i), false));
+      EXPECT_TRUE(impl->setString(ZoneFields::YOrigin, boost::lexical_cast<std::string>(i), false));
+    }
+  };
+
+  // the first round also pushes fields
+  makeChanges();
+  EXPECT_LT(200u, ws.numIdfObjectDiffs());
+  impl->emitChangeSignals();
+  EXPECT_EQ(0u, ws.numIdfObjectDiffs());
+
+  makeChanges();
+  EXPECT_EQ(200u, ws.numIdfObjectDiffs());
+  std::size_t fullMemory = ws.idfObjectDiffMemoryUsage();
+  EXPECT_GT(fullMemory, 0u);
+  impl->emitChangeSignals();
+  EXPECT_EQ(0u, ws.numIdfObjectDiffs());
+
+  ws.setIdfObjectDiffMode(IdfObjectDiffMode::Coalesced);
+  makeChanges();
+  EXPECT_EQ(2u, ws.numIdfObjectDiffs());
+  std::size_t coalescedMemory = ws.idfObjectDiffMemoryUsage();
+  EXPECT_LT(coalescedMemory, fullMemory);
+  impl->emitChangeSignals();
+
+  ws.setIdfObjectDiffMode(IdfObjectDiffMode::Off);
+  makeChanges();
+  EXPECT_EQ(2u, ws.numIdfObjectDiffs());
+  EXPECT_LE(ws.idfObjectDiffMemoryUsage(), coalescedMemory);
+
+  // signals are still emitted with diffs off
+  WorkspaceObjectWatcher watcher(*zone);
+  EXPECT_FALSE(watcher.dirty());
+  impl->emitChangeSignals();
+  EXPECT_TRUE(watcher.dirty());
+  EXPECT_TRUE(watcher.dataChanged());
+  EXPECT_FALSE(watcher.nameChanged());
+  EXPECT_EQ(0u, ws.numIdfObjectDiffs());
+
+  watcher.clearState();
+  EXPECT_TRUE(zone->setName("Renamed Zone"));
+  EXPECT_TRUE(watcher.nameChanged());
+  EXPECT_FALSE(watcher.dataChanged());
+
+  // objects keep using the mode of the workspace they belong to
+  Workspace clone = ws.clone();
+  EXPECT_EQ(IdfObjectDiffMode::Off, clone.idfObjectDiffMode().value());
+}
+
+namespace {
+
+  // zonesAndSurfaces, with a view factor on every surface to aggregate over
+  Workspace zonesAndViewFactors(unsigned n) {
+    IdfFile idfFile = zonesAndSurfaces(n);
+    for (IdfObject& object : idfFile.objects()) {
+      if (object.iddObject().type() == IddObjectType::BuildingSurface_Detailed) {
+        EXPECT_TRUE(object.setDouble(BuildingSurface_DetailedFields::ViewFactortoGround, 0.5));
+      }
+    }
+    return Workspace(idfFile, StrictnessLevel::Draft);
+  }
+
+  double sumViewFactorsByVector(const Workspace& ws) {
+    double result = 0;
+    for (const WorkspaceObject& surface : ws.getObjectsByType(IddObjectType::BuildingSurface_Detailed)) {
+      result += surface.getDouble(BuildingSurface_DetailedFields::ViewFactortoGround).get();
+    }
+    return result;
+  }
+
+  double sumViewFactorsByVisitor(const Workspace& ws) {
+    double result = 0;
+    ws.forEachObjectOfType(IddObjectType::BuildingSurface_Detailed, [&result](const std::shared_ptr<detail::WorkspaceObject_Impl>& p) {
+      result += p->getDouble(BuildingSurface_DetailedFields::ViewFactortoGround).get();
+    });
+    return result;
+  }
+
+  double sumSourceViewFactorsByVector(const WorkspaceObjectVector& zones) {
+    double result = 0;
+    for (const WorkspaceObject& zone : zones) {
+      for (const WorkspaceObject& surface : zone.getSources(IddObjectType::BuildingSurface_Detailed)) {
+        result += surface.getDouble(BuildingSurface_DetailedFields::ViewFactortoGround).get();
+      }
+    }
+    return result;
+  }
+
+  double sumSourceViewFactorsByVisitor(const WorkspaceObjectVector& zones) {
+    double result = 0;
+    for (const WorkspaceObject& zone : zones) {
+      zone.getImpl<detail::WorkspaceObject_Impl>()->forEachSource(IddObjectType::BuildingSurface_Detailed,
+        [&result](const std::shared_ptr<detail::WorkspaceObject_Impl>& p) {
+          result += p->getDouble(BuildingSurface_DetailedFields::ViewFactortoGround).get();
+        });
+    }
+    return result;
+  }
+
+}
+
+TEST_F(IdfFixture, Workspace_ForEachObjectOfType) {
+  unsigned n = 200;
+  Workspace ws = zonesAndViewFactors(n);
+  ASSERT_EQ(7 * n, ws.numObjects());
+
+  // visits exactly the objects getObjectsByType returns
+  std::set<Handle> visited;
+  ws.forEachObjectOfType(IddObjectType::Zone, [&visited](const std::shared_ptr<detail::WorkspaceObject_Impl>& p) {
+    EXPECT_EQ(IddObjectType(IddObjectType::Zone), p->iddObject().type());
+    EXPECT_TRUE(visited.insert(p->handle()).second);
+  });
+  EXPECT_EQ(n, visited.size());
+  for (const WorkspaceObject& zone : ws.getObjectsByType(IddObjectType::Zone)) {
+    EXPECT_EQ(1u, visited.count(zone.handle()));
+  }
+  unsigned count = 0;
+  ws.forEachObjectOfType(IddObjectType::Lights, [&count](const std::shared_ptr<detail::WorkspaceObject_Impl>&) { ++count; });
+  EXPECT_EQ(0u, count);
+
+  // forEachSource agrees with getSources
+  WorkspaceObjectVector zones = ws.getObjectsByType(IddObjectType::Zone);
+  for (const WorkspaceObject& zone : zones) {
+    std::vector<Handle> sources;
+    zone.getImpl<detail::WorkspaceObject_Impl>()->forEachSource(IddObjectType::BuildingSurface_Detailed,
+      [&sources](const std::shared_ptr<detail::WorkspaceObject_Impl>& p) { sources.push_back(p->handle()); });
+    std::vector<Handle> expected = getHandles(zone.getSources(IddObjectType::BuildingSurface_Detailed));
+    std::sort(sources.begin(), sources.end());
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(expected, sources);
+  }
+
+  // aggregates agree, as in Building_Impl::floorArea over spaces and Space_Impl::floorArea over surfaces
+  EXPECT_DOUBLE_EQ(0.5 * 6 * n, sumViewFactorsByVector(ws));
+  EXPECT_DOUBLE_EQ(0.5 * 6 * n, sumViewFactorsByVisitor(ws));
+  EXPECT_DOUBLE_EQ(0.5 * 6 * n, sumSourceViewFactorsByVector(zones));
+  EXPECT_DOUBLE_EQ(0.5 * 6 * n, sumSourceViewFactorsByVisitor(zones));
+}
+
+// timing only, run with --gtest_also_run_disabled_tests
+TEST_F(IdfFixture, DISABLED_Workspace_ForEachObjectOfType_Benchmark) {
+  unsigned n = 2000;
+  unsigned reps = 20;
+  Workspace ws = zonesAndViewFactors(n);
+  WorkspaceObjectVector zones = ws.getObjectsByType(IddObjectType::Zone);
+
+  auto timeReps = [reps](const std::function<double()>& sum) {
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned k = 0; k < reps; ++k) {
+      sum();
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  LOG_FREE(Info, "Workspace_ForEachObjectOfType_Benchmark", "Summed " << 6 * n << " surfaces " << reps << " times: getObjectsByType "
+           << timeReps([&ws]() { return sumViewFactorsByVector(ws); }) << " ms, forEachObjectOfType "
+           << timeReps([&ws]() { return sumViewFactorsByVisitor(ws); }) << " ms; getSources "
+           << timeReps([&zones]() { return sumSourceViewFactorsByVector(zones); }) << " ms, forEachSource "
+           << timeReps([&zones]() { return sumSourceViewFactorsByVisitor(zones); }) << " ms.");
+}
+
+namespace {
+
+  // zonesAndSurfaces, with the surface fields that are valid at Draft filled in
+  Workspace zonesAndWalls(unsigned n) {
+    IdfFile idfFile = zonesAndSurfaces(n);
+    for (IdfObject& object : idfFile.objects()) {
+      if (object.iddObject().type() == IddObjectType::BuildingSurface_Detailed) {
+        EXPECT_TRUE(object.setString(BuildingSurface_DetailedFields::SurfaceType, "Wall"));
+        EXPECT_TRUE(object.setString(BuildingSurface_DetailedFields::OutsideBoundaryCondition, "Outdoors"));
+        EXPECT_TRUE(object.setDouble(BuildingSurface_DetailedFields::ViewFactortoGround, 0.5));
+      }
+    }
+    return Workspace(idfFile, StrictnessLevel::Draft);
+  }
+
+}
+
+TEST_F(IdfFixture, Workspace_ValidityReport) {
+  unsigned n = 200;
+  Workspace ws = zonesAndWalls(n);
+  ASSERT_EQ(7 * n, ws.numObjects());
+
+  EXPECT_EQ(0u, ws.validityReport(StrictnessLevel::Draft).numErrors());
+  // surfaces are missing their construction and vertices
+  EXPECT_LT(0u, ws.validityReport(StrictnessLevel::Final).numErrors());
+
+  // field checks on set go through the same compiled validation program
+  WorkspaceObject surface = ws.getObjectByTypeAndName(IddObjectType::BuildingSurface_Detailed, "Surface 0").get();
+  EXPECT_TRUE(surface.setString(BuildingSurface_DetailedFields::SurfaceType, "fLoOr"));
+  EXPECT_FALSE(surface.setString(BuildingSurface_DetailedFields::SurfaceType, "Floors"));
+  EXPECT_EQ("fLoOr", surface.getString(BuildingSurface_DetailedFields::SurfaceType).get());
+  EXPECT_FALSE(surface.setDouble(BuildingSurface_DetailedFields::ViewFactortoGround, 1.5));
+  EXPECT_TRUE(surface.setString(BuildingSurface_DetailedFields::ViewFactortoGround, "autocalculate"));
+  EXPECT_TRUE(surface.setDouble(BuildingSurface_DetailedFields::ViewFactortoGround, 1.0));
+  EXPECT_FALSE(surface.setString(BuildingSurface_DetailedFields::NumberofVertices, "2"));
+  EXPECT_TRUE(surface.setString(BuildingSurface_DetailedFields::NumberofVertices, "4"));
+  EXPECT_TRUE(surface.setString(BuildingSurface_DetailedFields::ZoneName, "Zone 1"));
+  EXPECT_FALSE(surface.setString(BuildingSurface_DetailedFields::ConstructionName, "Zone 1"));
+  EXPECT_EQ(0u, ws.validityReport(StrictnessLevel::Draft).numErrors());
+}
+
+// timing only, run with --gtest_also_run_disabled_tests
+TEST_F(IdfFixture, DISABLED_Workspace_ValidityReport_Benchmark) {
+  Workspace ws = zonesAndWalls(2000);
+
+  auto start = std::chrono::steady_clock::now();
+  ValidityReport draftReport = ws.validityReport(StrictnessLevel::Draft);
+  auto draftTime = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  ValidityReport finalReport = ws.validityReport(StrictnessLevel::Final);
+  auto finalTime = std::chrono::steady_clock::now() - start;
+
+  LOG_FREE(Info, "Workspace_ValidityReport_Benchmark", "Checked " << ws.numObjects() << " objects: Draft validityReport "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(draftTime).count() << " ms, Final validityReport "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(finalTime).count() << " ms.");
+}
+
+TEST_F(IdfFixture, Workspace_BinarySnapshot) {
+  IdfFile idfFile(IddFileType::EnergyPlus);
+  idfFile.setHeader("! Snapshot test header");
+  unsigned n = 200;
+  for (unsigned i = 0; i < n; ++i) {
+    IdfObject zone(IddObjectType::Zone);
+    EXPECT_TRUE(zone.setName("Zone " + boost::lexical_cast<std::string>(i)));
+    idfFile.addObject(zone);
+    for (unsigned j = 0; j < 6; ++j) {
+      IdfObject surface(IddObjectType::BuildingSurface_Detailed);
+      EXPECT_TRUE(surface.setName("Surface, " + boost::lexical_cast<std::string>(6*i + j)));
+      EXPECT_TRUE(surface.setString(BuildingSurface_DetailedFields::SurfaceType, "Wall"));
+      EXPECT_TRUE(surface.setString(BuildingSurface_DetailedFields::ZoneName, *zone.name()));
+      EXPECT_TRUE(surface.setDouble(BuildingSurface_DetailedFields::ViewFactortoGround, 0.5));
+      idfFile.addObject(surface);
+    }
+  }
+  IdfObject lights(IddObjectType::Lights);
+  lights.setComment("! Lights with a dangling pointer");
+  EXPECT_TRUE(lights.setString(LightsFields::ZoneorZoneListName, "Zone 1"));
+  EXPECT_TRUE(lights.setString(LightsFields::ScheduleName, "No Such Schedule"));
+  EXPECT_TRUE(lights.setFieldComment(LightsFields::ZoneorZoneListName, "! the zone"));
+  idfFile.addObject(lights);
+  Workspace ws(idfFile, StrictnessLevel::Draft);
+
+  openstudio::path textPath = toPath("./Workspace_BinarySnapshot.idf");
+  openstudio::path snapshotPath = toPath("./Workspace_BinarySnapshot.snapshot");
+  EXPECT_TRUE(ws.save(textPath, true));
+  EXPECT_TRUE(ws.saveBinary(snapshotPath, true));
+  EXPECT_FALSE(ws.saveBinary(snapshotPath, false));
+  EXPECT_FALSE(Workspace::loadBinary(textPath));
+
+  OptionalWorkspace loaded = Workspace::loadBinary(snapshotPath);
+  ASSERT_TRUE(loaded);
+  EXPECT_EQ(ws.iddFileType(), loaded->iddFileType());
+  EXPECT_EQ(ws.strictnessLevel(), loaded->strictnessLevel());
+  ASSERT_EQ(ws.numObjects(), loaded->numObjects());
+
+  // same text, comments and header included
+  std::stringstream expected, actual;
+  ws.toIdfFile().print(expected);
+  loaded->toIdfFile().print(actual);
+  EXPECT_EQ(expected.str(), actual.str());
+
+  // same handles and pointers
+  for (const WorkspaceObject& object : ws.objects()) {
+    OptionalWorkspaceObject other = loaded->getObject(object.handle());
+    ASSERT_TRUE(other);
+    EXPECT_EQ(object.nameString(), other->nameString());
+    for (unsigned index : object.objectListFields()) {
+      OptionalWorkspaceObject target = object.getTarget(index);
+      OptionalWorkspaceObject otherTarget = other->getTarget(index);
+      ASSERT_EQ(static_cast<bool>(target), static_cast<bool>(otherTarget));
+      if (target) {
+        EXPECT_EQ(target->handle(), otherTarget->handle());
+      }
+    }
+  }
+  OptionalWorkspaceObject zone = loaded->getObjectByTypeAndName(IddObjectType::Zone, "Zone 1");
+  ASSERT_TRUE(zone);
+  EXPECT_EQ(1u, zone->getSources(IddObjectType::Lights).size());
+  EXPECT_EQ(6u, zone->getSources(IddObjectType::BuildingSurface_Detailed).size());
+
+  // snapshots stamped with just the IDD version, as from an IDD edited without a version bump,
+  // are refused
+  WorkspaceSnapshotWriter writer(IddFileType::EnergyPlus, StrictnessLevel::Draft,
+                                 IddFactory::instance().getVersion(IddFileType::EnergyPlus), "");
+  std::vector<std::string_view> fields(1, "Zone 1");
+  writer.addObject("Zone", createUUID(), "", fields, std::vector<std::string>(),
+                   std::vector<std::pair<unsigned, Handle> >());
+  EXPECT_TRUE(writer.save(snapshotPath));
+  EXPECT_FALSE(Workspace::loadBinary(snapshotPath));
+
+  openstudio::filesystem::remove(textPath);
+  openstudio::filesystem::remove(snapshotPath);
+}
+
+// timing only, run with --gtest_also_run_disabled_tests
+TEST_F(IdfFixture, DISABLED_Workspace_BinarySnapshot_Benchmark) {
+  IdfFile idfFile = zonesAndSurfaces(2000);
+  Workspace ws(idfFile, StrictnessLevel::Draft);
+  openstudio::path textPath = toPath("./Workspace_BinarySnapshot_Benchmark.idf");
+  openstudio::path snapshotPath = toPath("./Workspace_BinarySnapshot_Benchmark.snapshot");
+  EXPECT_TRUE(ws.save(textPath, true));
+  EXPECT_TRUE(ws.saveBinary(snapshotPath, true));
+
+  unsigned reps = 3;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < reps; ++i) {
+    EXPECT_TRUE(Workspace::load(textPath));
+  }
+  auto middle = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < reps; ++i) {
+    EXPECT_TRUE(Workspace::loadBinary(snapshotPath));
+  }
+  auto end = std::chrono::steady_clock::now();
+  LOG_FREE(Info, "Workspace_BinarySnapshot_Benchmark", reps << " loads of " << ws.numObjects() << " objects took "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(middle - start).count() << " ms from text and "
+           << std::chrono::duration_cast<std::chrono::milliseconds>(end - middle).count() << " ms from the snapshot.");
+
+  openstudio::filesystem::remove(textPath);
+  openstudio::filesystem::remove(snapshotPath);
+}
@@ -32,6 +32,9 @@
 
 #include "IdfFile.hpp"
 #include "ValidityReport.hpp"
+#include "WorkspaceSnapshot.hpp"
+
+#include "../idd/IddObjectValidation.hpp"
 
 #include <utilities/idd/IddEnums.hxx>
 #include <utilities/idd/IddFactory.hxx>
@@ -39,10 +42,15 @@
 #include "../plot/ProgressBar.hpp"
 
 #include "../core/Assert.hpp"
+#include "../core/Checksum.hpp"
+#include "../core/PathHelpers.hpp"
 #include "../core/StringHelpers.hpp"
 
 #include <boost/lexical_cast.hpp>
 
+#include <mutex>
+#include <sstream>
+
 
 using namespace std;
 using openstudio::istringEqual; // used for all name comparisons
@@ -51,18 +59,79 @@ namespace openstudio {
 
 namespace detail {
 
+  namespace {
+
+    // key for the name maps, folds case the same way as istringEqual
+    std::string nameMapKey(const std::string& name) {
+      std::string result(name);
+      std::transform(result.begin(), result.end(), result.begin(), [](char c) { return static_cast<char>(toupper(c)); });
+      return result;
+    }
+
+    // position of the ' ' or '_' that separates objectName from a positive integer suffix, if any
+    std::string::size_type findNameSuffix(const std::string& objectName, int& suffix) {
+      std::string::size_type found = objectName.find_last_of(" _");
+      if (found != std::string::npos) {
+        const char *p = objectName.c_str() + found + 1;
+        suffix = 0;
+        unsigned count = 0;
+        while (*p >= '0' && *p <= '9') {
+          suffix = (suffix * 10) + (*p - '0');
+          ++p;
+          ++count;
+        }
+        if (suffix > 0 && count == objectName.size() - found - 1) { return found; }
+      }
+      return std::string::npos;
+    }
+
+    // key for the name series maps; also returns the name's suffix and spacer
+    std::string nameSeriesKey(const std::string& name, boost::optional<int>& suffix, std::string& spacer) {
+      int value = 0;
+      std::string::size_type found = findNameSuffix(name, value);
+      if (found == std::string::npos) {
+        suffix = boost::none;
+        spacer = " ";
+        return nameMapKey(name);
+      }
+      suffix = value;
+      spacer = std::string(1, name[found]);
+      return nameMapKey(name.substr(0, found));
+    }
+
+    // identifies the IDD a binary snapshot was written against. Snapshots store fields by index,
+    // so an IDD edited without a version bump must make them stale as well: the stamp holds the
+    // version, the build and a checksum of the IDD text, computed once per IddFileType.
+    std::string snapshotIddStamp(const IddFileAndFactoryWrapper& iddFileAndFactoryWrapper) {
+      static std::mutex stampsMutex;
+      static std::map<int, std::string> stamps;
+      std::lock_guard<std::mutex> lock(stampsMutex);
+      int iddFileType = iddFileAndFactoryWrapper.iddFileType().value();
+      auto it = stamps.find(iddFileType);
+      if (it == stamps.end()) {
+        IddFile iddFile = iddFileAndFactoryWrapper.iddFile();
+        std::stringstream ss;
+        iddFile.print(ss);
+        std::string stamp = iddFile.version() + ";" + iddFile.build() + ";" + checksum(ss.str());
+        it = stamps.insert(std::make_pair(iddFileType, stamp)).first;
+      }
+      return it->second;
+    }
+
+  }
+
   // CONSTRUCTORS
 
   Workspace_Impl::Workspace_Impl(StrictnessLevel level,IddFileType iddFileType) :
       m_strictnessLevel(level),
       m_iddFileAndFactoryWrapper(iddFileType),
       m_fastNaming(false),
+      m_idfObjectDiffMode(IdfObjectDiffMode::Full),
+      m_batchEditDepth(0),
+      m_flushingBatchEdit(false),
       m_workspaceObjectOrder(std::shared_ptr<WorkspaceObjectOrder_Impl>(new
           WorkspaceObjectOrder_Impl(HandleVector(),std::bind(&Workspace_Impl::getObject,this,std::placeholders::_1))))
-  {
-    m_workspaceObjectMap.reserve(1<<15);
-    m_idfReferencesMap.reserve(1<<15);
-  }
+  {}
 
   Workspace_Impl::Workspace_Impl(const IdfFile& idfFile,
                                  StrictnessLevel level) :
@@ -70,18 +139,21 @@ namespace detail {
       m_header(idfFile.header()),
       m_iddFileAndFactoryWrapper(idfFile.iddFileAndFactoryWrapper()),
       m_fastNaming(false),
+      m_idfObjectDiffMode(IdfObjectDiffMode::Full),
+      m_batchEditDepth(0),
+      m_flushingBatchEdit(false),
       m_workspaceObjectOrder(std::shared_ptr<WorkspaceObjectOrder_Impl>(new
           WorkspaceObjectOrder_Impl(HandleVector(),std::bind(&Workspace_Impl::getObject,this,std::placeholders::_1))))
-  {
-    m_workspaceObjectMap.reserve(1<<15);
-    m_idfReferencesMap.reserve(1<<15);
-  }
+  {}
 
   Workspace_Impl::Workspace_Impl(const Workspace_Impl& other,bool keepHandles) :
     m_strictnessLevel(other.m_strictnessLevel),
     m_header(other.m_header),
     m_iddFileAndFactoryWrapper(other.m_iddFileAndFactoryWrapper),
     m_fastNaming(other.fastNaming()),
+    m_idfObjectDiffMode(other.m_idfObjectDiffMode),
+    m_batchEditDepth(0),
+    m_flushingBatchEdit(false),
     m_workspaceObjectOrder(std::shared_ptr<WorkspaceObjectOrder_Impl>(new
           WorkspaceObjectOrder_Impl(std::bind(&Workspace_Impl::getObject,this,std::placeholders::_1))))
   {
@@ -94,8 +166,7 @@ namespace detail {
     if (directOrderVector) {
       m_workspaceObjectOrder.setDirectOrder(*directOrderVector);
     }
-    m_workspaceObjectMap.reserve(1<<15);
-    m_idfReferencesMap.reserve(1<<15);
+    m_workspaceObjectMap.reserve(other.m_workspaceObjectMap.size());
   }
 
   Workspace_Impl::Workspace_Impl(const Workspace_Impl& other,
@@ -106,6 +177,9 @@ namespace detail {
       m_header(), // subset of original data--discard header
       m_iddFileAndFactoryWrapper(other.m_iddFileAndFactoryWrapper),
       m_fastNaming(other.fastNaming()),
+      m_idfObjectDiffMode(other.m_idfObjectDiffMode),
+      m_batchEditDepth(0),
+      m_flushingBatchEdit(false),
       m_workspaceObjectOrder(std::shared_ptr<WorkspaceObjectOrder_Impl>(new
           WorkspaceObjectOrder_Impl(hs,std::bind(&Workspace_Impl::getObject,this,std::placeholders::_1))))
   {
@@ -123,8 +197,14 @@ namespace detail {
       }
       m_workspaceObjectOrder.setDirectOrder(subsetOrder);
     }
-    m_workspaceObjectMap.reserve(1<<15);
-    m_idfReferencesMap.reserve(1<<15);
+    m_workspaceObjectMap.reserve(hs.size());
+  }
+
+  Workspace_Impl::~Workspace_Impl()
+  {
+    // every object's onChange is connected to this workspace, drop those connections in one pass
+    // rather than have each object search for its own as m_workspaceObjectMap is destroyed
+    disconnectAll();
   }
 
   Workspace Workspace_Impl::clone(bool keepHandles) const {
@@ -169,21 +249,33 @@ namespace detail {
     m_fastNaming = otherImpl->m_fastNaming;
     otherImpl->m_fastNaming = tfn;
 
-    WorkspaceObjectMap twop = m_workspaceObjectMap;
-    m_workspaceObjectMap = otherImpl->m_workspaceObjectMap;
-    otherImpl->m_workspaceObjectMap = twop;
+    std::swap(m_idfObjectDiffMode, otherImpl->m_idfObjectDiffMode);
+
+    m_workspaceObjectMap.swap(otherImpl->m_workspaceObjectMap);
 
     WorkspaceObjectOrder twoo = m_workspaceObjectOrder;
     m_workspaceObjectOrder = otherImpl->m_workspaceObjectOrder;
     otherImpl->m_workspaceObjectOrder = twoo;
 
-    IddObjectTypeMap tiotm = m_iddObjectTypeMap;
-    m_iddObjectTypeMap = otherImpl->m_iddObjectTypeMap;
-    otherImpl->m_iddObjectTypeMap = tiotm;
+    m_iddObjectTypeMap.swap(otherImpl->m_iddObjectTypeMap);
+    m_idfReferencesMap.swap(otherImpl->m_idfReferencesMap);
+
+    m_nameMap.swap(otherImpl->m_nameMap);
+    m_iddObjectTypeNameMap.swap(otherImpl->m_iddObjectTypeNameMap);
+    m_nameSeriesMap.swap(otherImpl->m_nameSeriesMap);
+    m_iddObjectTypeNameSeriesMap.swap(otherImpl->m_iddObjectTypeNameSeriesMap);
 
-    IdfReferencesMap tirm = m_idfReferencesMap;
-    m_idfReferencesMap = otherImpl->m_idfReferencesMap;
-    otherImpl->m_idfReferencesMap = tirm;
+    // objects follow their data into the other impl
+    for (const WorkspaceObjectMap::value_type& p : m_workspaceObjectMap) {
+      p.second->onChange.disconnect<Workspace_Impl, &Workspace_Impl::change>(otherImpl.get());
+      p.second->onChange.connect<Workspace_Impl, &Workspace_Impl::change>(this);
+      p.second->m_workspace = this;
+    }
+    for (const WorkspaceObjectMap::value_type& p : otherImpl->m_workspaceObjectMap) {
+      p.second->onChange.disconnect<Workspace_Impl, &Workspace_Impl::change>(this);
+      p.second->onChange.connect<Workspace_Impl, &Workspace_Impl::change>(otherImpl.get());
+      p.second->m_workspace = otherImpl.get();
+    }
   }
 
   // GETTERS
@@ -232,6 +324,14 @@ namespace detail {
     return boost::none;
   }
 
+  const std::shared_ptr<WorkspaceObject_Impl>* Workspace_Impl::findObject(const Handle& handle) const {
+    auto womIt = m_workspaceObjectMap.find(handle);
+    if (womIt != m_workspaceObjectMap.end()) {
+      return &(womIt->second);
+    }
+    return nullptr;
+  }
+
   std::vector<WorkspaceObject> Workspace_Impl::objects(bool sorted) const {
     OptionalIddObject versionIdd = m_iddFileAndFactoryWrapper.versionObject();
     if (!versionIdd) { return WorkspaceObjectVector(); }
@@ -344,10 +444,17 @@ namespace detail {
                                                                 bool exactMatch) const
   {
     WorkspaceObjectVector result;
-    if (exactMatch) {
+    if (exactMatch && !name.empty()) {
+      auto range = m_nameMap.equal_range(nameMapKey(name));
+      for (auto it = range.first; it != range.second; ++it) {
+        result.push_back(WorkspaceObject(it->second));
+      }
+    }
+    else if (exactMatch) {
+      // empty names are not kept in the name map
       for (const WorkspaceObjectMap::value_type& p : m_workspaceObjectMap) {
         if (OptionalString candidate = p.second->name()) {
-          if (istringEqual(*candidate,name)) {
+          if (candidate->empty()) {
             result.push_back(WorkspaceObject(p.second));
           }
         }
@@ -355,28 +462,51 @@ namespace detail {
     }
     else {
       std::string baseName = getBaseName(name);
-      for (const WorkspaceObjectMap::value_type& p : m_workspaceObjectMap) {
-        if (OptionalString candidate = p.second->name()) {
-          if (baseNamesMatch(baseName, *candidate)) {
+      if (!baseName.empty()) {
+        auto loc = m_nameSeriesMap.find(nameMapKey(baseName));
+        if (loc != m_nameSeriesMap.end()) {
+          result.reserve(loc->second.objects.size());
+          for (const WorkspaceObjectMap::value_type& p : loc->second.objects) {
             result.push_back(WorkspaceObject(p.second));
           }
         }
       }
+      else {
+        // empty names are not kept in the name series maps
+        for (const WorkspaceObjectMap::value_type& p : m_workspaceObjectMap) {
+          if (OptionalString candidate = p.second->name()) {
+            if (baseNamesMatch(baseName, *candidate)) {
+              result.push_back(WorkspaceObject(p.second));
+            }
+          }
+        }
+      }
     }
     return result;
   }
 
   std::vector<WorkspaceObject> Workspace_Impl::getObjectsByType(IddObjectType objectType) const {
-    auto loc = m_iddObjectTypeMap.find(objectType);
-    if (loc == m_iddObjectTypeMap.end()) { return WorkspaceObjectVector(); }
+    const WorkspaceObjectMap* objects = findObjectsOfType(objectType);
+    if (!objects) { return WorkspaceObjectVector(); }
     std::vector<WorkspaceObject> result;
-    result.reserve(loc->second.size());
-    for( auto it = loc->second.begin(); it != loc->second.end(); ++it ) {
+    result.reserve(objects->size());
+    for( auto it = objects->begin(); it != objects->end(); ++it ) {
       result.push_back( it->second );
     }
     return result;
   }
 
+  void Workspace_Impl::forEachObjectOfType(
+      IddObjectType objectType,
+      const std::function<void (const std::shared_ptr<WorkspaceObject_Impl>&)>& visitor) const
+  {
+    const WorkspaceObjectMap* objects = findObjectsOfType(objectType);
+    if (!objects) { return; }
+    for (const WorkspaceObjectMap::value_type& p : *objects) {
+      visitor(p.second);
+    }
+  }
+
   std::vector<WorkspaceObject> Workspace_Impl::getObjectsByType(const IddObject& objectType) const {
     WorkspaceObjectVector result;
     for (const WorkspaceObject& object : objects()) {
@@ -390,13 +520,23 @@ namespace detail {
   boost::optional<WorkspaceObject> Workspace_Impl::getObjectByTypeAndName(
       IddObjectType objectType,const std::string& name) const
   {
-    for (const WorkspaceObject& object : getObjectsByType(objectType)) {
-      OptionalString candidate = object.name();
-      if (candidate && istringEqual(*candidate,name)) {
-        return object;
+    if (name.empty()) {
+      const WorkspaceObjectMap* objects = findObjectsOfType(objectType);
+      if (!objects) { return boost::none; }
+      for (const WorkspaceObjectMap::value_type& p : *objects) {
+        OptionalString candidate = p.second->name();
+        if (candidate && candidate->empty()) {
+          return WorkspaceObject(p.second);
+        }
       }
+      return boost::none;
     }
-    return boost::none;
+
+    auto loc = m_iddObjectTypeNameMap.find(objectType);
+    if (loc == m_iddObjectTypeNameMap.end()) { return boost::none; }
+    auto it = loc->second.find(nameMapKey(name));
+    if (it == loc->second.end()) { return boost::none; }
+    return WorkspaceObject(it->second);
   }
 
   std::vector<WorkspaceObject> Workspace_Impl::getObjectsByTypeAndName(
@@ -405,12 +545,24 @@ namespace detail {
   {
     WorkspaceObjectVector result;
     std::string baseName = getBaseName(name);
-    for (const WorkspaceObject& object : getObjectsByType(objectType)) {
-      if (OptionalString candidate = object.name()) {
-        if (baseNamesMatch(baseName, *candidate)) {
-          result.push_back(object);
+    if (baseName.empty()) {
+      for (const WorkspaceObject& object : getObjectsByType(objectType)) {
+        if (OptionalString candidate = object.name()) {
+          if (baseNamesMatch(baseName, *candidate)) {
+            result.push_back(object);
+          }
         }
       }
+      return result;
+    }
+
+    auto loc = m_iddObjectTypeNameSeriesMap.find(objectType);
+    if (loc == m_iddObjectTypeNameSeriesMap.end()) { return result; }
+    auto it = loc->second.find(nameMapKey(baseName));
+    if (it == loc->second.end()) { return result; }
+    result.reserve(it->second.objects.size());
+    for (const WorkspaceObjectMap::value_type& p : it->second.objects) {
+      result.push_back(WorkspaceObject(p.second));
     }
     return result;
   }
@@ -418,11 +570,12 @@ namespace detail {
   std::vector<WorkspaceObject> Workspace_Impl::getObjectsByReference(
       const std::string& referenceName) const
   {
-    auto loc = m_idfReferencesMap.find(referenceName);
-    if (loc == m_idfReferencesMap.end()) { return WorkspaceObjectVector(); }
+    boost::optional<unsigned> referenceId = ReferenceListSet::findId(referenceName);
+    const WorkspaceObjectMap* objects = referenceId ? findObjectsByReference(*referenceId) : nullptr;
+    if (!objects) { return WorkspaceObjectVector(); }
     std::vector<WorkspaceObject> result;
-    result.reserve(loc->second.size());
-    for( auto it = loc->second.begin(); it != loc->second.end(); ++it ) {
+    result.reserve(objects->size());
+    for( auto it = objects->begin(); it != objects->end(); ++it ) {
       result.push_back( it->second );
     }
     return result;
@@ -433,9 +586,9 @@ namespace detail {
   {
     WorkspaceObjectMap objectMap;
     for (const std::string& referenceName : referenceNames) {
-      auto loc = m_idfReferencesMap.find(referenceName);
-      if (loc != m_idfReferencesMap.end()) {
-        objectMap.insert(loc->second.begin(),loc->second.end());
+      boost::optional<unsigned> referenceId = ReferenceListSet::findId(referenceName);
+      if (const WorkspaceObjectMap* objects = referenceId ? findObjectsByReference(*referenceId) : nullptr) {
+        objectMap.insert(objects->begin(),objects->end());
       }
     }
     std::vector<WorkspaceObject> result;
@@ -450,10 +603,43 @@ namespace detail {
       std::string name,
       const std::vector<std::string>& referenceNames) const
   {
-    for (const WorkspaceObject& object : getObjectsByReference(referenceNames)) {
-      OptionalString candidate = object.name();
-      if (candidate && istringEqual(*candidate,name)) {
-        return object;
+    std::vector<unsigned> referenceIds;
+    referenceIds.reserve(referenceNames.size());
+    for (const std::string& referenceName : referenceNames) {
+      if (boost::optional<unsigned> referenceId = ReferenceListSet::findId(referenceName)) {
+        referenceIds.push_back(*referenceId);
+      }
+    }
+    return getObjectByNameAndReference(name, referenceIds);
+  }
+
+  boost::optional<WorkspaceObject> Workspace_Impl::getObjectByNameAndReference(
+      const std::string& name,
+      const std::vector<unsigned>& referenceIds) const
+  {
+    if (!name.empty()) {
+      // look up by name, then check reference lists
+      auto range = m_nameMap.equal_range(nameMapKey(name));
+      for (auto it = range.first; it != range.second; ++it) {
+        for (unsigned referenceId : referenceIds) {
+          const WorkspaceObjectMap* objects = findObjectsByReference(referenceId);
+          if (objects && (objects->count(it->second->handle()) > 0)) {
+            return WorkspaceObject(it->second);
+          }
+        }
+      }
+      return boost::none;
+    }
+
+    // unnamed objects are not in the name map, so look through the reference lists
+    for (unsigned referenceId : referenceIds) {
+      if (const WorkspaceObjectMap* objects = findObjectsByReference(referenceId)) {
+        for (const WorkspaceObjectMap::value_type& p : *objects) {
+          OptionalString candidate = p.second->name();
+          if (candidate && candidate->empty()) {
+            return WorkspaceObject(p.second);
+          }
+        }
       }
     }
     return boost::none;
@@ -464,6 +650,48 @@ namespace detail {
     return m_fastNaming;
   }
 
+  IdfObjectDiffMode Workspace_Impl::idfObjectDiffMode() const
+  {
+    return m_idfObjectDiffMode;
+  }
+
+  unsigned Workspace_Impl::numIdfObjectDiffs() const
+  {
+    unsigned result = 0;
+    for (const WorkspaceObjectMap::value_type& p : m_workspaceObjectMap) {
+      result += p.second->numDiffs();
+    }
+    return result;
+  }
+
+  bool Workspace_Impl::isBatchEditing() const
+  {
+    return (m_batchEditDepth > 0);
+  }
+
+  std::size_t Workspace_Impl::idfObjectDiffMemoryUsage() const
+  {
+    std::size_t result = 0;
+    for (const WorkspaceObjectMap::value_type& p : m_workspaceObjectMap) {
+      result += p.second->diffMemoryUsage();
+    }
+    return result;
+  }
+
+  std::size_t Workspace_Impl::objectMapsMemoryUsage() const
+  {
+    std::size_t result = m_workspaceObjectMap.memoryUsage();
+    result += m_iddObjectTypeMap.capacity() * sizeof(WorkspaceObjectMap);
+    for (const WorkspaceObjectMap& objects : m_iddObjectTypeMap) {
+      result += objects.memoryUsage();
+    }
+    result += m_idfReferencesMap.capacity() * sizeof(WorkspaceObjectMap);
+    for (const WorkspaceObjectMap& objects : m_idfReferencesMap) {
+      result += objects.memoryUsage();
+    }
+    return result;
+  }
+
   // SETTERS
 
   bool Workspace_Impl::setStrictnessLevel(StrictnessLevel level) {
@@ -592,6 +820,244 @@ namespace detail {
     return newObjects;
   }
 
+  std::vector<WorkspaceObject> Workspace_Impl::bulkAddObjects(
+      std::vector<std::shared_ptr<WorkspaceObject_Impl> >& objectImplPtrs,
+      bool resolveNameConflicts)
+  {
+    HandleVector newHandles;
+    WorkspaceObjectVector newObjects;
+    bool hadObjects = !m_workspaceObjectMap.empty();
+
+    int N = objectImplPtrs.size();
+    this->progressRange.nano_emit(0, 3*N);
+    this->progressValue.nano_emit(0);
+    this->progressCaption.nano_emit("Adding Objects");
+
+    // step 1: add to pre-sized maps
+    std::size_t numTypes = m_iddObjectTypeMap.size();
+    std::size_t numReferences = m_idfReferencesMap.size();
+    reserveForObjects(objectImplPtrs);
+    newHandles.reserve(N);
+    bool ok = true;
+    for (WorkspaceObject_ImplPtr& ptr : objectImplPtrs) {
+      if (!nominallyAddObject(ptr)) {
+        LOG(Error,"Tried to add two objects with the same handle: " << ptr->handle());
+        ok = false;
+        break;
+      }
+      newHandles.push_back(ptr->handle());
+    }
+    this->progressValue.nano_emit(N);
+
+    // step 2: index new objects by reference and upper-cased name. two objects landing on the
+    // same entry is exactly what resolvePotentialNameConflicts looks for.
+    std::unordered_map<unsigned, std::unordered_map<std::string, WorkspaceObject_Impl*> > targetIndex;
+    bool potentialNameConflicts = hadObjects;
+    if (ok) {
+      for (const WorkspaceObject_ImplPtr& ptr : objectImplPtrs) {
+        OptionalString name = ptr->name();
+        if (!name || name->empty()) { continue; }
+        std::string key = nameMapKey(*name);
+        for (unsigned referenceId : ptr->iddObject().validation()->referenceIds()) {
+          if (!targetIndex[referenceId].insert(std::make_pair(key, ptr.get())).second) {
+            potentialNameConflicts = true;
+          }
+        }
+      }
+    }
+
+    // step 3: replace string pointers in one pass
+    if (ok) {
+      for (WorkspaceObject_ImplPtr& ptr : objectImplPtrs) {
+        IddObject iddObject = ptr->iddObject();
+        bool ptrsAsHandles = iddObject.hasHandleField();
+        std::shared_ptr<const IddObjectValidation> validation = iddObject.validation();
+        for (unsigned index : ptr->objectListFields()) {
+          std::string targetName = ptr->IdfObject_Impl::getString(index).get();
+          Handle targetHandle;
+          if (!targetName.empty()) {
+            if (ptrsAsHandles) {
+              targetHandle = toUUID(targetName);
+              if (m_workspaceObjectMap.find(targetHandle) == m_workspaceObjectMap.end()) {
+                targetHandle = Handle();
+              }
+            }
+            const std::vector<unsigned>& objectListIds = validation->field(index)->objectListIds;
+            if (targetHandle.isNull()) {
+              std::string key = nameMapKey(targetName);
+              for (unsigned referenceId : objectListIds) {
+                auto referenceIt = targetIndex.find(referenceId);
+                if (referenceIt == targetIndex.end()) { continue; }
+                auto it = referenceIt->second.find(key);
+                if (it != referenceIt->second.end()) {
+                  targetHandle = it->second->handle();
+                  break;
+                }
+              }
+            }
+            if (targetHandle.isNull() && hadObjects) {
+              OptionalWorkspaceObject target = getObjectByNameAndReference(targetName,objectListIds);
+              if (target) {
+                targetHandle = target->handle();
+              }
+            }
+            if (targetHandle.isNull()) {
+              LOG(Warn,ptr->briefDescription() << ", points to an object named " << targetName
+                  << " from field " << index << ", but that object cannot be located.");
+            }
+          }
+          ptr->setPointerImpl(index,targetHandle);
+        }
+      }
+      this->progressValue.nano_emit(2*N);
+    }
+
+    // step 4: register initialization
+    if (ok) {
+      newObjects.reserve(N);
+      for (WorkspaceObject_ImplPtr& ptr : objectImplPtrs) {
+        ptr->setInitialized();
+        newObjects.push_back(WorkspaceObject(ptr));
+      }
+      this->progressValue.nano_emit(3*N);
+    }
+
+    // step 5: check validity once, now that everything is in place
+    ok = ok && isValid();
+
+    // step 6: rollback if necessary
+    if (!ok) {
+      LOG(Info,"Unable to add objects to Workspace. The validity report is: " <<
+          std::endl << validityReport());
+      nominallyRemoveObjects(newHandles); // no validity check
+      releaseObjectMaps(numTypes, numReferences);
+      for (WorkspaceObject_ImplPtr& ptr : objectImplPtrs) {
+        ptr->disconnect();
+      }
+      newObjects.clear();
+      return newObjects;
+    }
+
+    // step 7: emit signals for successful completion
+    for (const WorkspaceObject& newObject : newObjects) {
+      registerAdditionOfObject(newObject);
+    }
+
+    // step 8: rename only if the index saw a conflict (or could not see the whole Workspace)
+    if (resolveNameConflicts && potentialNameConflicts) {
+      Workspace thisWorkspace = workspace();
+      resolvePotentialNameConflicts(thisWorkspace);
+    }
+
+    return newObjects;
+  }
+
+  bool Workspace_Impl::addSnapshotObjects(const WorkspaceSnapshotReader& snapshot)
+  {
+    OS_ASSERT(m_workspaceObjectMap.empty());
+    std::string iddStamp = snapshotIddStamp(m_iddFileAndFactoryWrapper);
+    if (snapshot.iddVersion() != iddStamp) {
+      LOG(Info,"Snapshot was written against IDD '" << snapshot.iddVersion() << "', not '"
+          << iddStamp << "'.");
+      return false;
+    }
+    m_header = std::string(snapshot.header());
+
+    int N = snapshot.numObjects();
+    this->progressRange.nano_emit(0, 2*N);
+    this->progressValue.nano_emit(0);
+    this->progressCaption.nano_emit("Adding Objects");
+
+    // step 1: look up the IddObject of each section once
+    IddObjectVector sectionIddObjects;
+    for (unsigned s = 0, n = snapshot.numSections(); s < n; ++s) {
+      OptionalIddObject iddObject = m_iddFileAndFactoryWrapper.getObject(std::string(snapshot.sectionTypeName(s)));
+      if (!iddObject) {
+        LOG(Error,"Snapshot contains objects of unknown type '" << snapshot.sectionTypeName(s) << "'.");
+        return false;
+      }
+      sectionIddObjects.push_back(*iddObject);
+    }
+
+    // step 2: construct objects in Workspace order, pointer fields are left blank
+    WorkspaceObject_ImplPtrVector objectImplPtrs;
+    objectImplPtrs.reserve(N);
+    std::vector<WorkspaceObject_Impl*> objectsByNumber(N, nullptr);
+    for (int i = 0; i < N; ++i) {
+      unsigned object = snapshot.orderedObject(i);
+      // each field is copied once, straight into the storage the object keeps
+      StringVector fields;
+      fields.reserve(snapshot.numFields(object));
+      for (unsigned j = 0, n = snapshot.numFields(object); j < n; ++j) {
+        fields.emplace_back(snapshot.field(object,j));
+      }
+      StringVector fieldComments;
+      fieldComments.reserve(snapshot.numFieldComments(object));
+      for (unsigned j = 0, n = snapshot.numFieldComments(object); j < n; ++j) {
+        fieldComments.emplace_back(snapshot.fieldComment(object,j));
+      }
+      IdfObject idfObject(std::shared_ptr<IdfObject_Impl>(new IdfObject_Impl(
+          snapshot.handle(object),std::string(snapshot.comment(object)),
+          sectionIddObjects[snapshot.section(object)],std::move(fields),std::move(fieldComments))));
+      objectImplPtrs.push_back(createObject(idfObject,true));
+      objectsByNumber[object] = objectImplPtrs.back().get();
+    }
+
+    // step 3: add to pre-sized maps
+    HandleVector newHandles;
+    newHandles.reserve(N);
+    std::size_t numTypes = m_iddObjectTypeMap.size();
+    std::size_t numReferences = m_idfReferencesMap.size();
+    reserveForObjects(objectImplPtrs);
+    bool ok = true;
+    for (WorkspaceObject_ImplPtr& ptr : objectImplPtrs) {
+      if (!nominallyAddObject(ptr)) {
+        LOG(Error,"Tried to add two objects with the same handle: " << ptr->handle());
+        ok = false;
+        break;
+      }
+      newHandles.push_back(ptr->handle());
+    }
+    this->progressValue.nano_emit(N);
+
+    // step 4: set pointers to the recorded targets
+    if (ok) {
+      for (int i = 0; i < N; ++i) {
+        unsigned object = snapshot.orderedObject(i);
+        unsigned numFields = snapshot.numFields(object);
+        WorkspaceObject_ImplPtr& ptr = objectImplPtrs[i];
+        for (unsigned index : ptr->objectListFields()) {
+          Handle targetHandle;
+          if (index < numFields) {
+            if (boost::optional<unsigned> target = snapshot.target(object,index)) {
+              targetHandle = objectsByNumber[*target]->handle();
+            }
+          }
+          ptr->setPointerImpl(index,targetHandle);
+        }
+        ptr->setInitialized();
+      }
+      this->progressValue.nano_emit(2*N);
+    }
+
+    // step 5: rollback if necessary
+    if (!ok) {
+      nominallyRemoveObjects(newHandles); // no validity check
+      releaseObjectMaps(numTypes, numReferences);
+      for (WorkspaceObject_ImplPtr& ptr : objectImplPtrs) {
+        ptr->disconnect();
+      }
+      return false;
+    }
+
+    // step 6: emit signals for successful completion
+    for (const WorkspaceObject_ImplPtr& ptr : objectImplPtrs) {
+      registerAdditionOfObject(WorkspaceObject(ptr));
+    }
+
+    return true;
+  }
+
   std::vector<WorkspaceObject> Workspace_Impl::addClones(
       std::vector< std::shared_ptr<WorkspaceObject_Impl> >& objectImplPtrs,
       const HandleMap& oldNewHandleMap,
@@ -618,6 +1084,7 @@ namespace detail {
       m_workspaceObjectMap.insert(WorkspaceObjectMap::value_type(newHandles.back(),ptr));
       insertIntoIddObjectTypeMap(ptr);
       insertIntoIdfReferencesMap(ptr);
+      insertIntoNameMaps(ptr);
       this->progressValue.nano_emit(++i);
     }
 
@@ -1427,10 +1894,9 @@ namespace detail {
         // ... try to find target in workspace
         OptionalString targetName = newObject.getString(i);
         OS_ASSERT(targetName);
-        OptionalIddField iddField = newObject.iddObject().getField(i);
-        OS_ASSERT(iddField);
-        OptionalWorkspaceObject oTarget = getObjectByNameAndReference(
-            *targetName,iddField->properties().objectLists);
+        const IddFieldValidation* field = newObject.iddObject().validation()->field(i);
+        OS_ASSERT(field);
+        OptionalWorkspaceObject oTarget = getObjectByNameAndReference(*targetName,field->objectListIds);
         if (oTarget) {
           targets.push_back(UHPointer(0,i,oTarget->handle()));
         }
@@ -1512,7 +1978,10 @@ namespace detail {
     if ((m_strictnessLevel < StrictnessLevel::Final) || isValid()) {
       std::vector<Handle> removedHandles(1, handle);
       registerRemovalOfObject(objectData->objectImplPtr,sources,removedHandles);
-      this->onChange.nano_emit();
+      if (m_batchEditDepth > 0) {
+        recordBatchEdit(handle,false);
+      }
+      this->change();
       return true;
     }
     else {
@@ -1544,7 +2013,12 @@ namespace detail {
 
     if ((m_strictnessLevel < StrictnessLevel::Final) || isValid()) {
       registerRemovalOfObjects(objectData,sources,handles);
-      this->onChange.nano_emit();
+      if (m_batchEditDepth > 0) {
+        for (const SavedWorkspaceObject& savedObject : objectData) {
+          recordBatchEdit(savedObject.handle,false);
+        }
+      }
+      this->change();
       return true;
     }
     else {
@@ -1566,7 +2040,7 @@ namespace detail {
     OptionalIddField iddField = sourceObject.iddObject().getField(index);
     OS_ASSERT(iddField);
     for (const std::string& referenceName : iddField->properties().references) {
-      m_idfReferencesMap[referenceName].insert(std::make_pair(targetHandle,getObject(targetHandle)->getImpl<WorkspaceObject_Impl>()));
+      objectsByReference(ReferenceListSet::id(referenceName)).insert(std::make_pair(targetHandle,getObject(targetHandle)->getImpl<WorkspaceObject_Impl>()));
     }
   }
 
@@ -1613,9 +2087,10 @@ namespace detail {
         }
         // if not, erase the reference
         if (!found) {
-          auto it = m_idfReferencesMap[referenceName].find(targetObject.handle());
-          OS_ASSERT(it != m_idfReferencesMap[referenceName].end());
-          m_idfReferencesMap[referenceName].erase(it);
+          WorkspaceObjectMap& objects = objectsByReference(ReferenceListSet::id(referenceName));
+          auto it = objects.find(targetObject.handle());
+          OS_ASSERT(it != objects.end());
+          objects.erase(it);
         }
       }
     }
@@ -1626,6 +2101,84 @@ namespace detail {
     m_fastNaming = fastNaming;
   }
 
+  void Workspace_Impl::setIdfObjectDiffMode(const IdfObjectDiffMode& mode)
+  {
+    m_idfObjectDiffMode = mode;
+  }
+
+  void Workspace_Impl::beginBatchEdit()
+  {
+    ++m_batchEditDepth;
+  }
+
+  void Workspace_Impl::endBatchEdit()
+  {
+    if (m_batchEditDepth == 0) {
+      LOG(Warn,"endBatchEdit called without a matching beginBatchEdit.");
+      return;
+    }
+    if (m_batchEditDepth > 1) {
+      --m_batchEditDepth;
+      return;
+    }
+
+    // emit the held back object signals; onChange is still held back until all are out
+    std::vector<Handle> handles;
+    handles.swap(m_batchEditHandles);
+    FlatHandleMap<bool> added;
+    added.swap(m_batchEditAdded);
+    m_flushingBatchEdit = true;
+    try {
+      for (const Handle& handle : handles) {
+        const std::shared_ptr<WorkspaceObject_Impl>* object = findObject(handle);
+        if (!object) {
+          // removed during the batch edit
+          continue;
+        }
+        // slots may add objects, which invalidates object
+        std::shared_ptr<WorkspaceObject_Impl> objectImplPtr = *object;
+        if (added.find(handle)->second) {
+          this->addWorkspaceObject.nano_emit(WorkspaceObject(objectImplPtr), objectImplPtr->iddObject().type(), handle);
+          this->addWorkspaceObjectPtr.nano_emit(objectImplPtr, objectImplPtr->iddObject().type(), handle);
+        }
+        objectImplPtr->emitChangeSignals();
+      }
+    }
+    catch (...) {
+      // a slot threw, the batch edit is over all the same
+      m_flushingBatchEdit = false;
+      m_batchEditDepth = 0;
+      m_batchEditHandles.clear();
+      m_batchEditAdded.clear();
+      throw;
+    }
+    m_flushingBatchEdit = false;
+    m_batchEditDepth = 0;
+
+    // objects touched by those slots were signaled directly, but are still part of this batch
+    for (const Handle& handle : m_batchEditHandles) {
+      if (added.insert(std::make_pair(handle,false)).second) {
+        handles.push_back(handle);
+      }
+    }
+    m_batchEditHandles.clear();
+    m_batchEditAdded.clear();
+
+    if (!handles.empty()) {
+      this->onChange.nano_emit();
+      this->onBatchChange.nano_emit(handles);
+    }
+  }
+
+  bool Workspace_Impl::deferChangeSignals(const Handle& handle)
+  {
+    if (m_batchEditDepth == 0) {
+      return false;
+    }
+    recordBatchEdit(handle,false);
+    return !m_flushingBatchEdit;
+  }
+
   // OBJECT ORDER
 
   WorkspaceObjectOrder Workspace_Impl::order() {
@@ -1657,9 +2210,9 @@ namespace detail {
   }
 
   unsigned Workspace_Impl::numObjectsOfType(IddObjectType type) const {
-    auto iotmLoc = m_iddObjectTypeMap.find(type);
-    if (iotmLoc == m_iddObjectTypeMap.end()) { return 0; }
-    return iotmLoc->second.size();
+    const WorkspaceObjectMap* objects = findObjectsOfType(type);
+    if (!objects) { return 0; }
+    return objects->size();
   }
 
   unsigned Workspace_Impl::numObjectsOfType(const IddObject& objectType) const {
@@ -1678,17 +2231,28 @@ namespace detail {
       if (istringEqual(referenceName,"AllObjects")) {
         return true;
       }
-      auto irmLoc = m_idfReferencesMap.find(referenceName);
-      if (irmLoc != m_idfReferencesMap.end()) {
-        auto it = irmLoc->second.find(handle);
-        if (it != irmLoc->second.end()) {
-          return true;
-        }
+      boost::optional<unsigned> referenceId = ReferenceListSet::findId(referenceName);
+      const WorkspaceObjectMap* objects = referenceId ? findObjectsByReference(*referenceId) : nullptr;
+      if (objects && (objects->count(handle) > 0)) {
+        return true;
       }
     }
     return false;
   }
 
+  bool Workspace_Impl::canBeTarget(const Handle& handle, const IddFieldValidation& field) const
+  {
+    if (field.allObjects) {
+      return true;
+    }
+    // objects are listed under each of the references of their IddObject
+    const std::shared_ptr<WorkspaceObject_Impl>* object = findObject(handle);
+    if (!object) {
+      return false;
+    }
+    return (*object)->iddObject().validation()->references().intersects(field.objectLists);
+  }
+
   bool Workspace_Impl::isInIddFile(IddObjectType type) const {
     return m_iddFileAndFactoryWrapper.isInFile(type);
   }
@@ -1698,8 +2262,12 @@ namespace detail {
       return toString(createUUID());
     }
 
-    WorkspaceObjectVector objectsInSeries = getObjectsByName(name,false);
-    return constructNextName(name,objectsInSeries,fillIn);
+    const NameSeries* series = nullptr;
+    auto loc = m_nameSeriesMap.find(nameMapKey(getBaseName(name)));
+    if (loc != m_nameSeriesMap.end()) {
+      series = &(loc->second);
+    }
+    return constructNextName(name,series,fillIn);
   }
 
   std::string Workspace_Impl::nextName(const IddObjectType& iddObjectType, bool fillIn) const {
@@ -1712,8 +2280,15 @@ namespace detail {
       return std::string();
     }
     std::string name = iddObjectNameToIdfObjectName(iddObject->name());
-    WorkspaceObjectVector objectsInSeries = getObjectsByTypeAndName(iddObjectType,name);
-    return constructNextName(name,objectsInSeries,fillIn);
+    const NameSeries* series = nullptr;
+    auto loc = m_iddObjectTypeNameSeriesMap.find(iddObjectType);
+    if (loc != m_iddObjectTypeNameSeriesMap.end()) {
+      auto it = loc->second.find(nameMapKey(getBaseName(name)));
+      if (it != loc->second.end()) {
+        series = &(it->second);
+      }
+    }
+    return constructNextName(name,series,fillIn);
   }
 
   bool Workspace_Impl::isValid() const {
@@ -1890,6 +2465,53 @@ namespace detail {
     return toIdfFile().save(p,overwrite);
   }
 
+  bool Workspace_Impl::saveBinary(const openstudio::path& p, bool overwrite) {
+    if (iddFileType() == IddFileType::UserCustom) {
+      LOG(Error,"Unable to save a binary snapshot of a Workspace that uses a custom IDD.");
+      return false;
+    }
+
+    // do not overwrite if not allowed
+    if (!overwrite) {
+      path temp = completePathToFile(p,path());
+      if (!temp.empty()) {
+        LOG(Info,"Save method failed because instructed not to overwrite path '"
+          << toString(p) << "'.");
+        return false;
+      }
+    }
+
+    if (!makeParentFolder(p)) {
+      LOG(Error,"Unable to write file to path '" << toString(p) << "', because parent directory "
+          << "could not be created.");
+      return false;
+    }
+
+    // same objects, in the same order, as toIdfFile
+    WorkspaceObjectVector objs = objects(true);
+    if (OptionalWorkspaceObject vo = versionObject()) {
+      objs.insert(objs.begin(),*vo);
+    }
+
+    WorkspaceSnapshotWriter writer(iddFileType(),m_strictnessLevel,snapshotIddStamp(m_iddFileAndFactoryWrapper),m_header);
+    std::vector<std::string_view> fields;
+    std::vector<std::pair<unsigned,Handle> > pointers;
+    for (const WorkspaceObject& obj : objs) {
+      std::shared_ptr<WorkspaceObject_Impl> ptr = obj.getImpl<WorkspaceObject_Impl>();
+      fields.clear();
+      for (unsigned i = 0, n = ptr->numFields(); i < n; ++i) {
+        fields.push_back(*(ptr->IdfObject_Impl::getStringView(i)));
+      }
+      pointers.clear();
+      for (unsigned index : ptr->objectListFields()) {
+        OptionalWorkspaceObject target = ptr->getTarget(index);
+        pointers.push_back(std::make_pair(index,target ? target->handle() : Handle()));
+      }
+      writer.addObject(ptr->iddObject().name(),ptr->handle(),ptr->comment(),fields,ptr->fieldComments(),pointers);
+    }
+    return writer.save(p);
+  }
+
   IdfFile Workspace_Impl::toIdfFile() {
 
     IdfFile result;
@@ -1932,65 +2554,19 @@ namespace detail {
   }
 
   std::tuple<boost::optional<int>, std::string> Workspace_Impl::getNameSuffix(const std::string& objectName) const {
-
-    std::size_t found1 = objectName.find_last_of(' ');
-    std::size_t found2 = objectName.find_last_of('_');
-    std::size_t found = string::npos;
-    std::string spacer = " ";
-    if (found1 != string::npos && found2 != string::npos) {
-      found = std::max(found1, found2);
-      if (found2 > found1) {
-        spacer = "_";
-      }
-    } else if (found1 != string::npos) {
-      found = found1;
-      spacer = " ";
-    } else if (found2 != string::npos) {
-      found = found2;
-      spacer = "_";
-    }
-
-    if ( found != string::npos ) {
-      std::string strSuffix = objectName.substr(found+1);
-      const char *p = strSuffix.c_str();
-      int suffix = 0;
-      unsigned count = 0;
-      while (*p >= '0' && *p <= '9') {
-          suffix = (suffix * 10) + (*p - '0');
-          ++p;
-          ++count;
-      }
-      if (suffix > 0 && count == strSuffix.size() ) { return std::make_tuple(suffix, spacer); }
+    int suffix = 0;
+    std::size_t found = findNameSuffix(objectName, suffix);
+    if (found != string::npos) {
+      return std::make_tuple(suffix, std::string(1, objectName[found]));
     }
     return std::make_tuple(boost::none, " ");
   }
 
   std::string Workspace_Impl::getBaseName(const std::string& objectName) const {
-
-    std::size_t found1 = objectName.find_last_of(' ');
-    std::size_t found2 = objectName.find_last_of('_');
-    std::size_t found = string::npos;
-    if (found1 != string::npos && found2 != string::npos) {
-      found = std::max(found1, found2);
-    } else if (found1 != string::npos) {
-      found = found1;
-    } else if (found2 != string::npos) {
-      found = found2;
-    }
-
-    if ( found != string::npos ) {
-      std::string strSuffix = objectName.substr(found+1);
-      const char *p = strSuffix.c_str();
-      int suffix = 0;
-      unsigned count = 0;
-      while (*p >= '0' && *p <= '9') {
-          suffix = (suffix * 10) + (*p - '0');
-          ++p;
-          ++count;
-      }
-      if (suffix > 0 && count == strSuffix.size() ) {
-        return objectName.substr(0, found);
-      }
+    int suffix = 0;
+    std::size_t found = findNameSuffix(objectName, suffix);
+    if (found != string::npos) {
+      return objectName.substr(0, found);
     }
     return objectName;
   }
@@ -2052,6 +2628,86 @@ namespace detail {
     }
   }
 
+  Workspace_Impl::WorkspaceObjectMap& Workspace_Impl::objectsOfType(IddObjectType type) {
+    auto index = static_cast<IddObjectTypeMap::size_type>(type.value());
+    if (index >= m_iddObjectTypeMap.size()) {
+      m_iddObjectTypeMap.resize(index + 1);
+    }
+    return m_iddObjectTypeMap[index];
+  }
+
+  const Workspace_Impl::WorkspaceObjectMap* Workspace_Impl::findObjectsOfType(IddObjectType type) const {
+    auto index = static_cast<IddObjectTypeMap::size_type>(type.value());
+    if (index >= m_iddObjectTypeMap.size()) { return nullptr; }
+    return &m_iddObjectTypeMap[index];
+  }
+
+  const Workspace_Impl::WorkspaceObjectMap* Workspace_Impl::findObjectsByReference(unsigned referenceId) const {
+    if (referenceId >= m_idfReferencesMap.size()) { return nullptr; }
+    return &m_idfReferencesMap[referenceId];
+  }
+
+  Workspace_Impl::WorkspaceObjectMap& Workspace_Impl::objectsByReference(unsigned referenceId) {
+    if (referenceId >= m_idfReferencesMap.size()) {
+      m_idfReferencesMap.resize(referenceId + 1);
+    }
+    return m_idfReferencesMap[referenceId];
+  }
+
+  void Workspace_Impl::reserveForObjects(const std::vector<std::shared_ptr<WorkspaceObject_Impl> >& objectImplPtrs)
+  {
+    std::map<IddObjectType, std::size_t> typeCounts;
+    std::map<IddObjectType, std::size_t> namedTypeCounts;
+    std::map<unsigned, std::size_t> referenceCounts;
+    for (const WorkspaceObject_ImplPtr& ptr : objectImplPtrs) {
+      IddObject iddObject = ptr->iddObject();
+      ++typeCounts[iddObject.type()];
+      OptionalString name = ptr->name();
+      if (name && !name->empty()) {
+        ++namedTypeCounts[iddObject.type()];
+      }
+      for (unsigned referenceId : iddObject.validation()->referenceIds()) {
+        ++referenceCounts[referenceId];
+      }
+    }
+
+    std::size_t n = m_workspaceObjectMap.size() + objectImplPtrs.size();
+    m_workspaceObjectMap.reserve(n);
+    m_nameMap.reserve(n);
+    m_nameSeriesMap.reserve(n);
+    for (const auto& typeCount : typeCounts) {
+      WorkspaceObjectMap& objects = objectsOfType(typeCount.first);
+      objects.reserve(objects.size() + typeCount.second);
+    }
+    // unnamed objects are not listed in the name maps, so types without names get no entry
+    for (const auto& typeCount : namedTypeCounts) {
+      NameMap& names = m_iddObjectTypeNameMap[typeCount.first];
+      names.reserve(names.size() + typeCount.second);
+    }
+    for (const auto& referenceCount : referenceCounts) {
+      WorkspaceObjectMap& objects = objectsByReference(referenceCount.first);
+      objects.reserve(objects.size() + referenceCount.second);
+    }
+  }
+
+  void Workspace_Impl::releaseObjectMaps(std::size_t numTypes, std::size_t numReferences)
+  {
+    if (m_iddObjectTypeMap.size() > numTypes) {
+      m_iddObjectTypeMap.resize(numTypes);
+    }
+    if (m_idfReferencesMap.size() > numReferences) {
+      m_idfReferencesMap.resize(numReferences);
+    }
+    for (auto it = m_iddObjectTypeNameMap.begin(); it != m_iddObjectTypeNameMap.end(); ) {
+      if (it->second.empty()) {
+        it = m_iddObjectTypeNameMap.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+  }
+
   bool Workspace_Impl::nominallyAddObject(std::shared_ptr<WorkspaceObject_Impl>& ptr) {
 
     Handle h = ptr->handle();
@@ -2073,6 +2729,9 @@ namespace detail {
     // IdfReferencesMap
     insertIntoIdfReferencesMap(ptr);
 
+    // NameMaps
+    insertIntoNameMaps(ptr);
+
     return true;
   }
 
@@ -2085,17 +2744,163 @@ namespace detail {
   void Workspace_Impl::insertIntoIddObjectTypeMap(
       const std::shared_ptr<WorkspaceObject_Impl>& objectImplPtr)
   {
-    m_iddObjectTypeMap[objectImplPtr->iddObject().type()].insert(std::make_pair(objectImplPtr->handle(),objectImplPtr));
+    objectsOfType(objectImplPtr->iddObject().type()).insert(std::make_pair(objectImplPtr->handle(),objectImplPtr));
   }
 
   void Workspace_Impl::insertIntoIdfReferencesMap(
       const std::shared_ptr<WorkspaceObject_Impl>& objectImplPtr)
   {
-    StringVector references = objectImplPtr->iddObject().references();
-    for (const std::string& referenceName : references) {
-      m_idfReferencesMap[referenceName].insert(std::make_pair(objectImplPtr->handle(), objectImplPtr));
+    for (unsigned referenceId : objectImplPtr->iddObject().validation()->referenceIds()) {
+      objectsByReference(referenceId).insert(std::make_pair(objectImplPtr->handle(), objectImplPtr));
     }
   }
+
+  void Workspace_Impl::insertIntoNameMaps(
+      const std::shared_ptr<WorkspaceObject_Impl>& objectImplPtr)
+  {
+    OptionalString name = objectImplPtr->name();
+    if (!name || name->empty()) { return; }
+    IddObjectType type = objectImplPtr->iddObject().type();
+    std::string key = nameMapKey(*name);
+    m_nameMap.insert(NameMap::value_type(key, objectImplPtr));
+    m_iddObjectTypeNameMap[type].insert(NameMap::value_type(key, objectImplPtr));
+
+    OptionalInt suffix;
+    std::string spacer;
+    key = nameSeriesKey(*name, suffix, spacer);
+    m_nameSeriesMap[key].insert(objectImplPtr, suffix, spacer);
+    m_iddObjectTypeNameSeriesMap[type][key].insert(objectImplPtr, suffix, spacer);
+  }
+
+  void Workspace_Impl::removeFromNameMaps(
+      const std::shared_ptr<WorkspaceObject_Impl>& objectImplPtr,
+      const std::string& name)
+  {
+    if (name.empty()) { return; }
+    std::string key = nameMapKey(name);
+
+    auto range = m_nameMap.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == objectImplPtr) {
+        m_nameMap.erase(it);
+        break;
+      }
+    }
+
+    auto iotnmLoc = m_iddObjectTypeNameMap.find(objectImplPtr->iddObject().type());
+    if (iotnmLoc != m_iddObjectTypeNameMap.end()) {
+      range = iotnmLoc->second.equal_range(key);
+      for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == objectImplPtr) {
+          iotnmLoc->second.erase(it);
+          break;
+        }
+      }
+      // erase entry if map is empty
+      if (iotnmLoc->second.empty()) { m_iddObjectTypeNameMap.erase(iotnmLoc); }
+    }
+
+    OptionalInt suffix;
+    std::string spacer;
+    key = nameSeriesKey(name, suffix, spacer);
+    auto nsmLoc = m_nameSeriesMap.find(key);
+    if (nsmLoc != m_nameSeriesMap.end()) {
+      nsmLoc->second.erase(objectImplPtr, suffix, spacer);
+      if (nsmLoc->second.objects.empty()) { m_nameSeriesMap.erase(nsmLoc); }
+    }
+
+    auto iotnsmLoc = m_iddObjectTypeNameSeriesMap.find(objectImplPtr->iddObject().type());
+    if (iotnsmLoc != m_iddObjectTypeNameSeriesMap.end()) {
+      nsmLoc = iotnsmLoc->second.find(key);
+      if (nsmLoc != iotnsmLoc->second.end()) {
+        nsmLoc->second.erase(objectImplPtr, suffix, spacer);
+        if (nsmLoc->second.objects.empty()) { iotnsmLoc->second.erase(nsmLoc); }
+      }
+      if (iotnsmLoc->second.empty()) { m_iddObjectTypeNameSeriesMap.erase(iotnsmLoc); }
+    }
+  }
+
+  void Workspace_Impl::NameSeries::insert(const std::shared_ptr<WorkspaceObject_Impl>& object,
+                                          const boost::optional<int>& suffix,
+                                          const std::string& spacer)
+  {
+    objects.insert(WorkspaceObjectMap::value_type(object->handle(), object));
+    if (!suffix) { return; }
+
+    std::pair<unsigned, unsigned>& counts = suffixes[*suffix];
+    ++counts.first;
+    if (spacer == "_") { ++counts.second; }
+    if (counts.first > 1u) { return; }
+
+    // suffix newly in use, merge it into the adjacent runs
+    int first = *suffix;
+    int last = *suffix;
+    auto next = runs.upper_bound(*suffix);
+    if ((next != runs.end()) && (next->first == *suffix + 1)) {
+      last = next->second;
+      next = runs.erase(next);
+    }
+    if (next != runs.begin()) {
+      auto previous = std::prev(next);
+      if (previous->second == *suffix - 1) {
+        first = previous->first;
+        runs.erase(previous);
+      }
+    }
+    runs[first] = last;
+  }
+
+  void Workspace_Impl::NameSeries::erase(const std::shared_ptr<WorkspaceObject_Impl>& object,
+                                         const boost::optional<int>& suffix,
+                                         const std::string& spacer)
+  {
+    objects.erase(object->handle());
+    if (!suffix) { return; }
+
+    auto it = suffixes.find(*suffix);
+    if (it == suffixes.end()) { return; }
+    --it->second.first;
+    if ((spacer == "_") && (it->second.second > 0u)) { --it->second.second; }
+    if (it->second.first > 0u) { return; }
+    suffixes.erase(it);
+
+    // suffix no longer in use, split the run that contains it
+    auto run = std::prev(runs.upper_bound(*suffix));
+    int first = run->first;
+    int last = run->second;
+    runs.erase(run);
+    if (first < *suffix) { runs[first] = *suffix - 1; }
+    if (*suffix < last) { runs[*suffix + 1] = last; }
+  }
+
+  int Workspace_Impl::NameSeries::nextSuffix(bool fillIn) const {
+    if (fillIn) {
+      if (runs.empty() || (runs.begin()->first != 1)) { return 1; }
+      return runs.begin()->second + 1;
+    }
+    if (suffixes.empty()) { return 1; }
+    return suffixes.rbegin()->first + 1;
+  }
+
+  std::string Workspace_Impl::NameSeries::spacer() const {
+    if (!suffixes.empty()) {
+      const std::pair<unsigned, unsigned>& counts = suffixes.rbegin()->second;
+      if (counts.second == counts.first) { return "_"; }
+    }
+    return " ";
+  }
+
+  void Workspace_Impl::updateNameMaps(const Handle& handle, const boost::optional<std::string>& oldName)
+  {
+    // objects are only listed once they are in the workspace
+    auto womIt = m_workspaceObjectMap.find(handle);
+    if (womIt == m_workspaceObjectMap.end()) { return; }
+    if (oldName) {
+      removeFromNameMaps(womIt->second, *oldName);
+    }
+    insertIntoNameMaps(womIt->second);
+  }
+
   bool Workspace_Impl::resolvePotentialNameConflicts(Workspace& other) {
     return resolvePotentialNameConflicts(other, std::vector<unsigned>());
   }
@@ -2240,6 +3045,18 @@ namespace detail {
     // direct order
     result.orderIndex = m_workspaceObjectOrder.indexInOrder(handle);
 
+    // pointers, so an undone removal can relink them
+    WorkspaceObject_ImplPtr objectImplPtr = result.objectImplPtr;
+    for (unsigned index : objectImplPtr->objectListFields()) {
+      OptionalWorkspaceObject target = objectImplPtr->getTarget(index);
+      if (target) {
+        result.pointers.push_back(HHPointer(handle,index,target->handle()));
+      }
+    }
+    for (const ReversePointer& ptr : objectImplPtr->getReversePointers()) {
+      result.pointers.push_back(HHPointer(ptr.sourceHandle,ptr.fieldIndex,handle));
+    }
+
     return result;
   }
 
@@ -2281,25 +3098,27 @@ namespace detail {
     }
 
     // IdfReferencesMap
-    StringVector references = objectImplPtr->iddObject().references();
-    for (const std::string& reference : references) {
-      auto irmLoc = m_idfReferencesMap.find(reference);
-      OS_ASSERT(irmLoc != m_idfReferencesMap.end());
-      auto loc = irmLoc->second.find(handle);
-      OS_ASSERT(loc != irmLoc->second.end());
-      irmLoc->second.erase(loc);
-      // erase entry if set is empty
-      if (irmLoc->second.empty()) { m_idfReferencesMap.erase(irmLoc); }
+    for (unsigned referenceId : objectImplPtr->iddObject().validation()->referenceIds()) {
+      WorkspaceObjectMap& objects = objectsByReference(referenceId);
+      auto loc = objects.find(handle);
+      OS_ASSERT(loc != objects.end());
+      objects.erase(loc);
+      // release storage if set is empty
+      if (objects.empty()) { objects.clear(); }
+    }
+
+    // NameMaps
+    if (OptionalString name = objectImplPtr->name()) {
+      removeFromNameMaps(objectImplPtr, *name);
     }
 
     // IddObjectTypeMap
-    auto iotmLoc = m_iddObjectTypeMap.find(objectImplPtr->iddObject().type());
-    OS_ASSERT(iotmLoc != m_iddObjectTypeMap.end());
-    auto loc = iotmLoc->second.find(handle);
-    OS_ASSERT(loc != iotmLoc->second.end());
-    iotmLoc->second.erase(loc);
-    // erase entry if set is empty
-    if (iotmLoc->second.empty()) { m_iddObjectTypeMap.erase(iotmLoc); }
+    WorkspaceObjectMap& objectsOfThisType = objectsOfType(objectImplPtr->iddObject().type());
+    auto loc = objectsOfThisType.find(handle);
+    OS_ASSERT(loc != objectsOfThisType.end());
+    objectsOfThisType.erase(loc);
+    // release storage if set is empty
+    if (objectsOfThisType.empty()) { objectsOfThisType.clear(); }
 
     // WorkspaceObjectOrder
     if (m_workspaceObjectOrder.isDirectOrder()) {
@@ -2348,13 +3167,54 @@ namespace detail {
 
   void Workspace_Impl::registerAdditionOfObject(const WorkspaceObject& object) {
     object.getImpl<WorkspaceObject_Impl>().get()->WorkspaceObject_Impl::onChange.connect<Workspace_Impl, &Workspace_Impl::change>(this);
+    if (m_batchEditDepth > 0) {
+      recordBatchEdit(object.handle(),!m_flushingBatchEdit);
+      if (!m_flushingBatchEdit) {
+        return;
+      }
+    }
     auto sh_ptr = object.getImpl<WorkspaceObject_Impl>();
     this->addWorkspaceObject.nano_emit(object, object.iddObject().type(), object.handle());
     this->addWorkspaceObjectPtr.nano_emit(sh_ptr, object.iddObject().type(), object.handle());
-    this->onChange.nano_emit();
+    this->change();
+  }
+
+  void Workspace_Impl::recordBatchEdit(const Handle& handle, bool added) {
+    std::pair<FlatHandleMap<bool>::iterator,bool> inserted = m_batchEditAdded.insert(std::make_pair(handle,added));
+    if (inserted.second) {
+      m_batchEditHandles.push_back(handle);
+    }
+    else if (added) {
+      // e.g. restored after a failed removal
+      inserted.first->second = true;
+    }
   }
 
   void Workspace_Impl::restoreObject(SavedWorkspaceObject& savedObject) {
+    reinsertObject(savedObject);
+    relinkObject(savedObject);
+
+    // Connect signals
+    WorkspaceObject workspaceObject(savedObject.objectImplPtr);
+
+    // emit signals
+    registerAdditionOfObject(workspaceObject);
+  }
+
+  void Workspace_Impl::restoreObjects(SavedWorkspaceObjectVector& savedObjects) {
+    // all objects must be back before pointers between them can be relinked
+    for (SavedWorkspaceObject& object : savedObjects) {
+      reinsertObject(object);
+    }
+    for (SavedWorkspaceObject& object : savedObjects) {
+      relinkObject(object);
+    }
+    for (SavedWorkspaceObject& object : savedObjects) {
+      registerAdditionOfObject(WorkspaceObject(object.objectImplPtr));
+    }
+  }
+
+  void Workspace_Impl::reinsertObject(SavedWorkspaceObject& savedObject) {
     // WorkspaceObjectMap
     m_workspaceObjectMap.insert(WorkspaceObjectMap::value_type(savedObject.handle,savedObject.objectImplPtr));
 
@@ -2369,58 +3229,32 @@ namespace detail {
     // IdfReferencesMap
     insertIntoIdfReferencesMap(savedObject.objectImplPtr);
 
-    // Fix Pointers
-    savedObject.objectImplPtr->restorePointers();
-
-    // Connect signals
-    WorkspaceObject workspaceObject(savedObject.objectImplPtr);
-
-    // emit signals
-    registerAdditionOfObject(workspaceObject);
+    // NameMaps
+    insertIntoNameMaps(savedObject.objectImplPtr);
   }
 
-  void Workspace_Impl::restoreObjects(SavedWorkspaceObjectVector& savedObjects) {
-    for (SavedWorkspaceObject& object : savedObjects) {
-      restoreObject(object);
+  void Workspace_Impl::relinkObject(SavedWorkspaceObject& savedObject) {
+    for (const HHPointer& ptr : savedObject.pointers) {
+      const WorkspaceObject_ImplPtr* source = findObject(ptr.source);
+      if (!source || !isMember(ptr.target)) { continue; }
+      OptionalWorkspaceObject currentTarget = (*source)->getTarget(ptr.fieldIndex);
+      if (currentTarget && (currentTarget->handle() == ptr.target)) { continue; }
+      (*source)->setPointer(ptr.fieldIndex,ptr.target,false);
     }
+    savedObject.objectImplPtr->restorePointers();
   }
 
   // QUERIES
 
   std::string Workspace_Impl::constructNextName(const std::string& objectName,
-                                                const std::vector<WorkspaceObject>& objectsInTheSeries,
+                                                const NameSeries* series,
                                                 bool fillIn) const
   {
-    vector<int> takenValues;
-    std::tuple<boost::optional<int>, std::string> takenSuffix;
-    for (const WorkspaceObject& object : objectsInTheSeries) {
-      takenSuffix = getNameSuffix(*(object.name()));
-      if (std::get<0>(takenSuffix)) {
-        takenValues.push_back(*std::get<0>(takenSuffix));
-      }
-    }
-    std::sort(takenValues.begin(), takenValues.end());
-    takenValues.erase(std::unique(takenValues.begin(), takenValues.end()), takenValues.end());
-
     int suffix(1);
-    if (fillIn) {
-      for (int usedSuffix : takenValues) {
-        if (usedSuffix == suffix) {
-          ++suffix;
-        }
-        else {
-          break;
-        }
-      }
-    }
-    else {
-      if (!takenValues.empty()) {
-        suffix = *(takenValues.rbegin()) + 1;
-      }
-    }
-    std::string spacer = std::get<1>(takenSuffix);
-    if (spacer == "") {
-      spacer = " ";
+    std::string spacer(" ");
+    if (series) {
+      suffix = series->nextSuffix(fillIn);
+      spacer = series->spacer();
     }
     return getBaseName(objectName) + spacer + boost::lexical_cast<std::string>(suffix);
   }
@@ -2494,6 +3328,10 @@ namespace detail {
   }
 
   void Workspace_Impl::change() {
+    // endBatchEdit emits onChange once for the whole batch
+    if (m_batchEditDepth > 0) {
+      return;
+    }
     this->onChange.nano_emit();
   }
 
@@ -2588,9 +3426,7 @@ Workspace::Workspace(const IdfFile& idfFile, StrictnessLevel level) :
     objectImplPtrs.push_back(m_impl->createObject(idfObject,true));
   }
   // add Object_ImplPtrs to Workspace_Impl
-  m_impl->addObjects(objectImplPtrs,false);
-  Workspace copyOfThis(m_impl);
-  m_impl->resolvePotentialNameConflicts(copyOfThis);
+  m_impl->bulkAddObjects(objectImplPtrs);
 }
 
 Workspace::Workspace(const Workspace& other)
@@ -2687,6 +3523,13 @@ std::vector<WorkspaceObject> Workspace::getObjectsByType(IddObjectType objectTyp
   return m_impl->getObjectsByType(objectType);
 }
 
+void Workspace::forEachObjectOfType(
+    IddObjectType objectType,
+    const std::function<void (const std::shared_ptr<detail::WorkspaceObject_Impl>&)>& visitor) const
+{
+  m_impl->forEachObjectOfType(objectType,visitor);
+}
+
 std::vector<WorkspaceObject> Workspace::getObjectsByType(const IddObject& objectType) const {
   return m_impl->getObjectsByType(objectType);
 }
@@ -2726,6 +3569,26 @@ bool Workspace::fastNaming() const
   return m_impl->fastNaming();
 }
 
+IdfObjectDiffMode Workspace::idfObjectDiffMode() const
+{
+  return m_impl->idfObjectDiffMode();
+}
+
+unsigned Workspace::numIdfObjectDiffs() const
+{
+  return m_impl->numIdfObjectDiffs();
+}
+
+bool Workspace::isBatchEditing() const
+{
+  return m_impl->isBatchEditing();
+}
+
+std::size_t Workspace::idfObjectDiffMemoryUsage() const
+{
+  return m_impl->idfObjectDiffMemoryUsage();
+}
+
 // SETTERS
 
 bool Workspace::setStrictnessLevel(StrictnessLevel level) {
@@ -2793,6 +3656,21 @@ void Workspace::setFastNaming(bool fastNaming)
   m_impl->setFastNaming(fastNaming);
 }
 
+void Workspace::setIdfObjectDiffMode(const IdfObjectDiffMode& mode)
+{
+  m_impl->setIdfObjectDiffMode(mode);
+}
+
+void Workspace::beginBatchEdit()
+{
+  m_impl->beginBatchEdit();
+}
+
+void Workspace::endBatchEdit()
+{
+  m_impl->endBatchEdit();
+}
+
 // ORDER
 
 WorkspaceObjectOrder Workspace::order() {
@@ -2900,6 +3778,23 @@ bool Workspace::save(const openstudio::path& p, bool overwrite) {
   return m_impl->save(p,overwrite);
 }
 
+bool Workspace::saveBinary(const openstudio::path& p, bool overwrite) {
+  return m_impl->saveBinary(p,overwrite);
+}
+
+boost::optional<Workspace> Workspace::loadBinary(const openstudio::path& p) {
+  WorkspaceSnapshotReader snapshot(p);
+  if (!snapshot.isValid() || (snapshot.iddFileType() == IddFileType::UserCustom)) {
+    return boost::none;
+  }
+  Workspace result(std::shared_ptr<detail::Workspace_Impl>(
+      new detail::Workspace_Impl(snapshot.strictnessLevel(),snapshot.iddFileType())));
+  if (!result.m_impl->addSnapshotObjects(snapshot)) {
+    return boost::none;
+  }
+  return result;
+}
+
 boost::optional<Workspace> Workspace::load(const openstudio::path& p) {
   OptionalIdfFile oIdfFile = IdfFile::load(p);
   if (oIdfFile) {
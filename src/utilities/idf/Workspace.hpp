@@ -33,6 +33,7 @@
 #include "../UtilitiesAPI.hpp"
 #include "ValidityEnums.hpp"
 #include "Handle.hpp"
+#include "IdfObjectDiff.hpp"
 
 #include "../core/Logger.hpp"
 #include "../core/Path.hpp"
@@ -41,6 +42,8 @@
 #include <ostream>
 #include <vector>
 #include <set>
+#include <functional>
+#include <memory>
 
 namespace openstudio {
 
@@ -206,6 +209,12 @@ class UTILITIES_API Workspace {
   /** Returns all objects with .iddObject() == objectType. */
   std::vector<WorkspaceObject> getObjectsByType(const IddObject& objectType) const;
 
+  /** Calls visitor on each object of type objectType, in no particular order. Unlike
+   *  getObjectsByType, no vector is built and no public objects are constructed, so this is the
+   *  preferred way to aggregate over large object sets. visitor must not add or remove objects. */
+  void forEachObjectOfType(IddObjectType objectType,
+                           const std::function<void (const std::shared_ptr<detail::WorkspaceObject_Impl>&)>& visitor) const;
+
   /** Returns the first object found of type objectType and named name (case insensitive,
    *  exact match). */
   boost::optional<WorkspaceObject> getObjectByTypeAndName(IddObjectType objectType,
@@ -241,6 +250,20 @@ class UTILITIES_API Workspace {
    *  objects and does not do any name conflict checking. */
   bool fastNaming() const;
 
+  /** Returns how the objects in this Workspace keep IdfObjectDiffs until their change signals are
+   *  emitted. The default is IdfObjectDiffMode::Full. */
+  IdfObjectDiffMode idfObjectDiffMode() const;
+
+  /** Returns the number of IdfObjectDiffs currently held by the objects in this Workspace. */
+  unsigned numIdfObjectDiffs() const;
+
+  /** Returns the approximate number of bytes used by the IdfObjectDiffs currently held by the
+   *  objects in this Workspace. */
+  std::size_t idfObjectDiffMemoryUsage() const;
+
+  /** Returns true between beginBatchEdit and the matching endBatchEdit. */
+  bool isBatchEditing() const;
+
   //@}
   /** @name Setters */
   //@{
@@ -350,6 +373,22 @@ class UTILITIES_API Workspace {
    *  handle. */
   void setFastNaming(bool fastNaming);
 
+  /** Sets how objects keep IdfObjectDiffs from now on. Batch processes that never look at the
+   *  diffs can use IdfObjectDiffMode::Off to bound the memory they use. */
+  void setIdfObjectDiffMode(const IdfObjectDiffMode& mode);
+
+  /** Starts a batch edit. Until the matching endBatchEdit, objects emit only their onChange
+   *  signal as they are changed, and the Workspace holds back its onChange and addWorkspaceObject
+   *  signals. Object removal is still signaled immediately. Batch edits nest. In C++, prefer the
+   *  scoped WorkspaceBatchEdit. */
+  void beginBatchEdit();
+
+  /** Ends a batch edit. Ending the outermost one emits the held back object signals once per
+   *  object, then the Workspace's onChange and onBatchChange once, the latter with the handles of
+   *  all objects changed, added or removed during the batch edit. If a connected slot throws, the
+   *  batch edit is still ended and the exception propagates. */
+  void endBatchEdit();
+
   //@}
   /** @name Object Order */
   //@{
@@ -438,6 +477,17 @@ class UTILITIES_API Workspace {
   static boost::optional<Workspace> load(const openstudio::path& p,
                                          const IddFile& iddFile);
 
+  /** Save a binary snapshot of this Workspace to path p, for fast reloading with loadBinary.
+   *  Snapshots are not a replacement for text files: they are only readable by builds using the
+   *  same IDD, down to its text, and cannot be written for Workspaces with custom IDDs. Will only overwrite
+   *  an existing file if overwrite==true. Returns true if the save operation is successful. */
+  bool saveBinary(const openstudio::path& p, bool overwrite=false);
+
+  /** Load a Workspace from a binary snapshot written by saveBinary. Returns an uninitialized
+   *  object if p is not a snapshot or was written against a different IDD, in which case the text
+   *  file should be loaded instead. */
+  static boost::optional<Workspace> loadBinary(const openstudio::path& p);
+
   /** Returns an IdfFile equivalent to this Workspace. If the objects have handle fields (as in the
    *  OpenStudio IDD), pointers between objects are serialized as handles, otherwise they are
    *  serialized as names. */
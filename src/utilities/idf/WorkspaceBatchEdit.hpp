@@ -0,0 +1,81 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2020, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef UTILITIES_IDF_WORKSPACEBATCHEDIT_HPP
+#define UTILITIES_IDF_WORKSPACEBATCHEDIT_HPP
+
+#include <utilities/UtilitiesAPI.hpp>
+#include <utilities/idf/Workspace.hpp>
+
+namespace openstudio{
+
+/** WorkspaceBatchEdit holds a batch edit open on a Workspace for as long as it is alive. Objects
+ *  changed during the batch edit emit their remaining change signals, and the Workspace emits
+ *  onChange and onBatchChange, once, when the outermost WorkspaceBatchEdit is destroyed. See
+ *  Workspace::beginBatchEdit.
+ *
+ *  \code
+ *  {
+ *    WorkspaceBatchEdit batchEdit(workspace);
+ *    for (WorkspaceObject& object : objects) {
+ *      object.setString(index,value);
+ *    }
+ *  } // signals are emitted here
+ *  \endcode
+ *
+ *  Slots connected to those signals may throw. A destructor cannot let that exception out, so it
+ *  logs it instead; call commit to end the batch edit with exceptions passed on to the caller.
+ *
+ *  Like WorkspaceWatcher, WorkspaceBatchEdit is designed to be stack allocated. */
+class UTILITIES_API WorkspaceBatchEdit {
+ public:
+
+  explicit WorkspaceBatchEdit(const Workspace& workspace);
+
+  ~WorkspaceBatchEdit();
+
+  WorkspaceBatchEdit(const WorkspaceBatchEdit& other) = delete;
+  WorkspaceBatchEdit& operator=(const WorkspaceBatchEdit& other) = delete;
+
+  /** Ends the batch edit now, emitting its signals if it is the outermost one. Exceptions thrown
+   *  by connected slots propagate, and the batch edit is ended either way. Does nothing if called
+   *  again. */
+  void commit();
+
+ private:
+
+  Workspace m_workspace;
+  bool m_committed;
+
+  REGISTER_LOGGER("utilities.idf.WorkspaceBatchEdit");
+};
+
+}
+
+#endif
@@ -36,6 +36,7 @@
 #include "WorkspaceExtensibleGroup.hpp"
 #include "ValidityReport.hpp"
 
+#include "../idd/IddObjectValidation.hpp"
 #include <utilities/idd/IddEnums.hxx>
 
 
@@ -123,9 +124,9 @@ namespace detail {
         }
       }
       if (targetHandle.isNull()) {
-        StringSet intermediate = iddObject().objectLists(index);
-        StringVector referenceLists(intermediate.begin(),intermediate.end());
-        OptionalWorkspaceObject target = m_workspace->getObjectByNameAndReference(targetName,referenceLists);
+        const IddFieldValidation* field = iddObject().validation()->field(index);
+        OS_ASSERT(field);
+        OptionalWorkspaceObject target = m_workspace->getObjectByNameAndReference(targetName,field->objectListIds);
         if (target) {
           targetHandle = target->handle();
         }
@@ -152,7 +153,7 @@ namespace detail {
           OptionalWorkspaceObject target = workspace().getObject(fp.targetHandle);
           if (target) {
             // need to set reverse pointer
-            target->getImpl<WorkspaceObject_Impl>()->setReversePointer(handle(),fp.fieldIndex);
+            target->getImpl<WorkspaceObject_Impl>()->setReversePointer(iddObject().type(),handle(),fp.fieldIndex);
             th = fp.targetHandle;
           }
         }
@@ -168,7 +169,7 @@ namespace detail {
       for (const ReversePointer& rp : m_targetData->reversePointers) {
         Handle sh = openstudio::applyHandleMap(rp.sourceHandle,oldNewHandleMap);
         if (!sh.isNull()) {
-          mappedPointers.insert(ReversePointer(sh,rp.fieldIndex));
+          mappedPointers.insert(ReversePointer(rp.sourceType,sh,rp.fieldIndex));
         }
       }
       m_targetData->reversePointers = mappedPointers;
@@ -219,6 +220,42 @@ namespace detail {
     return IdfObject_Impl::getString(index,returnDefault,returnUninitializedEmpty);
   }
 
+  boost::optional<std::string_view> WorkspaceObject_Impl::getStringView(unsigned index,
+                                                                        bool returnDefault,
+                                                                        bool returnUninitializedEmpty) const
+  {
+    if (canBeSource(index) && (index < numFields())) {
+      if (!initialized()) { return boost::none; }
+
+      // pointer field, return view of pointed-to object's name
+      OptionalWorkspaceObject oTarget = getTarget(index);
+      if (!oTarget) {
+        // implicitly or explicitly a null pointer
+        if (returnDefault) {
+          // get default from idd and return if exists
+          OptionalIddField iddField = iddObject().getField(index);
+          OS_ASSERT(iddField);
+          if (iddField->properties().stringDefault) {
+            return std::string_view(*(iddField->properties().stringDefault));
+          }
+        }
+        if (returnUninitializedEmpty){
+          return boost::none;
+        }
+        return std::string_view();
+      }
+      else {
+        if (OptionalUnsigned nameIndex = oTarget->iddObject().nameFieldIndex()) {
+          return oTarget->getStringView(*nameIndex);
+        }
+        return boost::none;
+      }
+    }
+
+    // regular field, let IdfObject_Impl take care of it
+    return IdfObject_Impl::getStringView(index,returnDefault,returnUninitializedEmpty);
+  }
+
   boost::optional<std::string> WorkspaceObject_Impl::getField(unsigned index) const {
     boost::optional<std::string> result;
 
@@ -313,18 +350,40 @@ namespace detail {
     WorkspaceObjectVector result;
     if (!initialized()) { return result; }
     if (m_targetData) {
-      for (const ReversePointer& ptr : m_targetData->reversePointers) {
-        OS_ASSERT(!ptr.sourceHandle.isNull());
-        OptionalWorkspaceObject owo = this->workspace().getObject(ptr.sourceHandle);
-        OS_ASSERT(owo);
-        if (owo->iddObject().type() == type) { result.push_back(*owo); }
+      // pointers from objects of type are a contiguous slice, with repeated handles adjacent
+      auto range = m_targetData->reversePointers.equal_range(type.value());
+      const Handle* lastHandle = nullptr;
+      for (auto it = range.first; it != range.second; ++it) {
+        OS_ASSERT(!it->sourceHandle.isNull());
+        if (lastHandle && (*lastHandle == it->sourceHandle)) { continue; }
+        lastHandle = &(it->sourceHandle);
+        const std::shared_ptr<WorkspaceObject_Impl>* source = m_workspace->findObject(it->sourceHandle);
+        OS_ASSERT(source);
+        result.push_back(WorkspaceObject(*source));
       }
       std::sort(result.begin(), result.end());
-      result.erase(std::unique(result.begin(), result.end()), result.end());
     }
     return result;
   }
 
+  void WorkspaceObject_Impl::forEachSource(
+      IddObjectType type,
+      const std::function<void (const std::shared_ptr<WorkspaceObject_Impl>&)>& visitor) const
+  {
+    if (!initialized()) { return; }
+    if (!m_targetData) { return; }
+    auto range = m_targetData->reversePointers.equal_range(type.value());
+    const Handle* lastHandle = nullptr;
+    for (auto it = range.first; it != range.second; ++it) {
+      OS_ASSERT(!it->sourceHandle.isNull());
+      if (lastHandle && (*lastHandle == it->sourceHandle)) { continue; }
+      lastHandle = &(it->sourceHandle);
+      const std::shared_ptr<WorkspaceObject_Impl>* source = m_workspace->findObject(it->sourceHandle);
+      OS_ASSERT(source);
+      visitor(*source);
+    }
+  }
+
   ReversePointerSet WorkspaceObject_Impl::getReversePointers() const {
     ReversePointerSet result;
     if (m_handle.isNull()) { return result; }
@@ -435,7 +494,7 @@ namespace detail {
     } // name
 
     // record diffs at start
-    unsigned diffSize = m_diffs.size();
+    DiffTransaction diffTransaction(*this);
 
     // field already exists
     if (index < numFields()) {
@@ -451,7 +510,7 @@ namespace detail {
           IdfObject_Impl::setString(index,*oldValue,false);
 
           // remove the diffs
-          m_diffs.resize(diffSize);
+          diffTransaction.rollback();
 
           return false;
         }
@@ -480,7 +539,7 @@ namespace detail {
         restoreOriginalNumFields(n);
 
         // remove the diffs
-        m_diffs.resize(diffSize);
+        diffTransaction.rollback();
 
         return false;
       }
@@ -527,7 +586,7 @@ namespace detail {
       }
 
       // record diffs at start
-      unsigned diffSize = m_diffs.size();
+      DiffTransaction diffTransaction(*this);
       bool checkValid = false; // check validity at object level?
       if (checkValidity && (level > StrictnessLevel::None) &&
           (m_workspace->iddFileType() == IddFileType::OpenStudio))
@@ -559,7 +618,7 @@ namespace detail {
         newValue = m_workspace->name(targetHandle);
       }
 
-      m_diffs.push_back(WorkspaceObjectDiff(index, oldValue, newValue, oldHandle, targetHandle));
+      recordDiff(WorkspaceObjectDiff(index, oldValue, newValue, oldHandle, targetHandle));
 
       if (checkValid && !isValid(level,false)) {
         if (n) {
@@ -570,7 +629,7 @@ namespace detail {
         }
 
         // remove the diffs
-        m_diffs.resize(diffSize);
+        diffTransaction.rollback();
 
         return false;
       }
@@ -617,7 +676,7 @@ namespace detail {
       return false;
     }
 
-    unsigned diffSize = m_diffs.size();
+    DiffTransaction diffTransaction(*this);
 
     // regular field
     bool result = IdfObject_Impl::pushString(value,checkValidity); // nominally add
@@ -630,7 +689,7 @@ namespace detail {
       restoreOriginalNumFields(index);
 
       // remove diffs
-      m_diffs.resize(diffSize);
+      diffTransaction.rollback();
     }
 
     return result;
@@ -938,6 +997,13 @@ namespace detail {
       return;
     }
 
+    // during a batch edit only onChange goes out now, so that slots clearing cached values still
+    // run; the rest waits for Workspace_Impl::endBatchEdit, which calls back in here
+    if (m_workspace && m_workspace->deferChangeSignals(m_handle)) {
+      this->onChange.nano_emit();
+      return;
+    }
+
     bool nameChange = false;
     bool dataChange = false;
 
@@ -1010,7 +1076,7 @@ namespace detail {
     OptionalWorkspaceObject oTarget = getTarget(index);
     if (oTarget) {
       WorkspaceObject target = *oTarget;
-      target.getImpl<WorkspaceObject_Impl>()->nullifyReversePointer(m_handle,index);
+      target.getImpl<WorkspaceObject_Impl>()->nullifyReversePointer(iddObject().type(),m_handle,index);
       // remove forwarded reference if no other source sets the same
       m_workspace->removeForwardedReferences(handle(),index,target);
     }
@@ -1027,23 +1093,29 @@ namespace detail {
   // Pre-condition:  Object sourceHandle points to this object from field index.
   // Post-condition: That information is removed from this object's m_targetData (in preparation for
   //                 a change to the source pointer).
-  void WorkspaceObject_Impl::nullifyReversePointer(const Handle& sourceHandle,unsigned index) {
+  void WorkspaceObject_Impl::nullifyReversePointer(IddObjectType sourceType,
+                                                   const Handle& sourceHandle,
+                                                   unsigned index)
+  {
     OS_ASSERT(!m_handle.isNull());
     OS_ASSERT(m_targetData);
-    auto it = m_targetData->reversePointers.find(ReversePointer(sourceHandle,index));
+    auto it = m_targetData->reversePointers.find(ReversePointer(sourceType.value(),sourceHandle,index));
     OS_ASSERT(it != m_targetData->reversePointers.end());
     m_targetData->reversePointers.erase(it);
   }
 
-  // Pre-condition:  ReversePointer(sourceHandle,index) is not in m_targetData.
-  // Post-condition: m_targetData indicates that object sourceHandle points to this object from
-  //                 field index.
-  void WorkspaceObject_Impl::setReversePointer(const Handle& sourceHandle, unsigned index) {
+  // Pre-condition:  ReversePointer(sourceType,sourceHandle,index) is not in m_targetData.
+  // Post-condition: m_targetData indicates that object sourceHandle, of type sourceType, points to
+  //                 this object from field index.
+  void WorkspaceObject_Impl::setReversePointer(IddObjectType sourceType,
+                                               const Handle& sourceHandle,
+                                               unsigned index)
+  {
     OS_ASSERT(!m_handle.isNull());
     if (!m_targetData) { m_targetData = TargetData(); }
     // automatically maintains uniqueness
     std::pair<TargetData::pointer_set::iterator,bool> insertResult;
-    insertResult = m_targetData->reversePointers.insert(ReversePointer(sourceHandle,index));
+    insertResult = m_targetData->reversePointers.insert(ReversePointer(sourceType.value(),sourceHandle,index));
     OS_ASSERT(insertResult.second);
   }
 
@@ -1057,7 +1129,7 @@ namespace detail {
             WorkspaceObjectVector sources = target->getSources(iddObject().type());
             HandleVector h = getHandles<WorkspaceObject>(sources);
             if (std::find(h.begin(),h.end(),m_handle) == h.end()) {
-              target->getImpl<WorkspaceObject_Impl>()->setReversePointer(m_handle,ptr.fieldIndex);
+              target->getImpl<WorkspaceObject_Impl>()->setReversePointer(iddObject().type(),m_handle,ptr.fieldIndex);
             }
           }
         }
@@ -1112,7 +1184,7 @@ namespace detail {
     if (!targetHandle.isNull()) {
       OptionalWorkspaceObject target = m_workspace->getObject(targetHandle);
       OS_ASSERT(target);
-      target->getImpl<WorkspaceObject_Impl>()->setReversePointer(m_handle,index);
+      target->getImpl<WorkspaceObject_Impl>()->setReversePointer(iddObject().type(),m_handle,index);
       // forward references if is object-list and defines references simultaneously
       m_workspace->forwardReferences(m_handle,index,targetHandle);
     }
@@ -1174,8 +1246,9 @@ namespace detail {
     // last field must be nonextensible, and final size must satisfy minimum number of fields
     if ((index >= minFields()) && (numExtensibleGroups() == 0)) {
       // delete field
-      m_diffs.push_back(IdfObjectDiff(index, m_fields[index], boost::none));
+      recordDiff(IdfObjectDiff(index, m_fields[index], boost::none));
       m_fields.pop_back();
+      trimParsedFields();
       if (m_fieldComments.size() > m_fields.size()) {
         m_fieldComments.resize(m_fields.size());
       }
@@ -1243,21 +1316,20 @@ namespace detail {
   }
 
   bool WorkspaceObject_Impl::fieldDataIsCorrectType(unsigned index) const {
-    OptionalIddField oIddField = iddObject().getField(index);
-    if (!oIddField) { return true; }
+    std::shared_ptr<const IddObjectValidation> validation = iddObject().validation();
+    const IddFieldValidation* field = validation->field(index);
+    if (!field) { return true; }
 
-    IddField iddField = *oIddField;
-    IddFieldType fieldType = iddField.properties().type;
     OS_ASSERT(m_fields.size() > index);
 
     bool result = true;
-    if ((fieldType == IddFieldType::ObjectListType) && m_sourceData) {
+    if ((field->type == IddFieldType::ObjectListType) && m_sourceData) {
       // automatically excludes unsupported reference lists by going through m_sourceData
       auto it = getConstIteratorAtFieldIndex<SourceData>(m_sourceData.get().pointers,index);
       if (it != m_sourceData.get().pointers.end()) {
-        ForwardPointer ptr = *it;
+        const ForwardPointer& ptr = *it;
         if (!ptr.targetHandle.isNull()) {
-          result = m_workspace->canBeTarget(ptr.targetHandle,iddObject().objectLists(index));
+          result = m_workspace->canBeTarget(ptr.targetHandle,*field);
         }
       }
     }
@@ -1271,14 +1343,14 @@ namespace detail {
   bool WorkspaceObject_Impl::fieldIsNonnullIfRequired(unsigned index) const {
     bool result = true;
 
-    OptionalIddField oIddField = iddObject().getField(index);
-    if (!oIddField) { return result; }
+    std::shared_ptr<const IddObjectValidation> validation = iddObject().validation();
+    const IddFieldValidation* field = validation->field(index);
+    if (!field) { return result; }
 
-    IddField field = *oIddField;
     if (m_sourceData) {
       auto it = getConstIteratorAtFieldIndex<SourceData>(m_sourceData.get().pointers,index);
       if (it != m_sourceData.get().pointers.end()) {
-        if (it->targetHandle.isNull() && field.properties().required) {
+        if (it->targetHandle.isNull() && field->required) {
           result = false;
         }
         return result;
@@ -1289,6 +1361,19 @@ namespace detail {
     return result;
   }
 
+  IdfObjectDiffMode WorkspaceObject_Impl::diffMode() const {
+    if (m_workspace) {
+      return m_workspace->idfObjectDiffMode();
+    }
+    return IdfObject_Impl::diffMode();
+  }
+
+  void WorkspaceObject_Impl::nameFieldChanged(const boost::optional<std::string>& oldName) {
+    if (m_workspace && !m_handle.isNull()) {
+      m_workspace->updateNameMaps(m_handle, oldName);
+    }
+  }
+
 } // detail
 
 bool WorkspaceObject::operator < (const WorkspaceObject& right) const
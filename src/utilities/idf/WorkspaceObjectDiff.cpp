@@ -52,6 +52,28 @@ namespace openstudio {
       return m_newHandle;
     }
 
+    std::shared_ptr<IdfObjectDiff_Impl> WorkspaceObjectDiff_Impl::merge(const IdfObjectDiff_Impl& later) const
+    {
+      const auto* laterImpl = dynamic_cast<const WorkspaceObjectDiff_Impl*>(&later);
+      if (!laterImpl) {
+        return nullptr;
+      }
+      return std::make_shared<WorkspaceObjectDiff_Impl>(index().get(), oldValue(), laterImpl->newValue(),
+                                                        m_oldHandle, laterImpl->newHandle());
+    }
+
+    std::shared_ptr<IdfObjectDiff_Impl> WorkspaceObjectDiff_Impl::withoutValues() const
+    {
+      // handles are kept so that relationship changes can still be reported
+      return std::make_shared<WorkspaceObjectDiff_Impl>(index().get(), boost::none, std::string(),
+                                                        m_oldHandle, m_newHandle);
+    }
+
+    std::size_t WorkspaceObjectDiff_Impl::memoryUsage() const
+    {
+      return IdfObjectDiff_Impl::memoryUsage() - sizeof(IdfObjectDiff_Impl) + sizeof(WorkspaceObjectDiff_Impl);
+    }
+
   }
 
   WorkspaceObjectDiff::WorkspaceObjectDiff(unsigned index, boost::optional<std::string> oldValue, boost::optional<std::string> newValue,
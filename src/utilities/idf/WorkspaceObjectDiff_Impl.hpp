@@ -51,6 +51,12 @@ namespace detail {
     /// get the new handle if there is one
     boost::optional<UUID> newHandle() const;
 
+    virtual std::shared_ptr<IdfObjectDiff_Impl> merge(const IdfObjectDiff_Impl& later) const override;
+
+    virtual std::shared_ptr<IdfObjectDiff_Impl> withoutValues() const override;
+
+    virtual std::size_t memoryUsage() const override;
+
   private:
 
     boost::optional<UUID> m_oldHandle;
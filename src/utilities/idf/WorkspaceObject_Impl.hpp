@@ -36,6 +36,8 @@
 #include <utilities/idf/IdfObject_Impl.hpp>
 #include <utilities/idf/ObjectPointer.hpp>
 
+#include <functional>
+
 namespace openstudio {
 
 // forward declarations
@@ -67,15 +69,33 @@ namespace detail {
   };
   typedef boost::optional<SourceData> OptionalSourceData;
 
+  /** Records that field fieldIndex of the object sourceHandle points to this object. sourceType is
+   *  the IddObjectType::value() of the source, so that reverse pointers can be bucketed by source
+   *  type. */
   struct UTILITIES_API ReversePointer {
+    int      sourceType;
     Handle   sourceHandle;
     unsigned fieldIndex;
 
-    ReversePointer() : fieldIndex(0) {}
-    ReversePointer(const Handle& h, unsigned i) : sourceHandle(h), fieldIndex(i) {}
+    ReversePointer() : sourceType(0), fieldIndex(0) {}
+    ReversePointer(int t, const Handle& h, unsigned i) : sourceType(t), sourceHandle(h), fieldIndex(i) {}
   };
+  /** Orders by source type, then source handle, then field index. All pointers from objects of a
+   *  given type are therefore contiguous, and repeats of a source handle are adjacent. Comparison
+   *  against a bare source type selects that slice with equal_range. */
   struct UTILITIES_API ReversePointerLess {
+    typedef void is_transparent;
+
+    bool operator()(const ReversePointer& left, int rightType) const {
+      return (left.sourceType < rightType);
+    }
+    bool operator()(int leftType, const ReversePointer& right) const {
+      return (leftType < right.sourceType);
+    }
     bool operator()(const ReversePointer& left, const ReversePointer& right) const {
+      if (left.sourceType != right.sourceType) {
+        return (left.sourceType < right.sourceType);
+      }
       if (left.sourceHandle == right.sourceHandle) {
         return (left.fieldIndex < right.fieldIndex);
       }
@@ -155,6 +175,10 @@ namespace detail {
      *  (non-extensible) fields and fields with empty data, if a default exists. */
     virtual boost::optional<std::string> getString(unsigned index, bool returnDefault=false,bool returnUninitializedEmpty=false) const override;
 
+    /** Like getString, but returns a view, see IdfObject_Impl::getStringView. For pointer fields
+     *  the view is of the target's name field. */
+    virtual boost::optional<std::string_view> getStringView(unsigned index, bool returnDefault=false,bool returnUninitializedEmpty=false) const override;
+
     boost::optional<std::string> getField(unsigned index) const;
 
     /** Returns the object pointed to by the field at index, if it exists. */
@@ -172,6 +196,11 @@ namespace detail {
     /** Returns the objects of type that point to this object. */
     std::vector<WorkspaceObject> getSources(IddObjectType type) const;
 
+    /** Calls visitor once on each object of type that points to this object, in handle order,
+     *  without constructing public objects. visitor must not add or remove objects. */
+    void forEachSource(IddObjectType type,
+                       const std::function<void (const std::shared_ptr<WorkspaceObject_Impl>&)>& visitor) const;
+
     /** Provided for Workspace_Impl to get easy access to targetData. */
     ReversePointerSet getReversePointers() const;
 
@@ -315,10 +344,10 @@ namespace detail {
     /** Mechanics only exposed to Workspace_Impl for use in object removal. */
     void nullifyPointer(unsigned index);
 
-    void nullifyReversePointer(const Handle& sourceHandle, unsigned index);
+    void nullifyReversePointer(IddObjectType sourceType, const Handle& sourceHandle, unsigned index);
 
 
-    void setReversePointer(const Handle& sourceHandle, unsigned index);
+    void setReversePointer(IddObjectType sourceType, const Handle& sourceHandle, unsigned index);
 
     /** Called when restoring object because could not remove and retain validity. Double-checks
      *  that companion pointers are in place. May not be able to fix all if multiple objects are
@@ -340,6 +369,14 @@ namespace detail {
 
     virtual bool fieldIsNonnullIfRequired(unsigned index) const override;
 
+    // SETTER HELPERS
+
+    /** Keeps the Workspace name maps current. */
+    virtual void nameFieldChanged(const boost::optional<std::string>& oldName) override;
+
+    /** Returns the Workspace's IdfObjectDiffMode. */
+    virtual IdfObjectDiffMode diffMode() const override;
+
    private:
 
     bool                m_initialized;
@@ -0,0 +1,479 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2020, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include "WorkspaceSnapshot.hpp"
+#include "FlatHandleMap.hpp"
+
+#include "../core/Assert.hpp"
+#include "../core/Filesystem.hpp"
+#include "../core/FilesystemHelpers.hpp"
+
+#include <algorithm>
+
+namespace openstudio {
+
+namespace {
+
+  const char snapshotMagic[8] = {'O', 'S', 'S', 'N', 'A', 'P', '\0', '\0'};
+  const std::uint32_t snapshotFormatVersion = 1;
+  const std::size_t headerSize = 64;
+  const std::size_t sectionEntrySize = 16;
+  const std::size_t objectRecordSize = 28; // handle, comment, numFields, numFieldComments
+  const std::uint32_t pointerFlag = 0x80000000u;
+
+  void putUInt32(std::string& out, std::uint32_t value) {
+    for (unsigned i = 0; i < 4; ++i) {
+      out.push_back(static_cast<char>((value >> (8 * i)) & 0xffu));
+    }
+  }
+
+  void putUInt64(std::string& out, std::uint64_t value) {
+    for (unsigned i = 0; i < 8; ++i) {
+      out.push_back(static_cast<char>((value >> (8 * i)) & 0xffu));
+    }
+  }
+
+  void setUInt64(std::string& out, std::size_t pos, std::uint64_t value) {
+    for (unsigned i = 0; i < 8; ++i) {
+      out[pos + i] = static_cast<char>((value >> (8 * i)) & 0xffu);
+    }
+  }
+
+  void padTo8(std::string& out) {
+    while (out.size() % 8 != 0) {
+      out.push_back('\0');
+    }
+  }
+
+  std::uint32_t getUInt32(const unsigned char* p) {
+    return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+           (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+  }
+
+  std::uint64_t getUInt64(const unsigned char* p) {
+    return static_cast<std::uint64_t>(getUInt32(p)) | (static_cast<std::uint64_t>(getUInt32(p + 4)) << 32);
+  }
+
+}
+
+WorkspaceSnapshotWriter::WorkspaceSnapshotWriter(IddFileType iddFileType,
+                                                 StrictnessLevel strictnessLevel,
+                                                 const std::string& iddVersion,
+                                                 const std::string& header)
+  : m_iddFileType(iddFileType),
+    m_strictnessLevel(strictnessLevel)
+{
+  m_iddVersion = stringId(iddVersion);
+  m_header = stringId(header);
+}
+
+void WorkspaceSnapshotWriter::addObject(const std::string& typeName,
+                                        const Handle& handle,
+                                        std::string_view comment,
+                                        const std::vector<std::string_view>& fields,
+                                        const std::vector<std::string>& fieldComments,
+                                        const std::vector<std::pair<unsigned, Handle> >& pointers)
+{
+  Object object;
+  object.type = stringId(typeName);
+  object.handle = handle;
+  object.comment = stringId(comment);
+  object.fields.reserve(fields.size());
+  for (const std::string_view& field : fields) {
+    object.fields.push_back(stringId(field));
+  }
+  object.fieldComments.reserve(fieldComments.size());
+  for (const std::string& fieldComment : fieldComments) {
+    object.fieldComments.push_back(stringId(fieldComment));
+  }
+  object.pointers = pointers;
+  m_objects.push_back(std::move(object));
+}
+
+bool WorkspaceSnapshotWriter::save(const openstudio::path& p) const {
+  // group objects into per-type sections, in order of first appearance, and number them
+  // section by section
+  std::vector<std::vector<unsigned> > sections;
+  std::vector<unsigned> sectionTypes;
+  std::unordered_map<unsigned, unsigned> sectionOfType;
+  for (unsigned i = 0, n = m_objects.size(); i < n; ++i) {
+    auto it = sectionOfType.find(m_objects[i].type);
+    if (it == sectionOfType.end()) {
+      it = sectionOfType.insert(std::make_pair(m_objects[i].type, static_cast<unsigned>(sections.size()))).first;
+      sections.push_back(std::vector<unsigned>());
+      sectionTypes.push_back(m_objects[i].type);
+    }
+    sections[it->second].push_back(i);
+  }
+  std::vector<unsigned> objectNumbers(m_objects.size());
+  detail::FlatHandleMap<unsigned> handleNumbers;
+  handleNumbers.reserve(m_objects.size());
+  unsigned number = 0;
+  for (const std::vector<unsigned>& section : sections) {
+    for (unsigned i : section) {
+      objectNumbers[i] = number;
+      handleNumbers.insert(std::make_pair(m_objects[i].handle, number));
+      ++number;
+    }
+  }
+
+  std::string out;
+
+  // header, offsets are filled in below
+  out.append(snapshotMagic, sizeof(snapshotMagic));
+  putUInt32(out, snapshotFormatVersion);
+  putUInt32(out, static_cast<std::uint32_t>(m_iddFileType.value()));
+  putUInt32(out, static_cast<std::uint32_t>(m_strictnessLevel.value()));
+  putUInt32(out, m_iddVersion);
+  putUInt32(out, m_header);
+  putUInt32(out, static_cast<std::uint32_t>(m_strings.size()));
+  putUInt32(out, static_cast<std::uint32_t>(m_objects.size()));
+  putUInt32(out, static_cast<std::uint32_t>(sections.size()));
+  std::size_t offsetsPos = out.size();
+  putUInt64(out, 0);
+  putUInt64(out, 0);
+  putUInt64(out, 0);
+  OS_ASSERT(out.size() == headerSize);
+
+  // string table
+  setUInt64(out, offsetsPos, out.size());
+  std::uint64_t stringOffset = 0;
+  for (const std::string& value : m_strings) {
+    putUInt64(out, stringOffset);
+    stringOffset += value.size();
+  }
+  putUInt64(out, stringOffset);
+  for (const std::string& value : m_strings) {
+    out.append(value);
+  }
+  padTo8(out);
+
+  // section table, then sections
+  setUInt64(out, offsetsPos + 8, out.size());
+  std::size_t sectionTablePos = out.size();
+  out.append(sections.size() * sectionEntrySize, '\0');
+  for (unsigned s = 0, n = sections.size(); s < n; ++s) {
+    std::string entry;
+    putUInt32(entry, sectionTypes[s]);
+    putUInt32(entry, static_cast<std::uint32_t>(sections[s].size()));
+    putUInt64(entry, out.size());
+    out.replace(sectionTablePos + s * sectionEntrySize, sectionEntrySize, entry);
+
+    std::vector<std::uint32_t> values;
+    for (unsigned i : sections[s]) {
+      const Object& object = m_objects[i];
+      out.append(reinterpret_cast<const char*>(&*object.handle.begin()), 16);
+      putUInt32(out, object.comment);
+      putUInt32(out, static_cast<std::uint32_t>(object.fields.size()));
+      putUInt32(out, static_cast<std::uint32_t>(object.fieldComments.size()));
+      values.assign(object.fields.begin(), object.fields.end());
+      for (const std::pair<unsigned, Handle>& pointer : object.pointers) {
+        if (pointer.first >= values.size()) {
+          continue;
+        }
+        std::uint32_t value = pointerFlag;
+        if (!pointer.second.isNull()) {
+          auto it = handleNumbers.find(pointer.second);
+          if (it == handleNumbers.end()) {
+            LOG(Error, "Unable to write snapshot, object " << toString(object.handle)
+                << " points to " << toString(pointer.second) << ", which is not in the snapshot.");
+            return false;
+          }
+          value |= it->second + 1;
+        }
+        values[pointer.first] = value;
+      }
+      for (std::uint32_t value : values) {
+        putUInt32(out, value);
+      }
+      for (unsigned fieldComment : object.fieldComments) {
+        putUInt32(out, fieldComment);
+      }
+    }
+    padTo8(out);
+  }
+
+  // object order
+  setUInt64(out, offsetsPos + 16, out.size());
+  for (unsigned objectNumber : objectNumbers) {
+    putUInt32(out, objectNumber);
+  }
+
+  openstudio::filesystem::ofstream outFile(p, std::ios_base::binary);
+  if (!outFile) {
+    LOG(Error, "Unable to write snapshot to path '" << toString(p) << "'.");
+    return false;
+  }
+  outFile.write(out.data(), out.size());
+  outFile.close();
+  return !outFile.fail();
+}
+
+unsigned WorkspaceSnapshotWriter::stringId(std::string_view value) {
+  std::string key(value);
+  auto it = m_stringIds.find(key);
+  if (it != m_stringIds.end()) {
+    return it->second;
+  }
+  unsigned result = m_strings.size();
+  m_strings.push_back(key);
+  m_stringIds.insert(std::make_pair(std::move(key), result));
+  return result;
+}
+
+WorkspaceSnapshotReader::WorkspaceSnapshotReader(const openstudio::path& p)
+  : m_file(new openstudio::filesystem::mapped_file_prefix(p)),
+    m_data(nullptr),
+    m_size(0),
+    m_valid(false),
+    m_iddFileType(0),
+    m_strictnessLevel(0),
+    m_iddVersion(0),
+    m_header(0),
+    m_numStrings(0),
+    m_stringOffsets(nullptr),
+    m_stringData(nullptr),
+    m_order(nullptr)
+{
+  if (m_file->is_open()) {
+    m_data = reinterpret_cast<const unsigned char*>(m_file->data().data());
+    m_size = m_file->data().size();
+    m_valid = parse();
+  }
+  if (!m_valid) {
+    LOG(Debug, "'" << toString(p) << "' is not a valid Workspace snapshot.");
+  }
+}
+
+WorkspaceSnapshotReader::~WorkspaceSnapshotReader() {}
+
+bool WorkspaceSnapshotReader::isValid() const {
+  return m_valid;
+}
+
+IddFileType WorkspaceSnapshotReader::iddFileType() const {
+  return IddFileType(static_cast<int>(m_iddFileType));
+}
+
+StrictnessLevel WorkspaceSnapshotReader::strictnessLevel() const {
+  return StrictnessLevel(static_cast<int>(m_strictnessLevel));
+}
+
+std::string_view WorkspaceSnapshotReader::iddVersion() const {
+  return string(m_iddVersion);
+}
+
+std::string_view WorkspaceSnapshotReader::header() const {
+  return string(m_header);
+}
+
+unsigned WorkspaceSnapshotReader::numObjects() const {
+  return m_objects.size();
+}
+
+unsigned WorkspaceSnapshotReader::orderedObject(unsigned i) const {
+  return getUInt32(m_order + 4 * i);
+}
+
+unsigned WorkspaceSnapshotReader::numSections() const {
+  return m_sectionTypes.size();
+}
+
+std::string_view WorkspaceSnapshotReader::sectionTypeName(unsigned section) const {
+  return string(m_sectionTypes[section]);
+}
+
+unsigned WorkspaceSnapshotReader::section(unsigned object) const {
+  return m_objectSections[object];
+}
+
+Handle WorkspaceSnapshotReader::handle(unsigned object) const {
+  Handle result;
+  std::copy(m_objects[object], m_objects[object] + 16, result.begin());
+  return result;
+}
+
+std::string_view WorkspaceSnapshotReader::comment(unsigned object) const {
+  return string(getUInt32(m_objects[object] + 16));
+}
+
+unsigned WorkspaceSnapshotReader::numFields(unsigned object) const {
+  return getUInt32(m_objects[object] + 20);
+}
+
+std::string_view WorkspaceSnapshotReader::field(unsigned object, unsigned index) const {
+  std::uint32_t value = fieldValue(object, index);
+  if (value & pointerFlag) {
+    return std::string_view();
+  }
+  return string(value);
+}
+
+boost::optional<unsigned> WorkspaceSnapshotReader::target(unsigned object, unsigned index) const {
+  std::uint32_t value = fieldValue(object, index);
+  if ((value & pointerFlag) && (value != pointerFlag)) {
+    return (value & ~pointerFlag) - 1;
+  }
+  return boost::none;
+}
+
+unsigned WorkspaceSnapshotReader::numFieldComments(unsigned object) const {
+  return getUInt32(m_objects[object] + 24);
+}
+
+std::string_view WorkspaceSnapshotReader::fieldComment(unsigned object, unsigned index) const {
+  const unsigned char* p = m_objects[object] + objectRecordSize + 4 * (numFields(object) + index);
+  return string(getUInt32(p));
+}
+
+bool WorkspaceSnapshotReader::parse() {
+  // true if length bytes starting at offset are inside the mapping
+  auto fits = [this](std::uint64_t offset, std::uint64_t length) {
+    return (offset <= m_size) && (length <= m_size - offset);
+  };
+
+  if (!fits(0, headerSize) || !std::equal(snapshotMagic, snapshotMagic + sizeof(snapshotMagic), m_data,
+                                          [](char c, unsigned char d) { return static_cast<unsigned char>(c) == d; })) {
+    return false;
+  }
+  if (getUInt32(m_data + 8) != snapshotFormatVersion) {
+    return false;
+  }
+  m_iddFileType = getUInt32(m_data + 12);
+  m_strictnessLevel = getUInt32(m_data + 16);
+  m_iddVersion = getUInt32(m_data + 20);
+  m_header = getUInt32(m_data + 24);
+  m_numStrings = getUInt32(m_data + 28);
+  std::uint32_t numObjects = getUInt32(m_data + 32);
+  std::uint32_t numSections = getUInt32(m_data + 36);
+  std::uint64_t stringsOffset = getUInt64(m_data + 40);
+  std::uint64_t sectionsOffset = getUInt64(m_data + 48);
+  std::uint64_t orderOffset = getUInt64(m_data + 56);
+  try {
+    iddFileType();
+    strictnessLevel();
+  }
+  catch (...) {
+    return false;
+  }
+  if (numObjects >= pointerFlag - 1) {
+    return false;
+  }
+
+  // string table
+  if (!fits(stringsOffset, 8 * (static_cast<std::uint64_t>(m_numStrings) + 1))) {
+    return false;
+  }
+  m_stringOffsets = m_data + stringsOffset;
+  std::uint64_t stringDataOffset = stringsOffset + 8 * (static_cast<std::uint64_t>(m_numStrings) + 1);
+  std::uint64_t previous = 0;
+  for (std::uint32_t i = 0; i <= m_numStrings; ++i) {
+    std::uint64_t offset = getUInt64(m_stringOffsets + 8 * i);
+    if (offset < previous) {
+      return false;
+    }
+    previous = offset;
+  }
+  if (!fits(stringDataOffset, previous)) {
+    return false;
+  }
+  m_stringData = m_data + stringDataOffset;
+  if ((m_iddVersion >= m_numStrings) || (m_header >= m_numStrings)) {
+    return false;
+  }
+
+  // sections and object records
+  if (!fits(sectionsOffset, sectionEntrySize * static_cast<std::uint64_t>(numSections))) {
+    return false;
+  }
+  m_objects.reserve(numObjects);
+  m_objectSections.reserve(numObjects);
+  for (std::uint32_t s = 0; s < numSections; ++s) {
+    const unsigned char* entry = m_data + sectionsOffset + sectionEntrySize * s;
+    std::uint32_t type = getUInt32(entry);
+    std::uint32_t count = getUInt32(entry + 4);
+    std::uint64_t offset = getUInt64(entry + 8);
+    if ((type >= m_numStrings) || (count > numObjects - m_objects.size())) {
+      return false;
+    }
+    m_sectionTypes.push_back(type);
+    for (std::uint32_t i = 0; i < count; ++i) {
+      if (!fits(offset, objectRecordSize)) {
+        return false;
+      }
+      const unsigned char* record = m_data + offset;
+      std::uint64_t numValues = static_cast<std::uint64_t>(getUInt32(record + 20)) + getUInt32(record + 24);
+      if (!fits(offset + objectRecordSize, 4 * numValues) || (getUInt32(record + 16) >= m_numStrings)) {
+        return false;
+      }
+      std::uint32_t nFields = getUInt32(record + 20);
+      for (std::uint64_t j = 0; j < numValues; ++j) {
+        std::uint32_t value = getUInt32(record + objectRecordSize + 4 * j);
+        bool ok = (j < nFields) && (value & pointerFlag) ? ((value & ~pointerFlag) <= numObjects) : (value < m_numStrings);
+        if (!ok) {
+          return false;
+        }
+      }
+      m_objects.push_back(record);
+      m_objectSections.push_back(s);
+      offset += objectRecordSize + 4 * numValues;
+    }
+  }
+  if (m_objects.size() != numObjects) {
+    return false;
+  }
+
+  // object order, a permutation of the object numbers
+  if (!fits(orderOffset, 4 * static_cast<std::uint64_t>(numObjects))) {
+    return false;
+  }
+  m_order = m_data + orderOffset;
+  std::vector<bool> seen(numObjects, false);
+  for (std::uint32_t i = 0; i < numObjects; ++i) {
+    std::uint32_t object = getUInt32(m_order + 4 * i);
+    if ((object >= numObjects) || seen[object]) {
+      return false;
+    }
+    seen[object] = true;
+  }
+
+  return true;
+}
+
+std::string_view WorkspaceSnapshotReader::string(std::uint32_t id) const {
+  std::uint64_t begin = getUInt64(m_stringOffsets + 8 * static_cast<std::uint64_t>(id));
+  std::uint64_t end = getUInt64(m_stringOffsets + 8 * (static_cast<std::uint64_t>(id) + 1));
+  return std::string_view(reinterpret_cast<const char*>(m_stringData + begin), end - begin);
+}
+
+std::uint32_t WorkspaceSnapshotReader::fieldValue(unsigned object, unsigned index) const {
+  return getUInt32(m_objects[object] + objectRecordSize + 4 * index);
+}
+
+} // openstudio
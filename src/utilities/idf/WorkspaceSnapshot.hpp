@@ -0,0 +1,219 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2020, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef UTILITIES_IDF_WORKSPACESNAPSHOT_HPP
+#define UTILITIES_IDF_WORKSPACESNAPSHOT_HPP
+
+#include "../UtilitiesAPI.hpp"
+
+#include "Handle.hpp"
+#include "ValidityEnums.hpp"
+#include "../idd/IddEnums.hpp"
+#include "../core/Path.hpp"
+#include "../core/Logger.hpp"
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace openstudio {
+
+namespace filesystem {
+  class mapped_file_prefix;
+}
+
+/** Binary snapshots of a Workspace, as written by Workspace::saveBinary. A snapshot holds the
+ *  stored (encoded) text of every object, with each distinct string written once, and pointer
+ *  fields already resolved to the position of their target in the snapshot, so loading one needs
+ *  neither Idf parsing nor name or handle lookup.
+ *
+ *  Layout (all integers little-endian):
+ *  \li 64 byte header: the 8 byte magic "OSSNAP\0\0", the format version, IddFileType,
+ *      StrictnessLevel, string ids of the IDD version stamp and of the Workspace header, the
+ *      numbers of strings, objects and sections, and the offsets of the string table, section
+ *      table and object order.
+ *  \li string table: numStrings + 1 uint64 offsets into the character data that follows them.
+ *  \li section table: per IddObject type, the string id of the type name, the number of objects
+ *      and the offset of the section. Objects are numbered section by section.
+ *  \li sections: per object, the 16 byte handle, string ids of the comment, the number of fields
+ *      and field comments, then one uint32 per field and a string id per field comment. Field
+ *      values are string ids, unless the high bit is set, in which case the remaining bits are
+ *      one plus the number of the target object, or 0 for a null pointer.
+ *  \li object order: numObjects uint32 object numbers, in Workspace order. */
+class UTILITIES_API WorkspaceSnapshotWriter {
+ public:
+  /** @name Constructors */
+  //@{
+
+  /** iddVersion should identify the IDD well enough to refuse snapshots written against
+   *  another one, see WorkspaceSnapshotReader::iddVersion. */
+  WorkspaceSnapshotWriter(IddFileType iddFileType,
+                          StrictnessLevel strictnessLevel,
+                          const std::string& iddVersion,
+                          const std::string& header);
+
+  //@}
+
+  /** Adds an object, in Workspace order. fields is the stored text of each field, and is ignored
+   *  for the field indices listed in pointers, which are written as pointers to the given targets
+   *  (null handles for null pointers). Targets may be added after the objects pointing to them. */
+  void addObject(const std::string& typeName,
+                 const Handle& handle,
+                 std::string_view comment,
+                 const std::vector<std::string_view>& fields,
+                 const std::vector<std::string>& fieldComments,
+                 const std::vector<std::pair<unsigned, Handle> >& pointers);
+
+  /** Writes the snapshot to p, replacing any existing file. Returns false if a pointer target was
+   *  never added or if the file cannot be written. */
+  bool save(const openstudio::path& p) const;
+
+ private:
+  struct Object {
+    unsigned type;
+    Handle handle;
+    unsigned comment;
+    std::vector<unsigned> fields;
+    std::vector<unsigned> fieldComments;
+    std::vector<std::pair<unsigned, Handle> > pointers;
+  };
+
+  unsigned stringId(std::string_view value);
+
+  IddFileType m_iddFileType;
+  StrictnessLevel m_strictnessLevel;
+  unsigned m_iddVersion;
+  unsigned m_header;
+  std::vector<std::string> m_strings;
+  std::unordered_map<std::string, unsigned> m_stringIds;
+  std::vector<Object> m_objects;
+
+  REGISTER_LOGGER("utilities.idf.WorkspaceSnapshotWriter");
+};
+
+/** Read-only view of a snapshot written by WorkspaceSnapshotWriter. The file is memory-mapped and
+ *  its structure is checked once on construction; all returned views point into the mapping and
+ *  are valid for the lifetime of the reader. Objects are identified by their number in the
+ *  snapshot, use orderedObject to visit them in Workspace order. */
+class UTILITIES_API WorkspaceSnapshotReader {
+ public:
+  /** @name Constructors */
+  //@{
+
+  explicit WorkspaceSnapshotReader(const openstudio::path& p);
+
+  ~WorkspaceSnapshotReader();
+
+  WorkspaceSnapshotReader(const WorkspaceSnapshotReader&) = delete;
+  WorkspaceSnapshotReader& operator=(const WorkspaceSnapshotReader&) = delete;
+
+  //@}
+  /** @name Getters */
+  //@{
+
+  /** Returns true if p could be mapped and holds a well-formed snapshot. All other getters
+   *  require this. */
+  bool isValid() const;
+
+  IddFileType iddFileType() const;
+
+  StrictnessLevel strictnessLevel() const;
+
+  /** The stamp identifying the IDD the snapshot was written against. */
+  std::string_view iddVersion() const;
+
+  std::string_view header() const;
+
+  unsigned numObjects() const;
+
+  /** Returns the number of the object at position i of the Workspace order. */
+  unsigned orderedObject(unsigned i) const;
+
+  unsigned numSections() const;
+
+  /** Returns the IddObject name shared by all objects in section. */
+  std::string_view sectionTypeName(unsigned section) const;
+
+  /** Returns the section holding object. */
+  unsigned section(unsigned object) const;
+
+  Handle handle(unsigned object) const;
+
+  std::string_view comment(unsigned object) const;
+
+  unsigned numFields(unsigned object) const;
+
+  /** Returns the stored text of field index of object, or an empty view for pointer fields. */
+  std::string_view field(unsigned object, unsigned index) const;
+
+  /** Returns the number of the object pointed to by field index of object, if that field is a
+   *  non-null pointer. */
+  boost::optional<unsigned> target(unsigned object, unsigned index) const;
+
+  unsigned numFieldComments(unsigned object) const;
+
+  std::string_view fieldComment(unsigned object, unsigned index) const;
+
+  //@}
+ private:
+  bool parse();
+
+  std::string_view string(std::uint32_t id) const;
+
+  std::uint32_t fieldValue(unsigned object, unsigned index) const;
+
+  std::unique_ptr<openstudio::filesystem::mapped_file_prefix> m_file;
+  const unsigned char* m_data;
+  std::size_t m_size;
+  bool m_valid;
+  std::uint32_t m_iddFileType;
+  std::uint32_t m_strictnessLevel;
+  std::uint32_t m_iddVersion;
+  std::uint32_t m_header;
+  std::uint32_t m_numStrings;
+  const unsigned char* m_stringOffsets;
+  const unsigned char* m_stringData;
+  const unsigned char* m_order;
+  std::vector<std::uint32_t> m_sectionTypes;
+  // per object, its section and the start of its record
+  std::vector<unsigned> m_objectSections;
+  std::vector<const unsigned char*> m_objects;
+
+  REGISTER_LOGGER("utilities.idf.WorkspaceSnapshotReader");
+};
+
+} // openstudio
+
+#endif // UTILITIES_IDF_WORKSPACESNAPSHOT_HPP
@@ -36,6 +36,7 @@
 #include <utilities/idf/WorkspaceObjectOrder.hpp>
 #include <utilities/idf/ValidityEnums.hpp>
 #include <utilities/idf/ObjectPointer.hpp>
+#include <utilities/idf/FlatHandleMap.hpp>
 
 #include <utilities/idd/IddFileAndFactoryWrapper.hpp>
 #include <nano/nano_signal_slot.hpp> // Signal-Slot replacement
@@ -50,12 +51,15 @@
 #include <set>
 #include <map>
 #include <unordered_map>
+#include <functional>
 
 namespace openstudio {
 
 // forward declarations
 class IdfFile;
 class VersionString;
+struct IddFieldValidation;
+class WorkspaceSnapshotReader;
 
 // private namespace
 namespace detail {
@@ -108,7 +112,7 @@ namespace detail {
     /** Swaps underlying data between this workspace and other. */
     virtual void swap(Workspace& other);
 
-    virtual ~Workspace_Impl() {}
+    virtual ~Workspace_Impl();
 
     //@}
     /** @name Type Casting */
@@ -157,6 +161,10 @@ namespace detail {
     /** Get object from its handle. */
     boost::optional<WorkspaceObject> getObject(const Handle& handle) const;
 
+    /** Returns a pointer to the stored implementation of the object with handle, or nullptr if
+     *  there is no such object. The pointer is invalidated by any addition or removal. */
+    const std::shared_ptr<WorkspaceObject_Impl>* findObject(const Handle& handle) const;
+
     /** Get all objects in this workspace. The returned objects' data is shared with the workspace.
      *  If sorted, then the objects are returned in the preferred order. */
     std::vector<WorkspaceObject> objects(bool sorted=false) const;
@@ -187,6 +195,12 @@ namespace detail {
     /// get all idf objects by full idd type
     std::vector<WorkspaceObject> getObjectsByType(const IddObject& objectType) const;
 
+    /** Calls visitor on each object of type objectType, in no particular order, without
+     *  building a vector or copying the stored pointers. visitor must not add or remove
+     *  objects. */
+    void forEachObjectOfType(IddObjectType objectType,
+                             const std::function<void (const std::shared_ptr<WorkspaceObject_Impl>&)>& visitor) const;
+
     /** Returns the first object found of type objectType and named name (case insensitive,
      *  exact match). */
     boost::optional<WorkspaceObject> getObjectByTypeAndName(IddObjectType objectType,
@@ -209,9 +223,27 @@ namespace detail {
     boost::optional<WorkspaceObject> getObjectByNameAndReference(
         std::string name,const std::vector<std::string>& referenceNames) const;
 
+    /** As above, with the reference lists given by id (see ReferenceListSet::id), for callers that
+     *  already have them from an IddFieldValidation. */
+    boost::optional<WorkspaceObject> getObjectByNameAndReference(
+        const std::string& name,const std::vector<unsigned>& referenceIds) const;
+
     /** Returns true if fast naming is enabled. */
     bool fastNaming() const;
 
+    IdfObjectDiffMode idfObjectDiffMode() const;
+
+    unsigned numIdfObjectDiffs() const;
+
+    std::size_t idfObjectDiffMemoryUsage() const;
+
+    /** Returns true between beginBatchEdit and the matching endBatchEdit. */
+    bool isBatchEditing() const;
+
+    /** Returns the number of bytes allocated by the handle, IddObjectType and reference maps, not
+     *  counting the objects themselves. */
+    std::size_t objectMapsMemoryUsage() const;
+
     //@}
     /** @name Setters */
     //@{
@@ -240,6 +272,23 @@ namespace detail {
         bool expectToLosePointers=false,
         bool checkNames = true);
 
+    /** Bulk-ingest path for trusted input, such as files previously saved by OpenStudio. Pre-sizes
+     *  the object, type, reference and name maps, resolves all pointer fields (by handle or by name)
+     *  in a single pass against a temporary name and reference index, and defers the validity check
+     *  and addition signals until all of the objects are in place. If resolveNameConflicts, name
+     *  conflicts are only looked for if the index finds two objects sharing a name and a reference
+     *  list. On failure, the Workspace is left unchanged and the returned vector is .empty(). */
+    std::vector<WorkspaceObject> bulkAddObjects(
+        std::vector< std::shared_ptr<WorkspaceObject_Impl> >& objectImplPtrs,
+        bool resolveNameConflicts = true);
+
+    /** Loads the objects of a binary snapshot (see saveBinary) into this empty Workspace. Pointers
+     *  are restored from the target positions recorded in the snapshot, so there is no name or
+     *  handle resolution, and no validity check, since the snapshot was written from a Workspace.
+     *  Returns false, leaving the Workspace empty, if the snapshot was written against a different
+     *  IDD (version, build or text) or its objects cannot be added. */
+    bool addSnapshotObjects(const WorkspaceSnapshotReader& snapshot);
+
     /** Adds objectImplPtrs to the Workspace. As clones, the pointer handles may be incorrect. This
      *  is fixed by applying oldNewHandleMap to the pointer data. If this is a wholeCollectionClone,
      *  then the map is applied to the directOrder (if it exists) as well, otherwise, the new
@@ -353,11 +402,29 @@ namespace detail {
                                    unsigned index,
                                    const WorkspaceObject& targetObject);
 
+    /** Keep the name maps current after the name of the object identified by handle has changed.
+     *  oldName is the name the object was indexed under, if any. */
+    void updateNameMaps(const Handle& handle, const boost::optional<std::string>& oldName);
+
     /** Setting fast naming to true reduces the time taken to create names by using a UUID as the name.
      *   This UUID is not the same as the object's handle.
      */
     void setFastNaming(bool fastNaming);
 
+    void setIdfObjectDiffMode(const IdfObjectDiffMode& mode);
+
+    /** Starts a batch edit. Batch edits nest; signals are held back until the outermost one
+     *  ends. */
+    void beginBatchEdit();
+
+    /** Ends a batch edit. Ending the outermost one emits the held back object signals, then
+     *  onChange and onBatchChange once. */
+    void endBatchEdit();
+
+    /** Called by WorkspaceObject_Impl::emitChangeSignals. Returns true, and remembers handle, if
+     *  the object's signals should wait for endBatchEdit. */
+    bool deferChangeSignals(const Handle& handle);
+
     /** Resolve name conflicts within other, and between this workspace and other by renaming objects
      *  in other. */
     bool resolvePotentialNameConflicts(Workspace& other);
@@ -400,6 +467,9 @@ namespace detail {
     /** True if an \\object-list field referencing the given names can point to this object. */
     bool canBeTarget(const Handle& handle, const std::set<std::string>& referenceListNames) const;
 
+    /** \overload Uses the object lists compiled into field. */
+    bool canBeTarget(const Handle& handle, const IddFieldValidation& field) const;
+
     /** True if the IddObject of type is in iddFile(). */
     bool isInIddFile(IddObjectType type) const;
 
@@ -437,6 +507,11 @@ namespace detail {
      *  .idf or modelFileExtension() depending on the underlying IddFileType. */
     virtual bool save(const openstudio::path& p, bool overwrite=false);
 
+    /** Save a binary snapshot of the Workspace to path, see WorkspaceSnapshotWriter. Will construct
+     *  parent folder, and will only overwrite an existing file if overwrite==true. Fails for
+     *  Workspaces using a custom IDD. */
+    bool saveBinary(const openstudio::path& p, bool overwrite=false);
+
     /** Creates an IdfFile from the collection, naming objects if necessary. To print out IDF text,
      *  use this method, then IdfFile.print(ostream). */
     IdfFile toIdfFile();
@@ -483,6 +558,11 @@ namespace detail {
     // DLM: deprecate this version
     // void addWorkspaceObjectPtr(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl>, const openstudio::IddObjectType& iddObjectType, const openstudio::UUID& handle) const;
     mutable Nano::Signal<void(std::shared_ptr<openstudio::detail::WorkspaceObject_Impl>, const openstudio::IddObjectType&, const openstudio::UUID&)> addWorkspaceObjectPtr;
+
+    /** Emitted once when the outermost batch edit ends, with the handles of the objects changed,
+     *  added or removed during it. */
+    // void onBatchChange(const std::vector<Handle>& handles) const;
+    mutable Nano::Signal<void(const std::vector<Handle>&)> onBatchChange;
     //@}
 
 
@@ -511,26 +591,67 @@ namespace detail {
     std::string m_header;                                // header for the IdfFile
     IddFileAndFactoryWrapper m_iddFileAndFactoryWrapper; // IDD file to be used for validity checking
     bool m_fastNaming;
+    IdfObjectDiffMode m_idfObjectDiffMode;
+
+    unsigned m_batchEditDepth;
+    bool m_flushingBatchEdit; // endBatchEdit is emitting the held back object signals
+    // objects changed, added or removed during the current batch edit, in the order first seen
+    std::vector<Handle> m_batchEditHandles;
+    // the same objects, mapped to true if their addition signals are held back
+    FlatHandleMap<bool> m_batchEditAdded;
 
-    typedef std::unordered_map<Handle, std::shared_ptr<WorkspaceObject_Impl>, boost::hash<boost::uuids::uuid> > WorkspaceObjectMap;
+    typedef FlatHandleMap<std::shared_ptr<WorkspaceObject_Impl> > WorkspaceObjectMap;
     WorkspaceObjectMap m_workspaceObjectMap;
 
     // object for ordering objects in the collection.
     WorkspaceObjectOrder m_workspaceObjectOrder;
 
-    // map of IddObjectType to set of objects identified by UUID
-    typedef std::map<IddObjectType, WorkspaceObjectMap > IddObjectTypeMap;
+    // objects identified by UUID, indexed by IddObjectType::value()
+    typedef std::vector<WorkspaceObjectMap> IddObjectTypeMap;
     IddObjectTypeMap m_iddObjectTypeMap;
 
-    // map of reference to set of objects identified by UUID
-    typedef std::unordered_map<std::string, WorkspaceObjectMap> IdfReferencesMap; // , IstringCompare
+    // objects identified by UUID, indexed by reference list id (see ReferenceListSet::id)
+    typedef std::vector<WorkspaceObjectMap> IdfReferencesMap;
     IdfReferencesMap m_idfReferencesMap;
 
+    // map of upper-cased name to objects with that name (objects with empty names are not listed)
+    typedef std::unordered_multimap<std::string, std::shared_ptr<WorkspaceObject_Impl> > NameMap;
+    NameMap m_nameMap;
+
+    // map of IddObjectType to name map for objects of that type
+    typedef std::map<IddObjectType, NameMap> IddObjectTypeNameMap;
+    IddObjectTypeNameMap m_iddObjectTypeNameMap;
+
+    // objects that share a base name (see getBaseName), along with the integer suffixes they use
+    struct NameSeries {
+      WorkspaceObjectMap objects;
+      // suffix to number of objects using it, and how many of those use '_' as the spacer
+      std::map<int, std::pair<unsigned, unsigned> > suffixes;
+      // runs of consecutive suffixes in use, first to last
+      std::map<int, int> runs;
+
+      void insert(const std::shared_ptr<WorkspaceObject_Impl>& object, const boost::optional<int>& suffix, const std::string& spacer);
+      void erase(const std::shared_ptr<WorkspaceObject_Impl>& object, const boost::optional<int>& suffix, const std::string& spacer);
+      // next suffix after the largest one in use, or the smallest unused suffix if fillIn
+      int nextSuffix(bool fillIn) const;
+      // spacer used by the object(s) with the largest suffix
+      std::string spacer() const;
+    };
+
+    // map of upper-cased base name to name series (objects with empty names are not listed)
+    typedef std::unordered_map<std::string, NameSeries> NameSeriesMap;
+    NameSeriesMap m_nameSeriesMap;
+
+    // map of IddObjectType to name series map for objects of that type
+    typedef std::map<IddObjectType, NameSeriesMap> IddObjectTypeNameSeriesMap;
+    IddObjectTypeNameSeriesMap m_iddObjectTypeNameSeriesMap;
+
     // data object for undos
     struct SavedWorkspaceObject {
       Handle                   handle;
       std::shared_ptr<WorkspaceObject_Impl>  objectImplPtr;
       OptionalUnsigned         orderIndex;
+      HHPointerVector          pointers; // to and from the object, nulled by nominallyRemoveObject
       SavedWorkspaceObject(const Handle& h, const std::shared_ptr<WorkspaceObject_Impl>& o) : handle(h), objectImplPtr(o) {}
     };
     typedef boost::optional<SavedWorkspaceObject> OptionalSavedWorkspaceObject;
@@ -557,6 +678,26 @@ namespace detail {
     // Replace m_iddFactoryWrapper if workspace remains valid.
     bool setIddFile(const IddFileAndFactoryWrapper& iddFileAndFileWrapper);
 
+    // Objects of type, growing m_iddObjectTypeMap as needed.
+    WorkspaceObjectMap& objectsOfType(IddObjectType type);
+
+    // Objects of type, or nullptr if no object of that type has been added.
+    const WorkspaceObjectMap* findObjectsOfType(IddObjectType type) const;
+
+    // Objects listed under referenceId, or nullptr if it has never been used.
+    const WorkspaceObjectMap* findObjectsByReference(unsigned referenceId) const;
+
+    // Objects listed under referenceId, growing m_idfReferencesMap as needed.
+    WorkspaceObjectMap& objectsByReference(unsigned referenceId);
+
+    // Reserves room in the object, type, reference and name maps for objectImplPtrs. Only creates
+    // the type, reference and name map entries those objects will be listed under.
+    void reserveForObjects(const std::vector< std::shared_ptr<WorkspaceObject_Impl> >& objectImplPtrs);
+
+    // Drops the type and reference map entries past the first numTypes and numReferences, and
+    // empty name map entries. Call once a failed add has removed its objects again.
+    void releaseObjectMaps(std::size_t numTypes, std::size_t numReferences);
+
       // Helper function to start the process of adding an object to the workspace.
     bool nominallyAddObject(std::shared_ptr<WorkspaceObject_Impl>& ptr);
 
@@ -566,6 +707,10 @@ namespace detail {
 
     void insertIntoIdfReferencesMap(const std::shared_ptr<WorkspaceObject_Impl>& object);
 
+    void insertIntoNameMaps(const std::shared_ptr<WorkspaceObject_Impl>& object);
+
+    void removeFromNameMaps(const std::shared_ptr<WorkspaceObject_Impl>& object, const std::string& name);
+
     // note default parameter for toIgnore is empty vector
     bool resolvePotentialNameConflicts(Workspace& other,
                                        const std::vector<unsigned>& toIgnore);
@@ -595,6 +740,12 @@ namespace detail {
 
     void restoreObject(SavedWorkspaceObject& savedObject);
 
+    /** Puts savedObject back in the maps, but does not relink its pointers. */
+    void reinsertObject(SavedWorkspaceObject& savedObject);
+
+    /** Resets the pointers to and from savedObject. All objects involved must be in the maps. */
+    void relinkObject(SavedWorkspaceObject& savedObject);
+
     void restoreObjects(SavedWorkspaceObjectVector& savedObjects);
 
     void registerRemovalOfObject(std::shared_ptr<WorkspaceObject_Impl> ptr,const std::vector<WorkspaceObject>& sources,const std::vector<Handle>& removedHandles);
@@ -603,11 +754,14 @@ namespace detail {
 
     void registerAdditionOfObject(const WorkspaceObject& object);
 
+    /** Remembers that handle was changed, added or removed during the current batch edit. */
+    void recordBatchEdit(const Handle& handle, bool added);
+
     // QUERIES
 
     /** Returns name with the next available integer suffix. */
     std::string constructNextName(const std::string& objectName,
-                                  const std::vector<WorkspaceObject>& objectsInTheSeries,
+                                  const NameSeries* series,
                                   bool fillIn) const;
 
     std::vector< std::vector<WorkspaceObject> > nameConflicts(
@@ -30,6 +30,8 @@
 #include "SqlFile.hpp"
 #include "SqlFile_Impl.hpp"
 #include "SqlFileTimeSeriesQuery.hpp"
+#include "SqlFileTimeSeriesBlock.hpp"
+#include "SqlFileTimeSeriesCursor.hpp"
 
 namespace openstudio{
 
@@ -1353,6 +1355,60 @@ boost::optional<std::vector<std::string> > SqlFile::execAndReturnVectorOfString(
   return result;
 }
 
+boost::optional<double> SqlFile::execAndReturnFirstDouble(const std::string& statement, const std::vector<std::string>& parameters) const
+{
+  boost::optional<double> result;
+  if (m_impl){
+    result = m_impl->execAndReturnFirstDouble(statement, parameters);
+  }
+  return result;
+}
+
+boost::optional<int> SqlFile::execAndReturnFirstInt(const std::string& statement, const std::vector<std::string>& parameters) const
+{
+  boost::optional<int> result;
+  if (m_impl){
+    result = m_impl->execAndReturnFirstInt(statement, parameters);
+  }
+  return result;
+}
+
+boost::optional<std::string> SqlFile::execAndReturnFirstString(const std::string& statement, const std::vector<std::string>& parameters) const
+{
+  boost::optional<std::string> result;
+  if (m_impl){
+    result = m_impl->execAndReturnFirstString(statement, parameters);
+  }
+  return result;
+}
+
+boost::optional<std::vector<double> > SqlFile::execAndReturnVectorOfDouble(const std::string& statement, const std::vector<std::string>& parameters) const
+{
+  boost::optional<std::vector<double> > result;
+  if (m_impl){
+    result = m_impl->execAndReturnVectorOfDouble(statement, parameters);
+  }
+  return result;
+}
+
+boost::optional<std::vector<int> > SqlFile::execAndReturnVectorOfInt(const std::string& statement, const std::vector<std::string>& parameters) const
+{
+  boost::optional<std::vector<int> > result;
+  if (m_impl){
+    result = m_impl->execAndReturnVectorOfInt(statement, parameters);
+  }
+  return result;
+}
+
+boost::optional<std::vector<std::string> > SqlFile::execAndReturnVectorOfString(const std::string& statement, const std::vector<std::string>& parameters) const
+{
+  boost::optional<std::vector<std::string> > result;
+  if (m_impl){
+    result = m_impl->execAndReturnVectorOfString(statement, parameters);
+  }
+  return result;
+}
+
 // execute a statement and return the error code, used for create/drop tables
 int SqlFile::execute(const std::string& statement)
 {
@@ -1388,6 +1444,44 @@ TimeSeriesVector SqlFile::timeSeries(const SqlFileTimeSeriesQuery& query) {
   return result;
 }
 
+SqlFileTimeSeriesBlock SqlFile::timeSeriesBlock(const std::string& envPeriod, const std::string& reportingFrequency,
+                                                const std::vector<std::string>& timeSeriesNames, const std::vector<std::string>& keyValues)
+{
+  SqlFileTimeSeriesBlock result;
+  if (m_impl) {
+    result = m_impl->timeSeriesBlock(envPeriod, reportingFrequency, timeSeriesNames, keyValues);
+  }
+  return result;
+}
+
+boost::optional<SqlFileTimeSeriesCursor> SqlFile::timeSeriesCursor(const std::string& envPeriod, const std::string& reportingFrequency,
+                                                                   const std::string& timeSeriesName, const std::string& keyValue, unsigned chunkSize)
+{
+  boost::optional<SqlFileTimeSeriesCursor> result;
+  if (m_impl) {
+    boost::optional<detail::DataDictionaryItem> dataDictionary = m_impl->dataDictionaryItem(envPeriod, reportingFrequency, timeSeriesName, keyValue);
+    if (dataDictionary) {
+      result = SqlFileTimeSeriesCursor(m_impl, *dataDictionary, chunkSize);
+    }
+  }
+  return result;
+}
+
+boost::optional<SqlFileTimeSeriesSummary> SqlFile::timeSeriesSummary(const std::string& envPeriod, const std::string& reportingFrequency,
+                                                                     const std::string& timeSeriesName, const std::string& keyValue,
+                                                                     const std::vector<double>& histogramBinEdges)
+{
+  boost::optional<SqlFileTimeSeriesSummary> result;
+  boost::optional<SqlFileTimeSeriesCursor> cursor = timeSeriesCursor(envPeriod, reportingFrequency, timeSeriesName, keyValue);
+  if (cursor) {
+    result = SqlFileTimeSeriesSummary(histogramBinEdges);
+    while (cursor->next()) {
+      result->add(*cursor);
+    }
+  }
+  return result;
+}
+
 boost::optional<std::pair<DateTime, DateTime> > SqlFile::daylightSavingsPeriod() const
 {
   boost::optional<std::pair<DateTime, DateTime> > result;
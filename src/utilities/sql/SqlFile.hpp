@@ -58,12 +58,17 @@ class DateTime;
 class EpwFile;
 class Calendar;
 class SqlFileTimeSeriesQuery;
+class SqlFileTimeSeriesBlock;
+class SqlFileTimeSeriesCursor;
+class SqlFileTimeSeriesSummary;
 
 namespace detail {
   class SqlFile_Impl;
 }
 
-/** SqlFile class is a transaction script around the sql output of EnergyPlus. */
+/** SqlFile class is a transaction script around the sql output of EnergyPlus. SqlFile is not
+ *  thread-safe, its queries share prepared statements, so an SqlFile (or copies of it) must not be
+ *  used from more than one thread at a time. */
 class UTILITIES_API SqlFile {
  public:
 
@@ -705,6 +710,33 @@ class UTILITIES_API SqlFile {
    *  down by ReportingFrequency and determine how many TimeSeries will be returned. */
   std::vector<TimeSeries> timeSeries(const SqlFileTimeSeriesQuery& query);
 
+  /** Returns every series of timeSeriesNames for keyValues, or for all available key values if
+   *  keyValues is empty, read in a single ordered scan of the report data. The series share one
+   *  time axis in the returned block, each in one column even if requested more than once. Use
+   *  this instead of calling timeSeries once per key value when extracting many series, e.g.
+   *  "Zone Mean Air Temperature" of every zone. */
+  SqlFileTimeSeriesBlock timeSeriesBlock(const std::string& envPeriod,
+                                         const std::string& reportingFrequency,
+                                         const std::vector<std::string>& timeSeriesNames,
+                                         const std::vector<std::string>& keyValues);
+
+  /** Returns a cursor reading the series matching name, keyValue, envPeriod, and reportingFrequency
+   *  in chunks of chunkSize values, for series too long to read at once with timeSeries. */
+  boost::optional<SqlFileTimeSeriesCursor> timeSeriesCursor(const std::string& envPeriod,
+                                                            const std::string& reportingFrequency,
+                                                            const std::string& timeSeriesName,
+                                                            const std::string& keyValue,
+                                                            unsigned chunkSize = 8760);
+
+  /** Returns the sum, extremes and their times, and a histogram over histogramBinEdges of the series
+   *  matching name, keyValue, envPeriod, and reportingFrequency, read through a timeSeriesCursor so
+   *  that memory use does not depend on the length of the series. */
+  boost::optional<SqlFileTimeSeriesSummary> timeSeriesSummary(const std::string& envPeriod,
+                                                              const std::string& reportingFrequency,
+                                                              const std::string& timeSeriesName,
+                                                              const std::string& keyValue,
+                                                              const std::vector<double>& histogramBinEdges = std::vector<double>());
+
   //@}
   /** @name Illuminance Map Interface */
   //@{
@@ -834,6 +866,25 @@ class UTILITIES_API SqlFile {
   /// execute a statement and return the results (if any) in a vector of string
   boost::optional<std::vector<std::string> > execAndReturnVectorOfString(const std::string& statement) const;
 
+  /// execute a statement with '?' parameters bound in order to parameters (as text) and return the first (if any) value as a double
+  /// statements are prepared once and cached, so prefer binding values over formatting them into the statement
+  boost::optional<double> execAndReturnFirstDouble(const std::string& statement, const std::vector<std::string>& parameters) const;
+
+  /// execute a statement with '?' parameters bound in order to parameters (as text) and return the first (if any) value as a int
+  boost::optional<int> execAndReturnFirstInt(const std::string& statement, const std::vector<std::string>& parameters) const;
+
+  /// execute a statement with '?' parameters bound in order to parameters (as text) and return the first (if any) value as a string
+  boost::optional<std::string> execAndReturnFirstString(const std::string& statement, const std::vector<std::string>& parameters) const;
+
+  /// execute a statement with '?' parameters bound in order to parameters (as text) and return the results (if any) in a vector of double
+  boost::optional<std::vector<double> > execAndReturnVectorOfDouble(const std::string& statement, const std::vector<std::string>& parameters) const;
+
+  /// execute a statement with '?' parameters bound in order to parameters (as text) and return the results (if any) in a vector of int
+  boost::optional<std::vector<int> > execAndReturnVectorOfInt(const std::string& statement, const std::vector<std::string>& parameters) const;
+
+  /// execute a statement with '?' parameters bound in order to parameters (as text) and return the results (if any) in a vector of string
+  boost::optional<std::vector<std::string> > execAndReturnVectorOfString(const std::string& statement, const std::vector<std::string>& parameters) const;
+
   /// execute a statement and return the error code, used for create/drop tables
   int execute(const std::string& statement);
 
@@ -8,6 +8,8 @@
   #include <utilities/sql/SqlFile.hpp>
   #include <utilities/sql/SqlFileEnums.hpp>
   #include <utilities/sql/SqlFileTimeSeriesQuery.hpp>
+  #include <utilities/sql/SqlFileTimeSeriesBlock.hpp>
+  #include <utilities/sql/SqlFileTimeSeriesCursor.hpp>
 
   #include <utilities/units/Unit.hpp>
   #include <utilities/units/BTUUnit.hpp>
@@ -32,6 +34,8 @@
 
 // create an instantiation of the optional classes
 %template(OptionalSqlFile) boost::optional<openstudio::SqlFile>;
+%template(OptionalSqlFileTimeSeriesCursor) boost::optional<openstudio::SqlFileTimeSeriesCursor>;
+%template(OptionalSqlFileTimeSeriesSummary) boost::optional<openstudio::SqlFileTimeSeriesSummary>;
 %template(OptionalEnvironmentType) boost::optional<openstudio::EnvironmentType>;
 %template(OptionalReportingFrequency) boost::optional<openstudio::ReportingFrequency>;
 %template(OptionalKeyValueIdentifier) boost::optional<openstudio::KeyValueIdentifier>;
@@ -46,6 +50,8 @@
 
 %include <utilities/sql/SqlFile.hpp>
 %include <utilities/sql/SqlFileTimeSeriesQuery.hpp>
+%include <utilities/sql/SqlFileTimeSeriesBlock.hpp>
+%include <utilities/sql/SqlFileTimeSeriesCursor.hpp>
 %include <utilities/sql/SqlFileEnums.hpp>
 
 #endif //UTILITIES_OUTPUT_SQLFILE_I
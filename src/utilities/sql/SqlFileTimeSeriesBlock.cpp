@@ -0,0 +1,165 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2020, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include "SqlFileTimeSeriesBlock.hpp"
+
+#include "../core/Assert.hpp"
+#include "../core/Compare.hpp"
+
+namespace openstudio {
+
+SqlFileTimeSeriesBlock::SqlFileTimeSeriesBlock()
+{}
+
+SqlFileTimeSeriesBlock::SqlFileTimeSeriesBlock(const std::string& envPeriod,
+                                               const std::string& reportingFrequency,
+                                               const boost::optional<DateTime>& firstReportDateTime,
+                                               std::vector<long> secondsFromStart,
+                                               const boost::optional<Time>& intervalLength,
+                                               std::vector<std::string> names,
+                                               std::vector<std::string> keyValues,
+                                               std::vector<std::string> units,
+                                               std::vector<std::vector<double> > values)
+  : m_envPeriod(envPeriod),
+    m_reportingFrequency(reportingFrequency),
+    m_firstReportDateTime(firstReportDateTime),
+    m_secondsFromStart(std::move(secondsFromStart)),
+    m_intervalLength(intervalLength),
+    m_names(std::move(names)),
+    m_keyValues(std::move(keyValues)),
+    m_units(std::move(units)),
+    m_values(std::move(values))
+{
+  OS_ASSERT(m_keyValues.size() == m_names.size());
+  OS_ASSERT(m_units.size() == m_names.size());
+  OS_ASSERT(m_values.size() == m_names.size());
+  for (const std::vector<double>& columnValues : m_values) {
+    OS_ASSERT(columnValues.size() == m_secondsFromStart.size());
+  }
+}
+
+std::string SqlFileTimeSeriesBlock::envPeriod() const
+{
+  return m_envPeriod;
+}
+
+std::string SqlFileTimeSeriesBlock::reportingFrequency() const
+{
+  return m_reportingFrequency;
+}
+
+boost::optional<DateTime> SqlFileTimeSeriesBlock::firstReportDateTime() const
+{
+  return m_firstReportDateTime;
+}
+
+const std::vector<long>& SqlFileTimeSeriesBlock::secondsFromStart() const
+{
+  return m_secondsFromStart;
+}
+
+boost::optional<Time> SqlFileTimeSeriesBlock::intervalLength() const
+{
+  return m_intervalLength;
+}
+
+std::vector<DateTime> SqlFileTimeSeriesBlock::dateTimes() const
+{
+  std::vector<DateTime> result;
+  if (!m_firstReportDateTime) {
+    return result;
+  }
+
+  // the first report ends at firstReportDateTime, after its own interval
+  long firstReportSeconds = m_secondsFromStart.empty() ? 0 : m_secondsFromStart.front();
+  result.reserve(m_secondsFromStart.size());
+  for (long seconds : m_secondsFromStart) {
+    result.push_back(*m_firstReportDateTime + Time(0, 0, 0, seconds - firstReportSeconds));
+  }
+  return result;
+}
+
+unsigned SqlFileTimeSeriesBlock::numRows() const
+{
+  return m_secondsFromStart.size();
+}
+
+unsigned SqlFileTimeSeriesBlock::numColumns() const
+{
+  return m_values.size();
+}
+
+const std::vector<std::string>& SqlFileTimeSeriesBlock::names() const
+{
+  return m_names;
+}
+
+const std::vector<std::string>& SqlFileTimeSeriesBlock::keyValues() const
+{
+  return m_keyValues;
+}
+
+const std::vector<std::string>& SqlFileTimeSeriesBlock::units() const
+{
+  return m_units;
+}
+
+boost::optional<unsigned> SqlFileTimeSeriesBlock::column(const std::string& name, const std::string& keyValue) const
+{
+  for (unsigned i = 0, n = m_names.size(); i < n; ++i) {
+    if (istringEqual(m_names[i], name) && istringEqual(m_keyValues[i], keyValue)) {
+      return i;
+    }
+  }
+  return boost::none;
+}
+
+const std::vector<double>& SqlFileTimeSeriesBlock::values(unsigned column) const
+{
+  OS_ASSERT(column < m_values.size());
+  return m_values[column];
+}
+
+boost::optional<TimeSeries> SqlFileTimeSeriesBlock::timeSeries(unsigned column) const
+{
+  boost::optional<TimeSeries> result;
+  if ((column >= m_values.size()) || !m_firstReportDateTime || m_secondsFromStart.empty()) {
+    return result;
+  }
+
+  Vector values = createVector(m_values[column]);
+  if (m_intervalLength) {
+    result = TimeSeries(*m_firstReportDateTime, *m_intervalLength, values, m_units[column]);
+  } else {
+    result = TimeSeries(*m_firstReportDateTime, m_secondsFromStart, values, m_units[column]);
+  }
+  return result;
+}
+
+} // openstudio
@@ -0,0 +1,121 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2020, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef UTILITIES_SQL_SQLFILETIMESERIESBLOCK_HPP
+#define UTILITIES_SQL_SQLFILETIMESERIESBLOCK_HPP
+
+#include "../UtilitiesAPI.hpp"
+
+#include "../data/TimeSeries.hpp"
+#include "../time/DateTime.hpp"
+#include "../time/Time.hpp"
+
+#include <boost/optional.hpp>
+
+#include <string>
+#include <vector>
+
+namespace openstudio {
+
+/** SqlFileTimeSeriesBlock holds several time series of one environment period and reporting
+ *  frequency, read from a SqlFile in a single scan of the report data. The series share one time
+ *  axis and their values are stored by column, so a column can be read without copying it. A
+ *  series that is not reported at some time of the axis has NaN there. */
+class UTILITIES_API SqlFileTimeSeriesBlock {
+ public:
+
+  /** Construct an empty block. */
+  SqlFileTimeSeriesBlock();
+
+  /** Construct from the shared time axis and one name, key value, units and value column per
+   *  series. Each column of values must have one entry per entry of secondsFromStart. */
+  SqlFileTimeSeriesBlock(const std::string& envPeriod,
+                         const std::string& reportingFrequency,
+                         const boost::optional<DateTime>& firstReportDateTime,
+                         std::vector<long> secondsFromStart,
+                         const boost::optional<Time>& intervalLength,
+                         std::vector<std::string> names,
+                         std::vector<std::string> keyValues,
+                         std::vector<std::string> units,
+                         std::vector<std::vector<double> > values);
+
+  std::string envPeriod() const;
+
+  std::string reportingFrequency() const;
+
+  /** Date and time of the first report, empty if nothing was reported. */
+  boost::optional<DateTime> firstReportDateTime() const;
+
+  /** Seconds from the start of the first reporting interval to the end of each report, as for the
+   *  TimeSeries constructor taking a vector of seconds. */
+  const std::vector<long>& secondsFromStart() const;
+
+  /** Length of every report, if the reports are regularly spaced. */
+  boost::optional<Time> intervalLength() const;
+
+  /** Date and time of each report. */
+  std::vector<DateTime> dateTimes() const;
+
+  /** Number of reports on the time axis. */
+  unsigned numRows() const;
+
+  /** Number of series. */
+  unsigned numColumns() const;
+
+  const std::vector<std::string>& names() const;
+
+  const std::vector<std::string>& keyValues() const;
+
+  const std::vector<std::string>& units() const;
+
+  /** Column of the series with name and keyValue, compared case insensitively. */
+  boost::optional<unsigned> column(const std::string& name, const std::string& keyValue) const;
+
+  /** Values of a column, one per report. The reference stays valid as long as the block. */
+  const std::vector<double>& values(unsigned column) const;
+
+  /** Copy a column into a TimeSeries, as SqlFile::timeSeries would return it. */
+  boost::optional<TimeSeries> timeSeries(unsigned column) const;
+
+ private:
+
+  std::string m_envPeriod;
+  std::string m_reportingFrequency;
+  boost::optional<DateTime> m_firstReportDateTime;
+  std::vector<long> m_secondsFromStart;
+  boost::optional<Time> m_intervalLength;
+  std::vector<std::string> m_names;
+  std::vector<std::string> m_keyValues;
+  std::vector<std::string> m_units;
+  std::vector<std::vector<double> > m_values;
+};
+
+} // openstudio
+
+#endif // UTILITIES_SQL_SQLFILETIMESERIESBLOCK_HPP
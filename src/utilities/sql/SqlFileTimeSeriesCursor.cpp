@@ -0,0 +1,218 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2020, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#include "SqlFileTimeSeriesCursor.hpp"
+#include "SqlFile_Impl.hpp"
+
+#include "../core/Assert.hpp"
+
+#include <algorithm>
+
+namespace openstudio {
+
+SqlFileTimeSeriesCursor::SqlFileTimeSeriesCursor()
+  : m_recordIndex(0), m_envPeriodIndex(0), m_chunkSize(0), m_lastRowId(0), m_numValuesRead(0)
+{}
+
+SqlFileTimeSeriesCursor::SqlFileTimeSeriesCursor(const std::shared_ptr<detail::SqlFile_Impl>& sqlFile,
+                                                 const detail::DataDictionaryItem& dataDictionary,
+                                                 unsigned chunkSize)
+  : m_sqlFile(sqlFile),
+    m_name(dataDictionary.name),
+    m_keyValue(dataDictionary.keyValue),
+    m_units(dataDictionary.units),
+    m_table(dataDictionary.table),
+    m_recordIndex(dataDictionary.recordIndex),
+    m_envPeriodIndex(dataDictionary.envPeriodIndex),
+    m_chunkSize(std::max(chunkSize, 1u)),
+    m_lastRowId(0),
+    m_numValuesRead(0)
+{
+  m_values.reserve(m_chunkSize);
+  m_dateTimes.reserve(m_chunkSize);
+}
+
+bool SqlFileTimeSeriesCursor::next()
+{
+  m_values.clear();
+  m_dateTimes.clear();
+  if (!m_sqlFile) {
+    return false;
+  }
+
+  m_sqlFile->timeSeriesChunk(m_table, m_recordIndex, m_envPeriodIndex, m_chunkSize, m_lastRowId, m_values, m_dateTimes);
+  m_numValuesRead += m_values.size();
+  if (m_values.size() < m_chunkSize) {
+    // this is the last chunk, release the file
+    m_sqlFile.reset();
+  }
+  return !m_values.empty();
+}
+
+const std::vector<double>& SqlFileTimeSeriesCursor::values() const
+{
+  return m_values;
+}
+
+const std::vector<DateTime>& SqlFileTimeSeriesCursor::dateTimes() const
+{
+  return m_dateTimes;
+}
+
+std::string SqlFileTimeSeriesCursor::name() const
+{
+  return m_name;
+}
+
+std::string SqlFileTimeSeriesCursor::keyValue() const
+{
+  return m_keyValue;
+}
+
+std::string SqlFileTimeSeriesCursor::units() const
+{
+  return m_units;
+}
+
+unsigned SqlFileTimeSeriesCursor::chunkSize() const
+{
+  return m_chunkSize;
+}
+
+unsigned SqlFileTimeSeriesCursor::numValuesRead() const
+{
+  return m_numValuesRead;
+}
+
+SqlFileTimeSeriesSummary::SqlFileTimeSeriesSummary(const std::vector<double>& histogramBinEdges)
+  : m_count(0), m_sum(0.0), m_numBelowHistogram(0), m_numAboveHistogram(0)
+{
+  if (histogramBinEdges.size() > 1) {
+    OS_ASSERT(std::is_sorted(histogramBinEdges.begin(), histogramBinEdges.end()));
+    m_histogramBinEdges = histogramBinEdges;
+    m_histogramCounts.resize(histogramBinEdges.size() - 1, 0);
+  }
+}
+
+void SqlFileTimeSeriesSummary::add(const std::vector<double>& values, const std::vector<DateTime>& dateTimes)
+{
+  OS_ASSERT(values.size() == dateTimes.size());
+
+  for (std::vector<double>::size_type i = 0; i < values.size(); ++i) {
+    double value = values[i];
+    ++m_count;
+    m_sum += value;
+
+    if (!m_minimum || (value < *m_minimum)) {
+      m_minimum = value;
+      m_minimumDateTime = dateTimes[i];
+    }
+    if (!m_maximum || (value > *m_maximum)) {
+      m_maximum = value;
+      m_maximumDateTime = dateTimes[i];
+    }
+
+    if (!m_histogramBinEdges.empty()) {
+      if (value < m_histogramBinEdges.front()) {
+        ++m_numBelowHistogram;
+      } else if (value > m_histogramBinEdges.back()) {
+        ++m_numAboveHistogram;
+      } else {
+        auto bin = std::upper_bound(m_histogramBinEdges.begin(), m_histogramBinEdges.end(), value) - m_histogramBinEdges.begin() - 1;
+        ++m_histogramCounts[std::min<std::ptrdiff_t>(bin, m_histogramCounts.size() - 1)];
+      }
+    }
+  }
+}
+
+void SqlFileTimeSeriesSummary::add(const SqlFileTimeSeriesCursor& cursor)
+{
+  add(cursor.values(), cursor.dateTimes());
+}
+
+unsigned SqlFileTimeSeriesSummary::count() const
+{
+  return m_count;
+}
+
+double SqlFileTimeSeriesSummary::sum() const
+{
+  return m_sum;
+}
+
+boost::optional<double> SqlFileTimeSeriesSummary::mean() const
+{
+  boost::optional<double> result;
+  if (m_count > 0) {
+    result = m_sum / m_count;
+  }
+  return result;
+}
+
+boost::optional<double> SqlFileTimeSeriesSummary::minimum() const
+{
+  return m_minimum;
+}
+
+boost::optional<DateTime> SqlFileTimeSeriesSummary::minimumDateTime() const
+{
+  return m_minimumDateTime;
+}
+
+boost::optional<double> SqlFileTimeSeriesSummary::maximum() const
+{
+  return m_maximum;
+}
+
+boost::optional<DateTime> SqlFileTimeSeriesSummary::maximumDateTime() const
+{
+  return m_maximumDateTime;
+}
+
+const std::vector<double>& SqlFileTimeSeriesSummary::histogramBinEdges() const
+{
+  return m_histogramBinEdges;
+}
+
+const std::vector<unsigned>& SqlFileTimeSeriesSummary::histogramCounts() const
+{
+  return m_histogramCounts;
+}
+
+unsigned SqlFileTimeSeriesSummary::numBelowHistogram() const
+{
+  return m_numBelowHistogram;
+}
+
+unsigned SqlFileTimeSeriesSummary::numAboveHistogram() const
+{
+  return m_numAboveHistogram;
+}
+
+} // openstudio
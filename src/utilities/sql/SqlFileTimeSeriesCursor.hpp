@@ -0,0 +1,164 @@
+/***********************************************************************************************************************
+*  OpenStudio(R), Copyright (c) 2008-2020, Alliance for Sustainable Energy, LLC, and other contributors. All rights reserved.
+*
+*  Redistribution and use in source and binary forms, with or without modification, are permitted provided that the
+*  following conditions are met:
+*
+*  (1) Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+*  disclaimer.
+*
+*  (2) Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+*  disclaimer in the documentation and/or other materials provided with the distribution.
+*
+*  (3) Neither the name of the copyright holder nor the names of any contributors may be used to endorse or promote products
+*  derived from this software without specific prior written permission from the respective party.
+*
+*  (4) Other than as required in clauses (1) and (2), distributions in any form of modifications or other derivative works
+*  may not use the "OpenStudio" trademark, "OS", "os", or any other confusingly similar designation without specific prior
+*  written permission from Alliance for Sustainable Energy, LLC.
+*
+*  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER(S) AND ANY CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+*  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+*  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER(S), ANY CONTRIBUTORS, THE UNITED STATES GOVERNMENT, OR THE UNITED
+*  STATES DEPARTMENT OF ENERGY, NOR ANY OF THEIR EMPLOYEES, BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+*  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+*  USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+*  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+*  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+***********************************************************************************************************************/
+
+#ifndef UTILITIES_SQL_SQLFILETIMESERIESCURSOR_HPP
+#define UTILITIES_SQL_SQLFILETIMESERIESCURSOR_HPP
+
+#include "../UtilitiesAPI.hpp"
+
+#include "../time/DateTime.hpp"
+
+#include <boost/optional.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace openstudio {
+
+class SqlFile;
+
+namespace detail {
+  class SqlFile_Impl;
+  struct DataDictionaryItem;
+}
+
+/** SqlFileTimeSeriesCursor reads the values of one time series from a SqlFile a chunk at a time,
+ *  in report order, so that a series with hundreds of thousands of reports can be processed without
+ *  holding all of it in memory. Cursors are returned by SqlFile::timeSeriesCursor; each call to next
+ *  replaces the current chunk with the following one. */
+class UTILITIES_API SqlFileTimeSeriesCursor {
+ public:
+
+  /** Construct a cursor that has nothing to read. */
+  SqlFileTimeSeriesCursor();
+
+  /** Read the next chunk of at most chunkSize values. Returns false, with an empty chunk, once every
+   *  value has been read or if the SqlFile has been closed. */
+  bool next();
+
+  /** Values of the current chunk. */
+  const std::vector<double>& values() const;
+
+  /** Date and time of each value of the current chunk. */
+  const std::vector<DateTime>& dateTimes() const;
+
+  std::string name() const;
+
+  std::string keyValue() const;
+
+  std::string units() const;
+
+  /** Maximum number of values in a chunk. */
+  unsigned chunkSize() const;
+
+  /** Number of values read so far, including the current chunk. */
+  unsigned numValuesRead() const;
+
+ private:
+
+  friend class SqlFile;
+
+  SqlFileTimeSeriesCursor(const std::shared_ptr<detail::SqlFile_Impl>& sqlFile, const detail::DataDictionaryItem& dataDictionary, unsigned chunkSize);
+
+  std::shared_ptr<detail::SqlFile_Impl> m_sqlFile;
+  std::string m_name;
+  std::string m_keyValue;
+  std::string m_units;
+  std::string m_table;
+  int m_recordIndex;
+  int m_envPeriodIndex;
+  unsigned m_chunkSize;
+  long long m_lastRowId; // sqlite3_int64, row ids of large outputs need 64 bits
+  unsigned m_numValuesRead;
+  std::vector<double> m_values;
+  std::vector<DateTime> m_dateTimes;
+};
+
+/** SqlFileTimeSeriesSummary computes summary statistics of a time series as its values are added,
+ *  typically one SqlFileTimeSeriesCursor chunk at a time, using memory independent of the length of
+ *  the series. */
+class UTILITIES_API SqlFileTimeSeriesSummary {
+ public:
+
+  /** Construct with the edges of the histogram bins, which must be increasing. No histogram is
+   *  kept if there are fewer than two edges. */
+  explicit SqlFileTimeSeriesSummary(const std::vector<double>& histogramBinEdges = std::vector<double>());
+
+  /** Add values reported at dateTimes, which must be of the same size. */
+  void add(const std::vector<double>& values, const std::vector<DateTime>& dateTimes);
+
+  /** Add the current chunk of cursor. */
+  void add(const SqlFileTimeSeriesCursor& cursor);
+
+  unsigned count() const;
+
+  double sum() const;
+
+  boost::optional<double> mean() const;
+
+  boost::optional<double> minimum() const;
+
+  /** Date and time of the first report of the minimum value. */
+  boost::optional<DateTime> minimumDateTime() const;
+
+  boost::optional<double> maximum() const;
+
+  /** Date and time of the first report of the maximum value, i.e. the peak. */
+  boost::optional<DateTime> maximumDateTime() const;
+
+  const std::vector<double>& histogramBinEdges() const;
+
+  /** Number of values in each bin, bin i holds values in [edge i, edge i+1) and the last bin also
+   *  holds values equal to the last edge. */
+  const std::vector<unsigned>& histogramCounts() const;
+
+  /** Number of values below the first edge. */
+  unsigned numBelowHistogram() const;
+
+  /** Number of values above the last edge. */
+  unsigned numAboveHistogram() const;
+
+ private:
+
+  unsigned m_count;
+  double m_sum;
+  boost::optional<double> m_minimum;
+  boost::optional<DateTime> m_minimumDateTime;
+  boost::optional<double> m_maximum;
+  boost::optional<DateTime> m_maximumDateTime;
+  std::vector<double> m_histogramBinEdges;
+  std::vector<unsigned> m_histogramCounts;
+  unsigned m_numBelowHistogram;
+  unsigned m_numAboveHistogram;
+};
+
+} // openstudio
+
+#endif // UTILITIES_SQL_SQLFILETIMESERIESCURSOR_HPP
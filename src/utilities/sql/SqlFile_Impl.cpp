@@ -36,6 +36,10 @@
 #include "../core/Containers.hpp"
 #include "../core/Assert.hpp"
 
+#include <algorithm>
+#include <limits>
+#include <set>
+
 
 
 using boost::multi_index_container;
@@ -56,7 +60,7 @@ namespace openstudio{
     }
 
     SqlFile_Impl::SqlFile_Impl(const openstudio::path& path, const bool createIndexes)
-      : m_path(path), m_connectionOpen(false), m_supportedVersion(false), m_hasYear(true), m_hasIlluminanceMapYear(true)
+      : m_path(path), m_connectionOpen(false), m_db(nullptr), m_supportedVersion(false), m_hasYear(true), m_hasIlluminanceMapYear(true)
     {
       if (openstudio::filesystem::exists(m_path)){
         m_path = openstudio::filesystem::canonical(m_path);
@@ -67,7 +71,7 @@ namespace openstudio{
 
     SqlFile_Impl::SqlFile_Impl(const openstudio::path &t_path, const openstudio::EpwFile &t_epwFile, const openstudio::DateTime &t_simulationTime,
         const openstudio::Calendar &t_calendar, const bool createIndexes)
-      : m_path(t_path)
+      : m_path(t_path), m_connectionOpen(false), m_db(nullptr)
     {
       if (openstudio::filesystem::exists(m_path)){
         m_path = openstudio::filesystem::canonical(m_path);
@@ -84,7 +88,7 @@ namespace openstudio{
         initschema = true;
       }
 
-      sqlite3_open_v2(fileName.c_str(), &m_db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_EXCLUSIVE, nullptr);
+      m_connectionOpen = (sqlite3_open_v2(fileName.c_str(), &m_db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_EXCLUSIVE, nullptr) == SQLITE_OK);
 
       if (initschema)
       {
@@ -380,6 +384,8 @@ namespace openstudio{
 
     void SqlFile_Impl::execAndThrowOnError(const std::string &t_stmt)
     {
+      clearTabularDataCache();
+
       char *err = nullptr;
       if (sqlite3_exec(m_db, t_stmt.c_str(), nullptr, nullptr, &err) != SQLITE_OK)
       {
@@ -419,8 +425,10 @@ namespace openstudio{
 
     bool SqlFile_Impl::close()
     {
+      clearTabularDataCache();
       if (m_connectionOpen)
       {
+        clearStatementCache();
         sqlite3_close(m_db);
         m_connectionOpen = false;
       }
@@ -451,6 +459,7 @@ namespace openstudio{
       m_connectionOpen = (code == 0);
       if (m_connectionOpen) {// create index on dictionaryIndex for large table reportvariabledata
         if (!isValidConnection()) {
+          clearStatementCache();
           sqlite3_close(m_db);
           m_connectionOpen = false;
           throw openstudio::Exception("OpenStudio is not compatible with this file.");
@@ -542,37 +551,35 @@ namespace openstudio{
     {
       int zoneIndex = getNextIndex("zones", "ZoneIndex");
 
-      std::stringstream insertZone;
-      insertZone << "insert into zones (ZoneIndex, ZoneName, RelNorth, OriginX, OriginY, OriginZ, CentroidX, CentroidY, CentroidZ, OfType, Multiplier, ListMultiplier, MinimumX, MaximumX, MinimumY, MaximumY, MinimumZ, MaximumZ, CeilingHeight, Volume, InsideConvectionAlgo, OutsideConvectionAlgo, FloorArea, ExtGrossWallArea, ExtNetWallArea, ExtWindowArea, IsPartOfTotalArea) values ("
-        << zoneIndex << ", "
-        << "'" << t_name << "', "
-        << t_relNorth << ", "
-        << t_originX << ", "
-        << t_originY << ", "
-        << t_originZ << ", "
-        << t_centroidX << ", "
-        << t_centroidY << ", "
-        << t_centroidZ << ", "
-        << t_ofType << ", "
-        << t_multiplier << ", "
-        << t_listMultiplier << ", "
-        << t_minimumX << ", "
-        << t_maximumX << ", "
-        << t_minimumY << ", "
-        << t_maximumY << ", "
-        << t_minimumZ << ", "
-        << t_maximumZ << ", "
-        << t_ceilingHeight << ", "
-        << t_volume << ", "
-        << t_insideConvectionAlgo << ", "
-        << t_outsideConvectionAlgo << ", "
-        << t_floorArea << ", "
-        << t_extGrossWallArea << ", "
-        << t_extNetWallArea << ", "
-        << t_extWindowArea << ", "
-        << t_isPartOfTotalArea << ");";
-
-      execAndThrowOnError(insertZone.str());
+      PreparedStatement insertZone("insert into zones (ZoneIndex, ZoneName, RelNorth, OriginX, OriginY, OriginZ, CentroidX, CentroidY, CentroidZ, OfType, Multiplier, ListMultiplier, MinimumX, MaximumX, MinimumY, MaximumY, MinimumZ, MaximumZ, CeilingHeight, Volume, InsideConvectionAlgo, OutsideConvectionAlgo, FloorArea, ExtGrossWallArea, ExtNetWallArea, ExtWindowArea, IsPartOfTotalArea) values (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);", m_db);
+      insertZone.bind(1, zoneIndex);
+      insertZone.bind(2, t_name);
+      insertZone.bind(3, t_relNorth);
+      insertZone.bind(4, t_originX);
+      insertZone.bind(5, t_originY);
+      insertZone.bind(6, t_originZ);
+      insertZone.bind(7, t_centroidX);
+      insertZone.bind(8, t_centroidY);
+      insertZone.bind(9, t_centroidZ);
+      insertZone.bind(10, t_ofType);
+      insertZone.bind(11, t_multiplier);
+      insertZone.bind(12, t_listMultiplier);
+      insertZone.bind(13, t_minimumX);
+      insertZone.bind(14, t_maximumX);
+      insertZone.bind(15, t_minimumY);
+      insertZone.bind(16, t_maximumY);
+      insertZone.bind(17, t_minimumZ);
+      insertZone.bind(18, t_maximumZ);
+      insertZone.bind(19, t_ceilingHeight);
+      insertZone.bind(20, t_volume);
+      insertZone.bind(21, t_insideConvectionAlgo);
+      insertZone.bind(22, t_outsideConvectionAlgo);
+      insertZone.bind(23, t_floorArea);
+      insertZone.bind(24, t_extGrossWallArea);
+      insertZone.bind(25, t_extNetWallArea);
+      insertZone.bind(26, t_extWindowArea);
+      insertZone.bind(27, static_cast<int>(t_isPartOfTotalArea));
+      insertZone.execute();
 
 
       return zoneIndex;
@@ -583,7 +590,7 @@ namespace openstudio{
         const std::string &t_environmentName, const std::vector<DateTime> &t_times,
         const std::vector<double> &t_xs, const std::vector<double> &t_ys, double t_z, const std::vector<Matrix> &t_maps)
     {
-      boost::optional<int> zoneIndex = execAndReturnFirstInt("select ZoneIndex from zones where ZoneName='" + t_zoneName + "';");
+      boost::optional<int> zoneIndex = execAndReturnFirstInt("select ZoneIndex from zones where ZoneName=?;", t_zoneName);
 
       if (!zoneIndex)
       {
@@ -601,17 +608,15 @@ namespace openstudio{
 
       std::string referencePt2 = "RefPt1=(" + boost::lexical_cast<std::string>(t_xs.back()) + ":" + boost::lexical_cast<std::string>(t_ys.back()) + ":" + boost::lexical_cast<std::string>(t_z) + ")";
 
-      std::stringstream mapInsert;
-      mapInsert << "insert into daylightmaps (MapNumber, MapName, Environment, Zone, ReferencePt1, ReferencePt2, Z) values ("
-        << mapIndex << ", "
-        << "'" << t_name << "', "
-        << "'" << t_environmentName << "', "
-        << *zoneIndex << ", "
-        << "'" << referencePt1 << "', "
-        << "'" << referencePt2 << "', "
-        << t_z << ");";
-
-      execAndThrowOnError(mapInsert.str());
+      PreparedStatement mapInsert("insert into daylightmaps (MapNumber, MapName, Environment, Zone, ReferencePt1, ReferencePt2, Z) values (?, ?, ?, ?, ?, ?, ?);", m_db);
+      mapInsert.bind(1, mapIndex);
+      mapInsert.bind(2, t_name);
+      mapInsert.bind(3, t_environmentName);
+      mapInsert.bind(4, *zoneIndex);
+      mapInsert.bind(5, referencePt1);
+      mapInsert.bind(6, referencePt2);
+      mapInsert.bind(7, t_z);
+      mapInsert.execute();
 
 
       int hourlyReportIndex = getNextIndex("daylightmaphourlyreports", "HourlyReportIndex");
@@ -697,32 +702,21 @@ namespace openstudio{
       int datadicindex = getNextIndex("reportdatadictionary", "ReportDataDictionaryIndex");
 
 
-      std::stringstream insertReportDataDictionary;
-      insertReportDataDictionary
-        << "insert into reportdatadictionary (ReportDataDictionaryIndex, IsMeter, Type, IndexGroup, TimestepType, KeyValue, Name, ReportingFrequency, ScheduleName, Units) values ("
-        << datadicindex << ", "
-        << "'0',"
-        << "'" << t_variableType << "', "
-        << "'" << t_indexGroup << "', "
-        << "'" << t_timestepType << "', "
-        << "'" << t_keyValue << "', "
-        << "'" << t_variableName << "', "
-        << "'" << t_reportingFrequency.valueName() << "', ";
-
+      PreparedStatement insertReportDataDictionary("insert into reportdatadictionary (ReportDataDictionaryIndex, IsMeter, Type, IndexGroup, TimestepType, KeyValue, Name, ReportingFrequency, ScheduleName, Units) values (?, '0', ?, ?, ?, ?, ?, ?, ?, ?);", m_db);
+      insertReportDataDictionary.bind(1, datadicindex);
+      insertReportDataDictionary.bind(2, t_variableType);
+      insertReportDataDictionary.bind(3, t_indexGroup);
+      insertReportDataDictionary.bind(4, t_timestepType);
+      insertReportDataDictionary.bind(5, t_keyValue);
+      insertReportDataDictionary.bind(6, t_variableName);
+      insertReportDataDictionary.bind(7, t_reportingFrequency.valueName());
+      // ScheduleName is left null when not bound
       if (t_scheduleName)
       {
-        insertReportDataDictionary
-          << "'" << *t_scheduleName << "', ";
-      } else {
-        insertReportDataDictionary
-          << "null, ";
+        insertReportDataDictionary.bind(8, *t_scheduleName);
       }
-
-      insertReportDataDictionary
-        << "'" << t_variableUnits << "');";
-
-
-      execAndThrowOnError(insertReportDataDictionary.str());
+      insertReportDataDictionary.bind(9, t_variableUnits);
+      insertReportDataDictionary.execute();
 
 
       std::vector<double> values = toStandardVector(t_timeSeries.values());
@@ -933,14 +927,9 @@ namespace openstudio{
         boost::algorithm::to_upper_copy(t_fuelType.valueName());
       const std::string rowname = t_monthOfYear.valueDescription();
 
-      const std::string& s = "SELECT Value FROM tabulardatawithstrings WHERE \
-                              ReportName='" + reportname + "' and \
-                              ReportForString='Meter' AND \
-                              RowName='" + rowname + "' AND \
-                              ColumnName='" + columnname + "' AND \
-                              Units='J'";
-
-      return execAndReturnFirstDouble(s);
+      return execAndReturnFirstDouble("SELECT Value FROM tabulardatawithstrings WHERE ReportName=? AND ReportForString='Meter' AND "
+                                      "RowName=? AND ColumnName=? AND Units='J'",
+                                      reportname, rowname, columnname);
     }
 
     //TODO
@@ -955,28 +944,19 @@ namespace openstudio{
         " {AT MAX/MIN}";
       const std::string rowname = t_monthOfYear.valueDescription();
 
-      const std::string& s = "SELECT Value FROM tabulardatawithstrings WHERE \
-                              ReportName='" + reportname + "' and \
-                              ReportForString='Meter' AND \
-                              RowName='" + rowname + "' AND \
-                              ColumnName='" + columnname + "' AND \
-                              Units='W'";
-
-      return execAndReturnFirstDouble(s);
+      return execAndReturnFirstDouble("SELECT Value FROM tabulardatawithstrings WHERE ReportName=? AND ReportForString='Meter' AND "
+                                      "RowName=? AND ColumnName=? AND Units='W'",
+                                      reportname, rowname, columnname);
     }
 
     /// hours simulated
     boost::optional<double> SqlFile_Impl::hoursSimulated() const
     {
-      const std::string& s = "SELECT Value FROM tabulardatawithstrings WHERE \
-                              ReportName='InputVerificationandResultsSummary' AND \
-                              ReportForString='Entire Facility' AND \
-                              TableName='General' AND \
-                              RowName='Hours Simulated' AND \
-                              Units='hrs'";
-      boost::optional<double> ret = execAndReturnFirstDouble(s);
-
-      if (ret) return ret;
+      for (const auto& it : tabularDataTable("InputVerificationandResultsSummary", "Entire Facility", "General")) {
+        if ((it->first[3] == "Hours Simulated") && (it->first[5] == "hrs")) {
+          return it->second.value;
+        }
+      }
 
       // Otherwise, let's try to calculate it:
       return execAndReturnFirstDouble(
@@ -997,14 +977,7 @@ namespace openstudio{
         LOG(Warn, "Reporting Net Site Energy with " << *hours << " hrs");
       }
 
-      std::string s = "SELECT Value FROM tabulardatawithstrings WHERE \
-                              ReportName='AnnualBuildingUtilityPerformanceSummary' AND \
-                              ReportForString='Entire Facility' AND \
-                              TableName='Site and Source Energy' AND \
-                              RowName='Net Site Energy' AND \
-                              ColumnName='Total Energy' AND \
-                              Units='GJ'";
-      boost::optional<double> d = execAndReturnFirstDouble(s);
+      boost::optional<double> d = tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "Site and Source Energy", "Net Site Energy", "Total Energy", "GJ");
 
       if (!d) {
         LOG(Warn, "Tabular results were not found, trying to calculate it ourselves");
@@ -1028,14 +1001,7 @@ namespace openstudio{
         LOG(Warn, "Reporting Net Source Energy with " << *hours << " hrs");
       }
 
-      const std::string& s = "SELECT Value FROM tabulardatawithstrings WHERE \
-                              ReportName='AnnualBuildingUtilityPerformanceSummary' AND \
-                              ReportForString='Entire Facility' AND \
-                              TableName='Site and Source Energy' AND \
-                              RowName='Net Source Energy' AND \
-                              ColumnName='Total Energy' AND \
-                              Units='GJ'";
-      return execAndReturnFirstDouble(s);
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "Site and Source Energy", "Net Source Energy", "Total Energy", "GJ");
     }
 
 
@@ -1048,14 +1014,7 @@ namespace openstudio{
         LOG(Warn, "Reporting Total Site Energy with " << *hours << " hrs");
       }
 
-      const std::string& s = "SELECT Value FROM tabulardatawithstrings WHERE \
-                              ReportName='AnnualBuildingUtilityPerformanceSummary' AND \
-                              ReportForString='Entire Facility' AND \
-                              TableName='Site and Source Energy' AND \
-                              RowName='Total Site Energy' AND \
-                              ColumnName='Total Energy' AND \
-                              Units='GJ'";
-      return execAndReturnFirstDouble(s);
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "Site and Source Energy", "Total Site Energy", "Total Energy", "GJ");
     }
 
 
@@ -1068,24 +1027,17 @@ namespace openstudio{
         LOG(Warn, "Reporting Total Source Energy with " << *hours << " hrs");
       }
 
-      const std::string& s = "SELECT Value FROM tabulardatawithstrings WHERE \
-                              ReportName='AnnualBuildingUtilityPerformanceSummary' AND \
-                              ReportForString='Entire Facility' AND \
-                              TableName='Site and Source Energy' AND \
-                              RowName='Total Source Energy' AND \
-                              ColumnName='Total Energy' AND \
-                              Units='GJ'";
-      return execAndReturnFirstDouble(s);
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "Site and Source Energy", "Total Source Energy", "Total Energy", "GJ");
     }
 
 
     OptionalDouble SqlFile_Impl::annualTotalCost(const FuelType& fuel) const
     {
       if (fuel == FuelType::Electricity){
-        return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'Economics Results Summary Report') and (ReportForString = 'Entire Facility') and (TableName = 'Annual Cost') and (ColumnName ='Electric') and (((RowName = 'Cost') and (Units = '~~$~~')) or (RowName = 'Cost (~~$~~)'))");
+        return annualCostTableValue("Electric");
       }
       else if (fuel == FuelType::Gas){
-        return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'Economics Results Summary Report') and (ReportForString = 'Entire Facility') and (TableName = 'Annual Cost') and (ColumnName ='Gas') and (((RowName = 'Cost') and (Units = '~~$~~')) or (RowName = 'Cost (~~$~~)'))");
+        return annualCostTableValue("Gas");
       }
       else {
         // E+ lumps all other fuel types under "Other," so we are forced to use the meters table instead.
@@ -1123,13 +1075,22 @@ namespace openstudio{
           meterName = "ENERGYTRANSFER:FACILITY";
         }
 
-        auto rowName = execAndReturnFirstString("SELECT RowName FROM tabulardatawithstrings WHERE ReportName='Economics Results Summary Report' AND ReportForString='Entire Facility' AND TableName='Tariff Summary' AND Value='" + meterName + "'");
-        if (rowName){
-          return execAndReturnFirstDouble("SELECT Value FROM tabulardatawithstrings WHERE ReportName='Economics Results Summary Report' AND ReportForString='Entire Facility' AND TableName='Tariff Summary' AND RowName='" + rowName.get() + "' AND ColumnName='Annual Cost (~~$~~)'");
+        std::vector<TabularDataCache::const_iterator> tariffSummary = tabularDataTable("Economics Results Summary Report", "Entire Facility", "Tariff Summary");
+        boost::optional<std::string> rowName;
+        for (const auto& it : tariffSummary) {
+          if (it->second.text == meterName) {
+            rowName = it->first[3];
+            break;
+          }
         }
-        else {
-          return boost::none; // Return an empty optional double, indicating that there is no annual cost for this energy type
+        if (rowName){
+          for (const auto& it : tariffSummary) {
+            if ((it->first[3] == rowName.get()) && (it->first[4] == "Annual Cost (~~$~~)")) {
+              return it->second.value;
+            }
+          }
         }
+        return boost::none; // Return an empty optional double, indicating that there is no annual cost for this energy type
 
       }
 
@@ -1139,7 +1100,7 @@ namespace openstudio{
     OptionalDouble SqlFile_Impl::annualTotalCostPerBldgArea(const FuelType& fuel) const
     {
       // Get the total building area
-      boost::optional<double> totalBuildingArea = execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'Building Area') and (ColumnName = 'Area') and (RowName = 'Total Building Area') and (Units = 'm2')");
+      boost::optional<double> totalBuildingArea = tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "Building Area", "Total Building Area", "Area", "m2");
 
       // Get the annual energy cost
       boost::optional<double> annualEnergyCost = annualTotalCost(fuel);
@@ -1157,7 +1118,7 @@ namespace openstudio{
     OptionalDouble SqlFile_Impl::annualTotalCostPerNetConditionedBldgArea(const FuelType& fuel) const
     {
       // Get the total building area
-      boost::optional<double> totalBuildingArea = execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'Building Area') and (ColumnName = 'Area') and (RowName = 'Net Conditioned Building Area') and (Units = 'm2')");
+      boost::optional<double> totalBuildingArea = tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "Building Area", "Net Conditioned Building Area", "Area", "m2");
 
       // Get the annual energy cost
       boost::optional<double> annualEnergyCost = annualTotalCost(fuel);
@@ -1271,8 +1232,7 @@ namespace openstudio{
     boost::optional<EnvironmentType> SqlFile_Impl::environmentType(const std::string& envPeriod) const
     {
       boost::optional<EnvironmentType> result;
-      std::string query = "SELECT EnvironmentType FROM environmentperiods WHERE EnvironmentName='" + envPeriod + "' COLLATE NOCASE";
-      boost::optional<int> temp = execAndReturnFirstInt(query);
+      boost::optional<int> temp = execAndReturnFirstInt("SELECT EnvironmentType FROM environmentperiods WHERE EnvironmentName=? COLLATE NOCASE", envPeriod);
       if (temp){
         try{
           result = EnvironmentType(*temp);
@@ -1285,7 +1245,7 @@ namespace openstudio{
 
     OptionalDouble SqlFile_Impl::economicsEnergyCost() const
     {
-      return execAndReturnFirstDouble("SELECT * from tabulardatawithstrings where (reportname = 'Economics Results Summary Report') and (ReportForString = 'Entire Facility') and (TableName = 'Annual Cost') and (ColumnName ='Total') and (((RowName = 'Cost') and (Units = '~~$~~')) or (RowName = 'Cost (~~$~~)'))");
+      return annualCostTableValue("Total");
     }
 
     OptionalDouble SqlFile_Impl::getElecOrGasUse(bool bGetGas) const
@@ -1298,19 +1258,26 @@ namespace openstudio{
 
       std::string fuelType;
       if(bGetGas){
-        fuelType = "'COMM GAS'";
+        fuelType = "COMM GAS";
       }
       else{
-        fuelType = "'COMM ELECT'";
+        fuelType = "COMM ELECT";
+      }
+
+      selectedRowNames = std::vector<std::string>();
+      qualifiedRowNames = std::vector<std::string>();
+      fuelTypeRowNames = std::vector<std::string>();
+      for (const auto& it : tabularDataTable("Economics Results Summary Report", "Entire Facility", "Tariff Summary")) {
+        const std::string& columnName = it->first[4];
+        if ((columnName == "Selected") && (it->second.text == "Yes")) {
+          selectedRowNames->push_back(it->first[3]);
+        } else if ((columnName == "Qualified") && (it->second.text == "Yes")) {
+          qualifiedRowNames->push_back(it->first[3]);
+        } else if ((columnName == "Group") && (it->second.text == fuelType)) {
+          fuelTypeRowNames->push_back(it->first[3]);
+        }
       }
 
-      std::string query("select rowname from tabulardatawithstrings where TableName = 'Tariff Summary' and ColumnName = 'Group' and Value = ");
-      query += fuelType;
-
-      selectedRowNames = execAndReturnVectorOfString("select rowname from tabulardatawithstrings where TableName = 'Tariff Summary' and (ColumnName = 'Selected' and Value = 'Yes')");
-      qualifiedRowNames = execAndReturnVectorOfString("select rowname from tabulardatawithstrings where TableName = 'Tariff Summary' and (ColumnName = 'Qualified' and Value = 'Yes')");
-      fuelTypeRowNames = execAndReturnVectorOfString(query);
-
       if(!selectedRowNames || !qualifiedRowNames || !fuelTypeRowNames) return result;
 
       std::vector<std::string> names;
@@ -1333,10 +1300,8 @@ namespace openstudio{
       }
       if(name.size() == 0) return result;
 
-      query = "SELECT value from tabulardatawithstrings where ReportName = 'Tariff Report' and ReportForString = '";
-      query += name;
-      query +=  "' and TableName = 'Native Variables' and ColumnName = 'Sum' and RowName = 'TotalEnergy'";
-      result = execAndReturnFirstDouble(query);
+      result = execAndReturnFirstDouble("SELECT value from tabulardatawithstrings where ReportName = 'Tariff Report' and ReportForString = ? "
+                                        "and TableName = 'Native Variables' and ColumnName = 'Sum' and RowName = 'TotalEnergy'", name);
 
       return result;
     }
@@ -1346,16 +1311,13 @@ namespace openstudio{
     {
       std::string fuelType;
       if(bGetGas){
-        fuelType = "'Gas'";
+        fuelType = "Gas";
       }
       else{
-        fuelType = "'Electric'";
+        fuelType = "Electric";
       }
 
-      std::string query("select value from tabulardatawithstrings where TableName = 'Annual Cost' and (((RowName = 'Cost') and (Units = '~~$~~')) or (RowName = 'Cost (~~$~~)')) and ColumnName = ");
-      query += fuelType;
-
-      return execAndReturnFirstDouble(query);
+      return annualCostTableValue(fuelType);
     }
 
     boost::optional<EndUses> SqlFile_Impl::endUses() const
@@ -1366,10 +1328,8 @@ namespace openstudio{
         std::string units = result.getUnitsForFuelType(fuelType);
         for (EndUseCategoryType category : result.categories()){
 
-          std::string query = "SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='" + \
-                               fuelType.valueDescription() + "') and (RowName ='" + category.valueDescription() + "') and (Units = '" + units + "')";
-
-          boost::optional<double> value = execAndReturnFirstDouble(query);
+          boost::optional<double> value = tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses",
+                                                           category.valueDescription(), fuelType.valueDescription(), units);
           OS_ASSERT(value);
 
           if (*value != 0.0){
@@ -1385,464 +1345,464 @@ namespace openstudio{
 
     OptionalDouble SqlFile_Impl::electricityHeating() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Electricity') and (RowName = 'Heating') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Heating", "Electricity", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::electricityCooling() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Electricity') and (RowName = 'Cooling') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Cooling", "Electricity", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::electricityInteriorLighting() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Electricity') and (RowName = 'Interior Lighting') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Interior Lighting", "Electricity", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::electricityExteriorLighting() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Electricity') and (RowName = 'Exterior Lighting') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Exterior Lighting", "Electricity", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::electricityInteriorEquipment() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Electricity') and (RowName = 'Interior Equipment') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Interior Equipment", "Electricity", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::electricityExteriorEquipment() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Electricity') and (RowName = 'Exterior Equipment') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Exterior Equipment", "Electricity", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::electricityFans() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Electricity') and (RowName = 'Fans') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Fans", "Electricity", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::electricityPumps() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Electricity') and (RowName = 'Pumps') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Pumps", "Electricity", "GJ");
     }
 
 
     OptionalDouble SqlFile_Impl::electricityHeatRejection() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Electricity') and (RowName ='Heat Rejection') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Heat Rejection", "Electricity", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::electricityHumidification() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Electricity') and (RowName = 'Humidification') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Humidification", "Electricity", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::electricityHeatRecovery() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Electricity') and (RowName ='Heat Recovery') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Heat Recovery", "Electricity", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::electricityWaterSystems() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Electricity') and (RowName ='Water Systems') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Water Systems", "Electricity", "GJ");
     }
 
 
     OptionalDouble SqlFile_Impl::electricityRefrigeration() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Electricity') and (RowName ='Refrigeration') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Refrigeration", "Electricity", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::electricityGenerators() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Electricity') and (RowName ='Generators') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Generators", "Electricity", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::electricityTotalEndUses() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Electricity') and (RowName ='Total End Uses') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Total End Uses", "Electricity", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::naturalGasHeating() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Natural Gas') and (RowName ='Heating') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Heating", "Natural Gas", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::naturalGasCooling() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Natural Gas') and (RowName ='Cooling') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Cooling", "Natural Gas", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::naturalGasInteriorLighting() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Natural Gas') and (RowName ='Interior Lighting') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Interior Lighting", "Natural Gas", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::naturalGasExteriorLighting() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Natural Gas') and (RowName ='Exterior Lighting') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Exterior Lighting", "Natural Gas", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::naturalGasInteriorEquipment() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Natural Gas') and (RowName ='Interior Equipment') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Interior Equipment", "Natural Gas", "GJ");
     }
     OptionalDouble SqlFile_Impl::naturalGasExteriorEquipment() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Natural Gas') and (RowName ='Exterior Equipment') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Exterior Equipment", "Natural Gas", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::naturalGasFans() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Natural Gas') and (RowName ='Fans') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Fans", "Natural Gas", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::naturalGasPumps() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Natural Gas') and (RowName ='Pumps') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Pumps", "Natural Gas", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::naturalGasHeatRejection() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Natural Gas') and (RowName ='Heat Rejection') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Heat Rejection", "Natural Gas", "GJ");
     }
 
 
     OptionalDouble SqlFile_Impl::naturalGasHumidification() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Natural Gas') and (RowName ='Humidification') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Humidification", "Natural Gas", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::naturalGasHeatRecovery() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Natural Gas') and (RowName ='Heat Recovery') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Heat Recovery", "Natural Gas", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::naturalGasWaterSystems() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Natural Gas') and (RowName ='Water Systems') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Water Systems", "Natural Gas", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::naturalGasRefrigeration() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Natural Gas') and (RowName ='Refrigeration') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Refrigeration", "Natural Gas", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::naturalGasGenerators() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Natural Gas') and (RowName ='Generators') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Generators", "Natural Gas", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::naturalGasTotalEndUses() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Natural Gas') and (RowName ='Total End Uses') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Total End Uses", "Natural Gas", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::otherFuelHeating() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Additional Fuel') and (RowName ='Heating') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Heating", "Additional Fuel", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::otherFuelCooling() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Additional Fuel') and (RowName ='Cooling') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Cooling", "Additional Fuel", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::otherFuelInteriorLighting() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Additional Fuel') and (RowName ='Interior Lighting') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Interior Lighting", "Additional Fuel", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::otherFuelExteriorLighting() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Additional Fuel') and (RowName ='Exterior Lighting') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Exterior Lighting", "Additional Fuel", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::otherFuelInteriorEquipment() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Additional Fuel') and (RowName ='Interior Equipment') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Interior Equipment", "Additional Fuel", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::otherFuelExteriorEquipment() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Additional Fuel') and (RowName ='Exterior Equipment') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Exterior Equipment", "Additional Fuel", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::otherFuelFans() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Additional Fuel') and (RowName ='Fans') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Fans", "Additional Fuel", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::otherFuelPumps() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Additional Fuel') and (RowName ='Pumps') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Pumps", "Additional Fuel", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::otherFuelHeatRejection() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Additional Fuel') and (RowName ='Heat Rejection') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Heat Rejection", "Additional Fuel", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::otherFuelHumidification() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Additional Fuel') and (RowName ='Humidification') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Humidification", "Additional Fuel", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::otherFuelHeatRecovery() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Additional Fuel') and (RowName ='Heat Recovery') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Heat Recovery", "Additional Fuel", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::otherFuelWaterSystems() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Additional Fuel') and (RowName ='Water Systems') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Water Systems", "Additional Fuel", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::otherFuelRefrigeration() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Additional Fuel') and (RowName ='Refrigeration') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Refrigeration", "Additional Fuel", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::otherFuelGenerators() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Additional Fuel') and (RowName ='Generators') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Generators", "Additional Fuel", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::otherFuelTotalEndUses() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Additional Fuel') and (RowName ='Total End Uses') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Total End Uses", "Additional Fuel", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtCoolingHeating() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Cooling') and (RowName ='Heating') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Heating", "District Cooling", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtCoolingCooling() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Cooling') and (RowName ='Cooling') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Cooling", "District Cooling", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtCoolingInteriorLighting() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Cooling') and (RowName ='Interior Lighting') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Interior Lighting", "District Cooling", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtCoolingExteriorLighting() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Cooling') and (RowName ='Exterior Lighting') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Exterior Lighting", "District Cooling", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtCoolingInteriorEquipment() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Cooling') and (RowName ='Interior Equipment') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Interior Equipment", "District Cooling", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtCoolingExteriorEquipment() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Cooling') and (RowName ='Exterior Equipment') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Exterior Equipment", "District Cooling", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtCoolingFans() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Cooling') and (RowName ='Fans') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Fans", "District Cooling", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtCoolingPumps() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Cooling') and (RowName ='Pumps') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Pumps", "District Cooling", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtCoolingHeatRejection() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Cooling') and (RowName ='Heat Rejection') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Heat Rejection", "District Cooling", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtCoolingHumidification() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Cooling') and (RowName ='Humidification') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Humidification", "District Cooling", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtCoolingHeatRecovery() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Cooling') and (RowName ='Heat Recovery') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Heat Recovery", "District Cooling", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtCoolingWaterSystems() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Cooling') and (RowName ='Water Systems') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Water Systems", "District Cooling", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtCoolingRefrigeration() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Cooling') and (RowName ='Refrigeration') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Refrigeration", "District Cooling", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtCoolingGenerators() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Cooling') and (RowName ='Generators') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Generators", "District Cooling", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtCoolingTotalEndUses() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Cooling') and (RowName ='Total End Uses') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Total End Uses", "District Cooling", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtHeatingHeating() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Heating') and (RowName ='Heating') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Heating", "District Heating", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtHeatingCooling() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Heating') and (RowName ='Cooling') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Cooling", "District Heating", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtHeatingInteriorLighting() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Heating') and (RowName ='Interior Lights') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Interior Lights", "District Heating", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtHeatingExteriorLighting() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Heating') and (RowName ='Exterior Lights') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Exterior Lights", "District Heating", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtHeatingInteriorEquipment() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Heating') and (RowName ='Interior Equipment') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Interior Equipment", "District Heating", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtHeatingExteriorEquipment() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Heating') and (RowName ='Exterior Equipment') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Exterior Equipment", "District Heating", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtHeatingFans() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Heating') and (RowName ='Fans') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Fans", "District Heating", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtHeatingPumps() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Heating') and (RowName ='Pumps') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Pumps", "District Heating", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtHeatingHeatRejection() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Heating') and (RowName ='Heat Rejection') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Heat Rejection", "District Heating", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtHeatingHumidification() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Heating') and (RowName ='Humidification') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Humidification", "District Heating", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtHeatingHeatRecovery() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Heating') and (RowName ='Heat Recovery') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Heat Recovery", "District Heating", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtHeatingWaterSystems() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Heating') and (RowName ='Water Systems') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Water Systems", "District Heating", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtHeatingRefrigeration() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Heating') and (RowName ='Refrigeration') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Refrigeration", "District Heating", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtHeatingGenerators() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Heating') and (RowName ='Generators') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Generators", "District Heating", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::districtHeatingTotalEndUses() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='District Heating') and (RowName ='Total End Uses') and (Units = 'GJ')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Total End Uses", "District Heating", "GJ");
     }
 
     OptionalDouble SqlFile_Impl::waterHeating() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Water') and (RowName ='Heating') and (Units = 'm3')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Heating", "Water", "m3");
     }
 
     OptionalDouble SqlFile_Impl::waterCooling() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Water') and (RowName ='Cooling') and (Units = 'm3')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Cooling", "Water", "m3");
     }
 
     OptionalDouble SqlFile_Impl::waterInteriorLighting() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Water') and (RowName ='Interior Lighting') and (Units = 'm3')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Interior Lighting", "Water", "m3");
     }
 
     OptionalDouble SqlFile_Impl::waterExteriorLighting() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Water') and (RowName ='Exterior Lighting') and (Units = 'm3')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Exterior Lighting", "Water", "m3");
     }
 
     OptionalDouble SqlFile_Impl::waterInteriorEquipment() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Water') and (RowName ='Interior Equipment') and (Units = 'm3')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Interior Equipment", "Water", "m3");
     }
 
     OptionalDouble SqlFile_Impl::waterExteriorEquipment() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Water') and (RowName ='Exterior Equipment') and (Units = 'm3')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Exterior Equipment", "Water", "m3");
     }
 
     OptionalDouble SqlFile_Impl::waterFans() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Water') and (RowName ='Fans') and (Units = 'm3')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Fans", "Water", "m3");
     }
 
     OptionalDouble SqlFile_Impl::waterPumps() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Water') and (RowName ='Pumps') and (Units = 'm3')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Pumps", "Water", "m3");
     }
 
     OptionalDouble SqlFile_Impl::waterHeatRejection() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Water') and (RowName ='Heat Rejection') and (Units = 'm3')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Heat Rejection", "Water", "m3");
     }
 
     OptionalDouble SqlFile_Impl::waterHumidification() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Water') and (RowName ='Humidification') and (Units = 'm3')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Humidification", "Water", "m3");
     }
 
     OptionalDouble SqlFile_Impl::waterHeatRecovery() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Water') and (RowName ='Heat Recovery') and (Units = 'm3')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Heat Recovery", "Water", "m3");
     }
 
     OptionalDouble SqlFile_Impl::waterWaterSystems() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Water') and (RowName ='Water Systems') and (Units = 'm3')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Water Systems", "Water", "m3");
     }
 
     OptionalDouble SqlFile_Impl::waterRefrigeration() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Water') and (RowName ='Refrigeration') and (Units = 'm3')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Refrigeration", "Water", "m3");
     }
 
     OptionalDouble SqlFile_Impl::waterGenerators() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Water') and (RowName ='Generators') and (Units = 'm3')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Generators", "Water", "m3");
     }
 
     OptionalDouble SqlFile_Impl::waterTotalEndUses() const
     {
-      return execAndReturnFirstDouble("SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and (ReportForString = 'Entire Facility') and (TableName = 'End Uses'  ) and (ColumnName ='Water') and (RowName ='Total End Uses') and (Units = 'm3')");
+      return tabularDataValue("AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "End Uses", "Total End Uses", "Water", "m3");
     }
 
     OptionalDouble SqlFile_Impl::hoursHeatingSetpointNotMet() const
     {
-      return execAndReturnFirstDouble("SELECT Value FROM TabularDataWithStrings WHERE (ReportName='SystemSummary') AND (ReportForString='Entire Facility') AND (TableName='Time Setpoint Not Met') AND (RowName = 'Facility') AND (ColumnName='During Heating') AND (Units = 'hr')");
+      return tabularDataValue("SystemSummary", "Entire Facility", "Time Setpoint Not Met", "Facility", "During Heating", "hr");
     }
 
     OptionalDouble SqlFile_Impl::hoursCoolingSetpointNotMet() const
     {
-      return execAndReturnFirstDouble("SELECT Value FROM TabularDataWithStrings WHERE (ReportName='SystemSummary') AND (ReportForString='Entire Facility') AND (TableName='Time Setpoint Not Met') AND (RowName = 'Facility') AND (ColumnName='During Cooling') AND (Units = 'hr')");
+      return tabularDataValue("SystemSummary", "Entire Facility", "Time Setpoint Not Met", "Facility", "During Cooling", "hr");
     }
 
 
@@ -1928,186 +1888,369 @@ namespace openstudio{
       {
         s << " WHERE ReportVariableDataDictionaryIndex=";
       }
-      s << boost::lexical_cast<std::string>(iEpRfNKv->recordIndex);
+      s << "?";
       //    s << " AND ep.EnvironmentName=";
       //    s << "'" << envPeriod << "'";
-      s << " AND t.EnvironmentPeriodIndex=";
-      s << boost::lexical_cast<std::string>(iEpRfNKv->envPeriodIndex);
+      s << " AND t.EnvironmentPeriodIndex=?";
 
-      return execAndReturnFirstDouble(s.str());
+      return execAndReturnFirstDouble(s.str(), iEpRfNKv->recordIndex, iEpRfNKv->envPeriodIndex);
     }
 
     boost::optional<double> SqlFile_Impl::execAndReturnFirstDouble(const std::string& statement) const
     {
-      boost::optional<double> value;
-      if (m_db)
-      {
-        sqlite3_stmt* sqlStmtPtr;
+      sqlite3_stmt* sqlStmtPtr = prepareStatement(statement);
+      auto result = firstDouble(sqlStmtPtr);
+      // values are formatted into the text of these statements, so they are not reused
+      sqlite3_finalize(sqlStmtPtr);
+      return result;
+    }
 
-        int code = sqlite3_prepare_v2(m_db, statement.c_str(), -1, &sqlStmtPtr, nullptr);
+    boost::optional<int> SqlFile_Impl::execAndReturnFirstInt(const std::string& statement) const
+    {
+      sqlite3_stmt* sqlStmtPtr = prepareStatement(statement);
+      auto result = firstInt(sqlStmtPtr);
+      // values are formatted into the text of these statements, so they are not reused
+      sqlite3_finalize(sqlStmtPtr);
+      return result;
+    }
 
-        code = sqlite3_step(sqlStmtPtr);
-        if (code == SQLITE_ROW)
-        {
-          value = sqlite3_column_double(sqlStmtPtr, 0);
-        }
+    boost::optional<std::string> SqlFile_Impl::execAndReturnFirstString(const std::string& statement) const
+    {
+      sqlite3_stmt* sqlStmtPtr = prepareStatement(statement);
+      auto result = firstString(sqlStmtPtr);
+      // values are formatted into the text of these statements, so they are not reused
+      sqlite3_finalize(sqlStmtPtr);
+      return result;
+    }
 
-        // must finalize to prevent memory leaks
-        sqlite3_finalize(sqlStmtPtr);
-      }
-      return value;
+    boost::optional<std::vector<double> > SqlFile_Impl::execAndReturnVectorOfDouble(const std::string& statement) const
+    {
+      sqlite3_stmt* sqlStmtPtr = prepareStatement(statement);
+      auto result = vectorOfDouble(sqlStmtPtr);
+      // values are formatted into the text of these statements, so they are not reused
+      sqlite3_finalize(sqlStmtPtr);
+      return result;
     }
 
-    boost::optional<int> SqlFile_Impl::execAndReturnFirstInt(const std::string& statement) const
+    boost::optional<std::vector<int> > SqlFile_Impl::execAndReturnVectorOfInt(const std::string& statement) const
     {
-      boost::optional<int> value;
-      if (m_db)
-      {
-        sqlite3_stmt* sqlStmtPtr;
+      sqlite3_stmt* sqlStmtPtr = prepareStatement(statement);
+      auto result = vectorOfInt(sqlStmtPtr);
+      // values are formatted into the text of these statements, so they are not reused
+      sqlite3_finalize(sqlStmtPtr);
+      return result;
+    }
+
+    boost::optional<std::vector<std::string> > SqlFile_Impl::execAndReturnVectorOfString(const std::string& statement) const
+    {
+      sqlite3_stmt* sqlStmtPtr = prepareStatement(statement);
+      auto result = vectorOfString(sqlStmtPtr);
+      // values are formatted into the text of these statements, so they are not reused
+      sqlite3_finalize(sqlStmtPtr);
+      return result;
+    }
 
-        int code = sqlite3_prepare_v2(m_db, statement.c_str(), -1, &sqlStmtPtr, nullptr);
+    unsigned SqlFile_Impl::numCachedStatements() const
+    {
+      return m_statementCache.size();
+    }
 
-        code = sqlite3_step(sqlStmtPtr);
-        if (code == SQLITE_ROW)
-        {
-          value = sqlite3_column_int(sqlStmtPtr, 0);
-        }
+    sqlite3_stmt* SqlFile_Impl::prepareStatement(const std::string& statement) const
+    {
+      if (!m_connectionOpen) {
+        return nullptr;
+      }
 
-        // must finalize to prevent memory leaks
+      sqlite3_stmt* sqlStmtPtr = nullptr;
+      int code = sqlite3_prepare_v2(m_db, statement.c_str(), statement.size(), &sqlStmtPtr, nullptr);
+      if (code != SQLITE_OK || !sqlStmtPtr) {
+        LOG(Debug, "Unable to prepare statement '" << statement << "': " << sqlite3_errmsg(m_db));
         sqlite3_finalize(sqlStmtPtr);
+        return nullptr;
       }
-      return value;
+      return sqlStmtPtr;
     }
 
-    boost::optional<std::string> SqlFile_Impl::execAndReturnFirstString(const std::string& statement) const
+    sqlite3_stmt* SqlFile_Impl::cachedStatement(const std::string& statement) const
     {
-      boost::optional<std::string> value;
-      if (m_db)
-      {
-        sqlite3_stmt* sqlStmtPtr;
+      auto it = m_statementCacheIndex.find(statement);
+      if (it != m_statementCacheIndex.end()) {
+        m_statementCache.splice(m_statementCache.begin(), m_statementCache, it->second);
+        return it->second->second;
+      }
 
-        int code = sqlite3_prepare_v2(m_db, statement.c_str(), -1, &sqlStmtPtr, nullptr);
+      sqlite3_stmt* sqlStmtPtr = prepareStatement(statement);
+      if (!sqlStmtPtr) {
+        return nullptr;
+      }
 
-        code = sqlite3_step(sqlStmtPtr);
-        if (code == SQLITE_ROW)
-        {
-          value = columnText(sqlite3_column_text(sqlStmtPtr, 0));
-        }
+      // drop the least recently used statement rather than the whole cache
+      if (m_statementCache.size() >= 512) {
+        sqlite3_finalize(m_statementCache.back().second);
+        m_statementCacheIndex.erase(m_statementCache.back().first);
+        m_statementCache.pop_back();
+      }
+      m_statementCache.emplace_front(statement, sqlStmtPtr);
+      m_statementCacheIndex.insert(std::make_pair(statement, m_statementCache.begin()));
+      return sqlStmtPtr;
+    }
 
-        // must finalize to prevent memory leaks
-        sqlite3_finalize(sqlStmtPtr);
+    void SqlFile_Impl::clearStatementCache() const
+    {
+      for (auto& cached : m_statementCache) {
+        sqlite3_finalize(cached.second);
       }
-      return value;
+      m_statementCache.clear();
+      m_statementCacheIndex.clear();
     }
 
-    boost::optional<std::vector<double> > SqlFile_Impl::execAndReturnVectorOfDouble(const std::string& statement) const
+    void SqlFile_Impl::bindParameter(sqlite3_stmt* statement, int position, const std::string& value)
     {
-      boost::optional<double> value;
-      boost::optional<std::vector<double> > valueVector;
-      if (m_db)
+      sqlite3_bind_text(statement, position, value.c_str(), value.size(), SQLITE_TRANSIENT);
+    }
+
+    void SqlFile_Impl::bindParameter(sqlite3_stmt* statement, int position, const char* value)
+    {
+      sqlite3_bind_text(statement, position, value, -1, SQLITE_TRANSIENT);
+    }
+
+    void SqlFile_Impl::bindParameter(sqlite3_stmt* statement, int position, int value)
+    {
+      sqlite3_bind_int(statement, position, value);
+    }
+
+    void SqlFile_Impl::bindParameter(sqlite3_stmt* statement, int position, sqlite3_int64 value)
+    {
+      sqlite3_bind_int64(statement, position, value);
+    }
+
+    void SqlFile_Impl::bindParameter(sqlite3_stmt* statement, int position, double value)
+    {
+      sqlite3_bind_double(statement, position, value);
+    }
+
+    sqlite3_stmt* SqlFile_Impl::boundStatement(const std::string& statement, const std::vector<std::string>& parameters) const
+    {
+      sqlite3_stmt* result = cachedStatement(statement);
+      if (result) {
+        for (unsigned i = 0; i < parameters.size(); ++i) {
+          bindParameter(result, i + 1, parameters[i]);
+        }
+      }
+      return result;
+    }
+
+    namespace {
+
+      // reset a cached statement so it can be reused, clearing any bound parameters
+      void resetStatement(sqlite3_stmt* statement)
       {
-        sqlite3_stmt* sqlStmtPtr;
+        sqlite3_reset(statement);
+        sqlite3_clear_bindings(statement);
+      }
 
-        int code = sqlite3_prepare_v2(m_db, statement.c_str(), -1, &sqlStmtPtr, nullptr);
-        while ((code!= SQLITE_DONE) && (code != SQLITE_BUSY)&& (code != SQLITE_ERROR) && (code != SQLITE_MISUSE)  )//loop until SQLITE_DONE
+      // step through all rows of a statement, calling getter on each
+      template <typename T, typename Getter>
+      boost::optional<std::vector<T> > collectColumn(sqlite3_stmt* statement, Getter getter)
+      {
+        boost::optional<std::vector<T> > valueVector;
+        if (statement)
         {
-          if (!valueVector){
-            valueVector = std::vector<double>();
-          }
-
-          code = sqlite3_step(sqlStmtPtr);
-          if (code == SQLITE_ROW)
+          valueVector = std::vector<T>();
+          int code = sqlite3_step(statement);
+          while (code == SQLITE_ROW)
           {
-            value = sqlite3_column_double(sqlStmtPtr, 0);
-            valueVector->push_back(*value);
-          }
-          else  // i didn't get a row.  something is wrong so set the exit condition.
-          {     // should never get here since i test for all documented return states above
-            code = SQLITE_DONE;
+            valueVector->push_back(getter(statement));
+            code = sqlite3_step(statement);
           }
+          resetStatement(statement);
+        }
+        return valueVector;
+      }
 
-        }// end loop
+    }
 
-        // must finalize to prevent memory leaks
-        sqlite3_finalize(sqlStmtPtr);
+    boost::optional<double> SqlFile_Impl::firstDouble(sqlite3_stmt* statement) const
+    {
+      boost::optional<double> value;
+      if (statement)
+      {
+        if (sqlite3_step(statement) == SQLITE_ROW)
+        {
+          value = sqlite3_column_double(statement, 0);
+        }
+        resetStatement(statement);
       }
-
-      return valueVector;
+      return value;
     }
 
-    boost::optional<std::vector<int> > SqlFile_Impl::execAndReturnVectorOfInt(const std::string& statement) const
+    boost::optional<int> SqlFile_Impl::firstInt(sqlite3_stmt* statement) const
     {
       boost::optional<int> value;
-      boost::optional<std::vector<int> > valueVector;
-      if (m_db)
+      if (statement)
       {
-        sqlite3_stmt* sqlStmtPtr;
+        if (sqlite3_step(statement) == SQLITE_ROW)
+        {
+          value = sqlite3_column_int(statement, 0);
+        }
+        resetStatement(statement);
+      }
+      return value;
+    }
 
-        int code = sqlite3_prepare_v2(m_db, statement.c_str(), -1, &sqlStmtPtr, nullptr);
-        while ((code!= SQLITE_DONE) && (code != SQLITE_BUSY)&& (code != SQLITE_ERROR) && (code != SQLITE_MISUSE)  )//loop until SQLITE_DONE
+    boost::optional<std::string> SqlFile_Impl::firstString(sqlite3_stmt* statement) const
+    {
+      boost::optional<std::string> value;
+      if (statement)
+      {
+        if (sqlite3_step(statement) == SQLITE_ROW)
         {
-          if (!valueVector){
-            valueVector = std::vector<int>();
-          }
+          value = columnText(sqlite3_column_text(statement, 0));
+        }
+        resetStatement(statement);
+      }
+      return value;
+    }
 
-          code = sqlite3_step(sqlStmtPtr);
-          if (code == SQLITE_ROW)
-          {
-            value = sqlite3_column_int(sqlStmtPtr, 0);
-            valueVector->push_back(*value);
-          }
-          else  // i didn't get a row.  something is wrong so set the exit condition.
-          {     // should never get here since i test for all documented return states above
-            code = SQLITE_DONE;
-          }
+    boost::optional<std::vector<double> > SqlFile_Impl::vectorOfDouble(sqlite3_stmt* statement) const
+    {
+      return collectColumn<double>(statement, [](sqlite3_stmt* s) { return sqlite3_column_double(s, 0); });
+    }
 
-        }// end loop
+    boost::optional<std::vector<int> > SqlFile_Impl::vectorOfInt(sqlite3_stmt* statement) const
+    {
+      return collectColumn<int>(statement, [](sqlite3_stmt* s) { return sqlite3_column_int(s, 0); });
+    }
 
-        // must finalize to prevent memory leaks
-        sqlite3_finalize(sqlStmtPtr);
+    boost::optional<std::vector<std::string> > SqlFile_Impl::vectorOfString(sqlite3_stmt* statement) const
+    {
+      return collectColumn<std::string>(statement, [](sqlite3_stmt* s) { return columnText(sqlite3_column_text(s, 0)); });
+    }
+
+    boost::optional<double> SqlFile_Impl::tabularDataValue(const std::string& reportName, const std::string& reportForString,
+                                                           const std::string& tableName, const std::string& rowName,
+                                                           const std::string& columnName, const std::string& units) const
+    {
+      if (isCachedTabularData(reportName, tableName)) {
+        const TabularDataCache& cache = tabularDataCache();
+        auto it = cache.find(TabularDataKey{{reportName, reportForString, tableName, rowName, columnName, units}});
+        if (it != cache.end()) {
+          return it->second.value;
+        }
+        return boost::none;
       }
 
-      return valueVector;
+      return execAndReturnFirstDouble("SELECT Value FROM tabulardatawithstrings WHERE ReportName=? AND ReportForString=? AND TableName=? "
+                                      "AND RowName=? AND ColumnName=? AND Units=?",
+                                      reportName, reportForString, tableName, rowName, columnName, units);
     }
 
-    boost::optional<std::vector<std::string> > SqlFile_Impl::execAndReturnVectorOfString(const std::string& statement) const
-    {
-      boost::optional<std::string> value;
-      boost::optional<std::vector<std::string> > valueVector;
-      if (m_db)
+    namespace {
+
+      // reports and tables held in the tabular data cache, an empty table name caches the whole report
+      const std::pair<const char*, const char*> cachedTabularData[] = {
+        {"AnnualBuildingUtilityPerformanceSummary", ""},
+        {"Economics Results Summary Report", ""},
+        {"Initialization Summary", "Component Sizing Information"},
+        {"InputVerificationandResultsSummary", "General"},
+        {"SystemSummary", "Time Setpoint Not Met"}
+      };
+
+      std::string nullableColumnText(sqlite3_stmt* statement, int column)
       {
-        sqlite3_stmt* sqlStmtPtr;
+        const unsigned char* text = sqlite3_column_text(statement, column);
+        return text ? columnText(text) : std::string();
+      }
 
-        int code = sqlite3_prepare_v2(m_db, statement.c_str(), -1, &sqlStmtPtr, nullptr);
-        while ((code!= SQLITE_DONE) && (code != SQLITE_BUSY)&& (code != SQLITE_ERROR) && (code != SQLITE_MISUSE)  )//loop until SQLITE_DONE
-        {
-          if (!valueVector){
-            valueVector = std::vector<std::string>();
-          }
+    }
 
-          code = sqlite3_step(sqlStmtPtr);
-          if (code == SQLITE_ROW)
-          {
-            value = columnText(sqlite3_column_text(sqlStmtPtr, 0));
-            valueVector->push_back(*value);
-          }
-          else  // i didn't get a row.  something is wrong so set the exit condition.
-          {     // should never get here since i test for all documented return states above
-            code = SQLITE_DONE;
+    bool SqlFile_Impl::isCachedTabularData(const std::string& reportName, const std::string& tableName)
+    {
+      for (const auto& cached : cachedTabularData) {
+        if ((reportName == cached.first) && ((*cached.second == '\0') || (tableName == cached.second))) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    const SqlFile_Impl::TabularDataCache& SqlFile_Impl::tabularDataCache() const
+    {
+      if (m_tabularDataCache) {
+        return *m_tabularDataCache;
+      }
+
+      m_tabularDataCache = TabularDataCache();
+
+      std::string statement = "SELECT ReportName, ReportForString, TableName, RowName, ColumnName, Units, Value FROM tabulardatawithstrings WHERE ";
+      std::vector<std::string> parameters;
+      for (const auto& cached : cachedTabularData) {
+        if (!parameters.empty()) {
+          statement += " OR ";
+        }
+        parameters.push_back(cached.first);
+        if (*cached.second == '\0') {
+          statement += "(ReportName=?)";
+        } else {
+          statement += "(ReportName=? AND TableName=?)";
+          parameters.push_back(cached.second);
+        }
+      }
+
+      sqlite3_stmt* sqlStmtPtr = boundStatement(statement, parameters);
+      if (sqlStmtPtr) {
+        while (sqlite3_step(sqlStmtPtr) == SQLITE_ROW) {
+          TabularDataKey key;
+          for (int i = 0; i < 6; ++i) {
+            key[i] = nullableColumnText(sqlStmtPtr, i);
           }
+          // keep the first cell for a key, as the queries this cache replaces did
+          m_tabularDataCache->emplace(std::move(key), TabularDataCell{sqlite3_column_double(sqlStmtPtr, 6), nullableColumnText(sqlStmtPtr, 6)});
+        }
+        resetStatement(sqlStmtPtr);
+      }
 
-        }// end loop
-        // must finalize to prevent memory leaks
-        sqlite3_finalize(sqlStmtPtr);
+      LOG(Debug, "Loaded " << m_tabularDataCache->size() << " cells of tabular data");
+
+      return *m_tabularDataCache;
+    }
+
+    std::vector<SqlFile_Impl::TabularDataCache::const_iterator> SqlFile_Impl::tabularDataTable(const std::string& reportName,
+                                                                                               const std::string& reportForString,
+                                                                                               const std::string& tableName) const
+    {
+      std::vector<TabularDataCache::const_iterator> result;
+      const TabularDataCache& cache = tabularDataCache();
+      for (auto it = cache.lower_bound(TabularDataKey{{reportName, reportForString, tableName, "", "", ""}}); it != cache.end(); ++it) {
+        if ((it->first[0] != reportName) || (it->first[1] != reportForString) || (it->first[2] != tableName)) {
+          break;
+        }
+        result.push_back(it);
       }
-      return valueVector;
+      return result;
+    }
+
+    void SqlFile_Impl::clearTabularDataCache() const
+    {
+      m_tabularDataCache.reset();
     }
 
+    boost::optional<double> SqlFile_Impl::annualCostTableValue(const std::string& columnName) const
+    {
+      for (const auto& it : tabularDataTable("Economics Results Summary Report", "Entire Facility", "Annual Cost")) {
+        const TabularDataKey& key = it->first;
+        if ((key[4] == columnName) && (((key[3] == "Cost") && (key[5] == "~~$~~")) || (key[3] == "Cost (~~$~~)"))) {
+          return it->second.value;
+        }
+      }
+      return boost::none;
+    }
 
     // execute a statement and return the error code, used for create/drop tables
     int SqlFile_Impl::execute(const std::string& statement)
     {
       int code = SQLITE_ERROR;
+      clearTabularDataCache();
       if (m_db)
       {
         sqlite3_stmt* sqlStmtPtr;
@@ -2142,19 +2285,20 @@ namespace openstudio{
         {
           s << " WHERE rvd.ReportVariableDataDictionaryIndex=";
         }
-        s << boost::lexical_cast<std::string>(dataDictionary.recordIndex);
+        s << "?";
         //      s << " AND ep.EnvironmentName = ";
         //      s << "'" << dataDictionary.envPeriod << "'";
-        s << " AND ti.EnvironmentPeriodIndex = ";
-        s << boost::lexical_cast<std::string>(dataDictionary.envPeriodIndex);
+        s << " AND ti.EnvironmentPeriodIndex = ?";
         // assume that timeindices.timeIndex are ordered from start to end
         //      s << " ORDER BY ti.TimeIndex";
 
-        sqlite3_stmt* sqlStmtPtr;
-
-        int code = sqlite3_prepare_v2(m_db, s.str().c_str(), -1, &sqlStmtPtr, nullptr);
+        // the statement text only depends on the table, so it is shared by every variable in that table
+        sqlite3_stmt* sqlStmtPtr = boundStatement(s.str(), dataDictionary.recordIndex, dataDictionary.envPeriodIndex);
+        if (!sqlStmtPtr) {
+          return stdValues;
+        }
 
-        code = sqlite3_step(sqlStmtPtr);
+        int code = sqlite3_step(sqlStmtPtr);
         std::stringstream s2;
         s2 << "SQL Query:" << std::endl;
         s2 << s.str();
@@ -2167,7 +2311,7 @@ namespace openstudio{
 
           code = sqlite3_step(sqlStmtPtr);
         }
-        sqlite3_finalize(sqlStmtPtr);
+        resetStatement(sqlStmtPtr);
       }
 
       LOG(Debug, "Created Timeseries with " << stdValues.size() << " values");
@@ -2424,34 +2568,92 @@ namespace openstudio{
     }
 
 
+    SqlFile_Impl::ReportTimeAxis::ReportTimeAxis(const std::string& t_reportingFrequency, int t_envPeriodIndex, bool t_energyPlus83)
+      : frequency(ReportingFrequency::RunPeriod), envPeriodIndex(t_envPeriodIndex), energyPlus83(t_energyPlus83),
+        isIntervalTimeSeries(false), cumulativeSeconds(0)
+    {
+      try {
+        frequency = ReportingFrequency(t_reportingFrequency);
+        isIntervalTimeSeries = (frequency == ReportingFrequency::Timestep) ||
+                               (frequency == ReportingFrequency::Hourly) ||
+                               (frequency == ReportingFrequency::Daily);
+
+      }catch(const std::exception&){
+      }
+    }
+
+    void SqlFile_Impl::addReportTime(ReportTimeAxis& axis, const boost::optional<unsigned>& year, unsigned month, unsigned day, unsigned intervalMinutes)
+    {
+      if (axis.frequency == ReportingFrequency::Annual){
+        intervalMinutes = 8760; // used for annual periods
+      }
+
+      if (axis.energyPlus83){
+        // workaround for bug in E+ 8.3, issue #1692
+        if (axis.frequency == ReportingFrequency::Daily){
+          intervalMinutes = 24 * 60;
+        } else if (axis.frequency == ReportingFrequency::Monthly){
+          intervalMinutes = day * 24 * 60;
+        } else if (axis.frequency == ReportingFrequency::RunPeriod){
+          DateTime firstDateTime = this->firstDateTime(false, axis.envPeriodIndex);
+          DateTime lastDateTime = this->lastDateTime(false, axis.envPeriodIndex);
+          Time deltaT = lastDateTime - firstDateTime;
+          intervalMinutes = (unsigned)deltaT.totalMinutes() + 60;
+        }
+      }
+
+      if (!axis.firstReportDateTime){
+        if ((month==0) || (day==0)){
+          // gets called for RunPeriod reports
+          axis.firstReportDateTime = lastDateTime(false, axis.envPeriodIndex);
+        } else{
+          // DLM: get standard time zone?
+          if (intervalMinutes >= 24 * 60){
+            // Daily or Monthly
+            OS_ASSERT(intervalMinutes % (24 * 60) == 0);
+            axis.firstReportDateTime = year
+              ? openstudio::DateTime(openstudio::Date(month, day, *year), openstudio::Time(1, 0, 0, 0))
+              : openstudio::DateTime(openstudio::Date(month, day), openstudio::Time(1, 0, 0, 0));
+          } else {
+            axis.firstReportDateTime = year
+              ? openstudio::DateTime(openstudio::Date(month, day, *year), openstudio::Time(0, 0, intervalMinutes, 0))
+              : openstudio::DateTime(openstudio::Date(month, day), openstudio::Time(0, 0, intervalMinutes, 0));
+          }
+
+        }
+      }
+
+      // Use the new way to create the time series with nonzero first entry
+      axis.cumulativeSeconds += 60*intervalMinutes;
+      axis.secondsFromStart.push_back(axis.cumulativeSeconds);
+
+      // check if this interval is same as the others
+      if (axis.isIntervalTimeSeries && !axis.reportingIntervalMinutes){
+        axis.reportingIntervalMinutes = intervalMinutes;
+      }else if (axis.reportingIntervalMinutes && (axis.reportingIntervalMinutes.get() != intervalMinutes)){
+        axis.isIntervalTimeSeries = false;
+        axis.reportingIntervalMinutes.reset();
+      }
+    }
+
+    bool SqlFile_Impl::isEnergyPlus83() const
+    {
+      VersionString version(energyPlusVersion());
+      return (version.major() == 8) && (version.minor() == 3);
+    }
+
     openstudio::OptionalTimeSeries SqlFile_Impl::timeSeries(const DataDictionaryItem& dataDictionary)
     {
       openstudio::OptionalTimeSeries ts;
       std::string units = dataDictionary.units;
 
-      boost::optional<openstudio::DateTime> firstReportDateTime;
-      std::vector<long> stdSecondsFromFirstReport;
-      stdSecondsFromFirstReport.reserve(8760);
-
       std::vector<double> stdValues;
       stdValues.reserve(8760);
-      boost::optional<unsigned> reportingIntervalMinutes;
-
-      ReportingFrequency reportingFrequency(ReportingFrequency::RunPeriod);
-      bool isIntervalTimeSeries = false;
-      try {
-        reportingFrequency = ReportingFrequency(dataDictionary.reportingFrequency);
-        isIntervalTimeSeries = (reportingFrequency == ReportingFrequency::Timestep) ||
-                               (reportingFrequency == ReportingFrequency::Hourly) ||
-                               (reportingFrequency == ReportingFrequency::Daily);
-
-      }catch(const std::exception&){
-      }
 
       if (m_db)
       {
-        std::string energyPlusVersion = this->energyPlusVersion();
-        VersionString version(energyPlusVersion);
+        ReportTimeAxis axis(dataDictionary.reportingFrequency, dataDictionary.envPeriodIndex, isEnergyPlus83());
+        axis.secondsFromStart.reserve(8760);
 
         std::stringstream s;
         // v8.9.0 added the 'Year' field
@@ -2489,8 +2691,6 @@ namespace openstudio{
         s2 << code;
         LOG(Debug, s2.str());
 
-        long cumulativeSeconds = 0;
-
         while (code == SQLITE_ROW)
         {
           int b = 0;
@@ -2505,77 +2705,251 @@ namespace openstudio{
           unsigned month = sqlite3_column_int(sqlStmtPtr, b++);
           unsigned day = sqlite3_column_int(sqlStmtPtr, b++);
           unsigned intervalMinutes = sqlite3_column_int(sqlStmtPtr, b++); // used for run periods
-          if (reportingFrequency == ReportingFrequency::Annual){
-            intervalMinutes = 8760; // used for annual periods
-          }
+          addReportTime(axis, year, month, day, intervalMinutes);
 
-          if ((version.major() == 8) && (version.minor() == 3)){
-            // workaround for bug in E+ 8.3, issue #1692
-            if (reportingFrequency == ReportingFrequency::Daily){
-              intervalMinutes = 24 * 60;
-            } else if (reportingFrequency == ReportingFrequency::Monthly){
-              intervalMinutes = day * 24 * 60;
-            } else if (reportingFrequency == ReportingFrequency::RunPeriod){
-              DateTime firstDateTime = this->firstDateTime(false, dataDictionary.envPeriodIndex);
-              DateTime lastDateTime = this->lastDateTime(false, dataDictionary.envPeriodIndex);
-              Time deltaT = lastDateTime - firstDateTime;
-              intervalMinutes = (unsigned)deltaT.totalMinutes() + 60;
-            }
+          // step to next row
+          code = sqlite3_step(sqlStmtPtr);
+        }
+
+        // must finalize to prevent memory leaks
+        sqlite3_finalize(sqlStmtPtr);
+
+        if (axis.firstReportDateTime && !axis.secondsFromStart.empty()){
+          if (axis.isIntervalTimeSeries){
+            openstudio::Time intervalTime(0,0,*axis.reportingIntervalMinutes,0);
+            openstudio::Vector values = createVector(stdValues);
+            ts = openstudio::TimeSeries(*axis.firstReportDateTime, intervalTime, values, units);
+          }else{
+            openstudio::Vector values = createVector(stdValues);
+            ts = openstudio::TimeSeries(*axis.firstReportDateTime, axis.secondsFromStart, values, units);
           }
+        }
+      }
 
-          if (!firstReportDateTime){
-            if ((month==0) || (day==0)){
-              // gets called for RunPeriod reports
-              firstReportDateTime = lastDateTime(false, dataDictionary.envPeriodIndex);
-            } else{
-              // DLM: get standard time zone?
-              if (intervalMinutes >= 24 * 60){
-                // Daily or Monthly
-                OS_ASSERT(intervalMinutes % (24 * 60) == 0);
-                firstReportDateTime = year
-                  ? openstudio::DateTime(openstudio::Date(month, day, *year), openstudio::Time(1, 0, 0, 0))
-                  : openstudio::DateTime(openstudio::Date(month, day), openstudio::Time(1, 0, 0, 0));
-              } else {
-                firstReportDateTime = year
-                  ? openstudio::DateTime(openstudio::Date(month, day, *year), openstudio::Time(0, 0, intervalMinutes, 0))
-                  : openstudio::DateTime(openstudio::Date(month, day), openstudio::Time(0, 0, intervalMinutes, 0));
-              }
+      return ts;
+    }
 
+    SqlFileTimeSeriesBlock SqlFile_Impl::timeSeriesBlock(const std::string& envPeriod, const std::string& reportingFrequency,
+                                                         const std::vector<std::string>& timeSeriesNames, const std::vector<std::string>& keyValues)
+    {
+      std::string queryEnvPeriod = boost::to_upper_copy(envPeriod);
+
+      // find the requested series in the data dictionary, trying the database name of the reporting frequency if needed
+      std::vector<DataDictionaryItem> items;
+      auto findItems = [&](const std::string& frequency) {
+        const auto& index = m_dataDictionary.get<envPeriodReportingFrequencyNameKeyValue>();
+        for (const std::string& timeSeriesName : timeSeriesNames) {
+          if (keyValues.empty()) {
+            auto range = index.equal_range(boost::make_tuple(queryEnvPeriod, frequency, timeSeriesName));
+            items.insert(items.end(), range.first, range.second);
+            continue;
+          }
+          for (const std::string& keyValue : keyValues) {
+            boost::optional<DataDictionaryItem> item = findDataDictionaryItem(queryEnvPeriod, frequency, timeSeriesName, keyValue);
+            if (item) {
+              items.push_back(*item);
             }
           }
+        }
+      };
+
+      std::string frequency = reportingFrequency;
+      findItems(frequency);
+      if (items.empty()) {
+        openstudio::OptionalReportingFrequency freq = reportingFrequencyFromDB(reportingFrequency);
+        if (freq && (freq->valueDescription() != reportingFrequency)) {
+          frequency = freq->valueDescription();
+          findItems(frequency);
+        }
+      }
+
+      // a series requested twice, e.g. with key values differing only in case, gets one column
+      std::set<std::pair<std::string, int> > requested;
+      items.erase(std::remove_if(items.begin(), items.end(), [&requested](const DataDictionaryItem& item) {
+                    return !requested.insert(std::make_pair(item.table, item.recordIndex)).second;
+                  }),
+                  items.end());
 
-          // Use the new way to create the time series with nonzero first entry
-          cumulativeSeconds += 60*intervalMinutes;
-          stdSecondsFromFirstReport.push_back(cumulativeSeconds);
+      std::vector<std::string> names, itemKeyValues, units;
+      std::vector<std::vector<double> > values(items.size());
+      boost::optional<DateTime> firstReportDateTime;
+      std::vector<long> secondsFromStart;
+      boost::optional<Time> intervalLength;
 
-          // check if this interval is same as the others
-          if (isIntervalTimeSeries && !reportingIntervalMinutes){
-            reportingIntervalMinutes = intervalMinutes;
-          }else if (reportingIntervalMinutes && (reportingIntervalMinutes.get() != intervalMinutes)){
-            isIntervalTimeSeries = false;
-            reportingIntervalMinutes.reset();
+      if (m_db && !items.empty())
+      {
+        ReportTimeAxis axis(frequency, items.front().envPeriodIndex, isEnergyPlus83());
+
+        // one scan of the report data for all of the series, meters and variables may be held in different tables
+        std::map<std::pair<bool, int>, unsigned> columns;
+        std::stringstream meterIndices, variableIndices;
+        for (unsigned column = 0; column < items.size(); ++column) {
+          const DataDictionaryItem& item = items[column];
+          bool isMeter = (item.table == "ReportMeterData");
+          columns[std::make_pair(isMeter, item.recordIndex)] = column;
+          std::stringstream& indices = isMeter ? meterIndices : variableIndices;
+          if (!indices.str().empty()) {
+            indices << ", ";
           }
+          indices << item.recordIndex;
+          names.push_back(item.name);
+          itemKeyValues.push_back(item.keyValue);
+          units.push_back(item.units);
+        }
 
-          // step to next row
-          code = sqlite3_step(sqlStmtPtr);
+        std::string timeColumns = std::string(hasYear() ? "Time.Year, " : "") + "Time.Month, Time.Day, Time.Interval";
+        std::stringstream s;
+        if (!variableIndices.str().empty()) {
+          s << "SELECT dt.TimeIndex, 0, dt.ReportVariableDataDictionaryIndex, dt.VariableValue, " << timeColumns
+            << " FROM ReportVariableData dt INNER JOIN Time ON Time.TimeIndex = dt.TimeIndex"
+            << " WHERE Time.EnvironmentPeriodIndex = " << axis.envPeriodIndex
+            << " AND dt.ReportVariableDataDictionaryIndex IN (" << variableIndices.str() << ")";
+        }
+        if (!meterIndices.str().empty()) {
+          if (!variableIndices.str().empty()) {
+            s << " UNION ALL ";
+          }
+          s << "SELECT dt.TimeIndex, 1, dt.ReportMeterDataDictionaryIndex, dt.VariableValue, " << timeColumns
+            << " FROM ReportMeterData dt INNER JOIN Time ON Time.TimeIndex = dt.TimeIndex"
+            << " WHERE Time.EnvironmentPeriodIndex = " << axis.envPeriodIndex
+            << " AND dt.ReportMeterDataDictionaryIndex IN (" << meterIndices.str() << ")";
         }
+        s << " ORDER BY 1";
 
-        // must finalize to prevent memory leaks
-        sqlite3_finalize(sqlStmtPtr);
+        // the index lists differ from call to call, so the statement is not cached
+        sqlite3_stmt* sqlStmtPtr = nullptr;
+        int code = sqlite3_prepare_v2(m_db, s.str().c_str(), -1, &sqlStmtPtr, nullptr);
+        if (code == SQLITE_OK) {
+          boost::optional<int> timeIndex;
+          code = sqlite3_step(sqlStmtPtr);
+          while (code == SQLITE_ROW)
+          {
+            int rowTimeIndex = sqlite3_column_int(sqlStmtPtr, 0);
+            if (!timeIndex || (*timeIndex != rowTimeIndex)) {
+              // a new report, add it to the time axis and start a row of missing values
+              timeIndex = rowTimeIndex;
+              int b = 4;
+              boost::optional<unsigned> year;
+              if (hasYear()) {
+                year = sqlite3_column_int(sqlStmtPtr, b++);
+              }
+              unsigned month = sqlite3_column_int(sqlStmtPtr, b++);
+              unsigned day = sqlite3_column_int(sqlStmtPtr, b++);
+              unsigned intervalMinutes = sqlite3_column_int(sqlStmtPtr, b++);
+              addReportTime(axis, year, month, day, intervalMinutes);
+              for (std::vector<double>& columnValues : values) {
+                columnValues.push_back(std::numeric_limits<double>::quiet_NaN());
+              }
+            }
 
-        if (firstReportDateTime && !stdSecondsFromFirstReport.empty()){
-          if (isIntervalTimeSeries){
-            openstudio::Time intervalTime(0,0,*reportingIntervalMinutes,0);
-            openstudio::Vector values = createVector(stdValues);
-            ts = openstudio::TimeSeries(*firstReportDateTime, intervalTime, values, units);
-          }else{
-            openstudio::Vector values = createVector(stdValues);
-            ts = openstudio::TimeSeries(*firstReportDateTime, stdSecondsFromFirstReport, values, units);
+            auto column = columns.find(std::make_pair(sqlite3_column_int(sqlStmtPtr, 1) != 0, sqlite3_column_int(sqlStmtPtr, 2)));
+            if (column != columns.end()) {
+              values[column->second].back() = sqlite3_column_double(sqlStmtPtr, 3);
+            }
+
+            code = sqlite3_step(sqlStmtPtr);
           }
+        } else {
+          LOG(Error, "Could not read time series block: " << sqlite3_errmsg(m_db));
         }
+        sqlite3_finalize(sqlStmtPtr);
+
+        LOG(Debug, "Read " << axis.secondsFromStart.size() << " reports of " << items.size() << " time series in one query");
+
+        firstReportDateTime = axis.firstReportDateTime;
+        secondsFromStart = std::move(axis.secondsFromStart);
+        if (axis.isIntervalTimeSeries && axis.reportingIntervalMinutes) {
+          intervalLength = openstudio::Time(0, 0, *axis.reportingIntervalMinutes, 0);
+        }
+      } else {
+        values.clear();
       }
 
-      return ts;
+      return SqlFileTimeSeriesBlock(envPeriod, frequency, firstReportDateTime, std::move(secondsFromStart), intervalLength,
+                                    std::move(names), std::move(itemKeyValues), std::move(units), std::move(values));
+    }
+
+    boost::optional<DataDictionaryItem> SqlFile_Impl::findDataDictionaryItem(const std::string& queryEnvPeriod, const std::string& reportingFrequency,
+                                                                            const std::string& timeSeriesName, const std::string& keyValue) const
+    {
+      boost::optional<DataDictionaryItem> result;
+      const auto& index = m_dataDictionary.get<envPeriodReportingFrequencyNameKeyValue>();
+      auto it = index.find(boost::make_tuple(queryEnvPeriod, reportingFrequency, timeSeriesName, keyValue));
+      if (it == index.end()) {
+        it = index.find(boost::make_tuple(queryEnvPeriod, reportingFrequency, timeSeriesName, boost::to_upper_copy(keyValue)));
+      }
+      if (it != index.end()) {
+        result = *it;
+      }
+      return result;
+    }
+
+    boost::optional<DataDictionaryItem> SqlFile_Impl::dataDictionaryItem(const std::string& envPeriod, const std::string& reportingFrequency,
+                                                                        const std::string& timeSeriesName, const std::string& keyValue)
+    {
+      std::string queryEnvPeriod = boost::to_upper_copy(envPeriod);
+      boost::optional<DataDictionaryItem> result = findDataDictionaryItem(queryEnvPeriod, reportingFrequency, timeSeriesName, keyValue);
+      if (!result) {
+        openstudio::OptionalReportingFrequency freq = reportingFrequencyFromDB(reportingFrequency);
+        if (freq && (freq->valueDescription() != reportingFrequency)) {
+          result = findDataDictionaryItem(queryEnvPeriod, freq->valueDescription(), timeSeriesName, keyValue);
+        }
+      }
+      return result;
+    }
+
+    void SqlFile_Impl::timeSeriesChunk(const std::string& table, int recordIndex, int envPeriodIndex, unsigned chunkSize, sqlite3_int64& lastRowId,
+                                       std::vector<double>& values, std::vector<DateTime>& dateTimes)
+    {
+      if (!m_db || ((table != "ReportMeterData") && (table != "ReportVariableData"))) {
+        return;
+      }
+
+      // page through the series by row id, which follows report order, so no statement is held open between chunks
+      std::stringstream s;
+      s << "SELECT dt.rowid, dt.VariableValue, ";
+      if (hasYear()) {
+        s << "Time.Year, ";
+      }
+      s << "Time.Month, Time.Day, Time.Hour, Time.Minute FROM ";
+      s << table;
+      s << " dt INNER JOIN Time ON Time.TimeIndex = dt.TimeIndex WHERE ";
+      if (table == "ReportMeterData") {
+        s << "dt.ReportMeterDataDictionaryIndex=?";
+      } else {
+        s << "dt.ReportVariableDataDictionaryIndex=?";
+      }
+      s << " AND Time.EnvironmentPeriodIndex=? AND dt.rowid>? ORDER BY dt.rowid LIMIT ?";
+
+      sqlite3_stmt* sqlStmtPtr = boundStatement(s.str(), recordIndex, envPeriodIndex, lastRowId, static_cast<int>(chunkSize));
+      if (!sqlStmtPtr) {
+        return;
+      }
+
+      while (sqlite3_step(sqlStmtPtr) == SQLITE_ROW)
+      {
+        int b = 0;
+        lastRowId = sqlite3_column_int64(sqlStmtPtr, b++);
+        values.push_back(sqlite3_column_double(sqlStmtPtr, b++));
+
+        boost::optional<unsigned> year;
+        if (hasYear()) {
+          year = sqlite3_column_int(sqlStmtPtr, b++);
+        }
+        unsigned month = sqlite3_column_int(sqlStmtPtr, b++);
+        unsigned day = sqlite3_column_int(sqlStmtPtr, b++);
+        unsigned hour = sqlite3_column_int(sqlStmtPtr, b++);
+        unsigned minute = sqlite3_column_int(sqlStmtPtr, b++);
+
+        // run period reports have no month or day, date them at the end of the environment period as addReportTime does
+        if ((month == 0) || (day == 0)) {
+          dateTimes.push_back(lastDateTime(false, envPeriodIndex));
+        } else {
+          openstudio::Date date = year ? openstudio::Date(monthOfYear(month), day, *year) : openstudio::Date(monthOfYear(month), day);
+          dateTimes.push_back(openstudio::DateTime(date, openstudio::Time(0, hour, minute, 0)));
+        }
+      }
+      resetStatement(sqlStmtPtr);
     }
 
     openstudio::DateTimeVector SqlFile_Impl::dateTimeVec(const DataDictionaryItem& dataDictionary)
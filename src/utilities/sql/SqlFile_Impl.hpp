@@ -36,6 +36,7 @@
 #include "SummaryData.hpp"
 #include "SqlFileEnums.hpp"
 #include "SqlFileDataDictionary.hpp"
+#include "SqlFileTimeSeriesBlock.hpp"
 #include "../data/DataEnums.hpp"
 #include "../data/EndUses.hpp"
 #include "../core/Optional.hpp"
@@ -43,7 +44,11 @@
 
 #include <boost/optional.hpp>
 
+#include <array>
+#include <list>
+#include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace openstudio{
@@ -656,6 +661,18 @@ namespace openstudio{
        *  down by ReportingFrequency and determine how many TimeSeries will be returned. */
       std::vector<TimeSeries> timeSeries(const SqlFileTimeSeriesQuery& query);
 
+      // return every series of timeSeriesNames for keyValues, or for all key values if keyValues is empty, read in one query
+      SqlFileTimeSeriesBlock timeSeriesBlock(const std::string& envPeriod, const std::string& reportingFrequency,
+                                             const std::vector<std::string>& timeSeriesNames, const std::vector<std::string>& keyValues);
+
+      // data dictionary entry of a series, trying the uppercased key value and the database name of the reporting frequency if needed
+      boost::optional<DataDictionaryItem> dataDictionaryItem(const std::string& envPeriod, const std::string& reportingFrequency,
+                                                             const std::string& timeSeriesName, const std::string& keyValue);
+
+      // append at most chunkSize values of a series reported after row lastRowId, and their date times, then advance lastRowId
+      void timeSeriesChunk(const std::string& table, int recordIndex, int envPeriodIndex, unsigned chunkSize, sqlite3_int64& lastRowId,
+                           std::vector<double>& values, std::vector<DateTime>& dateTimes);
+
       // returns an optional pair of date times for begin and end of daylight savings time
       boost::optional<std::pair<openstudio::DateTime, openstudio::DateTime> > daylightSavingsPeriod() const;
 
@@ -756,6 +773,45 @@ namespace openstudio{
       /// execute a statement and return the results (if any) in a vector of string
       boost::optional<std::vector<std::string> > execAndReturnVectorOfString(const std::string& statement) const;
 
+      /// execute a statement with '?' parameters bound in order to args and return the first (if any) value as a double
+      template <typename... Args>
+      boost::optional<double> execAndReturnFirstDouble(const std::string& statement, const Args&... args) const {
+        return firstDouble(boundStatement(statement, args...));
+      }
+
+      /// execute a statement with '?' parameters bound in order to args and return the first (if any) value as an int
+      template <typename... Args>
+      boost::optional<int> execAndReturnFirstInt(const std::string& statement, const Args&... args) const {
+        return firstInt(boundStatement(statement, args...));
+      }
+
+      /// execute a statement with '?' parameters bound in order to args and return the first (if any) value as a string
+      template <typename... Args>
+      boost::optional<std::string> execAndReturnFirstString(const std::string& statement, const Args&... args) const {
+        return firstString(boundStatement(statement, args...));
+      }
+
+      /// execute a statement with '?' parameters bound in order to args and return the results (if any) in a vector of double
+      template <typename... Args>
+      boost::optional<std::vector<double> > execAndReturnVectorOfDouble(const std::string& statement, const Args&... args) const {
+        return vectorOfDouble(boundStatement(statement, args...));
+      }
+
+      /// execute a statement with '?' parameters bound in order to args and return the results (if any) in a vector of int
+      template <typename... Args>
+      boost::optional<std::vector<int> > execAndReturnVectorOfInt(const std::string& statement, const Args&... args) const {
+        return vectorOfInt(boundStatement(statement, args...));
+      }
+
+      /// execute a statement with '?' parameters bound in order to args and return the results (if any) in a vector of string
+      template <typename... Args>
+      boost::optional<std::vector<std::string> > execAndReturnVectorOfString(const std::string& statement, const Args&... args) const {
+        return vectorOfString(boundStatement(statement, args...));
+      }
+
+      /// number of prepared statements currently held in the statement cache
+      unsigned numCachedStatements() const;
+
       // execute a statement and return the error code, used for create/drop tables
       int execute(const std::string& statement);
 
@@ -817,6 +873,31 @@ namespace openstudio{
       std::vector<double> timeSeriesValues(const DataDictionaryItem& dataDictionary);
       boost::optional<Date> timeSeriesStartDate(const DataDictionaryItem& dataDictionary);
 
+      // time axis of reported values, built one report at a time in the order of the Time table
+      struct ReportTimeAxis
+      {
+        ReportTimeAxis(const std::string& t_reportingFrequency, int t_envPeriodIndex, bool t_energyPlus83);
+
+        ReportingFrequency frequency;
+        int envPeriodIndex;
+        bool energyPlus83;
+        bool isIntervalTimeSeries; // true while every report has the same interval
+        boost::optional<unsigned> reportingIntervalMinutes;
+        boost::optional<DateTime> firstReportDateTime;
+        std::vector<long> secondsFromStart;
+        long cumulativeSeconds;
+      };
+
+      // add a report of Time.Year, Time.Month, Time.Day and Time.Interval to axis
+      void addReportTime(ReportTimeAxis& axis, const boost::optional<unsigned>& year, unsigned month, unsigned day, unsigned intervalMinutes);
+
+      // true for files written by EnergyPlus 8.3, which reports wrong intervals
+      bool isEnergyPlus83() const;
+
+      // data dictionary entry for an uppercased environment period, trying the uppercased key value if needed
+      boost::optional<DataDictionaryItem> findDataDictionaryItem(const std::string& queryEnvPeriod, const std::string& reportingFrequency,
+                                                                 const std::string& timeSeriesName, const std::string& keyValue) const;
+
       // return first date in time table used for start date of run period variables
       openstudio::DateTime firstDateTime(bool includeHourAndMinute, int envPeriodIndex);
 
@@ -830,6 +911,76 @@ namespace openstudio{
 
       bool isValidConnection();
 
+      // prepares statement, null if the connection is closed or statement does not compile, the caller must finalize it
+      sqlite3_stmt* prepareStatement(const std::string& statement) const;
+
+      // returns the prepared statement for statement from the cache, preparing and caching it on first use
+      // only statements that bind their parameters are cached, statements with values formatted into their text are not reused
+      // cached statements are reset and have their bindings cleared after each use, null if statement does not compile
+      sqlite3_stmt* cachedStatement(const std::string& statement) const;
+
+      // finalizes all cached statements, must be called before the connection is closed
+      void clearStatementCache() const;
+
+      static void bindParameter(sqlite3_stmt* statement, int position, const std::string& value);
+      static void bindParameter(sqlite3_stmt* statement, int position, const char* value);
+      static void bindParameter(sqlite3_stmt* statement, int position, int value);
+      static void bindParameter(sqlite3_stmt* statement, int position, sqlite3_int64 value);
+      static void bindParameter(sqlite3_stmt* statement, int position, double value);
+
+      // binds each parameter as text
+      sqlite3_stmt* boundStatement(const std::string& statement, const std::vector<std::string>& parameters) const;
+
+      template <typename... Args>
+      sqlite3_stmt* boundStatement(const std::string& statement, const Args&... args) const {
+        sqlite3_stmt* result = cachedStatement(statement);
+        if (result) {
+          int position = 0;
+          (bindParameter(result, ++position, args), ...);
+        }
+        return result;
+      }
+
+      // step a cached statement, collect its result and reset it
+      boost::optional<double> firstDouble(sqlite3_stmt* statement) const;
+      boost::optional<int> firstInt(sqlite3_stmt* statement) const;
+      boost::optional<std::string> firstString(sqlite3_stmt* statement) const;
+      boost::optional<std::vector<double> > vectorOfDouble(sqlite3_stmt* statement) const;
+      boost::optional<std::vector<int> > vectorOfInt(sqlite3_stmt* statement) const;
+      boost::optional<std::vector<std::string> > vectorOfString(sqlite3_stmt* statement) const;
+
+      // value of a single cell in tabulardatawithstrings, answered from the tabular data cache for cached reports
+      boost::optional<double> tabularDataValue(const std::string& reportName, const std::string& reportForString,
+                                               const std::string& tableName, const std::string& rowName,
+                                               const std::string& columnName, const std::string& units) const;
+
+      // key of a cell in tabulardatawithstrings: report name, report for string, table name, row name, column name and units
+      typedef std::array<std::string, 6> TabularDataKey;
+
+      struct TabularDataCell
+      {
+        double value;     // Value as sqlite converts it to a double
+        std::string text; // Value as stored
+      };
+
+      typedef std::map<TabularDataKey, TabularDataCell> TabularDataCache;
+
+      // true if every cell of this table is held in the tabular data cache
+      static bool isCachedTabularData(const std::string& reportName, const std::string& tableName);
+
+      // cells of the cached reports and tables, loaded with a single query on first use
+      const TabularDataCache& tabularDataCache() const;
+
+      // cached cells of one table, in key order
+      std::vector<TabularDataCache::const_iterator> tabularDataTable(const std::string& reportName, const std::string& reportForString,
+                                                                     const std::string& tableName) const;
+
+      // discard the tabular data cache, called whenever the file may have changed
+      void clearTabularDataCache() const;
+
+      // Economics Results Summary Report annual cost for columnName, rows 'Cost' in '~~$~~' or 'Cost (~~$~~)'
+      boost::optional<double> annualCostTableValue(const std::string& columnName) const;
+
       void mf_makeConsistent(std::vector<SqlFileTimeSeriesQuery>& queries);
 
       openstudio::path m_path;
@@ -844,6 +995,13 @@ namespace openstudio{
 
       bool m_hasIlluminanceMapYear;
 
+      // prepared statements with their text, most recently used first
+      // not guarded, SqlFile is not thread-safe and a cached statement must not be used from two threads at once
+      mutable std::list<std::pair<std::string, sqlite3_stmt*> > m_statementCache;
+      mutable std::unordered_map<std::string, std::list<std::pair<std::string, sqlite3_stmt*> >::iterator> m_statementCacheIndex;
+
+      mutable boost::optional<TabularDataCache> m_tabularDataCache;
+
       REGISTER_LOGGER("openstudio.energyplus.SqlFile");
     };
 
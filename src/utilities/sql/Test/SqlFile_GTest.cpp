@@ -31,14 +31,20 @@
 
 #include "SqlFileFixture.hpp"
 
+#include "../SqlFileTimeSeriesBlock.hpp"
+#include "../SqlFileTimeSeriesCursor.hpp"
+
 #include "../../time/Date.hpp"
 #include "../../time/Calendar.hpp"
 #include "../../core/Optional.hpp"
 #include "../../data/DataEnums.hpp"
+#include "../../data/EndUses.hpp"
 #include "../../data/TimeSeries.hpp"
 #include "../../filetypes/EpwFile.hpp"
 #include "../../units/UnitFactory.hpp"
 
+#include <chrono>
+#include <cmath>
 #include <iostream>
 #include <boost/regex.hpp>
 #include <resources.hxx>
@@ -188,6 +194,175 @@ TEST_F(SqlFileFixture, BadStatement)
   EXPECT_FALSE(result);
 }
 
+TEST_F(SqlFileFixture, BoundParameters)
+{
+  // values are bound, not formatted into the statement, so quotes need no escaping
+  boost::optional<std::string> name = sqlFile.execAndReturnFirstString("SELECT ?", std::vector<std::string>{"O'Brien's Zone"});
+  ASSERT_TRUE(name);
+  EXPECT_EQ("O'Brien's Zone", *name);
+
+  boost::optional<int> i = sqlFile.execAndReturnFirstInt("SELECT ? + ?", std::vector<std::string>{"40", "2"});
+  ASSERT_TRUE(i);
+  EXPECT_EQ(42, *i);
+
+  // the same cached statement is reused with different parameters
+  boost::optional<std::vector<std::string> > values = sqlFile.execAndReturnVectorOfString(
+    "SELECT Value FROM tabulardatawithstrings WHERE ReportName=? AND ReportForString=? AND TableName=? AND RowName=? AND ColumnName=? AND Units=?",
+    std::vector<std::string>{"AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "Site and Source Energy", "Net Site Energy", "Total Energy", "GJ"});
+  ASSERT_TRUE(values);
+  ASSERT_EQ(1u, values->size());
+  EXPECT_NEAR(*sqlFile.netSiteEnergy(), std::stod(values->front()), 1.0e-9);
+
+  values = sqlFile.execAndReturnVectorOfString(
+    "SELECT Value FROM tabulardatawithstrings WHERE ReportName=? AND ReportForString=? AND TableName=? AND RowName=? AND ColumnName=? AND Units=?",
+    std::vector<std::string>{"AnnualBuildingUtilityPerformanceSummary", "Entire Facility", "Site and Source Energy", "No Such Row'", "Total Energy", "GJ"});
+  ASSERT_TRUE(values);
+  EXPECT_TRUE(values->empty());
+
+  EXPECT_FALSE(sqlFile.execAndReturnFirstDouble("SELECT * FROM NonExistantTable WHERE Name=?", std::vector<std::string>{"x"}));
+}
+
+TEST_F(SqlFileFixture, PreparedStatementCache)
+{
+  const std::vector<std::string> rows{"Heating", "Cooling", "Interior Lighting", "Interior Equipment", "Fans", "Pumps"};
+  const std::vector<boost::optional<double> > getters{sqlFile.electricityHeating(), sqlFile.electricityCooling(),
+    sqlFile.electricityInteriorLighting(), sqlFile.electricityInteriorEquipment(), sqlFile.electricityFans(), sqlFile.electricityPumps()};
+
+  // formatted statements are prepared for each call, bound ones are cached, both agree with the getters
+  for (unsigned i = 0; i < rows.size(); ++i) {
+    std::string query = "SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and "
+                        "(ReportForString = 'Entire Facility') and (TableName = 'End Uses') and (ColumnName = 'Electricity') and "
+                        "(RowName = '" + rows[i] + "') and (Units = 'GJ')";
+    ASSERT_TRUE(getters[i]);
+    EXPECT_EQ(getters[i], sqlFile.execAndReturnFirstDouble(query));
+    EXPECT_EQ(getters[i], sqlFile.execAndReturnFirstDouble(
+      "SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and "
+      "(ReportForString = 'Entire Facility') and (TableName = 'End Uses') and (ColumnName = 'Electricity') and "
+      "(RowName = ?) and (Units = 'GJ')", std::vector<std::string>{rows[i]}));
+  }
+
+  // more distinct bound statements than the cache holds, the least recently used are evicted and prepared again
+  for (unsigned i = 0; i < 600; ++i) {
+    boost::optional<int> value = sqlFile.execAndReturnFirstInt("SELECT ? + " + std::to_string(i), std::vector<std::string>{"1"});
+    ASSERT_TRUE(value);
+    EXPECT_EQ(static_cast<int>(i) + 1, *value);
+  }
+  boost::optional<int> value = sqlFile.execAndReturnFirstInt("SELECT ? + 0", std::vector<std::string>{"2"});
+  ASSERT_TRUE(value);
+  EXPECT_EQ(2, *value);
+  EXPECT_EQ(getters[0], sqlFile.electricityHeating());
+}
+
+// timing only, run with --gtest_also_run_disabled_tests
+TEST_F(SqlFileFixture, DISABLED_PreparedStatementCache_Benchmark)
+{
+  const unsigned n = 1800;
+  const std::vector<std::string> rows{"Heating", "Cooling", "Interior Lighting", "Interior Equipment", "Fans", "Pumps"};
+
+  // before: every call formats its values into the statement text, which has to be compiled again each time
+  double sum1 = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < n; ++i) {
+    std::string query = "SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and "
+                        "(ReportForString = 'Entire Facility') and (TableName = 'End Uses') and (ColumnName = 'Electricity') and "
+                        "(RowName = '" + rows[i % rows.size()] + "') and (Units = 'GJ') and (" + std::to_string(i) + " = " + std::to_string(i) + ")";
+    boost::optional<double> value = sqlFile.execAndReturnFirstDouble(query);
+    ASSERT_TRUE(value);
+    sum1 += *value;
+  }
+  auto formatted = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+  // after: one cached statement with bound parameters
+  double sum2 = 0;
+  start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < n; ++i) {
+    boost::optional<double> value = sqlFile.execAndReturnFirstDouble(
+      "SELECT Value from tabulardatawithstrings where (reportname = 'AnnualBuildingUtilityPerformanceSummary') and "
+      "(ReportForString = 'Entire Facility') and (TableName = 'End Uses') and (ColumnName = 'Electricity') and "
+      "(RowName = ?) and (Units = 'GJ')", std::vector<std::string>{rows[i % rows.size()]});
+    ASSERT_TRUE(value);
+    sum2 += *value;
+  }
+  auto bound = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+  // the end use getters share the same cached statement
+  double sum3 = 0;
+  start = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i < n / rows.size(); ++i) {
+    sum3 += *sqlFile.electricityHeating() + *sqlFile.electricityCooling() + *sqlFile.electricityInteriorLighting()
+          + *sqlFile.electricityInteriorEquipment() + *sqlFile.electricityFans() + *sqlFile.electricityPumps();
+  }
+  auto getters = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+  EXPECT_NEAR(sum1, sum2, 1.0e-6 * (1.0 + std::abs(sum1)));
+  EXPECT_NEAR(sum1, sum3, 1.0e-6 * (1.0 + std::abs(sum1)));
+
+  LOG_FREE(Info, "PreparedStatementCache_Benchmark", "Per query latency over " << n << " queries: formatted statements "
+           << static_cast<double>(formatted) / n << " us, bound parameters " << static_cast<double>(bound) / n
+           << " us, end use getters " << static_cast<double>(getters) / n << " us");
+}
+
+TEST_F(SqlFileFixture, TabularDataCache)
+{
+  // getters answered from the cached tabular reports agree with querying tabulardatawithstrings directly
+  auto direct = [](const std::string& reportName, const std::string& tableName, const std::string& rowName, const std::string& columnName,
+                   const std::string& units) {
+    return sqlFile.execAndReturnFirstDouble(
+      "SELECT Value FROM tabulardatawithstrings WHERE ReportName=? AND ReportForString='Entire Facility' AND TableName=? AND RowName=? AND ColumnName=? AND Units=?",
+      std::vector<std::string>{reportName, tableName, rowName, columnName, units});
+  };
+
+  const std::string abups = "AnnualBuildingUtilityPerformanceSummary";
+  ASSERT_TRUE(sqlFile.netSiteEnergy());
+  EXPECT_EQ(direct(abups, "Site and Source Energy", "Net Site Energy", "Total Energy", "GJ"), sqlFile.netSiteEnergy());
+  EXPECT_EQ(direct(abups, "Site and Source Energy", "Total Source Energy", "Total Energy", "GJ"), sqlFile.totalSourceEnergy());
+  ASSERT_TRUE(sqlFile.electricityInteriorLighting());
+  EXPECT_EQ(direct(abups, "End Uses", "Interior Lighting", "Electricity", "GJ"), sqlFile.electricityInteriorLighting());
+  EXPECT_EQ(direct(abups, "End Uses", "Heating", "Natural Gas", "GJ"), sqlFile.naturalGasHeating());
+  EXPECT_EQ(direct(abups, "End Uses", "Total End Uses", "Water", "m3"), sqlFile.waterTotalEndUses());
+  EXPECT_EQ(direct("SystemSummary", "Time Setpoint Not Met", "Facility", "During Heating", "hr"), sqlFile.hoursHeatingSetpointNotMet());
+
+  boost::optional<double> hours = sqlFile.execAndReturnFirstDouble(
+    "SELECT Value FROM tabulardatawithstrings WHERE ReportName='InputVerificationandResultsSummary' AND ReportForString='Entire Facility' "
+    "AND TableName='General' AND RowName='Hours Simulated' AND Units='hrs'");
+  ASSERT_TRUE(hours);
+  EXPECT_EQ(hours, sqlFile.hoursSimulated());
+
+  boost::optional<EndUses> endUses = sqlFile.endUses();
+  ASSERT_TRUE(endUses);
+  for (const EndUseFuelType& fuelType : EndUses::fuelTypes()) {
+    for (const EndUseCategoryType& category : EndUses::categories()) {
+      boost::optional<double> value = direct(abups, "End Uses", category.valueDescription(), fuelType.valueDescription(),
+                                             EndUses::getUnitsForFuelType(fuelType));
+      ASSERT_TRUE(value);
+      EXPECT_EQ(*value, endUses->getEndUse(fuelType, category));
+    }
+  }
+
+  boost::optional<double> electricCost = sqlFile2.execAndReturnFirstDouble(
+    "SELECT Value FROM tabulardatawithstrings WHERE ReportName='Economics Results Summary Report' AND ReportForString='Entire Facility' "
+    "AND TableName='Annual Cost' AND ColumnName='Electric' AND (((RowName='Cost') AND (Units='~~$~~')) OR (RowName='Cost (~~$~~)'))");
+  ASSERT_TRUE(electricCost);
+  EXPECT_EQ(electricCost, sqlFile2.annualTotalCost(FuelType::Electricity));
+}
+
+// timing only, run with --gtest_also_run_disabled_tests
+TEST_F(SqlFileFixture, DISABLED_TabularDataCache_Benchmark)
+{
+  // a reporting measure calling every end use getter is answered from memory after the first one
+  const unsigned n = 100;
+  auto start = std::chrono::steady_clock::now();
+  double sum = 0;
+  for (unsigned i = 0; i < n; ++i) {
+    boost::optional<EndUses> e = sqlFile.endUses();
+    ASSERT_TRUE(e);
+    sum += e->getEndUseByFuelType(EndUseFuelType::Electricity) + *sqlFile.netSiteEnergy() + *sqlFile.electricityTotalEndUses();
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+  EXPECT_GT(sum, 0.0);
+  LOG_FREE(Info, "TabularDataCache_Benchmark", "endUses, netSiteEnergy and electricityTotalEndUses take " << static_cast<double>(elapsed) / n << " us per call");
+}
+
 TEST_F(SqlFileFixture, CreateSqlFile)
 {
   openstudio::path outfile = openstudio::tempDir() / openstudio::toPath("OpenStudioSqlFileTest.sql");
@@ -299,6 +474,236 @@ TEST_F(SqlFileFixture, CreateSqlFile)
 
 }
 
+namespace {
+
+  // writes the hourly "Zone Mean Air Temperature" of numZones zones, and "Zone Air Relative Humidity"
+  // of ZONE 0 for the first half of the period
+  openstudio::path writeZoneTemperatures(const std::string& fileName, unsigned numZones, unsigned numHours)
+  {
+    openstudio::path outfile = openstudio::tempDir() / openstudio::toPath(fileName);
+    if (openstudio::filesystem::exists(outfile))
+    {
+      openstudio::filesystem::remove(outfile);
+    }
+
+    openstudio::Calendar c(2012);
+    openstudio::SqlFile sql(outfile,
+        openstudio::EpwFile(resourcesPath() / toPath("utilities/Filetypes/USA_CO_Golden-NREL.724666_TMY3.epw")),
+        openstudio::DateTime::now(),
+        c);
+    EXPECT_TRUE(sql.connectionOpen());
+
+    for (unsigned zone = 0; zone < numZones; ++zone) {
+      std::vector<double> values;
+      for (unsigned hour = 0; hour < numHours; ++hour) {
+        values.push_back(20.0 + zone + 0.01 * hour);
+      }
+      TimeSeries timeSeries(c.startDate(), openstudio::Time(0,1), openstudio::createVector(values), "C");
+      sql.insertTimeSeriesData("Average", "Zone", "Zone", "ZONE " + std::to_string(zone), "Zone Mean Air Temperature",
+          openstudio::ReportingFrequency::Hourly, boost::optional<std::string>(), "C", timeSeries);
+    }
+
+    std::vector<double> humidity(numHours / 2, 50.0);
+    TimeSeries timeSeries(c.startDate(), openstudio::Time(0,1), openstudio::createVector(humidity), "%");
+    sql.insertTimeSeriesData("Average", "Zone", "Zone", "ZONE 0", "Zone Air Relative Humidity",
+        openstudio::ReportingFrequency::Hourly, boost::optional<std::string>(), "%", timeSeries);
+
+    return outfile;
+  }
+
+}
+
+TEST_F(SqlFileFixture, TimeSeriesBlock)
+{
+  const unsigned numZones = 100;
+  const unsigned numHours = 48;
+  openstudio::path outfile = writeZoneTemperatures("OpenStudioSqlFileTimeSeriesBlockTest.sql", numZones, numHours);
+
+  openstudio::SqlFile sql(outfile);
+  ASSERT_TRUE(sql.connectionOpen());
+  std::vector<std::string> envPeriods = sql.availableEnvPeriods();
+  ASSERT_EQ(1u, envPeriods.size());
+  std::vector<std::string> reportingFrequencies = sql.availableReportingFrequencies(envPeriods[0]);
+  ASSERT_EQ(1u, reportingFrequencies.size());
+
+  // all key values of one variable
+  SqlFileTimeSeriesBlock block = sql.timeSeriesBlock(envPeriods[0], reportingFrequencies[0], {"Zone Mean Air Temperature"}, {});
+  std::vector<TimeSeries> timeSeries = sql.timeSeries(envPeriods[0], reportingFrequencies[0], "Zone Mean Air Temperature");
+
+  ASSERT_EQ(numZones, block.numColumns());
+  ASSERT_EQ(numHours, block.numRows());
+  ASSERT_EQ(numZones, timeSeries.size());
+  ASSERT_TRUE(block.intervalLength());
+  EXPECT_EQ(openstudio::Time(0,1), block.intervalLength().get());
+  ASSERT_TRUE(block.firstReportDateTime());
+  EXPECT_EQ(timeSeries[0].firstReportDateTime(), block.firstReportDateTime().get());
+  EXPECT_EQ(timeSeries[0].dateTimes(), block.dateTimes());
+
+  boost::optional<unsigned> column = block.column("Zone Mean Air Temperature", "zone 7");
+  ASSERT_TRUE(column);
+  EXPECT_EQ("C", block.units()[*column]);
+  const std::vector<double>& values = block.values(*column);
+  ASSERT_EQ(numHours, values.size());
+  EXPECT_DOUBLE_EQ(27.0, values.front());
+  EXPECT_DOUBLE_EQ(27.47, values.back());
+
+  for (unsigned i = 0; i < block.numColumns(); ++i) {
+    boost::optional<TimeSeries> ts = sql.timeSeries(envPeriods[0], reportingFrequencies[0], block.names()[i], block.keyValues()[i]);
+    ASSERT_TRUE(ts);
+    EXPECT_EQ(openstudio::toStandardVector(ts->values()), block.values(i));
+    boost::optional<TimeSeries> blockTs = block.timeSeries(i);
+    ASSERT_TRUE(blockTs);
+    EXPECT_EQ(openstudio::toStandardVector(ts->daysFromFirstReport()), openstudio::toStandardVector(blockTs->daysFromFirstReport()));
+  }
+
+  // selected key values of several variables share one time axis, missing reports are NaN
+  block = sql.timeSeriesBlock(envPeriods[0], reportingFrequencies[0], {"Zone Mean Air Temperature", "Zone Air Relative Humidity"}, {"Zone 0", "ZONE 1"});
+  ASSERT_EQ(3u, block.numColumns());
+  ASSERT_EQ(numHours, block.numRows());
+  column = block.column("Zone Air Relative Humidity", "ZONE 0");
+  ASSERT_TRUE(column);
+  EXPECT_DOUBLE_EQ(50.0, block.values(*column).front());
+  EXPECT_TRUE(std::isnan(block.values(*column).back()));
+  EXPECT_FALSE(block.column("Zone Air Relative Humidity", "ZONE 1"));
+
+  // the same series requested twice gets one column
+  block = sql.timeSeriesBlock(envPeriods[0], reportingFrequencies[0], {"Zone Mean Air Temperature", "Zone Mean Air Temperature"}, {"Zone 1", "ZONE 1"});
+  ASSERT_EQ(1u, block.numColumns());
+  ASSERT_EQ(numHours, block.numRows());
+  EXPECT_EQ("ZONE 1", block.keyValues()[0]);
+  EXPECT_DOUBLE_EQ(21.0, block.values(0).front());
+  EXPECT_DOUBLE_EQ(21.47, block.values(0).back());
+
+  // nothing matches
+  block = sql.timeSeriesBlock(envPeriods[0], reportingFrequencies[0], {"Not A Variable"}, {});
+  EXPECT_EQ(0u, block.numColumns());
+  EXPECT_EQ(0u, block.numRows());
+  EXPECT_FALSE(block.firstReportDateTime());
+}
+
+// timing only, run with --gtest_also_run_disabled_tests
+TEST_F(SqlFileFixture, DISABLED_TimeSeriesBlock_Benchmark)
+{
+  const unsigned numZones = 100;
+  const unsigned numHours = 48;
+  openstudio::path outfile = writeZoneTemperatures("OpenStudioSqlFileTimeSeriesBlockBenchmark.sql", numZones, numHours);
+
+  openstudio::SqlFile sql(outfile);
+  ASSERT_TRUE(sql.connectionOpen());
+  std::vector<std::string> envPeriods = sql.availableEnvPeriods();
+  ASSERT_EQ(1u, envPeriods.size());
+  std::vector<std::string> reportingFrequencies = sql.availableReportingFrequencies(envPeriods[0]);
+  ASSERT_EQ(1u, reportingFrequencies.size());
+
+  auto start = std::chrono::steady_clock::now();
+  SqlFileTimeSeriesBlock block = sql.timeSeriesBlock(envPeriods[0], reportingFrequencies[0], {"Zone Mean Air Temperature"}, {});
+  auto middle = std::chrono::steady_clock::now();
+  std::vector<TimeSeries> timeSeries = sql.timeSeries(envPeriods[0], reportingFrequencies[0], "Zone Mean Air Temperature");
+  auto end = std::chrono::steady_clock::now();
+  EXPECT_EQ(numZones, block.numColumns());
+  EXPECT_EQ(numZones, timeSeries.size());
+
+  LOG_FREE(Info, "TimeSeriesBlock_Benchmark", numZones << " series of " << numHours << " values took "
+           << std::chrono::duration_cast<std::chrono::microseconds>(middle - start).count() << " us with timeSeriesBlock and "
+           << std::chrono::duration_cast<std::chrono::microseconds>(end - middle).count() << " us with timeSeries.");
+}
+
+TEST_F(SqlFileFixture, TimeSeriesCursor)
+{
+  openstudio::path outfile = openstudio::tempDir() / openstudio::toPath("OpenStudioSqlFileTimeSeriesCursorTest.sql");
+  if (openstudio::filesystem::exists(outfile))
+  {
+    openstudio::filesystem::remove(outfile);
+  }
+
+  openstudio::Calendar c(2012);
+  const unsigned numHours = 30 * 24;
+  std::vector<double> values;
+  for (unsigned hour = 0; hour < numHours; ++hour) {
+    values.push_back(static_cast<double>((hour * 37) % 101));
+  }
+  // a single peak
+  values[500] = 200.0;
+
+  {
+    openstudio::SqlFile sql(outfile,
+        openstudio::EpwFile(resourcesPath() / toPath("utilities/Filetypes/USA_CO_Golden-NREL.724666_TMY3.epw")),
+        openstudio::DateTime::now(),
+        c);
+    ASSERT_TRUE(sql.connectionOpen());
+    TimeSeries timeSeries(c.startDate(), openstudio::Time(0,1), openstudio::createVector(values), "W");
+    sql.insertTimeSeriesData("Sum", "Facility", "Zone", "BUILDING", "Facility Total Electric Demand Power",
+        openstudio::ReportingFrequency::Hourly, boost::optional<std::string>(), "W", timeSeries);
+  }
+
+  openstudio::SqlFile sql(outfile);
+  ASSERT_TRUE(sql.connectionOpen());
+  std::vector<std::string> envPeriods = sql.availableEnvPeriods();
+  ASSERT_EQ(1u, envPeriods.size());
+  std::vector<std::string> reportingFrequencies = sql.availableReportingFrequencies(envPeriods[0]);
+  ASSERT_EQ(1u, reportingFrequencies.size());
+
+  boost::optional<TimeSeries> ts = sql.timeSeries(envPeriods[0], reportingFrequencies[0], "Facility Total Electric Demand Power", "BUILDING");
+  ASSERT_TRUE(ts);
+  std::vector<DateTime> dateTimes = ts->dateTimes();
+
+  EXPECT_FALSE(sql.timeSeriesCursor(envPeriods[0], reportingFrequencies[0], "Facility Total Electric Demand Power", "NOT A KEY"));
+
+  // chunks concatenate to the whole series
+  boost::optional<SqlFileTimeSeriesCursor> cursor = sql.timeSeriesCursor(envPeriods[0], reportingFrequencies[0], "Facility Total Electric Demand Power", "building", 100);
+  ASSERT_TRUE(cursor);
+  EXPECT_EQ("W", cursor->units());
+  std::vector<double> cursorValues;
+  std::vector<DateTime> cursorDateTimes;
+  unsigned numChunks = 0;
+  while (cursor->next()) {
+    ++numChunks;
+    EXPECT_LE(cursor->values().size(), 100u);
+    ASSERT_EQ(cursor->values().size(), cursor->dateTimes().size());
+    cursorValues.insert(cursorValues.end(), cursor->values().begin(), cursor->values().end());
+    cursorDateTimes.insert(cursorDateTimes.end(), cursor->dateTimes().begin(), cursor->dateTimes().end());
+  }
+  EXPECT_EQ(8u, numChunks);
+  EXPECT_EQ(numHours, cursor->numValuesRead());
+  EXPECT_TRUE(cursor->values().empty());
+  EXPECT_FALSE(cursor->next());
+  EXPECT_EQ(values, cursorValues);
+  // cursor date times come from Time.Hour and Time.Minute, which insertTimeSeriesData writes one hour later than
+  // the interval based date times of timeSeries, so only compare their spacing
+  ASSERT_EQ(dateTimes.size(), cursorDateTimes.size());
+  for (unsigned i = 1; i < dateTimes.size(); ++i) {
+    EXPECT_EQ(dateTimes[i] - dateTimes[0], cursorDateTimes[i] - cursorDateTimes[0]);
+  }
+
+  // summary
+  boost::optional<SqlFileTimeSeriesSummary> summary = sql.timeSeriesSummary(envPeriods[0], reportingFrequencies[0], "Facility Total Electric Demand Power", "BUILDING",
+                                                                            {0.0, 50.0, 100.0});
+  ASSERT_TRUE(summary);
+  EXPECT_EQ(numHours, summary->count());
+  double sum = 0;
+  for (double value : values) {
+    sum += value;
+  }
+  EXPECT_DOUBLE_EQ(sum, summary->sum());
+  ASSERT_TRUE(summary->mean());
+  EXPECT_DOUBLE_EQ(sum / numHours, summary->mean().get());
+  ASSERT_TRUE(summary->maximum());
+  EXPECT_DOUBLE_EQ(200.0, summary->maximum().get());
+  ASSERT_TRUE(summary->maximumDateTime());
+  EXPECT_EQ(cursorDateTimes[500], summary->maximumDateTime().get());
+  ASSERT_TRUE(summary->minimum());
+  EXPECT_DOUBLE_EQ(0.0, summary->minimum().get());
+  ASSERT_TRUE(summary->minimumDateTime());
+  EXPECT_EQ(cursorDateTimes[0], summary->minimumDateTime().get());
+
+  ASSERT_EQ(2u, summary->histogramCounts().size());
+  unsigned below50 = std::count_if(values.begin(), values.end(), [](double value) { return value < 50.0; });
+  EXPECT_EQ(below50, summary->histogramCounts()[0]);
+  EXPECT_EQ(numHours - below50 - 1, summary->histogramCounts()[1]);
+  EXPECT_EQ(0u, summary->numBelowHistogram());
+  EXPECT_EQ(1u, summary->numAboveHistogram());
+}
+
 TEST_F(SqlFileFixture, AnnualTotalCosts) {
 
   struct SqlResults {